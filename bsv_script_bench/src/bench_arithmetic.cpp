@@ -1,7 +1,225 @@
 #include "bench_harness.h"
+#include "bench_registry.h"
+#include "model_fit.h"
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <openssl/bn.h>
+
+// Big-number script arithmetic. Since Genesis, BSV script numbers are not
+// limited to 4 bytes, and the node evaluates OP_ADD..OP_MOD and the numeric
+// comparisons with OpenSSL BIGNUMs. Each operation here does what the
+// interpreter does per opcode: decode both operands from their stack
+// encoding, run the BIGNUM operation, and encode the result back.
+//
+// input_bytes is the size of the larger operand, which is what the
+// estimator prices arithmetic opcodes by. OP_MUL multiplies two n-byte
+// numbers; OP_DIV and OP_MOD divide an n-byte number by an n/2-byte one,
+// the shape that maximizes schoolbook division's work for a given n.
+
+namespace {
+
+struct BnFree { void operator()(BIGNUM* p) const { BN_free(p); } };
+struct BnCtxFree { void operator()(BN_CTX* p) const { BN_CTX_free(p); } };
+
+using Bn = std::unique_ptr<BIGNUM, BnFree>;
+using BnCtx = std::unique_ptr<BN_CTX, BnCtxFree>;
+
+using Bytes = std::vector<uint8_t>;
+
+// Script number: little-endian magnitude, sign in the top bit of the last byte
+void decode(const Bytes& v, BIGNUM* out) {
+    if (v.empty()) {
+        BN_zero(out);
+        return;
+    }
+    bool negative = (v.back() & 0x80) != 0;
+    if (negative) {
+        Bytes magnitude = v;
+        magnitude.back() &= 0x7f;
+        BN_lebin2bn(magnitude.data(), static_cast<int>(magnitude.size()), out);
+    } else {
+        BN_lebin2bn(v.data(), static_cast<int>(v.size()), out);
+    }
+    BN_set_negative(out, negative);
+}
+
+Bytes encode(const BIGNUM* n) {
+    if (BN_is_zero(n)) return {};
+    int size = BN_num_bytes(n);
+    Bytes v(size);
+    BN_bn2lebinpad(n, v.data(), size);
+    // An extra byte if the magnitude's top bit would be read as the sign
+    if (v.back() & 0x80) v.push_back(0);
+    if (BN_is_negative(n)) v.back() |= 0x80;
+    return v;
+}
+
+// Positive n-byte script number with a full top byte (no sign bit)
+Bytes make_number(size_t n, uint8_t seed) {
+    Bytes v(n);
+    uint32_t x = 0x9e3779b9u * (seed + 1);
+    for (auto& b : v) {
+        x = x * 1664525u + 1013904223u;
+        b = static_cast<uint8_t>(x >> 24);
+    }
+    v.back() = 0x40 | (v.back() & 0x3f);
+    return v;
+}
+
+enum class ArithOp { ADD, SUB, MUL, DIV, MOD, NUMEQUAL, LESSTHAN };
+
+// Decoded operands and scratch state for one case, reused across iterations
+// the way the interpreter reuses its BN_CTX
+struct ArithCase {
+    ArithOp op;
+    Bytes a;
+    Bytes b;
+    BnCtx ctx{BN_CTX_new()};
+    Bn x{BN_new()};
+    Bn y{BN_new()};
+    Bn r{BN_new()};
+
+    // One opcode execution; returns the result size so it can't be elided
+    size_t run() {
+        decode(a, x.get());
+        decode(b, y.get());
+        switch (op) {
+            case ArithOp::ADD: BN_add(r.get(), x.get(), y.get()); break;
+            case ArithOp::SUB: BN_sub(r.get(), x.get(), y.get()); break;
+            case ArithOp::MUL: BN_mul(r.get(), x.get(), y.get(), ctx.get()); break;
+            case ArithOp::DIV: BN_div(r.get(), nullptr, x.get(), y.get(), ctx.get()); break;
+            // Script OP_MOD keeps the dividend's sign, which is BN_mod's
+            // (truncating) behaviour rather than BN_nnmod's
+            case ArithOp::MOD: BN_mod(r.get(), x.get(), y.get(), ctx.get()); break;
+            case ArithOp::NUMEQUAL: return BN_cmp(x.get(), y.get()) == 0;
+            case ArithOp::LESSTHAN: return BN_cmp(x.get(), y.get()) < 0;
+        }
+        return encode(r.get()).size();
+    }
+};
+
+void add_arith_case(bsv_bench::CaseBuilder& bench, const char* opcode, ArithOp op,
+                    size_t size_a, size_t size_b, const std::string& desc) {
+    bench.add(
+        opcode,
+        desc,
+        std::max(size_a, size_b),
+        [op, size_a, size_b]() -> bsv_bench::BenchOperation {
+            auto c = std::make_shared<ArithCase>();
+            c->op = op;
+            c->a = make_number(size_a, 1);
+            c->b = make_number(size_b, 2);
+            if (op == ArithOp::NUMEQUAL || op == ArithOp::LESSTHAN) {
+                // Equal but for the lowest byte: the comparison scans every word
+                c->b = c->a;
+                c->b[0] ^= 1;
+            }
+            return [c]() {
+                volatile size_t s = c->run();
+                (void)s;
+            };
+        }
+    );
+}
+
+std::string operand_desc(size_t size_a, size_t size_b) {
+    return std::to_string(size_a) + "B, " + std::to_string(size_b) + "B";
+}
+
+} // namespace
+
+BSV_BENCH_FAMILY(arithmetic, add_sub) {
+    for (auto size : bench.axis("sizes", {1, 4, 8, 32, 256, 1000, 10000, 100000, 1000000})) {
+        add_arith_case(bench, "OP_ADD", ArithOp::ADD, size, size, operand_desc(size, size));
+        add_arith_case(bench, "OP_SUB", ArithOp::SUB, size, size, operand_desc(size, size));
+    }
+}
+
+BSV_BENCH_FAMILY(arithmetic, mul) {
+    for (auto size : bench.axis("sizes", {1, 4, 8, 32, 256, 1000, 10000, 100000, 1000000})) {
+        add_arith_case(bench, "OP_MUL", ArithOp::MUL, size, size, operand_desc(size, size));
+    }
+}
+
+BSV_BENCH_FAMILY(arithmetic, div_mod) {
+    // Schoolbook division is quadratic: a 1MB / 512kB division takes
+    // seconds, so the default stops at 100kB; add 1000000 with
+    // --set div_sizes=... to measure it
+    bench.policy.adaptive.min_samples = 10;
+    bench.policy.adaptive.warmup_iterations = 2;
+
+    for (auto size : bench.axis("div_sizes", {2, 4, 8, 32, 256, 1000, 10000, 30000, 100000})) {
+        size_t divisor = std::max<size_t>(size / 2, 1);
+        add_arith_case(bench, "OP_DIV", ArithOp::DIV, size, divisor, operand_desc(size, divisor));
+        add_arith_case(bench, "OP_MOD", ArithOp::MOD, size, divisor, operand_desc(size, divisor));
+    }
+}
+
+BSV_BENCH_FAMILY(arithmetic, compare) {
+    for (auto size : bench.axis("sizes", {1, 4, 8, 32, 256, 1000, 10000, 100000, 1000000})) {
+        add_arith_case(bench, "OP_NUMEQUAL", ArithOp::NUMEQUAL, size, size, operand_desc(size, size));
+        add_arith_case(bench, "OP_LESSTHAN", ArithOp::LESSTHAN, size, size, operand_desc(size, size));
+    }
+}
+
+#ifndef BSV_BENCH_UNIFIED
+// Best of linear, n log n and quadratic by AICc, as bsv_fit_model fits
+// OP_MUL/DIV/MOD
+static void analyze_arithmetic_model(const std::vector<bsv_bench::BenchResult>& results,
+                                     const std::string& opcode_name) {
+    std::vector<bsv_bench::FitPoint> points;
+    for (const auto& r : results) {
+        if (r.opcode != opcode_name) continue;
+        points.push_back(bsv_bench::to_fit_point(r));
+    }
+    if (points.size() < 2) return;
+
+    std::vector<bsv_bench::ModelFit> candidates;
+    bsv_bench::ModelFit fit = bsv_bench::fit_best(
+        {bsv_bench::ModelForm::LINEAR, bsv_bench::ModelForm::NLOGN, bsv_bench::ModelForm::QUADRATIC},
+        points, bsv_bench::FitOptions(), &candidates);
+
+    std::cout << "\n=== " << opcode_name << ": " << bsv_bench::model_form_name(fit.form) << " ===\n";
+    for (const auto& [name, value] : fit.coefficients) {
+        std::cout << "  " << name << ": " << value << "\n";
+    }
+    std::cout << "  R² (weighted): " << fit.diagnostics.r_squared << "\n";
+    std::cout << "  Max relative error: " << fit.diagnostics.max_rel_error * 100 << "%\n";
+    for (const auto& c : candidates) {
+        std::cout << "  AICc " << bsv_bench::model_form_name(c.form) << ": " << c.diagnostics.aicc << "\n";
+    }
+}
+
+int main(int argc, char** argv) {
+    std::cout << "=== BSV Script Benchmark: Arithmetic Operations ===\n";
+    std::cout << "Big-number script arithmetic (OpenSSL BIGNUM), 1B to 1MB operands\n\n";
+
+    bsv_bench::BenchmarkHarness harness;
+    harness.initialize(0);  // Pin to CPU 0
+
+    auto cases = bsv_bench::BenchRegistry::instance().collect(
+        bsv_bench::ParamMatrix(), bsv_bench::CaseFilter());
+    std::vector<bsv_bench::BenchResult> results = bsv_bench::run_cases(harness, cases);
+
+    for (const char* opcode : {"OP_ADD", "OP_SUB", "OP_MUL", "OP_DIV", "OP_MOD"}) {
+        analyze_arithmetic_model(results, opcode);
+    }
+
+    std::string csv_file = "output/bench_arithmetic.csv";
+    std::string json_file = "output/bench_arithmetic.json";
+
+    harness.export_csv(results, csv_file);
+    harness.export_json(results, json_file);
+
+    std::cout << "\n=== Results exported to:\n";
+    std::cout << "  " << csv_file << "\n";
+    std::cout << "  " << json_file << "\n";
 
-int main() {
-    std::cout << "Arithmetic operations benchmarks - placeholder\n";
     return 0;
 }
+#endif
@@ -0,0 +1,576 @@
+#include "bench_harness.h"
+#include "bench_registry.h"
+#include "model_fit.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BSV_BENCH_X86 1
+#endif
+
+// Bitwise opcodes on arbitrary-length operands. OP_AND, OP_OR and OP_XOR
+// combine two equal-length items in place, OP_INVERT flips one in place, and
+// OP_LSHIFT/OP_RSHIFT shift an item by n bits as one big-endian bit string
+// (byte 0 is the most significant), keeping its length.
+//
+// Each opcode is measured with four kernels:
+//   scalar   the node's byte loops (the shifts with its per-byte masks), with
+//            vectorization disabled
+//   autovec  the same operation written for the compiler's vectorizer
+//   avx2     explicit 32-byte kernels
+//   avx512   explicit 64-byte kernels (AVX-512BW)
+// Kernels the CPU lacks are not registered. The node allocates the shift
+// result; every kernel here writes into a preallocated buffer, so only the
+// scalar kernel's zero-fill of it mirrors the node's allocation.
+
+namespace {
+
+#if defined(__clang__)
+#define BSV_NO_VECTORIZE
+#define BSV_SCALAR_LOOP _Pragma("clang loop vectorize(disable) interleave(disable)")
+#else
+#define BSV_NO_VECTORIZE __attribute__((optimize("no-tree-vectorize")))
+#define BSV_SCALAR_LOOP
+#endif
+
+enum class Kernel { SCALAR, AUTOVEC, AVX2, AVX512 };
+
+const char* kernel_name(Kernel k) {
+    switch (k) {
+        case Kernel::SCALAR: return "scalar";
+        case Kernel::AUTOVEC: return "autovec";
+        case Kernel::AVX2: return "avx2";
+        case Kernel::AVX512: return "avx512";
+    }
+    return "?";
+}
+
+bool kernel_supported(Kernel k) {
+    switch (k) {
+        case Kernel::SCALAR:
+        case Kernel::AUTOVEC:
+            return true;
+#ifdef BSV_BENCH_X86
+        case Kernel::AVX2: return __builtin_cpu_supports("avx2");
+        case Kernel::AVX512:
+            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+#else
+        default: return false;
+#endif
+    }
+    return false;
+}
+
+enum class BitOp { AND, OR, XOR };
+
+struct AndOp {
+    static uint8_t apply(uint8_t a, uint8_t b) { return a & b; }
+#ifdef BSV_BENCH_X86
+    __attribute__((target("avx2"))) static __m256i apply(__m256i a, __m256i b) {
+        return _mm256_and_si256(a, b);
+    }
+    __attribute__((target("avx512f"))) static __m512i apply(__m512i a, __m512i b) {
+        return _mm512_and_si512(a, b);
+    }
+#endif
+};
+
+struct OrOp {
+    static uint8_t apply(uint8_t a, uint8_t b) { return a | b; }
+#ifdef BSV_BENCH_X86
+    __attribute__((target("avx2"))) static __m256i apply(__m256i a, __m256i b) {
+        return _mm256_or_si256(a, b);
+    }
+    __attribute__((target("avx512f"))) static __m512i apply(__m512i a, __m512i b) {
+        return _mm512_or_si512(a, b);
+    }
+#endif
+};
+
+struct XorOp {
+    static uint8_t apply(uint8_t a, uint8_t b) { return a ^ b; }
+#ifdef BSV_BENCH_X86
+    __attribute__((target("avx2"))) static __m256i apply(__m256i a, __m256i b) {
+        return _mm256_xor_si256(a, b);
+    }
+    __attribute__((target("avx512f"))) static __m512i apply(__m512i a, __m512i b) {
+        return _mm512_xor_si512(a, b);
+    }
+#endif
+};
+
+// dst op= src, as the node applies OP_AND/OR/XOR to the first operand
+template <class Op>
+BSV_NO_VECTORIZE void binary_scalar(uint8_t* dst, const uint8_t* src, size_t n) {
+    BSV_SCALAR_LOOP
+    for (size_t i = 0; i < n; ++i) dst[i] = Op::apply(dst[i], src[i]);
+}
+
+template <class Op>
+void binary_autovec(uint8_t* __restrict dst, const uint8_t* __restrict src, size_t n) {
+    for (size_t i = 0; i < n; ++i) dst[i] = Op::apply(dst[i], src[i]);
+}
+
+BSV_NO_VECTORIZE void invert_scalar(uint8_t* dst, size_t n) {
+    BSV_SCALAR_LOOP
+    for (size_t i = 0; i < n; ++i) dst[i] = ~dst[i];
+}
+
+void invert_autovec(uint8_t* dst, size_t n) {
+    for (size_t i = 0; i < n; ++i) dst[i] = ~dst[i];
+}
+
+// The node's LShift/RShift: walk the source bytes and OR each one's two
+// parts into the result bytes they land in
+const uint8_t kLShiftMasks[8] = {0xff, 0x7f, 0x3f, 0x1f, 0x0f, 0x07, 0x03, 0x01};
+const uint8_t kRShiftMasks[8] = {0xff, 0xfe, 0xfc, 0xf8, 0xf0, 0xe0, 0xc0, 0x80};
+
+BSV_NO_VECTORIZE void lshift_scalar(uint8_t* out, const uint8_t* x, size_t n, size_t bits) {
+    std::memset(out, 0, n);
+    size_t byte_shift = bits / 8;
+    unsigned bit_shift = bits % 8;
+    uint8_t mask = kLShiftMasks[bit_shift];
+    uint8_t overflow_mask = ~mask;
+    BSV_SCALAR_LOOP
+    for (size_t i = n; i-- > byte_shift;) {
+        size_t k = i - byte_shift;
+        out[k] |= static_cast<uint8_t>((x[i] & mask) << bit_shift);
+        if (k > 0) out[k - 1] |= static_cast<uint8_t>((x[i] & overflow_mask) >> (8 - bit_shift));
+    }
+}
+
+BSV_NO_VECTORIZE void rshift_scalar(uint8_t* out, const uint8_t* x, size_t n, size_t bits) {
+    std::memset(out, 0, n);
+    size_t byte_shift = bits / 8;
+    unsigned bit_shift = bits % 8;
+    uint8_t mask = kRShiftMasks[bit_shift];
+    uint8_t overflow_mask = ~mask;
+    BSV_SCALAR_LOOP
+    for (size_t i = 0; i + byte_shift < n; ++i) {
+        size_t k = i + byte_shift;
+        out[k] |= static_cast<uint8_t>((x[i] & mask) >> bit_shift);
+        if (k + 1 < n) out[k + 1] |= static_cast<uint8_t>((x[i] & overflow_mask) << (8 - bit_shift));
+    }
+}
+
+// One result byte computed directly: for a left shift, out[k] is x[k + s]
+// shifted up plus the top bits of x[k + s + 1] (s = bits / 8), and a right
+// shift mirrors it. The vectorized kernels cover the body and
+// leave the edges, where a source byte is missing, to these.
+inline uint8_t lshift_byte(const uint8_t* x, size_t n, size_t k, size_t byte_shift, unsigned b) {
+    size_t i = k + byte_shift;
+    if (i >= n) return 0;
+    unsigned hi = x[i] << b;
+    unsigned lo = (b && i + 1 < n) ? x[i + 1] >> (8 - b) : 0;
+    return static_cast<uint8_t>(hi | lo);
+}
+
+inline uint8_t rshift_byte(const uint8_t* x, size_t k, size_t byte_shift, unsigned b) {
+    if (k < byte_shift) return 0;
+    size_t i = k - byte_shift;
+    unsigned lo = x[i] >> b;
+    unsigned hi = (b && i > 0) ? x[i - 1] << (8 - b) : 0;
+    return static_cast<uint8_t>(hi | lo);
+}
+
+void lshift_autovec(uint8_t* __restrict out, const uint8_t* __restrict x, size_t n, size_t bits) {
+    size_t byte_shift = std::min(bits / 8, n);
+    unsigned b = bits % 8;
+    // Both source bytes exist for k < n - byte_shift - 1
+    size_t body = n - byte_shift > 0 ? n - byte_shift - 1 : 0;
+    const uint8_t* src = x + byte_shift;
+    for (size_t k = 0; k < body; ++k) {
+        out[k] = static_cast<uint8_t>((src[k] << b) | (src[k + 1] >> (8 - b)));
+    }
+    for (size_t k = body; k < n - byte_shift; ++k) out[k] = lshift_byte(x, n, k, byte_shift, b);
+    std::memset(out + n - byte_shift, 0, byte_shift);
+}
+
+void rshift_autovec(uint8_t* __restrict out, const uint8_t* __restrict x, size_t n, size_t bits) {
+    size_t byte_shift = std::min(bits / 8, n);
+    unsigned b = bits % 8;
+    std::memset(out, 0, byte_shift);
+    if (byte_shift < n) out[byte_shift] = rshift_byte(x, byte_shift, byte_shift, b);
+    // Both source bytes exist for result bytes past byte_shift
+    uint8_t* dst = out + byte_shift;
+    for (size_t i = 1; i < n - byte_shift; ++i) {
+        dst[i] = static_cast<uint8_t>((x[i] >> b) | (x[i - 1] << (8 - b)));
+    }
+}
+
+#ifdef BSV_BENCH_X86
+template <class Op>
+__attribute__((target("avx2")))
+void binary_avx2(uint8_t* dst, const uint8_t* src, size_t n) {
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), Op::apply(a, b));
+    }
+    for (; i < n; ++i) dst[i] = Op::apply(dst[i], src[i]);
+}
+
+template <class Op>
+__attribute__((target("avx512f")))
+void binary_avx512(uint8_t* dst, const uint8_t* src, size_t n) {
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        __m512i a = _mm512_loadu_si512(dst + i);
+        __m512i b = _mm512_loadu_si512(src + i);
+        _mm512_storeu_si512(dst + i, Op::apply(a, b));
+    }
+    for (; i < n; ++i) dst[i] = Op::apply(dst[i], src[i]);
+}
+
+__attribute__((target("avx2")))
+void invert_avx2(uint8_t* dst, size_t n) {
+    const __m256i ones = _mm256_set1_epi8(-1);
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_xor_si256(a, ones));
+    }
+    for (; i < n; ++i) dst[i] = ~dst[i];
+}
+
+__attribute__((target("avx512f")))
+void invert_avx512(uint8_t* dst, size_t n) {
+    const __m512i ones = _mm512_set1_epi8(-1);
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        __m512i a = _mm512_loadu_si512(dst + i);
+        _mm512_storeu_si512(dst + i, _mm512_xor_si512(a, ones));
+    }
+    for (; i < n; ++i) dst[i] = ~dst[i];
+}
+
+// There are no 8-bit vector shifts: shift 16-bit lanes and mask off the bits
+// that crossed into the neighbouring byte. Across byte boundaries, each
+// result byte combines two unaligned loads one byte apart.
+__attribute__((target("avx2")))
+void lshift_avx2(uint8_t* out, const uint8_t* x, size_t n, size_t bits) {
+    size_t byte_shift = std::min(bits / 8, n);
+    unsigned b = bits % 8;
+    size_t body = n - byte_shift > 0 ? n - byte_shift - 1 : 0;
+    const uint8_t* src = x + byte_shift;
+    const __m128i left = _mm_cvtsi32_si128(static_cast<int>(b));
+    const __m128i right = _mm_cvtsi32_si128(static_cast<int>(8 - b));
+    const __m256i hi_mask = _mm256_set1_epi8(static_cast<char>(0xff << b));
+    const __m256i lo_mask = _mm256_set1_epi8(static_cast<char>(0xff >> (8 - b)));
+    size_t k = 0;
+    for (; k + 32 <= body; k += 32) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + k));
+        __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + k + 1));
+        __m256i hi = _mm256_and_si256(_mm256_sll_epi16(a, left), hi_mask);
+        __m256i lo = _mm256_and_si256(_mm256_srl_epi16(c, right), lo_mask);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + k), _mm256_or_si256(hi, lo));
+    }
+    for (; k < n - byte_shift; ++k) out[k] = lshift_byte(x, n, k, byte_shift, b);
+    std::memset(out + n - byte_shift, 0, byte_shift);
+}
+
+__attribute__((target("avx2")))
+void rshift_avx2(uint8_t* out, const uint8_t* x, size_t n, size_t bits) {
+    size_t byte_shift = std::min(bits / 8, n);
+    unsigned b = bits % 8;
+    const __m128i left = _mm_cvtsi32_si128(static_cast<int>(8 - b));
+    const __m128i right = _mm_cvtsi32_si128(static_cast<int>(b));
+    const __m256i hi_mask = _mm256_set1_epi8(static_cast<char>(0xff << (8 - b)));
+    const __m256i lo_mask = _mm256_set1_epi8(static_cast<char>(0xff >> b));
+    std::memset(out, 0, byte_shift);
+    if (byte_shift < n) out[byte_shift] = rshift_byte(x, byte_shift, byte_shift, b);
+    size_t k = byte_shift + 1;
+    // Result byte k reads source bytes k - byte_shift and the one before
+    for (; k + 32 <= n; k += 32) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + (k - byte_shift)));
+        __m256i p = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + (k - byte_shift - 1)));
+        __m256i lo = _mm256_and_si256(_mm256_srl_epi16(a, right), lo_mask);
+        __m256i hi = _mm256_and_si256(_mm256_sll_epi16(p, left), hi_mask);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + k), _mm256_or_si256(hi, lo));
+    }
+    for (; k < n; ++k) out[k] = rshift_byte(x, k, byte_shift, b);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+void lshift_avx512(uint8_t* out, const uint8_t* x, size_t n, size_t bits) {
+    size_t byte_shift = std::min(bits / 8, n);
+    unsigned b = bits % 8;
+    size_t body = n - byte_shift > 0 ? n - byte_shift - 1 : 0;
+    const uint8_t* src = x + byte_shift;
+    const __m128i left = _mm_cvtsi32_si128(static_cast<int>(b));
+    const __m128i right = _mm_cvtsi32_si128(static_cast<int>(8 - b));
+    const __m512i hi_mask = _mm512_set1_epi8(static_cast<char>(0xff << b));
+    const __m512i lo_mask = _mm512_set1_epi8(static_cast<char>(0xff >> (8 - b)));
+    size_t k = 0;
+    for (; k + 64 <= body; k += 64) {
+        __m512i a = _mm512_loadu_si512(src + k);
+        __m512i c = _mm512_loadu_si512(src + k + 1);
+        __m512i hi = _mm512_and_si512(_mm512_sll_epi16(a, left), hi_mask);
+        __m512i lo = _mm512_and_si512(_mm512_srl_epi16(c, right), lo_mask);
+        _mm512_storeu_si512(out + k, _mm512_or_si512(hi, lo));
+    }
+    for (; k < n - byte_shift; ++k) out[k] = lshift_byte(x, n, k, byte_shift, b);
+    std::memset(out + n - byte_shift, 0, byte_shift);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+void rshift_avx512(uint8_t* out, const uint8_t* x, size_t n, size_t bits) {
+    size_t byte_shift = std::min(bits / 8, n);
+    unsigned b = bits % 8;
+    const __m128i left = _mm_cvtsi32_si128(static_cast<int>(8 - b));
+    const __m128i right = _mm_cvtsi32_si128(static_cast<int>(b));
+    const __m512i hi_mask = _mm512_set1_epi8(static_cast<char>(0xff << (8 - b)));
+    const __m512i lo_mask = _mm512_set1_epi8(static_cast<char>(0xff >> b));
+    std::memset(out, 0, byte_shift);
+    if (byte_shift < n) out[byte_shift] = rshift_byte(x, byte_shift, byte_shift, b);
+    size_t k = byte_shift + 1;
+    // Result byte k reads source bytes k - byte_shift and the one before
+    for (; k + 64 <= n; k += 64) {
+        __m512i a = _mm512_loadu_si512(x + (k - byte_shift));
+        __m512i p = _mm512_loadu_si512(x + (k - byte_shift - 1));
+        __m512i lo = _mm512_and_si512(_mm512_srl_epi16(a, right), lo_mask);
+        __m512i hi = _mm512_and_si512(_mm512_sll_epi16(p, left), hi_mask);
+        _mm512_storeu_si512(out + k, _mm512_or_si512(hi, lo));
+    }
+    for (; k < n; ++k) out[k] = rshift_byte(x, k, byte_shift, b);
+}
+#endif
+
+using BinaryFn = void (*)(uint8_t*, const uint8_t*, size_t);
+using InvertFn = void (*)(uint8_t*, size_t);
+using ShiftFn = void (*)(uint8_t*, const uint8_t*, size_t, size_t);
+
+// One implementation of every bitwise opcode
+struct BitwiseKernels {
+    BinaryFn binary[3];     // Indexed by BitOp
+    InvertFn invert;
+    ShiftFn lshift;
+    ShiftFn rshift;
+};
+
+const BitwiseKernels& kernels(Kernel k) {
+    static const BitwiseKernels scalar = {
+        {binary_scalar<AndOp>, binary_scalar<OrOp>, binary_scalar<XorOp>},
+        invert_scalar, lshift_scalar, rshift_scalar};
+    static const BitwiseKernels autovec = {
+        {binary_autovec<AndOp>, binary_autovec<OrOp>, binary_autovec<XorOp>},
+        invert_autovec, lshift_autovec, rshift_autovec};
+#ifdef BSV_BENCH_X86
+    static const BitwiseKernels avx2 = {
+        {binary_avx2<AndOp>, binary_avx2<OrOp>, binary_avx2<XorOp>},
+        invert_avx2, lshift_avx2, rshift_avx2};
+    static const BitwiseKernels avx512 = {
+        {binary_avx512<AndOp>, binary_avx512<OrOp>, binary_avx512<XorOp>},
+        invert_avx512, lshift_avx512, rshift_avx512};
+#endif
+    switch (k) {
+#ifdef BSV_BENCH_X86
+        case Kernel::AVX2: return avx2;
+        case Kernel::AVX512: return avx512;
+#endif
+        case Kernel::AUTOVEC: return autovec;
+        default: return scalar;
+    }
+}
+
+std::vector<Kernel> supported_kernels() {
+    std::vector<Kernel> supported;
+    for (Kernel k : {Kernel::SCALAR, Kernel::AUTOVEC, Kernel::AVX2, Kernel::AVX512}) {
+        if (kernel_supported(k)) supported.push_back(k);
+    }
+    return supported;
+}
+
+// Vector kernels must agree with the node's loops before they are timed
+void check_kernel(Kernel k, const char* opcode, const std::vector<uint8_t>& expected,
+                  const std::vector<uint8_t>& actual) {
+    if (expected != actual) {
+        throw std::runtime_error(std::string(kernel_name(k)) + " " + opcode +
+                                 " disagrees with the scalar kernel");
+    }
+}
+
+// Operands with every bit pattern, so shifts move set and clear bits alike
+std::shared_ptr<std::vector<uint8_t>> make_operand(size_t size, uint8_t seed) {
+    auto data = bsv_bench::make_buffer(size, 0);
+    uint32_t x = 0x9e3779b9u * (seed + 1);
+    for (auto& b : *data) {
+        x = x * 1664525u + 1013904223u;
+        b = static_cast<uint8_t>(x >> 24);
+    }
+    return data;
+}
+
+std::string size_desc(Kernel k, size_t size) {
+    return std::string(kernel_name(k)) + ", " + std::to_string(size) + "B";
+}
+
+const std::vector<uint64_t> kDefaultSizes = {
+    1, 32, 256, 4096, 65536, 1000000, 10000000, 100000000
+};
+
+} // namespace
+
+BSV_BENCH_FAMILY(bitwise_ops, logic) {
+    static const struct { const char* opcode; BitOp op; } kOps[] = {
+        {"OP_AND", BitOp::AND}, {"OP_OR", BitOp::OR}, {"OP_XOR", BitOp::XOR}
+    };
+    for (auto size : bench.axis("sizes", kDefaultSizes)) {
+        for (const auto& [opcode, op] : kOps) {
+            for (Kernel k : supported_kernels()) {
+                bench.add(
+                    opcode,
+                    size_desc(k, size),
+                    size,
+                    [opcode = opcode, op = op, k, size]() -> bsv_bench::BenchOperation {
+                        auto a = make_operand(size, 1);
+                        auto b = make_operand(size, 2);
+                        BinaryFn fn = kernels(k).binary[static_cast<int>(op)];
+                        if (k != Kernel::SCALAR) {
+                            std::vector<uint8_t> expected = *a, actual = *a;
+                            kernels(Kernel::SCALAR).binary[static_cast<int>(op)](
+                                expected.data(), b->data(), size);
+                            fn(actual.data(), b->data(), size);
+                            check_kernel(k, opcode, expected, actual);
+                        }
+                        return [a, b, fn, size]() {
+                            fn(a->data(), b->data(), size);
+                            volatile uint8_t s = (*a)[0];
+                            (void)s;
+                        };
+                    }
+                );
+            }
+        }
+    }
+}
+
+BSV_BENCH_FAMILY(bitwise_ops, invert) {
+    for (auto size : bench.axis("sizes", kDefaultSizes)) {
+        for (Kernel k : supported_kernels()) {
+            bench.add(
+                "OP_INVERT",
+                size_desc(k, size),
+                size,
+                [k, size]() -> bsv_bench::BenchOperation {
+                    auto a = make_operand(size, 1);
+                    InvertFn fn = kernels(k).invert;
+                    if (k != Kernel::SCALAR) {
+                        std::vector<uint8_t> expected = *a, actual = *a;
+                        kernels(Kernel::SCALAR).invert(expected.data(), size);
+                        fn(actual.data(), size);
+                        check_kernel(k, "OP_INVERT", expected, actual);
+                    }
+                    return [a, fn, size]() {
+                        fn(a->data(), size);
+                        volatile uint8_t s = (*a)[0];
+                        (void)s;
+                    };
+                }
+            );
+        }
+    }
+}
+
+// Shift amounts: 8 moves whole bytes; 1 and 13 split every result byte
+// across two source bytes
+BSV_BENCH_FAMILY(bitwise_ops, shift) {
+    auto shifts = bench.axis("shift_bits", {1, 8, 13});
+    for (auto size : bench.axis("sizes", kDefaultSizes)) {
+        for (auto bits : shifts) {
+            for (const char* opcode : {"OP_LSHIFT", "OP_RSHIFT"}) {
+                bool left = std::strcmp(opcode, "OP_LSHIFT") == 0;
+                for (Kernel k : supported_kernels()) {
+                    bench.add(
+                        opcode,
+                        size_desc(k, size) + ", n=" + std::to_string(bits),
+                        size,
+                        [opcode, left, k, size, bits]() -> bsv_bench::BenchOperation {
+                            auto x = make_operand(size, 1);
+                            auto out = bsv_bench::make_buffer(size, 0);
+                            ShiftFn fn = left ? kernels(k).lshift : kernels(k).rshift;
+                            if (k != Kernel::SCALAR) {
+                                ShiftFn reference = left ? kernels(Kernel::SCALAR).lshift
+                                                         : kernels(Kernel::SCALAR).rshift;
+                                std::vector<uint8_t> expected(size), actual(size);
+                                reference(expected.data(), x->data(), size, bits);
+                                fn(actual.data(), x->data(), size, bits);
+                                check_kernel(k, opcode, expected, actual);
+                            }
+                            return [x, out, fn, size, bits]() {
+                                fn(out->data(), x->data(), size, bits);
+                                volatile uint8_t s = (*out)[0];
+                                (void)s;
+                            };
+                        }
+                    );
+                }
+            }
+        }
+    }
+}
+
+#ifndef BSV_BENCH_UNIFIED
+// What runtime dispatch would pick on this CPU
+static Kernel best_kernel() {
+    for (Kernel k : {Kernel::AVX512, Kernel::AVX2}) {
+        if (kernel_supported(k)) return k;
+    }
+    return Kernel::AUTOVEC;
+}
+
+// Per-byte cost of each kernel at the largest size measured
+static void analyze_kernels(const std::vector<bsv_bench::BenchResult>& results,
+                            const std::string& opcode_name) {
+    std::cout << "\n=== " << opcode_name << " ===\n";
+    for (Kernel k : supported_kernels()) {
+        std::vector<bsv_bench::FitPoint> points;
+        std::string prefix = std::string(kernel_name(k)) + ",";
+        for (const auto& r : results) {
+            if (r.opcode != opcode_name || r.param_desc.compare(0, prefix.size(), prefix) != 0) continue;
+            points.push_back(bsv_bench::to_fit_point(r));
+        }
+        if (points.size() < 2) continue;
+        bsv_bench::ModelFit fit = bsv_bench::fit_model(bsv_bench::ModelForm::LINEAR, points,
+                                                       bsv_bench::FitOptions());
+        std::cout << "  " << kernel_name(k) << ": c0 = " << fit.coefficient("c0")
+                  << ", c1 = " << fit.coefficient("c1") << " cycles/byte\n";
+    }
+}
+
+int main(int argc, char** argv) {
+    std::cout << "=== BSV Script Benchmark: Bitwise Operations ===\n";
+    std::cout << "OP_AND/OR/XOR/INVERT/LSHIFT/RSHIFT, 1B to 100MB operands\n";
+    std::cout << "Runtime dispatch selects: " << kernel_name(best_kernel()) << "\n\n";
+
+    bsv_bench::BenchmarkHarness harness;
+    harness.initialize(0);  // Pin to CPU 0
+
+    auto cases = bsv_bench::BenchRegistry::instance().collect(
+        bsv_bench::ParamMatrix(), bsv_bench::CaseFilter());
+    std::vector<bsv_bench::BenchResult> results = bsv_bench::run_cases(harness, cases);
+
+    for (const char* opcode : {"OP_AND", "OP_OR", "OP_XOR", "OP_INVERT", "OP_LSHIFT", "OP_RSHIFT"}) {
+        analyze_kernels(results, opcode);
+    }
+
+    std::string csv_file = "output/bench_bitwise_ops.csv";
+    std::string json_file = "output/bench_bitwise_ops.json";
+
+    harness.export_csv(results, csv_file);
+    harness.export_json(results, json_file);
+
+    std::cout << "\n=== Results exported to:\n";
+    std::cout << "  " << csv_file << "\n";
+    std::cout << "  " << json_file << "\n";
+
+    return 0;
+}
+#endif
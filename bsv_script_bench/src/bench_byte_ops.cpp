@@ -1,28 +1,44 @@
 #include "bench_harness.h"
+#include "bench_registry.h"
 #include <vector>
 #include <cstdint>
 #include <cstring>
 #include <iostream>
 #include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <openssl/sha.h>
+#include <sys/mman.h>
 
-// Simulate OP_CAT (concatenate two byte arrays)
-std::vector<uint8_t> op_cat(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b) {
-    std::vector<uint8_t> result;
+// Simulate OP_CAT (concatenate two byte arrays). Results are allocated
+// with Alloc so the allocator policies below can be swapped in.
+template <class Alloc = std::allocator<uint8_t>>
+std::vector<uint8_t, Alloc> op_cat(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b) {
+    std::vector<uint8_t, Alloc> result;
     result.reserve(a.size() + b.size());
     result.insert(result.end(), a.begin(), a.end());
     result.insert(result.end(), b.begin(), b.end());
+    bsv_bench::note_copy(a.size() + b.size());
     return result;
 }
 
 // Simulate OP_SPLIT (split byte array at position)
-std::pair<std::vector<uint8_t>, std::vector<uint8_t>> 
+template <class Alloc = std::allocator<uint8_t>>
+std::pair<std::vector<uint8_t, Alloc>, std::vector<uint8_t, Alloc>> 
 op_split(const std::vector<uint8_t>& data, size_t position) {
     if (position > data.size()) {
         throw std::runtime_error("Split position out of range");
     }
-    std::vector<uint8_t> left(data.begin(), data.begin() + position);
-    std::vector<uint8_t> right(data.begin() + position, data.end());
-    return {left, right};
+    std::vector<uint8_t, Alloc> left(data.begin(), data.begin() + position);
+    std::vector<uint8_t, Alloc> right(data.begin() + position, data.end());
+    bsv_bench::note_copy(data.size());
+    return {std::move(left), std::move(right)};
 }
 
 // Simulate OP_NUM2BIN (convert number to binary of specific size)
@@ -44,195 +60,588 @@ int64_t op_bin2num(const std::vector<uint8_t>& data) {
     return result;
 }
 
-void benchmark_op_cat(bsv_bench::BenchmarkHarness& harness,
-                      std::vector<bsv_bench::BenchResult>& results) {
-    std::cout << "Benchmarking OP_CAT (CRITICAL for BSV)...\n";
+// Allocator policies for OP_CAT/OP_SPLIT results. On the system allocator
+// the measured cost is the copy plus glibc malloc, and above its mmap
+// threshold (128KB, raised dynamically by glibc) a fresh mapping that
+// faults on every 4KB page when first written. Each policy removes part of
+// that, so bsv_fit_model can price allocation (c_alloc) separately from the
+// copy, and measure the per-page fault cost that first_touch falls back on.
+
+static constexpr size_t kPageBytes = 4096;
+static constexpr size_t kHugePageBytes = 2 * 1024 * 1024;
+static constexpr size_t kRegionBytes = 64 * 1024 * 1024;   // Largest case is 10MB + 10MB
+static constexpr size_t kArenaRetainBytes = 128 * 1024;    // glibc's default trim threshold
+
+// Bump allocation over an anonymous mapping, reset at the end of a script
+class BumpRegion {
+public:
+    BumpRegion(size_t capacity, bool prefault_huge)
+        : capacity_(capacity), mapping_size_(capacity + kHugePageBytes) {
+        void* mapping = mmap(nullptr, mapping_size_, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (mapping == MAP_FAILED) throw std::runtime_error("BumpRegion: mmap failed");
+        mapping_ = static_cast<uint8_t*>(mapping);
+        // 2MB-aligned so transparent huge pages can back it
+        uintptr_t misalign = reinterpret_cast<uintptr_t>(mapping_) % kHugePageBytes;
+        base_ = mapping_ + (misalign ? kHugePageBytes - misalign : 0);
+        if (prefault_huge) {
+            madvise(base_, capacity_, MADV_HUGEPAGE);
+            std::memset(base_, 0, capacity_);
+        }
+    }
     
-    // Test sizes: Small to very large (BSV allows multi-MB)
-    std::vector<std::pair<size_t, size_t>> size_pairs = {
-        {10, 10},           // 10B + 10B
-        {100, 100},         // 100B + 100B
-        {1000, 1000},       // 1kB + 1kB
-        {10000, 10000},     // 10kB + 10kB
-        {100000, 100000},   // 100kB + 100kB
-        {1000000, 1000000}, // 1MB + 1MB
-        {10000000, 10000000}, // 10MB + 10MB
-        {1, 10000000},      // Asymmetric: 1B + 10MB
-        {10000000, 1},      // Asymmetric: 10MB + 1B
-    };
+    ~BumpRegion() { munmap(mapping_, mapping_size_); }
     
-    for (const auto& [size_a, size_b] : size_pairs) {
-        std::vector<uint8_t> a(size_a, 0x42);
-        std::vector<uint8_t> b(size_b, 0x43);
-        
-        auto result = harness.benchmark(
-            "OP_CAT",
-            std::to_string(size_a) + "B + " + std::to_string(size_b) + "B",
-            size_a + size_b,
-            [&a, &b]() {
-                auto cat_result = op_cat(a, b);
-                // Force use to prevent optimization
-                volatile size_t s = cat_result.size();
-                (void)s;
-            },
-            (size_a + size_b > 1000000) ? 100 : 1000,  // Fewer iterations for large sizes
-            (size_a + size_b > 1000000) ? 10 : 100
-        );
-        
-        results.push_back(result);
-        std::cout << "  " << size_a << "B + " << size_b << "B -> " 
-                 << result.median_cycles << " cycles";
-        
-        // Calculate cycles per byte
-        if (size_a + size_b > 0) {
-            double cycles_per_byte = (double)result.median_cycles / (size_a + size_b);
-            std::cout << " (" << cycles_per_byte << " cycles/byte)";
+    BumpRegion(const BumpRegion&) = delete;
+    BumpRegion& operator=(const BumpRegion&) = delete;
+    
+    void* allocate(size_t n) {
+        size_t offset = (used_ + 63) & ~size_t(63);
+        if (offset > capacity_ || n > capacity_ - offset) throw std::bad_alloc();
+        used_ = offset + n;
+        return base_ + offset;
+    }
+    
+    // Forget every allocation. Pages past the first `retain` bytes go back
+    // to the kernel, so the next script to reach them faults them in again.
+    void reset(size_t retain) {
+        size_t used_pages = (used_ + kPageBytes - 1) & ~(kPageBytes - 1);
+        if (used_pages > retain) {
+            madvise(base_ + retain, used_pages - retain, MADV_DONTNEED);
         }
-        std::cout << "\n";
+        used_ = 0;
     }
-}
+    
+private:
+    size_t capacity_;
+    size_t mapping_size_;
+    uint8_t* mapping_;
+    uint8_t* base_;
+    size_t used_ = 0;
+};
 
-void benchmark_op_split(bsv_bench::BenchmarkHarness& harness,
-                        std::vector<bsv_bench::BenchResult>& results) {
-    std::cout << "Benchmarking OP_SPLIT...\n";
+// Per-script bump arena: allocating is a pointer bump and nothing is freed
+// until the script ends. The first 128KB stays resident between scripts;
+// anything beyond is released and takes first-touch faults again.
+struct ArenaAlloc {
+    static BumpRegion& region() {
+        static BumpRegion r(kRegionBytes, false);
+        return r;
+    }
+    static void* allocate(size_t n) { return region().allocate(n); }
+    static void deallocate(void*, size_t) {}
+    static void end_script() { region().reset(kArenaRetainBytes); }
+};
+
+// Size-class pool: power-of-two classes with intrusive free lists. Freed
+// blocks are kept, so once warm an allocation is a list pop on memory that
+// is already resident.
+struct PoolAlloc {
+    static void* allocate(size_t n) {
+        size_t cls = size_class(n);
+        void*& head = free_lists()[cls];
+        if (head) {
+            void* block = head;
+            head = *static_cast<void**>(block);
+            return block;
+        }
+        void* block = std::malloc(size_t(1) << cls);
+        if (!block) throw std::bad_alloc();
+        return block;
+    }
+    static void deallocate(void* block, size_t n) {
+        void*& head = free_lists()[size_class(n)];
+        *static_cast<void**>(block) = head;
+        head = block;
+    }
+    static void end_script() {}
     
-    std::vector<size_t> sizes = {100, 1000, 10000, 100000, 1000000, 10000000};
-    std::vector<double> split_positions = {0.01, 0.5, 0.99};  // Start, middle, end
+private:
+    static size_t size_class(size_t n) {
+        size_t cls = 4;  // 16B, room for the free-list link
+        while ((size_t(1) << cls) < n) ++cls;
+        return cls;
+    }
+    static std::array<void*, 64>& free_lists() {
+        static std::array<void*, 64> lists{};
+        return lists;
+    }
+};
+
+// Bump arena on a region that is pre-faulted and backed by transparent huge
+// pages where the kernel allows: no allocator work, no first-touch faults
+// and few TLB misses, which leaves the copy itself
+struct HugePageAlloc {
+    static BumpRegion& region() {
+        static BumpRegion r(kRegionBytes, true);
+        return r;
+    }
+    static void* allocate(size_t n) { return region().allocate(n); }
+    static void deallocate(void*, size_t) {}
+    static void end_script() { region().reset(kRegionBytes); }
+};
+
+// std::allocator-compatible adapter over a policy
+template <class T, class Policy>
+struct PolicyAllocator {
+    using value_type = T;
     
-    for (auto size : sizes) {
-        for (auto split_ratio : split_positions) {
-            size_t position = static_cast<size_t>(size * split_ratio);
-            std::vector<uint8_t> data(size, 0x42);
-            
-            auto result = harness.benchmark(
-                "OP_SPLIT",
-                std::to_string(size) + "B @ " + std::to_string(int(split_ratio * 100)) + "%",
-                size,
-                [&data, position]() {
-                    auto [left, right] = op_split(data, position);
-                    volatile size_t s = left.size() + right.size();
-                    (void)s;
-                },
-                (size > 1000000) ? 100 : 1000,
-                (size > 1000000) ? 10 : 100
-            );
-            
-            results.push_back(result);
-            std::cout << "  " << size << "B @ " << int(split_ratio * 100) << "% -> "
-                     << result.median_cycles << " cycles";
-            
-            if (size > 0) {
-                double cycles_per_byte = (double)result.median_cycles / size;
-                std::cout << " (" << cycles_per_byte << " cycles/byte)";
+    template <class U>
+    struct rebind { using other = PolicyAllocator<U, Policy>; };
+    
+    PolicyAllocator() = default;
+    template <class U>
+    PolicyAllocator(const PolicyAllocator<U, Policy>&) {}
+    
+    T* allocate(size_t n) { return static_cast<T*>(Policy::allocate(n * sizeof(T))); }
+    void deallocate(T* p, size_t n) { Policy::deallocate(p, n * sizeof(T)); }
+    
+    bool operator==(const PolicyAllocator&) const { return true; }
+    bool operator!=(const PolicyAllocator&) const { return false; }
+};
+
+// Chunk-list byte string: a list of slices of shared, immutable chunks.
+// OP_CAT appends the right operand's slices and OP_SPLIT cuts the list at
+// the split position, so neither copies payload bytes. Contiguous bytes are
+// only built when something needs them (hashing, comparison): data()
+// flattens the list into one chunk and keeps it, so later reads are free.
+// A slice keeps its whole chunk alive, so memory is not released until
+// every slice of a chunk is gone.
+class RopeBytes {
+public:
+    RopeBytes() = default;
+    
+    explicit RopeBytes(std::shared_ptr<const std::vector<uint8_t>> chunk)
+        : size_(chunk->size()) {
+        if (size_ > 0) pieces_.push_back({std::move(chunk), 0, size_});
+    }
+    
+    size_t size() const { return size_; }
+    size_t piece_count() const { return pieces_.size(); }
+    
+    // Takes the left operand by value so a chain appends in place
+    static RopeBytes cat(RopeBytes a, const RopeBytes& b) {
+        a.pieces_.insert(a.pieces_.end(), b.pieces_.begin(), b.pieces_.end());
+        a.size_ += b.size_;
+        return a;
+    }
+    
+    std::pair<RopeBytes, RopeBytes> split(size_t position) const {
+        if (position > size_) throw std::runtime_error("Split position out of range");
+        RopeBytes left, right;
+        size_t offset = 0;
+        for (const Piece& piece : pieces_) {
+            if (offset + piece.length <= position) {
+                left.append(piece);
+            } else if (offset >= position) {
+                right.append(piece);
+            } else {
+                size_t cut = position - offset;
+                left.append({piece.chunk, piece.offset, cut});
+                right.append({piece.chunk, piece.offset + cut, piece.length - cut});
             }
-            std::cout << "\n";
+            offset += piece.length;
         }
+        return {std::move(left), std::move(right)};
     }
+    
+    // Contiguous bytes, flattening first if there is more than one slice
+    const uint8_t* data() {
+        if (pieces_.size() > 1) flatten();
+        return pieces_.empty() ? nullptr : pieces_.front().chunk->data() + pieces_.front().offset;
+    }
+    
+private:
+    struct Piece {
+        std::shared_ptr<const std::vector<uint8_t>> chunk;
+        size_t offset;
+        size_t length;
+    };
+    
+    void append(Piece piece) {
+        size_ += piece.length;
+        pieces_.push_back(std::move(piece));
+    }
+    
+    void flatten() {
+        auto flat = std::make_shared<std::vector<uint8_t>>();
+        flat->reserve(size_);
+        for (const Piece& piece : pieces_) {
+            auto first = piece.chunk->begin() + piece.offset;
+            flat->insert(flat->end(), first, first + piece.length);
+        }
+        bsv_bench::note_copy(size_);
+        pieces_.assign(1, Piece{std::move(flat), 0, size_});
+    }
+    
+    std::vector<Piece> pieces_;
+    size_t size_ = 0;
+};
+
+// Byte-string representations the families run on. Each has an Item type
+// and load (wrap a setup buffer as a stack item), cat, split and contiguous
+// (bytes for hashing, flattening if needed), clone for copying an item the
+// way OP_DUP or OP_PICK would, and end_script to run after each sample.
+struct VectorRepr {
+    using Item = std::vector<uint8_t>;
+    
+    static std::shared_ptr<const Item> load(std::shared_ptr<std::vector<uint8_t>> buffer) {
+        return buffer;
+    }
+    static Item clone(const Item& item) {
+        bsv_bench::note_copy(item.size());
+        return item;
+    }
+    static Item cat(const Item& a, const Item& b) { return op_cat(a, b); }
+    static std::pair<Item, Item> split(const Item& data, size_t position) {
+        return op_split(data, position);
+    }
+    static const uint8_t* contiguous(Item& item) { return item.data(); }
+    static void end_script() {}
+};
+
+struct RopeRepr {
+    using Item = RopeBytes;
+    
+    static std::shared_ptr<const Item> load(std::shared_ptr<std::vector<uint8_t>> buffer) {
+        return std::make_shared<const Item>(std::move(buffer));
+    }
+    static Item clone(const Item& item) { return item; }
+    static Item cat(Item a, const Item& b) { return RopeBytes::cat(std::move(a), b); }
+    static std::pair<Item, Item> split(const Item& data, size_t position) {
+        return data.split(position);
+    }
+    static const uint8_t* contiguous(Item& item) { return item.data(); }
+    static void end_script() {}
+};
+
+// Runs fn(Repr{}, name) for every byte-string representation
+template <class Fn>
+void for_each_repr(Fn fn) {
+    fn(VectorRepr(), "vector");
+    fn(RopeRepr(), "rope");
 }
 
-void benchmark_op_num2bin(bsv_bench::BenchmarkHarness& harness,
-                          std::vector<bsv_bench::BenchResult>& results) {
-    std::cout << "Benchmarking OP_NUM2BIN...\n";
+// Vector whose OP_CAT/OP_SPLIT results come from an allocator policy.
+// Inputs stay ordinary setup buffers, as pushes are copied out of the script.
+template <class Policy>
+struct PolicyVectorRepr {
+    using Alloc = PolicyAllocator<uint8_t, Policy>;
+    using Item = std::vector<uint8_t, Alloc>;
     
-    std::vector<size_t> output_sizes = {1, 8, 32, 256, 1000, 10000, 1000000};
+    static std::shared_ptr<const std::vector<uint8_t>> load(std::shared_ptr<std::vector<uint8_t>> buffer) {
+        return buffer;
+    }
+    static Item cat(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b) {
+        return op_cat<Alloc>(a, b);
+    }
+    static std::pair<Item, Item> split(const std::vector<uint8_t>& data, size_t position) {
+        return op_split<Alloc>(data, position);
+    }
+    static void end_script() { Policy::end_script(); }
+};
+
+// Runs fn(Repr{}, name) for the vector on every non-system allocator; the
+// plain "vector" cases are the system allocator
+template <class Fn>
+void for_each_alloc_policy(Fn fn) {
+    fn(PolicyVectorRepr<ArenaAlloc>(), "vector/arena");
+    fn(PolicyVectorRepr<PoolAlloc>(), "vector/pool");
+    fn(PolicyVectorRepr<HugePageAlloc>(), "vector/hugepage");
+}
+
+BSV_BENCH_FAMILY(byte_ops, op_cat) {
+    // Test sizes: Small to very large (BSV allows multi-MB)
+    std::vector<std::pair<size_t, size_t>> size_pairs;
+    for (auto n : bench.axis("sizes", {10, 100, 1000, 10000, 100000, 1000000, 10000000})) {
+        size_pairs.push_back({n, n});           // Symmetric: nB + nB
+    }
+    for (auto n : bench.axis("asym_sizes", {10000000})) {
+        size_pairs.push_back({1, n});           // Asymmetric: 1B + nB
+        size_pairs.push_back({n, 1});           // Asymmetric: nB + 1B
+    }
     
-    for (auto size : output_sizes) {
+    auto add_cases = [&](auto repr, const std::string& name) {
+        using Repr = decltype(repr);
+        for (const auto& [size_a, size_b] : size_pairs) {
+            bench.add(
+                "OP_CAT",
+                name + ", " + std::to_string(size_a) + "B + " + std::to_string(size_b) + "B",
+                size_a + size_b,
+                [size_a = size_a, size_b = size_b]() -> bsv_bench::BenchOperation {
+                    auto a = Repr::load(bsv_bench::make_buffer(size_a, 0x42));
+                    auto b = Repr::load(bsv_bench::make_buffer(size_b, 0x43));
+                    return [a, b]() {
+                        {
+                            auto cat_result = Repr::cat(*a, *b);
+                            // Force use to prevent optimization
+                            volatile size_t s = cat_result.size();
+                            (void)s;
+                        }
+                        Repr::end_script();
+                    };
+                }
+            );
+        }
+    };
+    for_each_repr(add_cases);
+    for_each_alloc_policy(add_cases);
+}
+
+BSV_BENCH_FAMILY(byte_ops, op_split) {
+    auto sizes = bench.axis("sizes", {100, 1000, 10000, 100000, 1000000, 10000000});
+    auto split_percents = bench.axis("split_percents", {1, 50, 99});  // Start, middle, end
+    
+    auto add_cases = [&](auto repr, const std::string& name) {
+        using Repr = decltype(repr);
+        for (auto size : sizes) {
+            for (auto percent : split_percents) {
+                size_t position = static_cast<size_t>(size * (percent / 100.0));
+                
+                bench.add(
+                    "OP_SPLIT",
+                    name + ", " + std::to_string(size) + "B @ " + std::to_string(percent) + "%",
+                    size,
+                    [size, position]() -> bsv_bench::BenchOperation {
+                        auto data = Repr::load(bsv_bench::make_buffer(size, 0x42));
+                        return [data, position]() {
+                            {
+                                auto [left, right] = Repr::split(*data, position);
+                                volatile size_t s = left.size() + right.size();
+                                (void)s;
+                            }
+                            Repr::end_script();
+                        };
+                    }
+                );
+            }
+        }
+    };
+    for_each_repr(add_cases);
+    for_each_alloc_policy(add_cases);
+}
+
+BSV_BENCH_FAMILY(byte_ops, op_num2bin) {
+    for (auto size : bench.axis("sizes", {1, 8, 32, 256, 1000, 10000, 1000000})) {
         int64_t num = 0x123456789ABCDEF0;
         
-        auto result = harness.benchmark(
+        bench.add(
             "OP_NUM2BIN",
             "output_size=" + std::to_string(size) + "B",
             size,
-            [num, size]() {
-                auto bin = op_num2bin(num, size);
-                volatile size_t s = bin.size();
-                (void)s;
-            },
-            (size > 100000) ? 100 : 1000,
-            (size > 100000) ? 10 : 100
+            [num, size]() -> bsv_bench::BenchOperation {
+                return [num, size]() {
+                    auto bin = op_num2bin(num, size);
+                    volatile size_t s = bin.size();
+                    (void)s;
+                };
+            }
         );
-        
-        results.push_back(result);
-        std::cout << "  " << size << "B -> " << result.median_cycles << " cycles\n";
     }
 }
 
-void benchmark_op_bin2num(bsv_bench::BenchmarkHarness& harness,
-                          std::vector<bsv_bench::BenchResult>& results) {
-    std::cout << "Benchmarking OP_BIN2NUM...\n";
-    
-    std::vector<size_t> input_sizes = {1, 8, 32, 256, 1000, 10000, 1000000};
-    
-    for (auto size : input_sizes) {
-        std::vector<uint8_t> data(size, 0x42);
-        
-        auto result = harness.benchmark(
+BSV_BENCH_FAMILY(byte_ops, op_bin2num) {
+    for (auto size : bench.axis("sizes", {1, 8, 32, 256, 1000, 10000, 1000000})) {
+        bench.add(
             "OP_BIN2NUM",
             "input_size=" + std::to_string(size) + "B",
             size,
-            [&data]() {
-                auto num = op_bin2num(data);
-                volatile int64_t n = num;
-                (void)n;
-            },
-            (size > 100000) ? 100 : 1000,
-            (size > 100000) ? 10 : 100
+            [size]() -> bsv_bench::BenchOperation {
+                auto data = bsv_bench::make_buffer(size, 0x42);
+                return [data]() {
+                    auto num = op_bin2num(*data);
+                    volatile int64_t n = num;
+                    (void)n;
+                };
+            }
         );
-        
-        results.push_back(result);
-        std::cout << "  " << size << "B -> " << result.median_cycles << " cycles\n";
-    }
-}
-
-void benchmark_cat_chain(bsv_bench::BenchmarkHarness& harness,
-                         std::vector<bsv_bench::BenchResult>& results) {
-    std::cout << "Benchmarking OP_CAT chains (reallocation test)...\n";
-    
-    // Test repeated CAT operations to measure reallocation overhead
-    std::vector<int> chain_lengths = {2, 4, 8, 16};
-    std::vector<size_t> chunk_sizes = {100, 1000, 10000, 100000};
-    
-    for (auto chain_len : chain_lengths) {
-        for (auto chunk_size : chunk_sizes) {
-            std::vector<uint8_t> chunk(chunk_size, 0x42);
-            
-            auto result = harness.benchmark(
-                "OP_CAT_CHAIN",
-                std::to_string(chain_len) + " x " + std::to_string(chunk_size) + "B",
-                chain_len * chunk_size,
-                [&chunk, chain_len]() {
-                    std::vector<uint8_t> result = chunk;
-                    for (int i = 1; i < chain_len; ++i) {
-                        result = op_cat(result, chunk);
+    }
+}
+
+// Repeated CAT operations to measure reallocation overhead
+BSV_BENCH_FAMILY(byte_ops, cat_chain) {
+    auto chain_lengths = bench.axis("chain_lengths", {2, 4, 8, 16, 64, 256});
+    auto chunk_sizes = bench.axis("chunk_sizes", {100, 1000, 10000, 100000});
+    // Longer chains are skipped: the vector chain copies O(length^2) bytes
+    uint64_t max_bytes = bench.axis("max_chain_bytes", {16000000}).front();
+    
+    for_each_repr([&](auto repr, const std::string& name) {
+        using Repr = decltype(repr);
+        for (auto chain_len : chain_lengths) {
+            for (auto chunk_size : chunk_sizes) {
+                if (chain_len * chunk_size > max_bytes) continue;
+                
+                bench.add(
+                    "OP_CAT_CHAIN",
+                    name + ", " + std::to_string(chain_len) + " x " + std::to_string(chunk_size) + "B",
+                    chain_len * chunk_size,
+                    [chain_len, chunk_size]() -> bsv_bench::BenchOperation {
+                        auto chunk = Repr::load(bsv_bench::make_buffer(chunk_size, 0x42));
+                        return [chunk, chain_len]() {
+                            auto result = Repr::clone(*chunk);
+                            for (uint64_t i = 1; i < chain_len; ++i) {
+                                result = Repr::cat(std::move(result), *chunk);
+                            }
+                            volatile size_t s = result.size();
+                            (void)s;
+                        };
                     }
-                    volatile size_t s = result.size();
-                    (void)s;
-                },
-                (chunk_size > 10000) ? 100 : 500,
-                (chunk_size > 10000) ? 10 : 50
+                );
+            }
+        }
+    });
+}
+
+// Repeated OP_SPLIT peeling fixed-size fields off the front of a buffer, the
+// way scripts parse a serialized transaction: N splits of an N x SB buffer
+BSV_BENCH_FAMILY(byte_ops, split_chain) {
+    auto split_counts = bench.axis("split_counts", {4, 16, 64, 256});
+    auto sizes = bench.axis("sizes", {10000, 100000, 1000000});
+    
+    for_each_repr([&](auto repr, const std::string& name) {
+        using Repr = decltype(repr);
+        for (auto count : split_counts) {
+            for (auto size : sizes) {
+                size_t field = size / count;
+                if (field == 0) continue;
+                
+                bench.add(
+                    "OP_SPLIT_CHAIN",
+                    name + ", " + std::to_string(count) + " x " + std::to_string(field) + "B",
+                    count * field,
+                    [count, field]() -> bsv_bench::BenchOperation {
+                        auto data = Repr::load(bsv_bench::make_buffer(count * field, 0x42));
+                        return [data, count, field]() {
+                            auto parts = Repr::split(*data, field);
+                            size_t total = parts.first.size();
+                            for (uint64_t i = 1; i < count; ++i) {
+                                parts = Repr::split(parts.second, field);
+                                total += parts.first.size();
+                            }
+                            volatile size_t s = total;
+                            (void)s;
+                        };
+                    }
+                );
+            }
+        }
+    });
+}
+
+// CAT chain whose result is hashed: the rope has to flatten before SHA256,
+// so this prices the deferred copy
+BSV_BENCH_FAMILY(byte_ops, cat_hash) {
+    auto chain_lengths = bench.axis("chain_lengths", {2, 16, 256});
+    auto chunk_sizes = bench.axis("chunk_sizes", {100, 10000, 100000});
+    // Longer chains are skipped: the vector chain copies O(length^2) bytes
+    uint64_t max_bytes = bench.axis("max_chain_bytes", {16000000}).front();
+    
+    for_each_repr([&](auto repr, const std::string& name) {
+        using Repr = decltype(repr);
+        for (auto chain_len : chain_lengths) {
+            for (auto chunk_size : chunk_sizes) {
+                if (chain_len * chunk_size > max_bytes) continue;
+                
+                bench.add(
+                    "OP_CAT_SHA256",
+                    name + ", " + std::to_string(chain_len) + " x " + std::to_string(chunk_size) + "B",
+                    chain_len * chunk_size,
+                    [chain_len, chunk_size]() -> bsv_bench::BenchOperation {
+                        auto chunk = Repr::load(bsv_bench::make_buffer(chunk_size, 0x42));
+                        return [chunk, chain_len]() {
+                            auto result = Repr::clone(*chunk);
+                            for (uint64_t i = 1; i < chain_len; ++i) {
+                                result = Repr::cat(std::move(result), *chunk);
+                            }
+                            uint8_t digest[SHA256_DIGEST_LENGTH];
+                            SHA256(Repr::contiguous(result), result.size(), digest);
+                            volatile uint8_t d = digest[0];
+                            (void)d;
+                        };
+                    }
+                );
+            }
+        }
+    });
+}
+
+// First-touch cost of a large item, without the copy: map a fresh region,
+// write one byte per 4KB page, unmap. This is what a large push or result
+// pays on top of memcpy when it lands in memory the process hasn't used
+// yet (glibc mmaps anything above its threshold). "4k" forbids transparent
+// huge pages on the region, "thp" asks for them on a 2MB-aligned region.
+BSV_BENCH_FAMILY(byte_ops, first_touch) {
+    auto sizes = bench.axis("sizes", {131072, 1000000, 4000000, 16000000, 64000000, 100000000});
+    
+    for (bool huge : {false, true}) {
+        for (auto size : sizes) {
+            bench.add(
+                "PAGE_FIRST_TOUCH",
+                std::string(huge ? "thp" : "4k") + ", " + std::to_string(size) + "B",
+                size,
+                [size, huge]() -> bsv_bench::BenchOperation {
+                    return [size, huge]() {
+                        size_t map_size = size + (huge ? kHugePageBytes : 0);
+                        void* mapping = mmap(nullptr, map_size, PROT_READ | PROT_WRITE,
+                                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                        if (mapping == MAP_FAILED) throw std::bad_alloc();
+                        uint8_t* base = static_cast<uint8_t*>(mapping);
+                        if (huge) {
+                            uintptr_t misalign = reinterpret_cast<uintptr_t>(base) % kHugePageBytes;
+                            base += misalign ? kHugePageBytes - misalign : 0;
+                        }
+                        madvise(base, size, huge ? MADV_HUGEPAGE : MADV_NOHUGEPAGE);
+                        volatile uint8_t* bytes = base;
+                        for (size_t offset = 0; offset < size; offset += kPageBytes) {
+                            bytes[offset] = 1;
+                        }
+                        munmap(mapping, map_size);
+                    };
+                }
             );
-            
-            results.push_back(result);
-            std::cout << "  " << chain_len << " x " << chunk_size << "B -> "
-                     << result.median_cycles << " cycles\n";
         }
     }
 }
 
+#ifndef BSV_BENCH_UNIFIED
+// Print what the rope saves over the vector for each case both ran
+static void print_repr_savings(const std::vector<bsv_bench::BenchResult>& results) {
+    const std::string vector_prefix = "vector, ";
+    const std::string rope_prefix = "rope, ";
+    std::map<std::string, const bsv_bench::BenchResult*> vector_results;
+    for (const auto& r : results) {
+        if (r.param_desc.compare(0, vector_prefix.size(), vector_prefix) == 0) {
+            vector_results[r.opcode + " " + r.param_desc.substr(vector_prefix.size())] = &r;
+        }
+    }
+    
+    std::cout << "\n=== Rope vs vector (cycles, allocations, bytes copied) ===\n";
+    for (const auto& rope : results) {
+        if (rope.param_desc.compare(0, rope_prefix.size(), rope_prefix) != 0) continue;
+        std::string key = rope.opcode + " " + rope.param_desc.substr(rope_prefix.size());
+        auto it = vector_results.find(key);
+        if (it == vector_results.end()) continue;
+        const bsv_bench::BenchResult& vec = *it->second;
+        std::cout << "  " << key << ": "
+                  << vec.median_cycles << " -> " << rope.median_cycles << " cycles, "
+                  << vec.malloc_count << " -> " << rope.malloc_count << " allocs, "
+                  << vec.copied_bytes << " -> " << rope.copied_bytes << "B copied\n";
+    }
+}
+
 int main(int argc, char** argv) {
     std::cout << "=== BSV Script Benchmark: Byte Operations ===\n";
-    std::cout << "Testing OP_CAT, OP_SPLIT (critical for BSV unbounded scripts)\n\n";
+    std::cout << "Testing OP_CAT, OP_SPLIT (critical for BSV unbounded scripts)\n";
+    std::cout << "on contiguous vectors and on a zero-copy chunk list (rope)\n\n";
     
     bsv_bench::BenchmarkHarness harness;
     harness.initialize(0);  // Pin to CPU 0
     
-    std::vector<bsv_bench::BenchResult> results;
-    
-    benchmark_op_cat(harness, results);
-    benchmark_op_split(harness, results);
-    benchmark_op_num2bin(harness, results);
-    benchmark_op_bin2num(harness, results);
-    benchmark_cat_chain(harness, results);
+    // Default matrix; cases sample until the median's 95% CI is within 2%
+    auto cases = bsv_bench::BenchRegistry::instance().collect(
+        bsv_bench::ParamMatrix(), bsv_bench::CaseFilter());
+    std::vector<bsv_bench::BenchResult> results = bsv_bench::run_cases(harness, cases);
+    print_repr_savings(results);
     
     // Export results
     std::string csv_file = "output/bench_byte_ops.csv";
@@ -247,3 +656,4 @@ int main(int argc, char** argv) {
     
     return 0;
 }
+#endif
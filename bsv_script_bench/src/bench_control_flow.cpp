@@ -1,7 +1,367 @@
 #include "bench_harness.h"
+#include "bench_registry.h"
+#include "model_fit.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// OP_IF / OP_NOTIF / OP_ELSE / OP_ENDIF on the interpreter's condition
+// stack. The loop below is the node's: every opcode first asks whether it
+// executes (no open IF is false), then reads its push data (GetOp copies it
+// whether or not the branch executes), and only executed opcodes and the
+// flow-control ones act.
+//
+// Two condition stack representations:
+//   vector   std::vector<bool> vfExec, executing iff it contains no false -
+//            what BSV nodes do, a scan of every open IF per opcode
+//   counter  depth plus the position of the first false, O(1) per opcode
+
+namespace {
+
+using Bytes = std::vector<uint8_t>;
+
+constexpr uint8_t OP_0 = 0x00;
+constexpr uint8_t OP_PUSHDATA1 = 0x4c;
+constexpr uint8_t OP_PUSHDATA2 = 0x4d;
+constexpr uint8_t OP_PUSHDATA4 = 0x4e;
+constexpr uint8_t OP_1 = 0x51;
+constexpr uint8_t OP_16 = 0x60;
+constexpr uint8_t OP_NOP = 0x61;
+constexpr uint8_t OP_IF = 0x63;
+constexpr uint8_t OP_NOTIF = 0x64;
+constexpr uint8_t OP_ELSE = 0x67;
+constexpr uint8_t OP_ENDIF = 0x68;
+constexpr uint8_t OP_DROP = 0x75;
+
+class VectorCondStack {
+public:
+    bool executing() const { return std::count(values_.begin(), values_.end(), false) == 0; }
+    bool empty() const { return values_.empty(); }
+    void push(bool value) { values_.push_back(value); }
+    void pop() { values_.pop_back(); }
+    void toggle_top() { values_.back() = !values_.back(); }
+    void clear() { values_.clear(); }
+
+private:
+    std::vector<bool> values_;
+};
+
+class CounterCondStack {
+public:
+    bool executing() const { return first_false_ == kNoFalse; }
+    bool empty() const { return size_ == 0; }
+    void push(bool value) {
+        if (first_false_ == kNoFalse && !value) first_false_ = size_;
+        ++size_;
+    }
+    void pop() {
+        --size_;
+        if (first_false_ == size_) first_false_ = kNoFalse;
+    }
+    void toggle_top() {
+        // Only the top can change whether the first false is the top
+        if (first_false_ == kNoFalse) first_false_ = size_ - 1;
+        else if (first_false_ == size_ - 1) first_false_ = kNoFalse;
+    }
+    void clear() {
+        size_ = 0;
+        first_false_ = kNoFalse;
+    }
+
+private:
+    static constexpr uint32_t kNoFalse = UINT32_MAX;
+    uint32_t size_ = 0;
+    uint32_t first_false_ = kNoFalse;
+};
+
+// Read one opcode, copying any push data into `push` (GetScriptOp)
+bool get_op(const uint8_t*& pc, const uint8_t* end, uint8_t& op, Bytes& push) {
+    op = *pc++;
+    push.clear();
+    if (op > OP_PUSHDATA4) return true;
+
+    uint32_t size = op;
+    if (op == OP_PUSHDATA1) {
+        if (end - pc < 1) return false;
+        size = pc[0];
+        pc += 1;
+    } else if (op == OP_PUSHDATA2) {
+        if (end - pc < 2) return false;
+        size = pc[0] | (pc[1] << 8);
+        pc += 2;
+    } else if (op == OP_PUSHDATA4) {
+        if (end - pc < 4) return false;
+        std::memcpy(&size, pc, 4);
+        pc += 4;
+    }
+    if (static_cast<uint64_t>(end - pc) < size) return false;
+    push.assign(pc, pc + size);
+    pc += size;
+    return true;
+}
+
+bool cast_to_bool(const Bytes& v) {
+    for (size_t i = 0; i < v.size(); ++i) {
+        if (v[i] != 0) return !(i == v.size() - 1 && v[i] == 0x80);
+    }
+    return false;
+}
+
+// Interpreter state reused across runs, as the node reuses it per input
+template <class CondStack>
+struct Interpreter {
+    std::vector<Bytes> stack;
+    CondStack cond;
+    Bytes push;
+
+    bool run(const Bytes& script) {
+        stack.clear();
+        cond.clear();
+        const uint8_t* pc = script.data();
+        const uint8_t* end = pc + script.size();
+
+        while (pc < end) {
+            bool exec = cond.executing();
+            uint8_t op;
+            if (!get_op(pc, end, op, push)) return false;
+
+            if (op <= OP_PUSHDATA4) {
+                if (exec) stack.push_back(push);
+                continue;
+            }
+            if (!exec && (op < OP_IF || op > OP_ENDIF)) continue;
+
+            switch (op) {
+                case OP_IF:
+                case OP_NOTIF: {
+                    bool value = false;
+                    if (exec) {
+                        if (stack.empty()) return false;
+                        value = cast_to_bool(stack.back());
+                        if (op == OP_NOTIF) value = !value;
+                        stack.pop_back();
+                    }
+                    cond.push(value);
+                    break;
+                }
+                case OP_ELSE:
+                    if (cond.empty()) return false;
+                    cond.toggle_top();
+                    break;
+                case OP_ENDIF:
+                    if (cond.empty()) return false;
+                    cond.pop();
+                    break;
+                case OP_DROP:
+                    if (stack.empty()) return false;
+                    stack.pop_back();
+                    break;
+                case OP_NOP:
+                    break;
+                default:
+                    if (op >= OP_1 && op <= OP_16) {
+                        stack.push_back(Bytes{static_cast<uint8_t>(op - OP_1 + 1)});
+                        break;
+                    }
+                    return false;
+            }
+        }
+        return cond.empty();
+    }
+};
+
+void append_push(Bytes& script, size_t size) {
+    if (size < OP_PUSHDATA1) {
+        script.push_back(static_cast<uint8_t>(size));
+    } else if (size <= 0xff) {
+        script.push_back(OP_PUSHDATA1);
+        script.push_back(static_cast<uint8_t>(size));
+    } else if (size <= 0xffff) {
+        script.push_back(OP_PUSHDATA2);
+        script.push_back(static_cast<uint8_t>(size));
+        script.push_back(static_cast<uint8_t>(size >> 8));
+    } else {
+        script.push_back(OP_PUSHDATA4);
+        uint32_t n = static_cast<uint32_t>(size);
+        uint8_t bytes[4];
+        std::memcpy(bytes, &n, 4);
+        script.insert(script.end(), bytes, bytes + 4);
+    }
+    script.resize(script.size() + size, 0x5a);
+}
+
+// Build a script into a make_buffer allocation so cache modes see it
+std::shared_ptr<Bytes> script_buffer(const Bytes& script) {
+    auto buffer = bsv_bench::make_buffer(script.size(), 0);
+    std::memcpy(buffer->data(), script.data(), script.size());
+    return buffer;
+}
+
+template <class CondStack>
+bsv_bench::BenchOperation run_scripts(std::vector<std::shared_ptr<Bytes>> scripts) {
+    auto interpreter = std::make_shared<Interpreter<CondStack>>();
+    if (!interpreter->run(*scripts.front())) {
+        throw std::runtime_error("control flow script failed to run");
+    }
+    size_t next = 0;
+    return [interpreter, scripts, next]() mutable {
+        const Bytes& script = *scripts[next];
+        if (++next == scripts.size()) next = 0;
+        volatile bool ok = interpreter->run(script);
+        (void)ok;
+    };
+}
+
+bsv_bench::BenchOperation run_scripts(bool counter, std::vector<std::shared_ptr<Bytes>> scripts) {
+    return counter ? run_scripts<CounterCondStack>(std::move(scripts))
+                   : run_scripts<VectorCondStack>(std::move(scripts));
+}
+
+const char* scheme_name(bool counter) { return counter ? "counter" : "vector"; }
+
+} // namespace
+
+BSV_BENCH_FAMILY(control_flow, nesting) {
+    // depth x (OP_1 OP_IF), OP_NOP, depth x OP_ENDIF: every opcode runs
+    // with up to `depth` open IFs, so the vector scheme is quadratic in depth
+    for (bool counter : {false, true}) {
+        for (auto depth : bench.axis("depths", {1, 10, 100, 1000, 10000})) {
+            bench.add(
+                "CONDITION_NESTING",
+                std::string(scheme_name(counter)) + ", depth=" + std::to_string(depth),
+                depth,
+                [counter, depth]() -> bsv_bench::BenchOperation {
+                    Bytes script;
+                    for (uint64_t i = 0; i < depth; ++i) {
+                        script.push_back(OP_1);
+                        script.push_back(OP_IF);
+                    }
+                    script.push_back(OP_NOP);
+                    script.insert(script.end(), depth, OP_ENDIF);
+                    return run_scripts(counter, {script_buffer(script)});
+                }
+            );
+        }
+    }
+}
+
+BSV_BENCH_FAMILY(control_flow, branch_push) {
+    // (OP_1|OP_0) OP_IF [pushes x (<push> OP_DROP)] OP_ENDIF. A skipped
+    // branch still copies every push out of the script; an executed one
+    // also copies it onto the stack.
+    auto pushes = bench.axis("pushes", {16}).front();
+    for (bool executed : {true, false}) {
+        for (auto size : bench.axis("push_sizes", {1, 75, 520, 10000, 100000, 1000000})) {
+            bench.add(
+                "BRANCH_PUSH",
+                std::string(executed ? "executed" : "skipped") + ", push=" + std::to_string(size) +
+                    "B, pushes=" + std::to_string(pushes),
+                pushes * size,
+                [executed, size, pushes]() -> bsv_bench::BenchOperation {
+                    Bytes script = {executed ? OP_1 : OP_0, OP_IF};
+                    for (uint64_t i = 0; i < pushes; ++i) {
+                        append_push(script, size);
+                        script.push_back(OP_DROP);
+                    }
+                    script.push_back(OP_ENDIF);
+                    return run_scripts(false, {script_buffer(script)});
+                }
+            );
+        }
+    }
+}
+
+BSV_BENCH_FAMILY(control_flow, branch_pattern) {
+    // blocks x (<cond> OP_IF OP_NOP OP_ELSE OP_NOP OP_ENDIF) with conditions
+    // that are constant, alternating, or random. Random runs rotate over
+    // several scripts so the branch predictor can't learn one pattern.
+    auto blocks = bench.axis("blocks", {1000}).front();
+    for (bool counter : {false, true}) {
+        for (const char* pattern : {"constant", "alternating", "random"}) {
+            bench.add(
+                "BRANCH_PATTERN",
+                std::string(pattern) + ", " + scheme_name(counter) + ", blocks=" + std::to_string(blocks),
+                blocks,
+                [counter, pattern = std::string(pattern), blocks]() -> bsv_bench::BenchOperation {
+                    std::mt19937_64 rng(blocks);
+                    int variants = pattern == "random" ? 16 : 1;
+                    std::vector<std::shared_ptr<Bytes>> scripts;
+                    for (int v = 0; v < variants; ++v) {
+                        Bytes script;
+                        for (uint64_t i = 0; i < blocks; ++i) {
+                            bool taken = pattern == "constant" ? true
+                                       : pattern == "alternating" ? (i & 1) != 0
+                                       : (rng() & 1) != 0;
+                            script.insert(script.end(),
+                                          {taken ? OP_1 : OP_0, OP_IF, OP_NOP, OP_ELSE, OP_NOP, OP_ENDIF});
+                        }
+                        scripts.push_back(script_buffer(script));
+                    }
+                    return run_scripts(counter, std::move(scripts));
+                }
+            );
+        }
+    }
+}
+
+#ifndef BSV_BENCH_UNIFIED
+static std::vector<bsv_bench::FitPoint> fit_points(const std::vector<bsv_bench::BenchResult>& results,
+                                                   const std::string& opcode_name,
+                                                   const std::string& prefix) {
+    std::vector<bsv_bench::FitPoint> points;
+    for (const auto& r : results) {
+        if (r.opcode != opcode_name || r.param_desc.compare(0, prefix.size(), prefix) != 0) continue;
+        points.push_back(bsv_bench::to_fit_point(r));
+    }
+    return points;
+}
+
+// Per-opcode depth cost of each condition stack (the same fit bsv_fit_model
+// uses for the model's control_flow section)
+static void analyze_nesting(const std::vector<bsv_bench::BenchResult>& results) {
+    for (bool counter : {false, true}) {
+        auto points = fit_points(results, "CONDITION_NESTING", scheme_name(counter));
+        if (points.size() < 3) continue;
+        bsv_bench::ModelFit fit = bsv_bench::fit_model(bsv_bench::ModelForm::QUADRATIC, points,
+                                                       bsv_bench::FitOptions());
+        // The script's opcodes see 1.5*depth^2 + 0.5*depth open IFs in total
+        double per_depth = fit.coefficient("c2") / 1.5;
+        std::cout << "\n=== Condition stack: " << scheme_name(counter) << " ===\n"
+                  << "  cycles per opcode per open IF: " << per_depth << "\n"
+                  << "  cycles per nesting level (OP_1 OP_IF .. OP_ENDIF): "
+                  << fit.coefficient("c1") - 0.5 * per_depth << "\n"
+                  << "  R² (weighted): " << fit.diagnostics.r_squared << "\n";
+    }
+}
+
+int main(int argc, char** argv) {
+    std::cout << "=== BSV Script Benchmark: Control Flow ===\n";
+    std::cout << "OP_IF/OP_NOTIF/OP_ELSE/OP_ENDIF condition stack, vector vs counter\n\n";
+
+    bsv_bench::BenchmarkHarness harness;
+    harness.initialize(0);  // Pin to CPU 0
+
+    auto cases = bsv_bench::BenchRegistry::instance().collect(
+        bsv_bench::ParamMatrix(), bsv_bench::CaseFilter());
+    std::vector<bsv_bench::BenchResult> results = bsv_bench::run_cases(harness, cases);
+
+    analyze_nesting(results);
+
+    std::string csv_file = "output/bench_control_flow.csv";
+    std::string json_file = "output/bench_control_flow.json";
+
+    harness.export_csv(results, csv_file);
+    harness.export_json(results, json_file);
+
+    std::cout << "\n=== Results exported to:\n";
+    std::cout << "  " << csv_file << "\n";
+    std::cout << "  " << json_file << "\n";
 
-int main() {
-    std::cout << "OP_IF/OP_ELSE control flow benchmarks - placeholder\n";
     return 0;
 }
+#endif
@@ -1,4 +1,5 @@
 #include "bench_harness.h"
+#include "bench_sysinfo.h"
 #include <algorithm>
 #include <numeric>
 #include <cmath>
@@ -9,6 +10,30 @@
 #include <sys/ioctl.h>
 #include <cstring>
 #include <iostream>
+#include <random>
+#include <immintrin.h>
+#include <cstdlib>
+#include <new>
+
+// Count heap allocations for BenchResult::malloc_count and alloc_bytes.
+// Every benchmark binary links the harness, so this replaces operator new
+// (and, through it, new[] and nothrow new) for all of them. Direct malloc
+// calls, e.g. inside OpenSSL, are not counted.
+void* operator new(std::size_t size) {
+    bsv_bench::TrafficCounters& traffic = bsv_bench::thread_traffic();
+    ++traffic.allocations;
+    traffic.alloc_bytes += size;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
 
 namespace bsv_bench {
 
@@ -24,8 +49,12 @@ BenchmarkHarness::BenchmarkHarness()
     , perf_fd_l1d_misses_(-1)
     , perf_fd_llc_misses_(-1)
     , perf_fd_branch_misses_(-1)
+    , perf_fd_page_faults_(-1)
+    , perf_fd_minor_faults_(-1)
     , perf_counters_enabled_(false)
-    , pinned_cpu_(-1) {
+    , perf_faults_enabled_(false)
+    , pinned_cpu_(-1)
+    , cache_mode_(CacheMode::WARM) {
 }
 
 BenchmarkHarness::~BenchmarkHarness() {
@@ -34,6 +63,8 @@ BenchmarkHarness::~BenchmarkHarness() {
     if (perf_fd_l1d_misses_ >= 0) close(perf_fd_l1d_misses_);
     if (perf_fd_llc_misses_ >= 0) close(perf_fd_llc_misses_);
     if (perf_fd_branch_misses_ >= 0) close(perf_fd_branch_misses_);
+    if (perf_fd_page_faults_ >= 0) close(perf_fd_page_faults_);
+    if (perf_fd_minor_faults_ >= 0) close(perf_fd_minor_faults_);
 }
 
 void BenchmarkHarness::initialize(int cpu_core) {
@@ -75,11 +106,70 @@ void BenchmarkHarness::initialize(int cpu_core) {
     pe.config = PERF_COUNT_HW_BRANCH_MISSES;
     perf_fd_branch_misses_ = perf_event_open(&pe, 0, -1, -1, 0);
     
+    // Page faults (software events, counted by the kernel's fault handler)
+    pe.type = PERF_TYPE_SOFTWARE;
+    pe.config = PERF_COUNT_SW_PAGE_FAULTS;
+    perf_fd_page_faults_ = perf_event_open(&pe, 0, -1, -1, 0);
+    pe.config = PERF_COUNT_SW_PAGE_FAULTS_MIN;
+    perf_fd_minor_faults_ = perf_event_open(&pe, 0, -1, -1, 0);
+    
     perf_counters_enabled_ = (perf_fd_cycles_ >= 0);
+    perf_faults_enabled_ = (perf_fd_page_faults_ >= 0 && perf_fd_minor_faults_ >= 0);
     
     if (!perf_counters_enabled_) {
         std::cerr << "Warning: Performance counters not available. Running with rdtsc only.\n";
     }
+    if (!perf_faults_enabled_) {
+        std::cerr << "Warning: Page-fault counters not available. Using getrusage.\n";
+    }
+}
+
+const char* cache_mode_name(CacheMode mode) {
+    switch (mode) {
+        case CacheMode::WARM: return "warm";
+        case CacheMode::COLD: return "cold";
+        case CacheMode::ROTATING: return "rotating";
+    }
+    return "warm";
+}
+
+bool parse_cache_mode(const std::string& name, CacheMode& mode) {
+    if (name == "warm") mode = CacheMode::WARM;
+    else if (name == "cold") mode = CacheMode::COLD;
+    else if (name == "rotating") mode = CacheMode::ROTATING;
+    else return false;
+    return true;
+}
+
+void BenchmarkHarness::set_cache_mode(CacheMode mode, const std::vector<MemoryRegion>& regions) {
+    cache_mode_ = mode;
+    flush_regions_ = regions;
+}
+
+void BenchmarkHarness::evict_caches() {
+    if (!flush_regions_.empty()) {
+        for (const auto& region : flush_regions_) {
+            const char* p = static_cast<const char*>(region.data);
+            for (size_t offset = 0; offset < region.size; offset += 64) {
+                _mm_clflush(p + offset);
+            }
+            if (region.size > 0) _mm_clflush(p + region.size - 1);
+        }
+        _mm_mfence();
+        return;
+    }
+    
+    // Unknown footprint: stream through 1.5x the LLC so earlier lines are gone
+    if (sweep_buffer_.empty()) {
+        sweep_buffer_.assign(llc_size_bytes() + llc_size_bytes() / 2, 1);
+    }
+    volatile uint8_t sink = 0;
+    for (size_t i = 0; i < sweep_buffer_.size(); i += 64) {
+        sweep_buffer_[i] += 1;
+        sink = sink + sweep_buffer_[i];
+    }
+    (void)sink;
+    _mm_mfence();
 }
 
 Statistics BenchmarkHarness::calculate_stats(std::vector<uint64_t>& samples) {
@@ -101,6 +191,124 @@ Statistics BenchmarkHarness::calculate_stats(std::vector<uint64_t>& samples) {
     return stats;
 }
 
+ConfidenceInterval BenchmarkHarness::bootstrap_median_ci(
+    const std::vector<uint64_t>& samples,
+    double confidence,
+    int resamples
+) {
+    if (samples.empty()) return {0.0, 0.0};
+    if (samples.size() == 1 || resamples <= 0) {
+        return {static_cast<double>(samples[0]), static_cast<double>(samples[0])};
+    }
+    
+    // Fixed seed so repeated analysis of the same samples is reproducible
+    std::mt19937_64 rng(0x5eed);
+    std::uniform_int_distribution<size_t> pick(0, samples.size() - 1);
+    
+    std::vector<uint64_t> resample(samples.size());
+    std::vector<double> medians;
+    medians.reserve(resamples);
+    
+    for (int r = 0; r < resamples; ++r) {
+        for (auto& v : resample) {
+            v = samples[pick(rng)];
+        }
+        auto mid = resample.begin() + resample.size() / 2;
+        std::nth_element(resample.begin(), mid, resample.end());
+        medians.push_back(static_cast<double>(*mid));
+    }
+    
+    std::sort(medians.begin(), medians.end());
+    double alpha = (1.0 - confidence) / 2.0;
+    size_t lo = static_cast<size_t>(alpha * (medians.size() - 1));
+    size_t hi = static_cast<size_t>((1.0 - alpha) * (medians.size() - 1));
+    return {medians[lo], medians[hi]};
+}
+
+bool BenchmarkHarness::is_disturbed(const ResourceSnapshot& before,
+                                    const ResourceSnapshot& after,
+                                    uint64_t fault_baseline) {
+    if (after.context_switches != before.context_switches) {
+        return true;
+    }
+    // Allow some slack for operations that fault on every run
+    uint64_t faults = after.page_faults - before.page_faults;
+    return faults > fault_baseline + fault_baseline / 8;
+}
+
+bool BenchmarkHarness::has_converged(const std::vector<uint64_t>& samples,
+                                     const AdaptivePolicy& policy) {
+    if (samples.size() < static_cast<size_t>(std::max(3, policy.min_samples))) {
+        return false;
+    }
+    
+    std::vector<uint64_t> sorted(samples);
+    auto mid = sorted.begin() + sorted.size() / 2;
+    std::nth_element(sorted.begin(), mid, sorted.end());
+    double median = static_cast<double>(*mid);
+    if (median <= 0.0) return true;
+    
+    ConfidenceInterval ci = bootstrap_median_ci(samples, policy.confidence,
+                                                policy.bootstrap_resamples);
+    return (ci.high - ci.low) / median <= policy.target_rel_ci_width;
+}
+
+BenchResult BenchmarkHarness::make_result(
+    const std::string& opcode_name,
+    const std::string& param_description,
+    uint64_t input_size_bytes,
+    std::vector<uint64_t>& cycle_samples,
+    const CounterTotals& totals,
+    uint32_t rejected_samples,
+    double confidence,
+    int bootstrap_resamples
+) const {
+    BenchResult result = {};
+    result.opcode = opcode_name;
+    result.param_desc = param_description;
+    result.input_bytes = input_size_bytes;
+    result.rejected_samples = rejected_samples;
+    result.cache_mode = cache_mode_name(cache_mode_);
+    
+    if (cycle_samples.empty()) {
+        return result;
+    }
+    
+    ConfidenceInterval ci = bootstrap_median_ci(cycle_samples, confidence, bootstrap_resamples);
+    Statistics stats = calculate_stats(cycle_samples);
+    size_t n = cycle_samples.size();
+    
+    // Assume 3.5 GHz for ns conversion (adjust based on actual CPU)
+    const double CPU_GHZ = 3.5;
+    
+    result.median_cycles = static_cast<uint64_t>(stats.median);
+    result.p90_cycles = static_cast<uint64_t>(stats.p90);
+    result.p99_cycles = static_cast<uint64_t>(stats.p99);
+    result.p95_cycles = static_cast<uint64_t>(stats.p95);
+    result.mean_cycles = stats.mean;
+    result.stddev_cycles = stats.stddev;
+    result.median_ns = stats.median / CPU_GHZ;
+    result.instructions = totals.instructions / n;
+    result.ipc = perf_counters_enabled_ && result.median_cycles > 0 ?
+                 (double)result.instructions / result.median_cycles : 0.0;
+    result.l1d_misses = totals.l1d_misses / n;
+    result.llc_misses = totals.llc_misses / n;
+    result.branch_misses = totals.branch_misses / n;
+    result.malloc_count = totals.allocations / n;
+    result.alloc_bytes = totals.alloc_bytes / n;
+    result.copied_bytes = totals.copied_bytes / n;
+    result.page_faults = totals.page_faults / n;
+    result.minor_faults = totals.minor_faults / n;
+    result.ci_low_cycles = static_cast<uint64_t>(ci.low);
+    result.ci_high_cycles = static_cast<uint64_t>(ci.high);
+    result.sample_count = static_cast<uint32_t>(n);
+    for (auto sample : cycle_samples) {
+        result.histogram.record(sample);
+    }
+    
+    return result;
+}
+
 void BenchmarkHarness::export_csv(const std::vector<BenchResult>& results, 
                                   const std::string& filename) {
     std::ofstream out(filename);
@@ -108,7 +316,9 @@ void BenchmarkHarness::export_csv(const std::vector<BenchResult>& results,
     // Header
     out << "opcode,param_desc,input_bytes,median_cycles,p90_cycles,p99_cycles,"
         << "median_ns,instructions,ipc,l1d_misses,llc_misses,branch_misses,"
-        << "malloc_count,alloc_bytes\n";
+        << "malloc_count,alloc_bytes,ci_low_cycles,ci_high_cycles,"
+        << "sample_count,rejected_samples,p95_cycles,mean_cycles,stddev_cycles,"
+        << "cache_mode,copied_bytes,page_faults,minor_faults\n";
     
     // Data rows
     for (const auto& r : results) {
@@ -125,7 +335,18 @@ void BenchmarkHarness::export_csv(const std::vector<BenchResult>& results,
             << r.llc_misses << ","
             << r.branch_misses << ","
             << r.malloc_count << ","
-            << r.alloc_bytes << "\n";
+            << r.alloc_bytes << ","
+            << r.ci_low_cycles << ","
+            << r.ci_high_cycles << ","
+            << r.sample_count << ","
+            << r.rejected_samples << ","
+            << r.p95_cycles << ","
+            << r.mean_cycles << ","
+            << r.stddev_cycles << ","
+            << r.cache_mode << ","
+            << r.copied_bytes << ","
+            << r.page_faults << ","
+            << r.minor_faults << "\n";
     }
 }
 
@@ -140,15 +361,29 @@ void BenchmarkHarness::export_json(const std::vector<BenchResult>& results,
             << "      \"opcode\": \"" << r.opcode << "\",\n"
             << "      \"param_desc\": \"" << r.param_desc << "\",\n"
             << "      \"input_bytes\": " << r.input_bytes << ",\n"
+            << "      \"cache_mode\": \"" << r.cache_mode << "\",\n"
             << "      \"median_cycles\": " << r.median_cycles << ",\n"
             << "      \"p90_cycles\": " << r.p90_cycles << ",\n"
+            << "      \"p95_cycles\": " << r.p95_cycles << ",\n"
             << "      \"p99_cycles\": " << r.p99_cycles << ",\n"
+            << "      \"mean_cycles\": " << r.mean_cycles << ",\n"
+            << "      \"stddev_cycles\": " << r.stddev_cycles << ",\n"
             << "      \"median_ns\": " << r.median_ns << ",\n"
             << "      \"instructions\": " << r.instructions << ",\n"
             << "      \"ipc\": " << r.ipc << ",\n"
             << "      \"l1d_misses\": " << r.l1d_misses << ",\n"
             << "      \"llc_misses\": " << r.llc_misses << ",\n"
-            << "      \"branch_misses\": " << r.branch_misses << "\n"
+            << "      \"branch_misses\": " << r.branch_misses << ",\n"
+            << "      \"malloc_count\": " << r.malloc_count << ",\n"
+            << "      \"alloc_bytes\": " << r.alloc_bytes << ",\n"
+            << "      \"copied_bytes\": " << r.copied_bytes << ",\n"
+            << "      \"page_faults\": " << r.page_faults << ",\n"
+            << "      \"minor_faults\": " << r.minor_faults << ",\n"
+            << "      \"ci_low_cycles\": " << r.ci_low_cycles << ",\n"
+            << "      \"ci_high_cycles\": " << r.ci_high_cycles << ",\n"
+            << "      \"sample_count\": " << r.sample_count << ",\n"
+            << "      \"rejected_samples\": " << r.rejected_samples << ",\n"
+            << "      \"histogram\": " << r.histogram.to_json() << "\n"
             << "    }" << (i < results.size() - 1 ? "," : "") << "\n";
     }
     
@@ -4,10 +4,15 @@
 #include <string>
 #include <vector>
 #include <functional>
+#include <algorithm>
 #include <fstream>
+#include <chrono>
+#include <limits>
 #include <sys/ioctl.h>
+#include <sys/resource.h>
 #include <unistd.h>
 #include <linux/perf_event.h>
+#include "bench_histogram.h"
 
 namespace bsv_bench {
 
@@ -21,6 +26,9 @@ struct BenchResult {
     uint64_t median_cycles;
     uint64_t p90_cycles;
     uint64_t p99_cycles;
+    uint64_t p95_cycles;
+    double mean_cycles;
+    double stddev_cycles;
     double median_ns;
     
     // Performance counters
@@ -30,9 +38,40 @@ struct BenchResult {
     uint64_t llc_misses;
     uint64_t branch_misses;
     
-    // Memory allocation tracking
+    // Memory traffic per sample (see TrafficCounters)
     uint64_t malloc_count;
     uint64_t alloc_bytes;
+    uint64_t copied_bytes;
+    uint64_t page_faults;       // Minor + major faults per sample
+    uint64_t minor_faults;      // Faults served without I/O (first touch, COW)
+    
+    // Sampling quality: bootstrap confidence interval of the median
+    uint64_t ci_low_cycles;
+    uint64_t ci_high_cycles;
+    uint32_t sample_count;      // Samples kept for statistics
+    uint32_t rejected_samples;  // Samples dropped (context switch / page fault)
+    
+    // Full latency distribution of the kept samples
+    LatencyHistogram histogram;
+    
+    // Cache state the samples were taken in ("warm", "cold", "rotating")
+    std::string cache_mode;
+};
+
+// Cache state of an operation's inputs at the start of each sample
+enum class CacheMode {
+    WARM,       // Same inputs every sample, left hot in L1/L2 (default)
+    COLD,       // Inputs evicted from all cache levels before each sample
+    ROTATING    // Cycle through a pool of distinct inputs larger than the LLC
+};
+
+const char* cache_mode_name(CacheMode mode);
+bool parse_cache_mode(const std::string& name, CacheMode& mode);
+
+// A block of memory an operation reads, for targeted cache eviction
+struct MemoryRegion {
+    const void* data;
+    size_t size;
 };
 
 // Statistics calculator
@@ -45,6 +84,62 @@ struct Statistics {
     double stddev;
 };
 
+// Confidence interval for a statistic (in cycles)
+struct ConfidenceInterval {
+    double low;
+    double high;
+};
+
+// Adaptive sampling policy: keep sampling until the bootstrap confidence
+// interval of the median is narrower than target_rel_ci_width, or until the
+// time budget runs out.
+struct AdaptivePolicy {
+    double target_rel_ci_width = 0.02;  // (ci_high - ci_low) / median
+    double confidence = 0.95;
+    uint64_t time_budget_ms = 2000;     // Per benchmark case, excluding warmup
+    int min_samples = 20;
+    int max_samples = 200000;
+    int warmup_iterations = 10;
+    int bootstrap_resamples = 200;
+    bool reject_outliers = true;        // Drop samples disturbed by the OS
+};
+
+// Per-thread OS activity counters, read around each sample to detect
+// context switches and page faults that were not caused by the operation
+struct ResourceSnapshot {
+    uint64_t context_switches;
+    uint64_t page_faults;
+    uint64_t minor_faults;
+    
+    static ResourceSnapshot now() {
+        struct rusage usage;
+        getrusage(RUSAGE_THREAD, &usage);
+        return {
+            static_cast<uint64_t>(usage.ru_nvcsw + usage.ru_nivcsw),
+            static_cast<uint64_t>(usage.ru_minflt + usage.ru_majflt),
+            static_cast<uint64_t>(usage.ru_minflt)
+        };
+    }
+};
+
+// Heap and copy traffic of the calling thread. The harness replaces global
+// operator new to count allocations; byte-string code reports the bytes it
+// copies with note_copy(). Read around each sample like the perf counters.
+struct TrafficCounters {
+    uint64_t allocations = 0;
+    uint64_t alloc_bytes = 0;
+    uint64_t copied_bytes = 0;
+};
+
+inline TrafficCounters& thread_traffic() {
+    static thread_local TrafficCounters counters;
+    return counters;
+}
+
+inline void note_copy(uint64_t bytes) {
+    thread_traffic().copied_bytes += bytes;
+}
+
 // Helper: Pin current thread to specific CPU core
 void pin_to_cpu(int cpu_core);
 
@@ -76,6 +171,13 @@ public:
     // Initialize performance counters and CPU pinning
     void initialize(int cpu_core = -1);
     
+    // Cache state for subsequent benchmarks. In COLD mode, regions are
+    // flushed with clflush before every sample; with no regions an LLC-sized
+    // buffer is swept instead. ROTATING only labels results: the caller
+    // supplies an operation that cycles through distinct inputs.
+    void set_cache_mode(CacheMode mode, const std::vector<MemoryRegion>& regions = {});
+    CacheMode cache_mode() const { return cache_mode_; }
+    
     // Run a benchmark function multiple times and collect statistics
     template<typename Func>
     BenchResult benchmark(
@@ -88,11 +190,7 @@ public:
     ) {
         std::vector<uint64_t> cycle_samples;
         cycle_samples.reserve(iterations);
-        
-        uint64_t total_instructions = 0;
-        uint64_t total_l1d_misses = 0;
-        uint64_t total_llc_misses = 0;
-        uint64_t total_branch_misses = 0;
+        CounterTotals totals;
         
         // Warmup
         for (int i = 0; i < warmup_iterations; ++i) {
@@ -101,79 +199,89 @@ public:
         
         // Actual measurements
         for (int i = 0; i < iterations; ++i) {
-            // Reset and enable counters
-            if (perf_counters_enabled_) {
-                ioctl(perf_fd_cycles_, PERF_EVENT_IOC_RESET, 0);
-                ioctl(perf_fd_instructions_, PERF_EVENT_IOC_RESET, 0);
-                ioctl(perf_fd_l1d_misses_, PERF_EVENT_IOC_RESET, 0);
-                ioctl(perf_fd_llc_misses_, PERF_EVENT_IOC_RESET, 0);
-                ioctl(perf_fd_branch_misses_, PERF_EVENT_IOC_RESET, 0);
-                
-                ioctl(perf_fd_cycles_, PERF_EVENT_IOC_ENABLE, 0);
-                ioctl(perf_fd_instructions_, PERF_EVENT_IOC_ENABLE, 0);
-                ioctl(perf_fd_l1d_misses_, PERF_EVENT_IOC_ENABLE, 0);
-                ioctl(perf_fd_llc_misses_, PERF_EVENT_IOC_ENABLE, 0);
-                ioctl(perf_fd_branch_misses_, PERF_EVENT_IOC_ENABLE, 0);
-            }
-            
-            // Measure with rdtsc
-            serialize();
-            uint64_t start = rdtsc();
-            mfence();
-            
+            prepare_sample();
+            ResourceSnapshot before = ResourceSnapshot::now();
+            SampleCounters sample = measure_once(operation);
+            ResourceSnapshot after = ResourceSnapshot::now();
+            rusage_faults(sample, before, after);
+            totals.add(sample);
+            cycle_samples.push_back(sample.cycles);
+        }
+        
+        return make_result(opcode_name, param_description, input_size_bytes,
+                           cycle_samples, totals, 0, 0.95, 200);
+    }
+    
+    // Run a benchmark function until the median has converged (see
+    // AdaptivePolicy). Samples during which the thread was context-switched
+    // or took more page faults than the operation itself causes are rejected.
+    template<typename Func>
+    BenchResult benchmark_adaptive(
+        const std::string& opcode_name,
+        const std::string& param_description,
+        uint64_t input_size_bytes,
+        Func&& operation,
+        const AdaptivePolicy& policy = AdaptivePolicy()
+    ) {
+        std::vector<uint64_t> cycle_samples;
+        CounterTotals totals;
+        uint32_t rejected = 0;
+        
+        // Warmup; also establishes how many page faults the operation takes
+        // on its own (e.g. first-touch of a freshly mmap'd result buffer)
+        uint64_t fault_baseline = std::numeric_limits<uint64_t>::max();
+        for (int i = 0; i < std::max(1, policy.warmup_iterations); ++i) {
+            ResourceSnapshot before = ResourceSnapshot::now();
             operation();
+            ResourceSnapshot after = ResourceSnapshot::now();
+            fault_baseline = std::min(fault_baseline, after.page_faults - before.page_faults);
+        }
+        
+        const auto deadline = std::chrono::steady_clock::now() +
+                              std::chrono::milliseconds(policy.time_budget_ms);
+        size_t next_check = static_cast<size_t>(std::max(3, policy.min_samples));
+        
+        while (cycle_samples.size() < static_cast<size_t>(policy.max_samples)) {
+            prepare_sample();
+            ResourceSnapshot before = ResourceSnapshot::now();
+            SampleCounters sample = measure_once(operation);
+            ResourceSnapshot after = ResourceSnapshot::now();
+            rusage_faults(sample, before, after);
             
-            mfence();
-            uint64_t end = rdtsc();
-            serialize();
-            
-            // Disable counters
-            if (perf_counters_enabled_) {
-                ioctl(perf_fd_cycles_, PERF_EVENT_IOC_DISABLE, 0);
-                ioctl(perf_fd_instructions_, PERF_EVENT_IOC_DISABLE, 0);
-                ioctl(perf_fd_l1d_misses_, PERF_EVENT_IOC_DISABLE, 0);
-                ioctl(perf_fd_llc_misses_, PERF_EVENT_IOC_DISABLE, 0);
-                ioctl(perf_fd_branch_misses_, PERF_EVENT_IOC_DISABLE, 0);
-                
-                uint64_t count;
-                if (read(perf_fd_instructions_, &count, sizeof(count)) == sizeof(count))
-                    total_instructions += count;
-                if (read(perf_fd_l1d_misses_, &count, sizeof(count)) == sizeof(count))
-                    total_l1d_misses += count;
-                if (read(perf_fd_llc_misses_, &count, sizeof(count)) == sizeof(count))
-                    total_llc_misses += count;
-                if (read(perf_fd_branch_misses_, &count, sizeof(count)) == sizeof(count))
-                    total_branch_misses += count;
+            // Never reject more than we keep, so a noisy box still terminates
+            bool disturbed = policy.reject_outliers &&
+                             is_disturbed(before, after, fault_baseline) &&
+                             rejected < std::max<size_t>(policy.min_samples, cycle_samples.size());
+            if (disturbed) {
+                ++rejected;
+            } else {
+                totals.add(sample);
+                cycle_samples.push_back(sample.cycles);
             }
             
-            cycle_samples.push_back(end - start);
+            if (cycle_samples.size() >= 3 && std::chrono::steady_clock::now() >= deadline) {
+                break;
+            }
+            if (cycle_samples.size() >= next_check) {
+                if (has_converged(cycle_samples, policy)) break;
+                // Re-check after ~25% more samples to keep bootstrap cost bounded
+                next_check = cycle_samples.size() +
+                             std::max<size_t>(policy.min_samples, cycle_samples.size() / 4);
+            }
         }
         
-        Statistics stats = calculate_stats(cycle_samples);
-        
-        // Assume 3.5 GHz for ns conversion (adjust based on actual CPU)
-        const double CPU_GHZ = 3.5;
-        
-        BenchResult result;
-        result.opcode = opcode_name;
-        result.param_desc = param_description;
-        result.input_bytes = input_size_bytes;
-        result.median_cycles = static_cast<uint64_t>(stats.median);
-        result.p90_cycles = static_cast<uint64_t>(stats.p90);
-        result.p99_cycles = static_cast<uint64_t>(stats.p99);
-        result.median_ns = stats.median / CPU_GHZ;
-        result.instructions = total_instructions / iterations;
-        result.ipc = perf_counters_enabled_ ? 
-                     (double)result.instructions / result.median_cycles : 0.0;
-        result.l1d_misses = total_l1d_misses / iterations;
-        result.llc_misses = total_llc_misses / iterations;
-        result.branch_misses = total_branch_misses / iterations;
-        result.malloc_count = 0;  // TODO: Hook malloc
-        result.alloc_bytes = 0;   // TODO: Track allocations
-        
-        return result;
+        return make_result(opcode_name, param_description, input_size_bytes,
+                           cycle_samples, totals, rejected,
+                           policy.confidence, policy.bootstrap_resamples);
     }
     
+    // Bootstrap confidence interval of the median of samples
+    static ConfidenceInterval bootstrap_median_ci(
+        const std::vector<uint64_t>& samples,
+        double confidence,
+        int resamples
+    );
+    
     // Export results to CSV
     void export_csv(const std::vector<BenchResult>& results, const std::string& filename);
     
@@ -181,6 +289,159 @@ public:
     void export_json(const std::vector<BenchResult>& results, const std::string& filename);
     
 private:
+    // Counters for a single timed execution
+    struct SampleCounters {
+        uint64_t cycles;
+        uint64_t instructions;
+        uint64_t l1d_misses;
+        uint64_t llc_misses;
+        uint64_t branch_misses;
+        uint64_t allocations;
+        uint64_t alloc_bytes;
+        uint64_t copied_bytes;
+        uint64_t page_faults;
+        uint64_t minor_faults;
+    };
+    
+    // Sums of counters over the kept samples
+    struct CounterTotals {
+        uint64_t instructions = 0;
+        uint64_t l1d_misses = 0;
+        uint64_t llc_misses = 0;
+        uint64_t branch_misses = 0;
+        uint64_t allocations = 0;
+        uint64_t alloc_bytes = 0;
+        uint64_t copied_bytes = 0;
+        uint64_t page_faults = 0;
+        uint64_t minor_faults = 0;
+        
+        void add(const SampleCounters& s) {
+            instructions += s.instructions;
+            l1d_misses += s.l1d_misses;
+            llc_misses += s.llc_misses;
+            branch_misses += s.branch_misses;
+            allocations += s.allocations;
+            alloc_bytes += s.alloc_bytes;
+            copied_bytes += s.copied_bytes;
+            page_faults += s.page_faults;
+            minor_faults += s.minor_faults;
+        }
+    };
+    
+    // Time one execution of operation with rdtsc and perf counters
+    template<typename Func>
+    SampleCounters measure_once(Func& operation) {
+        SampleCounters sample = {};
+        const TrafficCounters traffic = thread_traffic();
+        
+        // Reset and enable counters
+        if (perf_counters_enabled_) {
+            ioctl(perf_fd_cycles_, PERF_EVENT_IOC_RESET, 0);
+            ioctl(perf_fd_instructions_, PERF_EVENT_IOC_RESET, 0);
+            ioctl(perf_fd_l1d_misses_, PERF_EVENT_IOC_RESET, 0);
+            ioctl(perf_fd_llc_misses_, PERF_EVENT_IOC_RESET, 0);
+            ioctl(perf_fd_branch_misses_, PERF_EVENT_IOC_RESET, 0);
+            
+            ioctl(perf_fd_cycles_, PERF_EVENT_IOC_ENABLE, 0);
+            ioctl(perf_fd_instructions_, PERF_EVENT_IOC_ENABLE, 0);
+            ioctl(perf_fd_l1d_misses_, PERF_EVENT_IOC_ENABLE, 0);
+            ioctl(perf_fd_llc_misses_, PERF_EVENT_IOC_ENABLE, 0);
+            ioctl(perf_fd_branch_misses_, PERF_EVENT_IOC_ENABLE, 0);
+        }
+        if (perf_faults_enabled_) {
+            ioctl(perf_fd_page_faults_, PERF_EVENT_IOC_RESET, 0);
+            ioctl(perf_fd_minor_faults_, PERF_EVENT_IOC_RESET, 0);
+            ioctl(perf_fd_page_faults_, PERF_EVENT_IOC_ENABLE, 0);
+            ioctl(perf_fd_minor_faults_, PERF_EVENT_IOC_ENABLE, 0);
+        }
+        
+        // Measure with rdtsc
+        serialize();
+        uint64_t start = rdtsc();
+        mfence();
+        
+        operation();
+        
+        mfence();
+        uint64_t end = rdtsc();
+        serialize();
+        
+        // Disable counters
+        if (perf_counters_enabled_) {
+            ioctl(perf_fd_cycles_, PERF_EVENT_IOC_DISABLE, 0);
+            ioctl(perf_fd_instructions_, PERF_EVENT_IOC_DISABLE, 0);
+            ioctl(perf_fd_l1d_misses_, PERF_EVENT_IOC_DISABLE, 0);
+            ioctl(perf_fd_llc_misses_, PERF_EVENT_IOC_DISABLE, 0);
+            ioctl(perf_fd_branch_misses_, PERF_EVENT_IOC_DISABLE, 0);
+            
+            uint64_t count;
+            if (read(perf_fd_instructions_, &count, sizeof(count)) == sizeof(count))
+                sample.instructions = count;
+            if (read(perf_fd_l1d_misses_, &count, sizeof(count)) == sizeof(count))
+                sample.l1d_misses = count;
+            if (read(perf_fd_llc_misses_, &count, sizeof(count)) == sizeof(count))
+                sample.llc_misses = count;
+            if (read(perf_fd_branch_misses_, &count, sizeof(count)) == sizeof(count))
+                sample.branch_misses = count;
+        }
+        if (perf_faults_enabled_) {
+            ioctl(perf_fd_page_faults_, PERF_EVENT_IOC_DISABLE, 0);
+            ioctl(perf_fd_minor_faults_, PERF_EVENT_IOC_DISABLE, 0);
+            
+            uint64_t count;
+            if (read(perf_fd_page_faults_, &count, sizeof(count)) == sizeof(count))
+                sample.page_faults = count;
+            if (read(perf_fd_minor_faults_, &count, sizeof(count)) == sizeof(count))
+                sample.minor_faults = count;
+        }
+        
+        sample.cycles = end - start;
+        const TrafficCounters& after = thread_traffic();
+        sample.allocations = after.allocations - traffic.allocations;
+        sample.alloc_bytes = after.alloc_bytes - traffic.alloc_bytes;
+        sample.copied_bytes = after.copied_bytes - traffic.copied_bytes;
+        return sample;
+    }
+    
+    // Fault counts from getrusage, when the perf software counters that
+    // measure_once reads are unavailable
+    void rusage_faults(SampleCounters& sample,
+                       const ResourceSnapshot& before,
+                       const ResourceSnapshot& after) const {
+        if (perf_faults_enabled_) return;
+        sample.page_faults = after.page_faults - before.page_faults;
+        sample.minor_faults = after.minor_faults - before.minor_faults;
+    }
+    
+    // Put caches into the configured state before a sample (not timed)
+    void prepare_sample() {
+        if (cache_mode_ == CacheMode::COLD) evict_caches();
+    }
+    
+    // Flush the COLD-mode regions, or sweep the eviction buffer
+    void evict_caches();
+    
+    // True if the OS interfered with a sample
+    static bool is_disturbed(const ResourceSnapshot& before,
+                             const ResourceSnapshot& after,
+                             uint64_t fault_baseline);
+    
+    // True once the median's bootstrap CI is within the policy's target width
+    static bool has_converged(const std::vector<uint64_t>& samples,
+                              const AdaptivePolicy& policy);
+    
+    // Build a BenchResult from raw samples (sorts samples in place)
+    BenchResult make_result(
+        const std::string& opcode_name,
+        const std::string& param_description,
+        uint64_t input_size_bytes,
+        std::vector<uint64_t>& cycle_samples,
+        const CounterTotals& totals,
+        uint32_t rejected_samples,
+        double confidence,
+        int bootstrap_resamples
+    ) const;
+    
     // Cycle counter using rdtsc
     static inline uint64_t read_cycles();
     
@@ -193,9 +454,16 @@ private:
     int perf_fd_l1d_misses_;
     int perf_fd_llc_misses_;
     int perf_fd_branch_misses_;
+    int perf_fd_page_faults_;       // Software events: work without PMU access
+    int perf_fd_minor_faults_;
     
     bool perf_counters_enabled_;
+    bool perf_faults_enabled_;
     int pinned_cpu_;
+    
+    CacheMode cache_mode_;
+    std::vector<MemoryRegion> flush_regions_;
+    std::vector<uint8_t> sweep_buffer_;  // Allocated on first LLC sweep
 };
 
 } // namespace bsv_bench
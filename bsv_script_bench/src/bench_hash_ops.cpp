@@ -1,10 +1,33 @@
 #include "bench_harness.h"
+#include "bench_registry.h"
+#include "model_fit.h"
+#include "ripemd160_kernels.h"
+#include "sha256_kernels.h"
 #include <vector>
+#include <algorithm>
+#include <array>
 #include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <openssl/evp.h>
 #include <openssl/sha.h>
 #include <openssl/ripemd.h>
 
+// Fetched digest by name, kept for the process; the legacy method if the
+// providers lack it (RIPEMD-160 is only in the legacy provider before 3.0.7)
+const EVP_MD* fetch_digest(const char* name, const EVP_MD* legacy) {
+    const EVP_MD* md = EVP_MD_fetch(nullptr, name, nullptr);
+    return md ? md : legacy;
+}
+
+// One-shot RIPEMD-160 through EVP; RIPEMD160() is deprecated in OpenSSL 3
+void openssl_ripemd160(const uint8_t* data, size_t len, uint8_t* out) {
+    static const EVP_MD* md = fetch_digest("RIPEMD160", EVP_ripemd160());
+    EVP_Digest(data, len, out, nullptr, md, nullptr);
+}
+
 // Hash operation wrappers using OpenSSL
 std::vector<uint8_t> op_sha1(const std::vector<uint8_t>& data) {
     std::vector<uint8_t> hash(SHA_DIGEST_LENGTH);
@@ -24,7 +47,7 @@ std::vector<uint8_t> op_hash160(const std::vector<uint8_t>& data) {
     SHA256(data.data(), data.size(), sha256_hash.data());
     
     std::vector<uint8_t> hash(RIPEMD160_DIGEST_LENGTH);
-    RIPEMD160(sha256_hash.data(), sha256_hash.size(), hash.data());
+    openssl_ripemd160(sha256_hash.data(), sha256_hash.size(), hash.data());
     return hash;
 }
 
@@ -40,19 +63,105 @@ std::vector<uint8_t> op_hash256(const std::vector<uint8_t>& data) {
 
 std::vector<uint8_t> op_ripemd160(const std::vector<uint8_t>& data) {
     std::vector<uint8_t> hash(RIPEMD160_DIGEST_LENGTH);
-    RIPEMD160(data.data(), data.size(), hash.data());
+    openssl_ripemd160(data.data(), data.size(), hash.data());
     return hash;
 }
 
-void benchmark_hash_op(bsv_bench::BenchmarkHarness& harness,
-                       std::vector<bsv_bench::BenchResult>& results,
-                       const std::string& opcode_name,
-                       std::function<std::vector<uint8_t>(const std::vector<uint8_t>&)> hash_fn) {
-    
-    std::cout << "Benchmarking " << opcode_name << "...\n";
-    
+// The same opcodes writing the digest into the caller's buffer, with no
+// heap allocation; hash160/hash256 keep the intermediate digest on the stack
+void op_sha1_into(const uint8_t* data, size_t len, uint8_t* out) {
+    SHA1(data, len, out);
+}
+
+void op_sha256_into(const uint8_t* data, size_t len, uint8_t* out) {
+    SHA256(data, len, out);
+}
+
+void op_hash160_into(const uint8_t* data, size_t len, uint8_t* out) {
+    uint8_t sha256_hash[SHA256_DIGEST_LENGTH];
+    SHA256(data, len, sha256_hash);
+    openssl_ripemd160(sha256_hash, sizeof(sha256_hash), out);
+}
+
+void op_hash256_into(const uint8_t* data, size_t len, uint8_t* out) {
+    uint8_t first_hash[SHA256_DIGEST_LENGTH];
+    SHA256(data, len, first_hash);
+    SHA256(first_hash, sizeof(first_hash), out);
+}
+
+void op_ripemd160_into(const uint8_t* data, size_t len, uint8_t* out) {
+    openssl_ripemd160(data, len, out);
+}
+
+// Streaming (init/update/final) variants, fed kStreamChunk bytes per update
+// as an item assembled piecewise would be, digest into the caller's buffer.
+// Each thread reuses one EVP_MD_CTX, as bench_sig_ops' HashWriter does, and
+// digests are fetched once: EVP_sha256() and friends make OpenSSL 3 fetch
+// the implementation again on every EVP_DigestInit_ex.
+constexpr size_t kStreamChunk = 4096;
+
+struct MdCtxFree { void operator()(EVP_MD_CTX* p) const { EVP_MD_CTX_free(p); } };
+
+void stream_digest(const EVP_MD* md, const uint8_t* data, size_t len, uint8_t* out) {
+    thread_local std::unique_ptr<EVP_MD_CTX, MdCtxFree> ctx(EVP_MD_CTX_new());
+    EVP_DigestInit_ex(ctx.get(), md, nullptr);
+    for (size_t offset = 0; offset < len; offset += kStreamChunk) {
+        EVP_DigestUpdate(ctx.get(), data + offset, std::min(kStreamChunk, len - offset));
+    }
+    EVP_DigestFinal_ex(ctx.get(), out, nullptr);
+}
+
+void op_sha1_stream(const uint8_t* data, size_t len, uint8_t* out) {
+    static const EVP_MD* md = fetch_digest("SHA1", EVP_sha1());
+    stream_digest(md, data, len, out);
+}
+
+void op_sha256_stream(const uint8_t* data, size_t len, uint8_t* out) {
+    static const EVP_MD* md = fetch_digest("SHA256", EVP_sha256());
+    stream_digest(md, data, len, out);
+}
+
+void op_hash160_stream(const uint8_t* data, size_t len, uint8_t* out) {
+    uint8_t sha256_hash[SHA256_DIGEST_LENGTH];
+    op_sha256_stream(data, len, sha256_hash);
+    static const EVP_MD* md = fetch_digest("RIPEMD160", EVP_ripemd160());
+    stream_digest(md, sha256_hash, sizeof(sha256_hash), out);
+}
+
+void op_hash256_stream(const uint8_t* data, size_t len, uint8_t* out) {
+    uint8_t first_hash[SHA256_DIGEST_LENGTH];
+    op_sha256_stream(data, len, first_hash);
+    op_sha256_stream(first_hash, sizeof(first_hash), out);
+}
+
+void op_ripemd160_stream(const uint8_t* data, size_t len, uint8_t* out) {
+    static const EVP_MD* md = fetch_digest("RIPEMD160", EVP_ripemd160());
+    stream_digest(md, data, len, out);
+}
+
+using HashFn = std::vector<uint8_t> (*)(const std::vector<uint8_t>&);
+using HashIntoFn = void (*)(const uint8_t*, size_t, uint8_t*);
+
+// Each opcode runs on three paths, named by the param_desc prefix:
+//   vector   returns a fresh std::vector (one allocation, two for
+//            hash160/hash256), as the wrappers above always did
+//   into     one-shot digest into a caller buffer, no allocation
+//   stream   init/update/final digest into a caller buffer
+// vector - into is the allocation share, which bsv_fit_model reports as
+// c_alloc so c0 is the hashing alone.
+struct HashPaths {
+    HashFn vector;
+    HashIntoFn into;
+    HashIntoFn stream;
+};
+
+const char* const kHashPaths[] = {"vector", "into", "stream"};
+
+void add_hash_cases(bsv_bench::CaseBuilder& bench,
+                    const std::string& opcode_name,
+                    HashPaths paths) {
     // Test sizes from 1 byte to 100MB (BSV can handle large data)
-    std::vector<size_t> sizes = {
+    auto sizes = bench.axis("sizes", {
         1,
         64,         // Single SHA256 block
         512,        // Multiple blocks
@@ -61,94 +170,369 @@ void benchmark_hash_op(bsv_bench::BenchmarkHarness& harness,
         1000000,    // 1MB
         10000000,   // 10MB
         100000000   // 100MB
-    };
+    });
     
     for (auto size : sizes) {
-        std::vector<uint8_t> data(size, 0x42);
-        
-        auto result = harness.benchmark(
-            opcode_name,
-            std::to_string(size) + "B",
-            size,
-            [&data, &hash_fn]() {
-                auto hash = hash_fn(data);
-                volatile size_t s = hash.size();
-                (void)s;
-            },
-            (size > 10000000) ? 50 : (size > 1000000) ? 100 : 1000,
-            (size > 10000000) ? 5 : (size > 1000000) ? 10 : 100
-        );
-        
-        results.push_back(result);
-        
-        std::cout << "  " << size << "B -> " << result.median_cycles << " cycles";
-        
-        if (size > 0) {
-            double cycles_per_byte = (double)result.median_cycles / size;
-            std::cout << " (" << cycles_per_byte << " cycles/byte)";
+        for (std::string path : kHashPaths) {
+            bench.add(
+                opcode_name,
+                path + ", " + std::to_string(size) + "B",
+                size,
+                [size, paths, path]() -> bsv_bench::BenchOperation {
+                    auto data = bsv_bench::make_buffer(size, 0x42);
+                    if (path == "vector") {
+                        return [data, paths]() {
+                            auto hash = paths.vector(*data);
+                            volatile size_t s = hash.size();
+                            (void)s;
+                        };
+                    }
+                    HashIntoFn fn = path == "into" ? paths.into : paths.stream;
+                    auto digest = std::make_shared<std::array<uint8_t, SHA256_DIGEST_LENGTH>>();
+                    return [data, digest, fn]() {
+                        fn(data->data(), data->size(), digest->data());
+                        volatile uint8_t s = (*digest)[0];
+                        (void)s;
+                    };
+                }
+            );
         }
-        std::cout << "\n";
     }
 }
 
-void analyze_hash_linearity(const std::vector<bsv_bench::BenchResult>& results,
-                            const std::string& opcode_name) {
-    std::cout << "\n=== Linear Model Analysis for " << opcode_name << " ===\n";
-    
-    // Filter results for this opcode
-    std::vector<std::pair<uint64_t, uint64_t>> points;  // (bytes, cycles)
-    for (const auto& r : results) {
-        if (r.opcode == opcode_name) {
-            points.push_back({r.input_bytes, r.median_cycles});
+BSV_BENCH_FAMILY(hash_ops, sha1) {
+    add_hash_cases(bench, "OP_SHA1", {op_sha1, op_sha1_into, op_sha1_stream});
+}
+BSV_BENCH_FAMILY(hash_ops, sha256) {
+    add_hash_cases(bench, "OP_SHA256", {op_sha256, op_sha256_into, op_sha256_stream});
+}
+BSV_BENCH_FAMILY(hash_ops, hash160) {
+    add_hash_cases(bench, "OP_HASH160", {op_hash160, op_hash160_into, op_hash160_stream});
+}
+BSV_BENCH_FAMILY(hash_ops, hash256) {
+    add_hash_cases(bench, "OP_HASH256", {op_hash256, op_hash256_into, op_hash256_stream});
+}
+BSV_BENCH_FAMILY(hash_ops, ripemd160) {
+    add_hash_cases(bench, "OP_RIPEMD160", {op_ripemd160, op_ripemd160_into, op_ripemd160_stream});
+}
+
+// In-tree SHA-256 kernels (sha256_kernels.h) against OpenSSL. SHA256_KERNEL
+// hashes one message per call with each single-message kernel;
+// SHA256_BATCH hashes <batch> equal-length messages per call, as validation
+// does with the signature preimages of a block, where the avx2 kernel runs
+// eight at once. Batch input_bytes is the total hashed, batch x length.
+// Kernels the CPU lacks are not registered, and each must match OpenSSL
+// before it is timed.
+
+enum class Sha256Impl { OPENSSL, SCALAR, SHANI, AVX2 };
+
+const char* sha256_impl_name(Sha256Impl impl) {
+    switch (impl) {
+        case Sha256Impl::OPENSSL: return "openssl";
+        case Sha256Impl::SCALAR: return bsv_bench::sha256_kernel_name(bsv_bench::Sha256Kernel::SCALAR);
+        case Sha256Impl::SHANI: return bsv_bench::sha256_kernel_name(bsv_bench::Sha256Kernel::SHANI);
+        case Sha256Impl::AVX2: return bsv_bench::sha256_kernel_name(bsv_bench::Sha256Kernel::AVX2);
+    }
+    return "?";
+}
+
+bsv_bench::Sha256Kernel sha256_impl_kernel(Sha256Impl impl) {
+    return impl == Sha256Impl::SHANI ? bsv_bench::Sha256Kernel::SHANI
+         : impl == Sha256Impl::AVX2  ? bsv_bench::Sha256Kernel::AVX2
+                                     : bsv_bench::Sha256Kernel::SCALAR;
+}
+
+std::vector<Sha256Impl> sha256_impls(bool batched) {
+    std::vector<Sha256Impl> impls = {Sha256Impl::OPENSSL, Sha256Impl::SCALAR};
+    if (bsv_bench::sha256_kernel_supported(bsv_bench::Sha256Kernel::SHANI)) {
+        impls.push_back(Sha256Impl::SHANI);
+    }
+    if (batched && bsv_bench::sha256_kernel_supported(bsv_bench::Sha256Kernel::AVX2)) {
+        impls.push_back(Sha256Impl::AVX2);
+    }
+    return impls;
+}
+
+void sha256_impl_batch(Sha256Impl impl, const uint8_t* const* messages, size_t len,
+                       size_t count, uint8_t* out) {
+    if (impl == Sha256Impl::OPENSSL) {
+        for (size_t i = 0; i < count; ++i) SHA256(messages[i], len, out + SHA256_DIGEST_LENGTH * i);
+    } else {
+        bsv_bench::sha256_batch(sha256_impl_kernel(impl), messages, len, count, out);
+    }
+}
+
+// Distinct messages, so no lane can share another's work
+struct MessageBatch {
+    std::vector<std::vector<uint8_t>> messages;
+    std::vector<const uint8_t*> pointers;
+    std::vector<uint8_t> digests;
+
+    MessageBatch(size_t count, size_t len, size_t digest_bytes)
+        : messages(count), pointers(count), digests(count * digest_bytes) {
+        uint32_t x = 0x9e3779b9u;
+        for (size_t i = 0; i < count; ++i) {
+            messages[i].resize(len);
+            for (auto& b : messages[i]) {
+                x = x * 1664525u + 1013904223u;
+                b = static_cast<uint8_t>(x >> 24);
+            }
+            pointers[i] = messages[i].data();
+        }
+    }
+};
+
+void check_batch(MessageBatch& batch, Sha256Impl impl) {
+    sha256_impl_batch(impl, batch.pointers.data(), batch.messages[0].size(), batch.messages.size(),
+                      batch.digests.data());
+    uint8_t expected[SHA256_DIGEST_LENGTH];
+    for (size_t i = 0; i < batch.messages.size(); ++i) {
+        SHA256(batch.pointers[i], batch.messages[i].size(), expected);
+        if (std::memcmp(expected, batch.digests.data() + SHA256_DIGEST_LENGTH * i, sizeof(expected)) != 0) {
+            throw std::runtime_error(std::string(sha256_impl_name(impl)) +
+                                     " SHA-256 disagrees with OpenSSL");
         }
     }
+}
+
+BSV_BENCH_FAMILY(hash_ops, sha256_kernels) {
+    auto sizes = bench.axis("sizes", {1, 64, 200, 1024, 4096, 65536, 1000000, 10000000});
     
-    if (points.size() < 2) return;
+    for (auto size : sizes) {
+        for (Sha256Impl impl : sha256_impls(false)) {
+            bench.add(
+                "SHA256_KERNEL",
+                std::string(sha256_impl_name(impl)) + ", " + std::to_string(size) + "B",
+                size,
+                [impl, size]() -> bsv_bench::BenchOperation {
+                    auto batch = std::make_shared<MessageBatch>(1, size, SHA256_DIGEST_LENGTH);
+                    check_batch(*batch, impl);
+                    return [batch, impl, size]() {
+                        sha256_impl_batch(impl, batch->pointers.data(), size, 1, batch->digests.data());
+                        volatile uint8_t s = batch->digests[0];
+                        (void)s;
+                    };
+                }
+            );
+        }
+    }
+}
+
+BSV_BENCH_FAMILY(hash_ops, sha256_batch) {
+    auto batches = bench.axis("batches", {1, 2, 4, 8, 16, 32, 64, 256, 1024});
+    auto lengths = bench.axis("lengths", {64, 200, 1000, 16384});
     
-    // Simple linear regression: cycles = c0 + c1 * bytes
-    double sum_x = 0, sum_y = 0, sum_xy = 0, sum_xx = 0;
-    int n = points.size();
+    for (auto length : lengths) {
+        for (auto count : batches) {
+            for (Sha256Impl impl : sha256_impls(true)) {
+                bench.add(
+                    "SHA256_BATCH",
+                    std::string(sha256_impl_name(impl)) + ", " + std::to_string(count) + " x " +
+                        std::to_string(length) + "B",
+                    count * length,
+                    [impl, count, length]() -> bsv_bench::BenchOperation {
+                        auto batch = std::make_shared<MessageBatch>(count, length, SHA256_DIGEST_LENGTH);
+                        check_batch(*batch, impl);
+                        return [batch, impl, count, length]() {
+                            sha256_impl_batch(impl, batch->pointers.data(), length, count,
+                                              batch->digests.data());
+                            volatile uint8_t s = batch->digests[0];
+                            (void)s;
+                        };
+                    }
+                );
+            }
+        }
+    }
+}
+
+// In-tree RIPEMD-160 kernels (ripemd160_kernels.h) against OpenSSL, whose
+// RIPEMD-160 is portable C on x86-64. RIPEMD160_KERNEL hashes one message per
+// call with the single-message implementations; RIPEMD160_BATCH hashes
+// <batch> equal-length messages per call, where the sse2 and avx2 kernels
+// run four and eight at once. 32 bytes is OP_HASH160's inner hash. As with
+// SHA-256, each kernel must match OpenSSL before it is timed.
+
+enum class Ripemd160Impl { OPENSSL, UNROLLED, SSE2, AVX2 };
+
+const char* ripemd160_impl_name(Ripemd160Impl impl) {
+    switch (impl) {
+        case Ripemd160Impl::OPENSSL: return "openssl";
+        case Ripemd160Impl::UNROLLED:
+            return bsv_bench::ripemd160_kernel_name(bsv_bench::Ripemd160Kernel::UNROLLED);
+        case Ripemd160Impl::SSE2: return bsv_bench::ripemd160_kernel_name(bsv_bench::Ripemd160Kernel::SSE2);
+        case Ripemd160Impl::AVX2: return bsv_bench::ripemd160_kernel_name(bsv_bench::Ripemd160Kernel::AVX2);
+    }
+    return "?";
+}
+
+bsv_bench::Ripemd160Kernel ripemd160_impl_kernel(Ripemd160Impl impl) {
+    return impl == Ripemd160Impl::SSE2 ? bsv_bench::Ripemd160Kernel::SSE2
+         : impl == Ripemd160Impl::AVX2 ? bsv_bench::Ripemd160Kernel::AVX2
+                                       : bsv_bench::Ripemd160Kernel::UNROLLED;
+}
+
+std::vector<Ripemd160Impl> ripemd160_impls(bool batched) {
+    std::vector<Ripemd160Impl> impls = {Ripemd160Impl::OPENSSL, Ripemd160Impl::UNROLLED};
+    if (!batched) return impls;
+    for (Ripemd160Impl impl : {Ripemd160Impl::SSE2, Ripemd160Impl::AVX2}) {
+        if (bsv_bench::ripemd160_kernel_supported(ripemd160_impl_kernel(impl))) impls.push_back(impl);
+    }
+    return impls;
+}
+
+void ripemd160_impl_batch(Ripemd160Impl impl, const uint8_t* const* messages, size_t len,
+                          size_t count, uint8_t* out) {
+    if (impl == Ripemd160Impl::OPENSSL) {
+        for (size_t i = 0; i < count; ++i) {
+            openssl_ripemd160(messages[i], len, out + RIPEMD160_DIGEST_LENGTH * i);
+        }
+    } else {
+        bsv_bench::ripemd160_batch(ripemd160_impl_kernel(impl), messages, len, count, out);
+    }
+}
+
+void check_batch(MessageBatch& batch, Ripemd160Impl impl) {
+    ripemd160_impl_batch(impl, batch.pointers.data(), batch.messages[0].size(), batch.messages.size(),
+                         batch.digests.data());
+    uint8_t expected[RIPEMD160_DIGEST_LENGTH];
+    for (size_t i = 0; i < batch.messages.size(); ++i) {
+        openssl_ripemd160(batch.pointers[i], batch.messages[i].size(), expected);
+        if (std::memcmp(expected, batch.digests.data() + RIPEMD160_DIGEST_LENGTH * i, sizeof(expected)) != 0) {
+            throw std::runtime_error(std::string(ripemd160_impl_name(impl)) +
+                                     " RIPEMD-160 disagrees with OpenSSL");
+        }
+    }
+}
+
+BSV_BENCH_FAMILY(hash_ops, ripemd160_kernels) {
+    auto sizes = bench.axis("sizes", {1, 32, 64, 200, 1024, 4096, 65536, 1000000, 10000000});
     
-    for (const auto& [x, y] : points) {
-        sum_x += x;
-        sum_y += y;
-        sum_xy += x * y;
-        sum_xx += x * x;
+    for (auto size : sizes) {
+        for (Ripemd160Impl impl : ripemd160_impls(false)) {
+            bench.add(
+                "RIPEMD160_KERNEL",
+                std::string(ripemd160_impl_name(impl)) + ", " + std::to_string(size) + "B",
+                size,
+                [impl, size]() -> bsv_bench::BenchOperation {
+                    auto batch = std::make_shared<MessageBatch>(1, size, RIPEMD160_DIGEST_LENGTH);
+                    check_batch(*batch, impl);
+                    return [batch, impl, size]() {
+                        ripemd160_impl_batch(impl, batch->pointers.data(), size, 1, batch->digests.data());
+                        volatile uint8_t s = batch->digests[0];
+                        (void)s;
+                    };
+                }
+            );
+        }
     }
+}
+
+BSV_BENCH_FAMILY(hash_ops, ripemd160_batch) {
+    auto batches = bench.axis("batches", {1, 4, 8, 16, 64, 256});
+    auto lengths = bench.axis("lengths", {32, 200, 1024, 65536});
     
-    double c1 = (n * sum_xy - sum_x * sum_y) / (n * sum_xx - sum_x * sum_x);
-    double c0 = (sum_y - c1 * sum_x) / n;
+    for (auto length : lengths) {
+        for (auto count : batches) {
+            for (Ripemd160Impl impl : ripemd160_impls(true)) {
+                bench.add(
+                    "RIPEMD160_BATCH",
+                    std::string(ripemd160_impl_name(impl)) + ", " + std::to_string(count) + " x " +
+                        std::to_string(length) + "B",
+                    count * length,
+                    [impl, count, length]() -> bsv_bench::BenchOperation {
+                        auto batch = std::make_shared<MessageBatch>(count, length, RIPEMD160_DIGEST_LENGTH);
+                        check_batch(*batch, impl);
+                        return [batch, impl, count, length]() {
+                            ripemd160_impl_batch(impl, batch->pointers.data(), length, count,
+                                                 batch->digests.data());
+                            volatile uint8_t s = batch->digests[0];
+                            (void)s;
+                        };
+                    }
+                );
+            }
+        }
+    }
+}
+
+#ifndef BSV_BENCH_UNIFIED
+// Per-message throughput at each batch size, the SHA256_BATCH table behind
+// the model's c_preimage_per_byte_batched, and the same for RIPEMD160_BATCH
+static void print_batch_throughput(const std::vector<bsv_bench::BenchResult>& results) {
+    for (const char* opcode : {"SHA256_BATCH", "RIPEMD160_BATCH"}) {
+        bool sha256 = std::string(opcode) == "SHA256_BATCH";
+        std::cout << "\n=== " << (sha256 ? "SHA-256" : "RIPEMD-160")
+                  << " cycles per message by batch size ===\n";
+        std::cout << "  Runtime dispatch selects: ";
+        if (sha256) {
+            std::cout << bsv_bench::sha256_kernel_name(bsv_bench::sha256_best_kernel()) << " (single), "
+                      << bsv_bench::sha256_kernel_name(bsv_bench::sha256_best_batch_kernel()) << " (batch)\n";
+        } else {
+            std::cout << "unrolled (single), "
+                      << bsv_bench::ripemd160_kernel_name(bsv_bench::ripemd160_best_batch_kernel())
+                      << " (batch)\n";
+        }
+        for (const auto& r : results) {
+            if (r.opcode != opcode) continue;
+            size_t comma = r.param_desc.find(", ");
+            double count = std::stod(r.param_desc.substr(comma + 2));
+            std::cout << "  " << r.param_desc << ": " << r.median_cycles / count << " cycles/message ("
+                      << r.median_cycles / r.input_bytes << " cycles/byte)\n";
+        }
+    }
+}
+
+static void analyze_hash_linearity(const std::vector<bsv_bench::BenchResult>& results,
+                                   const std::string& opcode_name) {
+    std::cout << "\n=== Linear Model Analysis for " << opcode_name << " ===\n";
     
-    std::cout << "  Model: cost(n) = " << c0 << " + " << c1 << " * n\n";
-    std::cout << "  c0 (base cost): " << c0 << " cycles\n";
-    std::cout << "  c1 (per-byte cost): " << c1 << " cycles/byte\n";
+    double vector_c0 = -1, into_c0 = -1;
+    for (std::string path : kHashPaths) {
+        // Filter results for this opcode and path
+        std::vector<bsv_bench::FitPoint> points;
+        uint64_t small_mallocs = 0;
+        for (const auto& r : results) {
+            if (r.opcode == opcode_name && r.param_desc.compare(0, path.size() + 2, path + ", ") == 0) {
+                points.push_back(bsv_bench::to_fit_point(r));
+                if (r.input_bytes <= 512) small_mallocs = std::max(small_mallocs, r.malloc_count);
+            }
+        }
+        
+        if (points.size() < 2) continue;
+        
+        // Weighted, robust, non-negative fit: cycles = c0 + c1 * bytes
+        // (same fit as bsv_fit_model, so the numbers here match the model file)
+        bsv_bench::ModelFit fit = bsv_bench::fit_model(
+            bsv_bench::ModelForm::LINEAR, points, bsv_bench::FitOptions());
+        double c0 = fit.coefficient("c0");
+        double c1 = fit.coefficient("c1");
+        if (path == "vector") vector_c0 = c0;
+        if (path == "into") into_c0 = c0;
+        
+        std::cout << "  " << path << ": cost(n) = " << c0 << " + " << c1 << " * n  (R² "
+                  << fit.diagnostics.r_squared << ", max error "
+                  << fit.diagnostics.max_rel_error * 100 << "%, " << small_mallocs
+                  << " mallocs up to 512B)\n";
+    }
     
-    // Calculate R²
-    double mean_y = sum_y / n;
-    double ss_tot = 0, ss_res = 0;
-    for (const auto& [x, y] : points) {
-        double y_pred = c0 + c1 * x;
-        ss_tot += (y - mean_y) * (y - mean_y);
-        ss_res += (y - y_pred) * (y - y_pred);
+    if (vector_c0 > 0 && into_c0 >= 0) {
+        std::cout << "  Allocation share of vector c0: " << vector_c0 - into_c0 << " cycles ("
+                  << 100 * std::max(0.0, vector_c0 - into_c0) / vector_c0 << "%)\n";
     }
-    double r_squared = 1.0 - (ss_res / ss_tot);
-    std::cout << "  R² (fit quality): " << r_squared << "\n";
 }
 
-int main(int argc, char** argv) {
+int main() {
     std::cout << "=== BSV Script Benchmark: Hash Operations ===\n";
     std::cout << "Testing linear cost model: cost(n) = c0 + c1*n\n\n";
     
     bsv_bench::BenchmarkHarness harness;
     harness.initialize(0);  // Pin to CPU 0
     
-    std::vector<bsv_bench::BenchResult> results;
-    
-    benchmark_hash_op(harness, results, "OP_SHA1", op_sha1);
-    benchmark_hash_op(harness, results, "OP_SHA256", op_sha256);
-    benchmark_hash_op(harness, results, "OP_HASH160", op_hash160);
-    benchmark_hash_op(harness, results, "OP_HASH256", op_hash256);
-    benchmark_hash_op(harness, results, "OP_RIPEMD160", op_ripemd160);
+    // Default matrix; cases sample until the median's 95% CI is within 2%
+    auto cases = bsv_bench::BenchRegistry::instance().collect(
+        bsv_bench::ParamMatrix(), bsv_bench::CaseFilter());
+    std::vector<bsv_bench::BenchResult> results = bsv_bench::run_cases(harness, cases);
     
     // Analyze linear models
     analyze_hash_linearity(results, "OP_SHA1");
@@ -156,6 +540,7 @@ int main(int argc, char** argv) {
     analyze_hash_linearity(results, "OP_HASH160");
     analyze_hash_linearity(results, "OP_HASH256");
     analyze_hash_linearity(results, "OP_RIPEMD160");
+    print_batch_throughput(results);
     
     // Export results
     std::string csv_file = "output/bench_hash_ops.csv";
@@ -170,3 +555,4 @@ int main(int argc, char** argv) {
     
     return 0;
 }
+#endif
@@ -0,0 +1,175 @@
+#include "bench_histogram.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace bsv_bench {
+
+LatencyHistogram::LatencyHistogram(int sub_bucket_bits)
+    : sub_bucket_bits_(sub_bucket_bits)
+    , sub_bucket_half_(uint64_t(1) << (sub_bucket_bits - 1))
+    , total_count_(0)
+    , min_(std::numeric_limits<uint64_t>::max())
+    , max_(0) {
+    if (sub_bucket_bits < 2 || sub_bucket_bits > 20) {
+        throw std::invalid_argument("sub_bucket_bits must be in [2, 20]");
+    }
+}
+
+uint32_t LatencyHistogram::index_for(uint64_t value) const {
+    if (value < (sub_bucket_half_ << 1)) {
+        return static_cast<uint32_t>(value);
+    }
+    int msb = 63 - __builtin_clzll(value);
+    int shift = msb - sub_bucket_bits_ + 1;
+    return static_cast<uint32_t>(shift * sub_bucket_half_ + (value >> shift));
+}
+
+uint64_t LatencyHistogram::lowest_equivalent(uint32_t index) const {
+    if (index < (sub_bucket_half_ << 1)) {
+        return index;
+    }
+    uint64_t shift = index / sub_bucket_half_ - 1;
+    uint64_t mantissa = index - shift * sub_bucket_half_;
+    return mantissa << shift;
+}
+
+uint64_t LatencyHistogram::highest_equivalent(uint32_t index) const {
+    if (index < (sub_bucket_half_ << 1)) {
+        return index;
+    }
+    uint64_t shift = index / sub_bucket_half_ - 1;
+    uint64_t mantissa = index - shift * sub_bucket_half_;
+    return ((mantissa + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t value, uint64_t count) {
+    if (count == 0) return;
+    uint32_t index = index_for(value);
+    if (index >= counts_.size()) {
+        counts_.resize(index + 1, 0);
+    }
+    counts_[index] += count;
+    total_count_ += count;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    if (other.total_count_ == 0) return;
+
+    if (other.sub_bucket_bits_ == sub_bucket_bits_) {
+        if (other.counts_.size() > counts_.size()) {
+            counts_.resize(other.counts_.size(), 0);
+        }
+        for (size_t i = 0; i < other.counts_.size(); ++i) {
+            counts_[i] += other.counts_[i];
+        }
+        total_count_ += other.total_count_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+        return;
+    }
+
+    // Different resolution: re-bin at each source bucket's midpoint
+    for (const auto& [index, count] : other.buckets()) {
+        uint64_t lo = other.lowest_equivalent(index);
+        uint64_t hi = other.highest_equivalent(index);
+        record(lo + (hi - lo) / 2, count);
+    }
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+}
+
+double LatencyHistogram::mean() const {
+    if (total_count_ == 0) return 0.0;
+    double sum = 0.0;
+    for (size_t i = 0; i < counts_.size(); ++i) {
+        if (counts_[i] == 0) continue;
+        uint32_t index = static_cast<uint32_t>(i);
+        double mid = (lowest_equivalent(index) + highest_equivalent(index)) / 2.0;
+        sum += mid * counts_[i];
+    }
+    return sum / total_count_;
+}
+
+double LatencyHistogram::stddev() const {
+    if (total_count_ == 0) return 0.0;
+    double m = mean();
+    double variance = 0.0;
+    for (size_t i = 0; i < counts_.size(); ++i) {
+        if (counts_[i] == 0) continue;
+        uint32_t index = static_cast<uint32_t>(i);
+        double mid = (lowest_equivalent(index) + highest_equivalent(index)) / 2.0;
+        variance += (mid - m) * (mid - m) * counts_[i];
+    }
+    return std::sqrt(variance / total_count_);
+}
+
+uint64_t LatencyHistogram::value_at_percentile(double percentile) const {
+    if (total_count_ == 0) return 0;
+    percentile = std::min(std::max(percentile, 0.0), 100.0);
+
+    uint64_t target = static_cast<uint64_t>(std::ceil(percentile / 100.0 * total_count_));
+    target = std::max<uint64_t>(target, 1);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts_.size(); ++i) {
+        seen += counts_[i];
+        if (seen >= target) {
+            return std::min(highest_equivalent(static_cast<uint32_t>(i)), max_);
+        }
+    }
+    return max_;
+}
+
+std::vector<std::pair<uint32_t, uint64_t>> LatencyHistogram::buckets() const {
+    std::vector<std::pair<uint32_t, uint64_t>> out;
+    for (size_t i = 0; i < counts_.size(); ++i) {
+        if (counts_[i] != 0) {
+            out.emplace_back(static_cast<uint32_t>(i), counts_[i]);
+        }
+    }
+    return out;
+}
+
+LatencyHistogram LatencyHistogram::from_buckets(
+    int sub_bucket_bits,
+    const std::vector<std::pair<uint32_t, uint64_t>>& buckets,
+    uint64_t min_value,
+    uint64_t max_value
+) {
+    LatencyHistogram h(sub_bucket_bits);
+    for (const auto& [index, count] : buckets) {
+        h.record(h.lowest_equivalent(index), count);
+    }
+    if (h.total_count_ > 0) {
+        h.min_ = min_value;
+        h.max_ = max_value;
+    }
+    return h;
+}
+
+std::string LatencyHistogram::to_json() const {
+    std::ostringstream out;
+    out << "{\"sub_bucket_bits\":" << sub_bucket_bits_
+        << ",\"min\":" << min()
+        << ",\"max\":" << max()
+        << ",\"count\":" << total_count_
+        << ",\"buckets\":[";
+
+    uint32_t prev = 0;
+    bool first = true;
+    for (const auto& [index, count] : buckets()) {
+        if (!first) out << ",";
+        out << (index - prev) << "," << count;
+        prev = index;
+        first = false;
+    }
+    out << "]}";
+    return out.str();
+}
+
+} // namespace bsv_bench
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bsv_bench {
+
+// HDR-style log-bucketed latency histogram.
+//
+// Values below 2^sub_bucket_bits are recorded exactly. Above that, each
+// power-of-two range is split into 2^(sub_bucket_bits-1) linear sub-buckets,
+// so the relative error of any reported value is below 2^-(sub_bucket_bits-1)
+// (under 1.6% with the default of 7 bits). Bucket layout depends only on
+// sub_bucket_bits, so histograms from different runs and machines can be
+// merged bucket-for-bucket.
+class LatencyHistogram {
+public:
+    LatencyHistogram() : LatencyHistogram(7) {}
+    explicit LatencyHistogram(int sub_bucket_bits);
+
+    void record(uint64_t value, uint64_t count = 1);
+
+    // Add all counts from other (re-bins if the resolution differs)
+    void merge(const LatencyHistogram& other);
+
+    uint64_t total_count() const { return total_count_; }
+    uint64_t min() const { return total_count_ ? min_ : 0; }
+    uint64_t max() const { return max_; }
+    double mean() const;
+    double stddev() const;
+
+    // Highest value equivalent to the sample at the given percentile (0-100)
+    uint64_t value_at_percentile(double percentile) const;
+
+    int sub_bucket_bits() const { return sub_bucket_bits_; }
+
+    // Non-empty buckets as (index, count) pairs, in ascending index order
+    std::vector<std::pair<uint32_t, uint64_t>> buckets() const;
+
+    // Rebuild from buckets() output (used when reading exported JSON)
+    static LatencyHistogram from_buckets(
+        int sub_bucket_bits,
+        const std::vector<std::pair<uint32_t, uint64_t>>& buckets,
+        uint64_t min_value,
+        uint64_t max_value
+    );
+
+    // Compact JSON object: delta-encoded sparse buckets
+    //   {"sub_bucket_bits":7,"min":..,"max":..,"count":..,"buckets":[d0,c0,d1,c1,...]}
+    // where d is the bucket index delta from the previous non-empty bucket.
+    std::string to_json() const;
+
+    // Bucket geometry
+    uint32_t index_for(uint64_t value) const;
+    uint64_t lowest_equivalent(uint32_t index) const;
+    uint64_t highest_equivalent(uint32_t index) const;
+
+private:
+    int sub_bucket_bits_;
+    uint64_t sub_bucket_half_;
+    std::vector<uint64_t> counts_;
+    uint64_t total_count_;
+    uint64_t min_;
+    uint64_t max_;
+};
+
+} // namespace bsv_bench
@@ -0,0 +1,216 @@
+#include "bench_registry.h"
+#include "bench_sysinfo.h"
+#include <algorithm>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <stdexcept>
+
+namespace bsv_bench {
+
+const std::vector<uint64_t>* ParamMatrix::find(const std::string& family,
+                                               const std::string& axis) const {
+    auto it = axes_.find(family + "." + axis);
+    if (it != axes_.end()) return &it->second;
+    it = axes_.find(axis);
+    if (it != axes_.end()) return &it->second;
+    return nullptr;
+}
+
+// Buffers handed out by make_buffer() while a case's setup() runs
+static thread_local std::vector<MemoryRegion>* recorded_regions = nullptr;
+
+std::shared_ptr<std::vector<uint8_t>> make_buffer(size_t size, uint8_t fill) {
+    auto buffer = std::make_shared<std::vector<uint8_t>>(size, fill);
+    if (recorded_regions != nullptr && size > 0) {
+        recorded_regions->push_back({buffer->data(), buffer->size()});
+    }
+    return buffer;
+}
+
+// Run setup() while recording the input buffers it creates
+static BenchOperation setup_recorded(const BenchCase& c, std::vector<MemoryRegion>& regions) {
+    recorded_regions = &regions;
+    try {
+        BenchOperation operation = c.setup();
+        recorded_regions = nullptr;
+        return operation;
+    } catch (...) {
+        recorded_regions = nullptr;
+        throw;
+    }
+}
+
+std::string case_id(const BenchCase& c) {
+    std::string id = c.suite + "/" + c.family + "/" + c.opcode + "/" + c.param_desc;
+    if (c.cache_mode != CacheMode::WARM) {
+        id += std::string("/") + cache_mode_name(c.cache_mode);
+    }
+    return id;
+}
+
+void CaseFilter::set_regex(const std::string& pattern) {
+    std::shared_ptr<const std::regex> compiled;
+    if (!pattern.empty()) {
+        try {
+            compiled = std::make_shared<const std::regex>(pattern);
+        } catch (const std::regex_error& e) {
+            throw std::runtime_error("invalid filter regex '" + pattern + "': " + e.what());
+        }
+    }
+    regex_ = pattern;
+    compiled_ = compiled;
+}
+
+bool CaseFilter::matches(const BenchCase& c) const {
+    if (!suite.empty() && c.suite != suite) return false;
+    if (!families.empty() &&
+        std::find(families.begin(), families.end(), c.family) == families.end()) {
+        return false;
+    }
+    if (!opcodes.empty() &&
+        std::find(opcodes.begin(), opcodes.end(), c.opcode) == opcodes.end()) {
+        return false;
+    }
+    if (c.input_bytes < min_bytes || c.input_bytes > max_bytes) return false;
+    if (compiled_ && !std::regex_search(case_id(c), *compiled_)) {
+        return false;
+    }
+    return true;
+}
+
+std::vector<uint64_t> CaseBuilder::axis(const std::string& name,
+                                        const std::vector<uint64_t>& defaults) const {
+    const std::vector<uint64_t>* values = params_.find(family_, name);
+    return values ? *values : defaults;
+}
+
+void CaseBuilder::add(const std::string& opcode,
+                      const std::string& param_desc,
+                      uint64_t input_bytes,
+                      std::function<BenchOperation()> setup) {
+    BenchCase c;
+    c.suite = suite_;
+    c.family = family_;
+    c.opcode = opcode;
+    c.param_desc = param_desc;
+    c.input_bytes = input_bytes;
+    c.policy = params_.override_policy ? params_.policy : policy;
+    c.exclusive = exclusive;
+    c.setup = std::move(setup);
+    
+    for (CacheMode mode : params_.cache_modes) {
+        c.cache_mode = mode;
+        out_.push_back(c);
+    }
+}
+
+BenchRegistry& BenchRegistry::instance() {
+    static BenchRegistry registry;
+    return registry;
+}
+
+std::vector<BenchCase> BenchRegistry::collect(const ParamMatrix& params,
+                                              const CaseFilter& filter) const {
+    std::vector<BenchCase> selected;
+    for (const auto& family : families_) {
+        if (!filter.suite.empty() && family.suite != filter.suite) continue;
+
+        std::vector<BenchCase> cases;
+        CaseBuilder builder(family.suite, family.name, params, cases);
+        family.fn(builder);
+
+        for (auto& c : cases) {
+            if (filter.matches(c)) selected.push_back(std::move(c));
+        }
+    }
+    return selected;
+}
+
+// Upper bound on ROTATING pool instances, to bound setup time and memory
+static const size_t kMaxRotationPool = 65536;
+
+BenchResult run_case(BenchmarkHarness& harness, const BenchCase& c) {
+    std::vector<MemoryRegion> regions;
+    BenchOperation operation = setup_recorded(c, regions);
+    
+    size_t footprint = 0;
+    for (const auto& r : regions) footprint += r.size;
+    
+    // A case whose inputs weren't made with make_buffer has no footprint to
+    // size a pool by, so nothing would rotate: it runs and is recorded warm
+    CacheMode mode = c.cache_mode;
+    if (mode == CacheMode::ROTATING && footprint == 0) mode = CacheMode::WARM;
+    
+    if (mode == CacheMode::ROTATING) {
+        // Build enough independent instances that one full cycle through
+        // them touches 1.5x the LLC, so each instance is cold when reused
+        size_t target = llc_size_bytes() + llc_size_bytes() / 2;
+        size_t pool_size = (target + footprint - 1) / footprint;
+        pool_size = std::min(std::max<size_t>(pool_size, 1), kMaxRotationPool);
+        
+        auto pool = std::make_shared<std::vector<BenchOperation>>();
+        pool->reserve(pool_size);
+        pool->push_back(std::move(operation));
+        while (pool->size() < pool_size) {
+            std::vector<MemoryRegion> ignored;
+            pool->push_back(setup_recorded(c, ignored));
+        }
+        
+        size_t next = 0;
+        operation = [pool, next]() mutable {
+            (*pool)[next]();
+            if (++next == pool->size()) next = 0;
+        };
+    }
+    
+    harness.set_cache_mode(mode, regions);
+
+    if (c.policy.mode == IterationPolicy::Mode::FIXED) {
+        return harness.benchmark(c.opcode, c.param_desc, c.input_bytes, operation,
+                                 c.policy.iterations, c.policy.warmup_iterations);
+    }
+    return harness.benchmark_adaptive(c.opcode, c.param_desc, c.input_bytes,
+                                      operation, c.policy.adaptive);
+}
+
+std::vector<BenchResult> run_cases(BenchmarkHarness& harness,
+                                   const std::vector<BenchCase>& cases) {
+    std::vector<BenchResult> results;
+    results.reserve(cases.size());
+
+    std::string current_family;
+    for (const auto& c : cases) {
+        if (c.family != current_family) {
+            std::cout << "Benchmarking " << c.family << "...\n";
+            current_family = c.family;
+        }
+
+        BenchResult result = run_case(harness, c);
+        results.push_back(result);
+        std::cout << "  " << format_result_line(c, result) << "\n";
+    }
+    return results;
+}
+
+std::string format_result_line(const BenchCase& c, const BenchResult& result) {
+    std::ostringstream line;
+    line << c.opcode << " " << c.param_desc;
+    if (result.cache_mode != cache_mode_name(CacheMode::WARM)) {
+        line << " [" << result.cache_mode << "]";
+    }
+    line << " -> " << result.median_cycles << " cycles";
+    if (c.input_bytes > 0) {
+        line << " (" << (double)result.median_cycles / c.input_bytes << " cycles/byte)";
+    }
+    line << " [CI " << result.ci_low_cycles << "-" << result.ci_high_cycles
+         << ", n=" << result.sample_count << "]";
+    if (result.malloc_count > 0 || result.copied_bytes > 0 || result.page_faults > 0) {
+        line << " [" << result.malloc_count << " allocs, " << result.alloc_bytes
+             << "B allocated, " << result.copied_bytes << "B copied, "
+             << result.page_faults << " faults]";
+    }
+    return line.str();
+}
+
+} // namespace bsv_bench
@@ -0,0 +1,186 @@
+#pragma once
+
+#include "bench_harness.h"
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace bsv_bench {
+
+// How many samples to take for a benchmark case
+struct IterationPolicy {
+    enum class Mode {
+        FIXED,      // Exactly `iterations` samples after `warmup_iterations`
+        ADAPTIVE    // Sample until converged (see AdaptivePolicy)
+    } mode = Mode::ADAPTIVE;
+
+    int iterations = 1000;
+    int warmup_iterations = 100;
+    AdaptivePolicy adaptive;
+
+    static IterationPolicy fixed(int iterations, int warmup_iterations) {
+        IterationPolicy p;
+        p.mode = Mode::FIXED;
+        p.iterations = iterations;
+        p.warmup_iterations = warmup_iterations;
+        return p;
+    }
+};
+
+// Operation to time, produced by a case's setup function. It owns its inputs.
+using BenchOperation = std::function<void()>;
+
+// A single benchmark case. setup() builds the inputs and returns the timed
+// operation, so inputs only exist while their case runs.
+struct BenchCase {
+    std::string suite;
+    std::string family;
+    std::string opcode;
+    std::string param_desc;
+    uint64_t input_bytes;
+    IterationPolicy policy;
+    CacheMode cache_mode = CacheMode::WARM;
+    // The case pins threads of its own to other CPUs, so the parallel
+    // scheduler runs it alone once its workers have finished
+    bool exclusive = false;
+    std::function<BenchOperation()> setup;
+};
+
+// Allocate an input buffer for a case. Buffers made with this during setup()
+// are what COLD mode flushes and what ROTATING mode sizes its pool by, so
+// families should create their data-dependent inputs through it.
+std::shared_ptr<std::vector<uint8_t>> make_buffer(size_t size, uint8_t fill);
+
+// Named parameter axes (sizes, depths, ...) overriding family defaults.
+// Axes are looked up as "<family>.<axis>" first, then as "<axis>".
+class ParamMatrix {
+public:
+    void set(const std::string& axis, const std::vector<uint64_t>& values) {
+        axes_[axis] = values;
+    }
+
+    const std::vector<uint64_t>* find(const std::string& family,
+                                      const std::string& axis) const;
+
+    const std::map<std::string, std::vector<uint64_t>>& axes() const { return axes_; }
+
+    // When set, replaces every case's own iteration policy
+    bool override_policy = false;
+    IterationPolicy policy;
+    
+    // Each case is run once per cache mode listed here
+    std::vector<CacheMode> cache_modes = {CacheMode::WARM};
+
+private:
+    std::map<std::string, std::vector<uint64_t>> axes_;
+};
+
+// Selects which cases run
+struct CaseFilter {
+    std::string suite;                  // Empty = all suites
+    std::vector<std::string> families;  // Empty = all families
+    std::vector<std::string> opcodes;   // Empty = all opcodes
+    uint64_t min_bytes = 0;
+    uint64_t max_bytes = UINT64_MAX;
+
+    // Pattern matched against case_id(), compiled once here. Throws
+    // std::runtime_error if it isn't a valid regex.
+    void set_regex(const std::string& pattern);
+    const std::string& regex() const { return regex_; }
+
+    bool matches(const BenchCase& c) const;
+
+private:
+    std::string regex_;
+    std::shared_ptr<const std::regex> compiled_;  // Null when regex_ is empty
+};
+
+// "suite/family/opcode/param_desc[/cache_mode]" (mode omitted when warm)
+std::string case_id(const BenchCase& c);
+
+// Handed to a family function to declare its cases
+class CaseBuilder {
+public:
+    CaseBuilder(const std::string& suite, const std::string& family,
+                const ParamMatrix& params, std::vector<BenchCase>& out)
+        : suite_(suite), family_(family), params_(params), out_(out) {}
+
+    // Values for a parameter axis, or defaults if the matrix doesn't set it
+    std::vector<uint64_t> axis(const std::string& name,
+                               const std::vector<uint64_t>& defaults) const;
+
+    void add(const std::string& opcode,
+             const std::string& param_desc,
+             uint64_t input_bytes,
+             std::function<BenchOperation()> setup);
+
+    // Iteration policy for cases added after this is set
+    IterationPolicy policy;
+
+    // Marks cases added after this is set as exclusive (see BenchCase)
+    bool exclusive = false;
+
+private:
+    std::string suite_;
+    std::string family_;
+    const ParamMatrix& params_;
+    std::vector<BenchCase>& out_;
+};
+
+using FamilyFn = void (*)(CaseBuilder&);
+
+struct FamilyInfo {
+    std::string suite;
+    std::string name;
+    FamilyFn fn;
+};
+
+// Global list of benchmark families, filled by BSV_BENCH_FAMILY at static
+// initialization time
+class BenchRegistry {
+public:
+    static BenchRegistry& instance();
+
+    void add(const FamilyInfo& family) { families_.push_back(family); }
+    const std::vector<FamilyInfo>& families() const { return families_; }
+
+    // Expand every registered family over params and keep matching cases
+    std::vector<BenchCase> collect(const ParamMatrix& params,
+                                   const CaseFilter& filter) const;
+
+private:
+    std::vector<FamilyInfo> families_;
+};
+
+struct FamilyRegistrar {
+    FamilyRegistrar(const char* suite, const char* name, FamilyFn fn) {
+        BenchRegistry::instance().add({suite, name, fn});
+    }
+};
+
+// Run cases serially on one harness, printing a line per case
+std::vector<BenchResult> run_cases(BenchmarkHarness& harness,
+                                   const std::vector<BenchCase>& cases);
+
+// Run a single case according to its iteration policy and cache mode
+BenchResult run_case(BenchmarkHarness& harness, const BenchCase& c);
+
+// One-line console summary of a case's result
+std::string format_result_line(const BenchCase& c, const BenchResult& result);
+
+} // namespace bsv_bench
+
+// Register a benchmark family:
+//
+//   BSV_BENCH_FAMILY(byte_ops, op_cat) {
+//       for (auto n : bench.axis("sizes", {10, 100})) bench.add(...);
+//   }
+#define BSV_BENCH_FAMILY(suite, name)                                          \
+    static void bsv_bench_family_##name(::bsv_bench::CaseBuilder& bench);      \
+    static ::bsv_bench::FamilyRegistrar bsv_bench_registrar_##name(            \
+        #suite, #name, &bsv_bench_family_##name);                              \
+    static void bsv_bench_family_##name(::bsv_bench::CaseBuilder& bench)
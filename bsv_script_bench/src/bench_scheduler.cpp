@@ -0,0 +1,159 @@
+#include "bench_scheduler.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace bsv_bench {
+
+std::vector<BenchResult> run_cases_parallel(
+    const std::vector<BenchCase>& cases,
+    const SchedulerOptions& options,
+    std::vector<InterferenceCheck>* checks
+) {
+    if (options.cpus.empty()) {
+        throw std::invalid_argument("run_cases_parallel: no CPUs configured");
+    }
+
+    // Largest cases first so the long 10-100MB points don't end up as a
+    // single straggler after every other worker has finished
+    std::vector<size_t> order;
+    std::vector<size_t> exclusive;
+    for (size_t i = 0; i < cases.size(); ++i) {
+        (cases[i].exclusive ? exclusive : order).push_back(i);
+    }
+    std::stable_sort(order.begin(), order.end(), [&cases](size_t a, size_t b) {
+        return cases[a].input_bytes > cases[b].input_bytes;
+    });
+
+    std::vector<BenchResult> results(cases.size());
+    std::atomic<size_t> next{0};
+    std::mutex print_mutex;
+
+    auto worker = [&](int cpu) {
+        BenchmarkHarness harness;
+        harness.initialize(cpu);
+
+        for (size_t i = next++; i < order.size(); i = next++) {
+            const BenchCase& c = cases[order[i]];
+            results[order[i]] = run_case(harness, c);
+
+            std::lock_guard<std::mutex> lock(print_mutex);
+            std::cout << "  [cpu " << cpu << "] "
+                      << format_result_line(c, results[order[i]]) << "\n";
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int cpu : options.cpus) {
+        workers.emplace_back(worker, cpu);
+    }
+    for (auto& t : workers) {
+        t.join();
+    }
+
+    // Cases that spread over CPUs themselves would collide with the workers
+    if (!exclusive.empty()) {
+        std::cout << "\nRunning " << exclusive.size() << " exclusive cases alone on cpu "
+                  << options.cpus.front() << "...\n";
+        BenchmarkHarness harness;
+        harness.initialize(options.cpus.front());
+        for (size_t index : exclusive) {
+            results[index] = run_case(harness, cases[index]);
+            std::cout << "  [cpu " << options.cpus.front() << "] "
+                      << format_result_line(cases[index], results[index]) << "\n";
+        }
+    }
+
+    if (checks == nullptr || options.interference_fraction <= 0.0 || cases.empty()) {
+        return results;
+    }
+
+    // Re-run an evenly spaced sample serially, with every other core idle
+    size_t sample_count = std::max<size_t>(
+        1, static_cast<size_t>(std::ceil(cases.size() * options.interference_fraction)));
+    sample_count = std::min(sample_count, cases.size());
+    double stride = static_cast<double>(cases.size()) / sample_count;
+
+    std::cout << "\nInterference check: re-running " << sample_count
+              << " cases serially on cpu " << options.cpus.front() << "...\n";
+
+    BenchmarkHarness harness;
+    harness.initialize(options.cpus.front());
+
+    for (size_t k = 0; k < sample_count; ++k) {
+        size_t index = static_cast<size_t>(k * stride);
+        BenchResult serial = run_case(harness, cases[index]);
+        const BenchResult& parallel = results[index];
+
+        InterferenceCheck check;
+        check.case_index = index;
+        check.parallel_median = parallel.median_cycles;
+        check.serial_median = serial.median_cycles;
+        check.rel_diff = serial.median_cycles > 0
+            ? ((double)parallel.median_cycles - serial.median_cycles) / serial.median_cycles
+            : 0.0;
+        check.flagged = std::fabs(check.rel_diff) > options.interference_threshold &&
+                        (parallel.median_cycles < serial.ci_low_cycles ||
+                         parallel.median_cycles > serial.ci_high_cycles);
+        checks->push_back(check);
+
+        std::cout << "  " << case_id(cases[index]) << ": parallel "
+                  << check.parallel_median << " vs serial " << check.serial_median
+                  << " (" << (check.rel_diff * 100.0) << "%)"
+                  << (check.flagged ? "  <-- INTERFERENCE" : "") << "\n";
+    }
+
+    return results;
+}
+
+std::vector<int> parse_cpu_list(const std::string& spec) {
+    std::string list = spec;
+    if (spec == "isolated") {
+        std::ifstream file("/sys/devices/system/cpu/isolated");
+        std::getline(file, list);
+        if (list.empty()) {
+            throw std::runtime_error("No isolated CPUs (boot with isolcpus=...)");
+        }
+    }
+
+    std::vector<int> cpus;
+    std::stringstream ss(list);
+    std::string part;
+    while (std::getline(ss, part, ',')) {
+        if (part.empty()) continue;
+        auto dash = part.find('-');
+        if (dash == std::string::npos) {
+            cpus.push_back(std::stoi(part));
+        } else {
+            int first = std::stoi(part.substr(0, dash));
+            int last = std::stoi(part.substr(dash + 1));
+            for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+std::string interference_to_json(const std::vector<BenchCase>& cases,
+                                 const std::vector<InterferenceCheck>& checks) {
+    std::ostringstream out;
+    out << "{\n  \"checks\": [\n";
+    for (size_t i = 0; i < checks.size(); ++i) {
+        const auto& c = checks[i];
+        out << "    {\"case\": \"" << case_id(cases[c.case_index]) << "\", "
+            << "\"parallel_median\": " << c.parallel_median << ", "
+            << "\"serial_median\": " << c.serial_median << ", "
+            << "\"rel_diff\": " << c.rel_diff << ", "
+            << "\"flagged\": " << (c.flagged ? "true" : "false") << "}"
+            << (i + 1 < checks.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+    return out.str();
+}
+
+} // namespace bsv_bench
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "bench_registry.h"
+#include <string>
+#include <vector>
+
+namespace bsv_bench {
+
+// Parallel calibration settings
+struct SchedulerOptions {
+    // One pinned worker thread per CPU; these should be isolated cores
+    // (isolcpus=...) so workers don't share them with the OS or each other
+    std::vector<int> cpus;
+
+    // Fraction of cases (0-1) re-run serially afterwards to check that
+    // parallel execution didn't distort results via shared LLC/memory
+    // bandwidth. 0 disables the check.
+    double interference_fraction = 0.0;
+
+    // Relative median difference above which a re-run is flagged
+    double interference_threshold = 0.05;
+};
+
+// Parallel vs serial measurement of one case
+struct InterferenceCheck {
+    size_t case_index;
+    uint64_t parallel_median;
+    uint64_t serial_median;
+    double rel_diff;        // (parallel - serial) / serial
+    bool flagged;           // Beyond threshold and outside the serial CI
+};
+
+// Run independent cases across options.cpus, largest cases first, then the
+// exclusive ones one at a time on the first CPU. Results are returned in case
+// order. If an interference check is requested, the sampled cases are re-run
+// serially on the first CPU and compared.
+std::vector<BenchResult> run_cases_parallel(
+    const std::vector<BenchCase>& cases,
+    const SchedulerOptions& options,
+    std::vector<InterferenceCheck>* checks = nullptr
+);
+
+// Parse a CPU list such as "2-5,8" or "isolated" (reads
+// /sys/devices/system/cpu/isolated)
+std::vector<int> parse_cpu_list(const std::string& spec);
+
+// JSON array describing interference check results
+std::string interference_to_json(const std::vector<BenchCase>& cases,
+                                 const std::vector<InterferenceCheck>& checks);
+
+} // namespace bsv_bench
@@ -1,11 +1,1035 @@
-// Placeholder stubs for remaining benchmark files
-// These will be implemented after integrating with actual BSV signature verification
-
 #include "bench_harness.h"
+#include "bench_registry.h"
+#include "bench_sysinfo.h"
+#include "model_fit.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#include <openssl/obj_mac.h>
+#include <openssl/sha.h>
+
+// OP_CHECKSIG / OP_CHECKMULTISIG on secp256k1 using OpenSSL's EC arithmetic.
+// A check runs the same steps as the node: build the BIP143 (FORKID)
+// signature hash, parse the public key, parse the DER signature, enforce
+// low-S, then verify. Verification is done with EC_POINT_mul directly (the
+// same dual scalar multiplication ECDSA_do_verify uses), which avoids the
+// deprecated EC_KEY API and per-call key object setup.
+
+namespace {
+
+constexpr uint32_t kSighashAllForkId = 0x41;  // SIGHASH_ALL | SIGHASH_FORKID
+
+struct BnFree { void operator()(BIGNUM* p) const { BN_free(p); } };
+struct BnCtxFree { void operator()(BN_CTX* p) const { BN_CTX_free(p); } };
+struct PointFree { void operator()(EC_POINT* p) const { EC_POINT_free(p); } };
+struct SigFree { void operator()(ECDSA_SIG* p) const { ECDSA_SIG_free(p); } };
+struct MdCtxFree { void operator()(EVP_MD_CTX* p) const { EVP_MD_CTX_free(p); } };
+
+using Bn = std::unique_ptr<BIGNUM, BnFree>;
+using BnCtx = std::unique_ptr<BN_CTX, BnCtxFree>;
+using Point = std::unique_ptr<EC_POINT, PointFree>;
+using Sig = std::unique_ptr<ECDSA_SIG, SigFree>;
+using MdCtx = std::unique_ptr<EVP_MD_CTX, MdCtxFree>;
+
+// Curve constants shared by all cases (read-only after construction)
+struct Curve {
+    EC_GROUP* group;
+    Bn order;
+    Bn half_order;
+
+    Curve() : group(EC_GROUP_new_by_curve_name(NID_secp256k1)), order(BN_new()), half_order(BN_new()) {
+        if (group == nullptr) {
+            throw std::runtime_error("OpenSSL has no secp256k1 support");
+        }
+        EC_GROUP_get_order(group, order.get(), nullptr);
+        BN_rshift1(half_order.get(), order.get());
+    }
+};
+
+const Curve& secp256k1() {
+    static const Curve curve;
+    return curve;
+}
+
+// ---------------------------------------------------------------------------
+// Keys and signatures (setup only, never timed)
+
+struct KeyPair {
+    std::shared_ptr<BIGNUM> secret;
+    std::vector<uint8_t> compressed;     // 33 bytes
+    std::vector<uint8_t> uncompressed;   // 65 bytes
+};
+
+KeyPair make_key() {
+    const Curve& curve = secp256k1();
+    BnCtx ctx(BN_CTX_new());
+    KeyPair key;
+    key.secret.reset(BN_new(), BN_free);
+    do {
+        BN_rand_range(key.secret.get(), curve.order.get());
+    } while (BN_is_zero(key.secret.get()));
+
+    Point pub(EC_POINT_new(curve.group));
+    EC_POINT_mul(curve.group, pub.get(), key.secret.get(), nullptr, nullptr, ctx.get());
+    key.compressed.resize(33);
+    key.uncompressed.resize(65);
+    EC_POINT_point2oct(curve.group, pub.get(), POINT_CONVERSION_COMPRESSED,
+                       key.compressed.data(), key.compressed.size(), ctx.get());
+    EC_POINT_point2oct(curve.group, pub.get(), POINT_CONVERSION_UNCOMPRESSED,
+                       key.uncompressed.data(), key.uncompressed.size(), ctx.get());
+    return key;
+}
+
+// DER signature followed by the sighash type byte, as it appears in a script.
+// low_s = false produces the high-S twin, which consensus rejects.
+std::vector<uint8_t> sign(const KeyPair& key, const uint8_t digest[32], bool low_s = true) {
+    const Curve& curve = secp256k1();
+    BnCtx ctx(BN_CTX_new());
+    Bn k(BN_new()), k_inv(BN_new()), x(BN_new()), e(BN_new());
+    Bn r(BN_new()), s(BN_new());
+    Point point(EC_POINT_new(curve.group));
+
+    do {
+        do {
+            BN_rand_range(k.get(), curve.order.get());
+        } while (BN_is_zero(k.get()));
+        EC_POINT_mul(curve.group, point.get(), k.get(), nullptr, nullptr, ctx.get());
+        EC_POINT_get_affine_coordinates(curve.group, point.get(), x.get(), nullptr, ctx.get());
+        BN_nnmod(r.get(), x.get(), curve.order.get(), ctx.get());
+    } while (BN_is_zero(r.get()));
+
+    // s = k^-1 (e + r*d) mod n
+    BN_bin2bn(digest, 32, e.get());
+    BN_mod_inverse(k_inv.get(), k.get(), curve.order.get(), ctx.get());
+    BN_mod_mul(s.get(), r.get(), key.secret.get(), curve.order.get(), ctx.get());
+    BN_mod_add(s.get(), s.get(), e.get(), curve.order.get(), ctx.get());
+    BN_mod_mul(s.get(), s.get(), k_inv.get(), curve.order.get(), ctx.get());
+
+    bool is_high = BN_cmp(s.get(), curve.half_order.get()) > 0;
+    if (is_high == low_s) {
+        BN_sub(s.get(), curve.order.get(), s.get());
+    }
+
+    ECDSA_SIG* sig = ECDSA_SIG_new();
+    ECDSA_SIG_set0(sig, r.release(), s.release());
+    Sig owned(sig);
+    int length = i2d_ECDSA_SIG(sig, nullptr);
+    std::vector<uint8_t> der(length);
+    uint8_t* out = der.data();
+    i2d_ECDSA_SIG(sig, &out);
+    der.push_back(static_cast<uint8_t>(kSighashAllForkId));
+    return der;
+}
+
+// ---------------------------------------------------------------------------
+// Verification (timed)
+
+// Scratch values for one thread of verification, allocated once per case so
+// the timed path measures the arithmetic rather than BIGNUM allocation
+class Verifier {
+public:
+    Verifier()
+        : ctx_(BN_CTX_new()),
+          e_(BN_new()), w_(BN_new()), u1_(BN_new()), u2_(BN_new()), x_(BN_new()),
+          pubkey_(EC_POINT_new(secp256k1().group)),
+          point_(EC_POINT_new(secp256k1().group)) {}
+
+    // Decode a 33- or 65-byte public key into the pubkey slot
+    bool parse_pubkey(const std::vector<uint8_t>& pubkey) {
+        return EC_POINT_oct2point(secp256k1().group, pubkey_.get(),
+                                  pubkey.data(), pubkey.size(), ctx_.get()) == 1;
+    }
+
+    // Strict DER parse of a script signature (sighash type byte excluded)
+    static Sig parse_der(const std::vector<uint8_t>& sig) {
+        if (sig.empty()) return Sig();
+        const uint8_t* p = sig.data();
+        long length = static_cast<long>(sig.size() - 1);
+        Sig parsed(d2i_ECDSA_SIG(nullptr, &p, length));
+        if (parsed && p != sig.data() + length) parsed.reset();  // trailing garbage
+        return parsed;
+    }
+
+    static bool is_low_s(const ECDSA_SIG* sig) {
+        return BN_cmp(ECDSA_SIG_get0_s(sig), secp256k1().half_order.get()) <= 0;
+    }
+
+    // ECDSA verify against the parsed pubkey: x(u1*G + u2*Q) == r with
+    // u1 = e/s, u2 = r/s (mod n)
+    bool verify_parsed(const ECDSA_SIG* sig, const uint8_t digest[32]) {
+        const Curve& curve = secp256k1();
+        const BIGNUM* r = ECDSA_SIG_get0_r(sig);
+        const BIGNUM* s = ECDSA_SIG_get0_s(sig);
+        if (BN_is_zero(r) || BN_is_negative(r) || BN_cmp(r, curve.order.get()) >= 0 ||
+            BN_is_zero(s) || BN_is_negative(s) || BN_cmp(s, curve.order.get()) >= 0) {
+            return false;
+        }
+
+        BN_bin2bn(digest, 32, e_.get());
+        if (BN_mod_inverse(w_.get(), s, curve.order.get(), ctx_.get()) == nullptr) return false;
+        BN_mod_mul(u1_.get(), e_.get(), w_.get(), curve.order.get(), ctx_.get());
+        BN_mod_mul(u2_.get(), r, w_.get(), curve.order.get(), ctx_.get());
+        if (!EC_POINT_mul(curve.group, point_.get(), u1_.get(), pubkey_.get(), u2_.get(), ctx_.get()) ||
+            EC_POINT_is_at_infinity(curve.group, point_.get())) {
+            return false;
+        }
+        EC_POINT_get_affine_coordinates(curve.group, point_.get(), x_.get(), nullptr, ctx_.get());
+        BN_nnmod(x_.get(), x_.get(), curve.order.get(), ctx_.get());
+        return BN_cmp(x_.get(), r) == 0;
+    }
+
+    // Everything OP_CHECKSIG does after the signature hash
+    bool check(const std::vector<uint8_t>& sig, const std::vector<uint8_t>& pubkey,
+               const uint8_t digest[32]) {
+        if (!parse_pubkey(pubkey)) return false;
+        Sig parsed = parse_der(sig);
+        if (!parsed || !is_low_s(parsed.get())) return false;
+        return verify_parsed(parsed.get(), digest);
+    }
+
+private:
+    BnCtx ctx_;
+    Bn e_, w_, u1_, u2_, x_;
+    Point pubkey_;
+    Point point_;
+};
+
+// ---------------------------------------------------------------------------
+// Transactions and the BIP143 (FORKID) signature hash
+
+struct TxIn {
+    uint8_t prevout[36];
+    std::vector<uint8_t> script_sig;
+    uint32_t sequence;
+};
+
+struct TxOut {
+    uint64_t value;
+    std::shared_ptr<std::vector<uint8_t>> script_pubkey;
+};
+
+struct Tx {
+    int32_t version = 1;
+    std::vector<TxIn> inputs;
+    std::vector<TxOut> outputs;
+    uint32_t locktime = 0;
+};
+
+// Preimage bytes of make_tx()'s transaction before its data output: the
+// inputs and a P2PKH output
+uint64_t base_sighash_bytes(uint64_t n_inputs, size_t script_sig_bytes) {
+    return 4 + 1 + n_inputs * (36 + 1 + script_sig_bytes + 4) + 1 + (8 + 1 + 25) + 4 + 4;
+}
+
+uint64_t data_output_bytes(uint64_t total_bytes, uint64_t n_inputs, size_t script_sig_bytes) {
+    uint64_t used = base_sighash_bytes(n_inputs, script_sig_bytes) + 8 + 1;
+    return total_bytes > used + 2 ? total_bytes - used : 2;
+}
+
+// Preimage size of make_tx(total_bytes, ...) as the cost estimator's
+// calculate_sighash_size() counts it for SIGHASH_ALL, so fitted per-byte
+// costs apply to the estimator's input
+uint64_t tx_sighash_bytes(uint64_t total_bytes, uint64_t n_inputs, size_t script_sig_bytes) {
+    return base_sighash_bytes(n_inputs, script_sig_bytes) + 8 + 1 +
+           data_output_bytes(total_bytes, n_inputs, script_sig_bytes);
+}
+
+// A transaction of roughly total_bytes with n_inputs inputs. Inputs carry
+// script_sig_bytes of unlocking script; the remainder goes into an
+// OP_FALSE OP_RETURN data output next to a P2PKH output, so the bulk of a
+// large transaction is in the outputs that the signature hash covers.
+Tx make_tx(uint64_t total_bytes, uint64_t n_inputs, size_t script_sig_bytes) {
+    Tx tx;
+    for (uint64_t i = 0; i < n_inputs; ++i) {
+        TxIn in;
+        for (int b = 0; b < 36; ++b) in.prevout[b] = static_cast<uint8_t>(i * 31 + b);
+        in.script_sig.assign(script_sig_bytes, 0x47);
+        in.sequence = 0xffffffff;
+        tx.inputs.push_back(std::move(in));
+    }
+
+    tx.outputs.push_back({1000, bsv_bench::make_buffer(25, 0x14)});
+
+    auto data = bsv_bench::make_buffer(data_output_bytes(total_bytes, n_inputs, script_sig_bytes), 0x42);
+    (*data)[0] = 0x00;  // OP_FALSE
+    (*data)[1] = 0x6a;  // OP_RETURN
+    tx.outputs.push_back({0, data});
+    return tx;
+}
+
+// Streaming double SHA-256, reused across calls
+class HashWriter {
+public:
+    HashWriter() : ctx_(EVP_MD_CTX_new()), md_(EVP_sha256()) {}
+
+    void reset() { EVP_DigestInit_ex(ctx_.get(), md_, nullptr); }
+    void write(const void* data, size_t size) { EVP_DigestUpdate(ctx_.get(), data, size); }
+
+    void write_u32(uint32_t v) {
+        uint8_t b[4] = {uint8_t(v), uint8_t(v >> 8), uint8_t(v >> 16), uint8_t(v >> 24)};
+        write(b, 4);
+    }
+
+    void write_u64(uint64_t v) {
+        write_u32(static_cast<uint32_t>(v));
+        write_u32(static_cast<uint32_t>(v >> 32));
+    }
+
+    void write_compact_size(uint64_t n) {
+        uint8_t b[9];
+        size_t len;
+        if (n < 0xfd) {
+            b[0] = static_cast<uint8_t>(n); len = 1;
+        } else if (n <= 0xffff) {
+            b[0] = 0xfd; len = 3;
+        } else if (n <= 0xffffffff) {
+            b[0] = 0xfe; len = 5;
+        } else {
+            b[0] = 0xff; len = 9;
+        }
+        for (size_t i = 1; i < len; ++i) b[i] = static_cast<uint8_t>(n >> (8 * (i - 1)));
+        write(b, len);
+    }
+
+    void write_script(const std::vector<uint8_t>& script) {
+        write_compact_size(script.size());
+        write(script.data(), script.size());
+    }
+
+    // SHA256(SHA256(written bytes))
+    void finalize(uint8_t out[32]) {
+        uint8_t first[32];
+        EVP_DigestFinal_ex(ctx_.get(), first, nullptr);
+        SHA256(first, sizeof(first), out);
+    }
+
+private:
+    MdCtx ctx_;
+    const EVP_MD* md_;
+};
+
+// BIP143 signature hash for SIGHASH_ALL|FORKID without precomputed
+// transaction data: hashPrevouts, hashSequence and hashOutputs are rebuilt on
+// every call, as a node does for a transaction it has not cached
+void signature_hash(HashWriter& hasher, const Tx& tx, size_t input_index,
+                    const std::vector<uint8_t>& script_code, uint64_t amount,
+                    uint8_t digest[32]) {
+    uint8_t hash_prevouts[32], hash_sequence[32], hash_outputs[32];
+
+    hasher.reset();
+    for (const auto& in : tx.inputs) hasher.write(in.prevout, sizeof(in.prevout));
+    hasher.finalize(hash_prevouts);
+
+    hasher.reset();
+    for (const auto& in : tx.inputs) hasher.write_u32(in.sequence);
+    hasher.finalize(hash_sequence);
+
+    hasher.reset();
+    for (const auto& out : tx.outputs) {
+        hasher.write_u64(out.value);
+        hasher.write_script(*out.script_pubkey);
+    }
+    hasher.finalize(hash_outputs);
+
+    const TxIn& in = tx.inputs[input_index];
+    hasher.reset();
+    hasher.write_u32(static_cast<uint32_t>(tx.version));
+    hasher.write(hash_prevouts, 32);
+    hasher.write(hash_sequence, 32);
+    hasher.write(in.prevout, sizeof(in.prevout));
+    hasher.write_script(script_code);
+    hasher.write_u64(amount);
+    hasher.write_u32(in.sequence);
+    hasher.write(hash_outputs, 32);
+    hasher.write_u32(tx.locktime);
+    hasher.write_u32(kSighashAllForkId);
+    hasher.finalize(digest);
+}
+
+std::vector<uint8_t> p2pkh_script() {
+    std::vector<uint8_t> script = {0x76, 0xa9, 0x14};  // DUP HASH160 <20>
+    script.resize(23, 0x5a);
+    script.push_back(0x88);  // EQUALVERIFY
+    script.push_back(0xac);  // CHECKSIG
+    return script;
+}
+
+// <m> <pubkey>... <n> OP_CHECKMULTISIG
+std::vector<uint8_t> multisig_script(const std::vector<KeyPair>& keys, size_t m) {
+    auto push_number = [](std::vector<uint8_t>& script, size_t v) {
+        if (v <= 16) {
+            script.push_back(static_cast<uint8_t>(0x50 + v));  // OP_1..OP_16
+        } else {
+            script.push_back(0x01);
+            script.push_back(static_cast<uint8_t>(v));
+        }
+    };
+
+    std::vector<uint8_t> script;
+    push_number(script, m);
+    for (const auto& key : keys) {
+        script.push_back(static_cast<uint8_t>(key.compressed.size()));
+        script.insert(script.end(), key.compressed.begin(), key.compressed.end());
+    }
+    push_number(script, keys.size());
+    script.push_back(0xae);  // CHECKMULTISIG
+    return script;
+}
+
+// The node's OP_CHECKMULTISIG loop: each signature is tried against the
+// remaining keys in order until one matches, failing once too few keys are
+// left. All signatures use SIGHASH_ALL|FORKID, so the signature hash is built
+// once per signature and reused for the keys tried against it.
+bool check_multisig(HashWriter& hasher, Verifier& verifier, const Tx& tx,
+                    const std::vector<uint8_t>& script_code,
+                    const std::vector<std::vector<uint8_t>>& sigs,
+                    const std::vector<std::vector<uint8_t>>& pubkeys) {
+    size_t isig = 0, ikey = 0;
+    uint8_t digest[32];
+    bool have_digest = false;
+    while (isig < sigs.size()) {
+        if (sigs.size() - isig > pubkeys.size() - ikey) return false;
+        if (!have_digest) {
+            signature_hash(hasher, tx, 0, script_code, 1000, digest);
+            have_digest = true;
+        }
+        if (verifier.check(sigs[isig], pubkeys[ikey], digest)) {
+            ++isig;
+            have_digest = false;
+        }
+        ++ikey;
+    }
+    return true;
+}
+
+std::vector<uint8_t> fixed_digest() {
+    std::vector<uint8_t> digest(32);
+    for (int i = 0; i < 32; ++i) digest[i] = static_cast<uint8_t>(0xa5 ^ (i * 7));
+    return digest;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Components of a signature check, each timed on its own
+
+BSV_BENCH_FAMILY(sig_ops, pubkey_parse) {
+    // Compressed keys need a modular square root to recover y
+    for (bool compressed : {true, false}) {
+        bench.add(
+            "PUBKEY_PARSE",
+            compressed ? "compressed" : "uncompressed",
+            compressed ? 33 : 65,
+            [compressed]() -> bsv_bench::BenchOperation {
+                KeyPair key = make_key();
+                auto pubkey = compressed ? key.compressed : key.uncompressed;
+                auto verifier = std::make_shared<Verifier>();
+                return [verifier, pubkey]() {
+                    volatile bool ok = verifier->parse_pubkey(pubkey);
+                    (void)ok;
+                };
+            }
+        );
+    }
+}
+
+BSV_BENCH_FAMILY(sig_ops, der_parse) {
+    auto digest = fixed_digest();
+    KeyPair key = make_key();
+    auto sig = sign(key, digest.data());
+    bench.add(
+        "DER_PARSE",
+        std::to_string(sig.size()) + "B",
+        sig.size(),
+        [sig]() -> bsv_bench::BenchOperation {
+            return [sig]() {
+                Sig parsed = Verifier::parse_der(sig);
+                volatile bool ok = parsed != nullptr;
+                (void)ok;
+            };
+        }
+    );
+}
+
+BSV_BENCH_FAMILY(sig_ops, low_s_check) {
+    auto digest = fixed_digest();
+    KeyPair key = make_key();
+    for (bool low_s : {true, false}) {
+        auto sig = sign(key, digest.data(), low_s);
+        bench.add(
+            "LOW_S_CHECK",
+            low_s ? "low-S" : "high-S",
+            sig.size(),
+            [sig]() -> bsv_bench::BenchOperation {
+                auto parsed = std::shared_ptr<ECDSA_SIG>(Verifier::parse_der(sig).release(), ECDSA_SIG_free);
+                return [parsed]() {
+                    volatile bool ok = Verifier::is_low_s(parsed.get());
+                    (void)ok;
+                };
+            }
+        );
+    }
+}
+
+BSV_BENCH_FAMILY(sig_ops, ecdsa_verify) {
+    // Pubkey parse + DER parse + low-S + verify, without the signature hash
+    for (bool compressed : {true, false}) {
+        bench.add(
+            "ECDSA_VERIFY",
+            compressed ? "compressed" : "uncompressed",
+            compressed ? 33 : 65,
+            [compressed]() -> bsv_bench::BenchOperation {
+                auto digest = fixed_digest();
+                KeyPair key = make_key();
+                auto pubkey = compressed ? key.compressed : key.uncompressed;
+                auto sig = sign(key, digest.data());
+                auto verifier = std::make_shared<Verifier>();
+                if (!verifier->check(sig, pubkey, digest.data())) {
+                    throw std::runtime_error("ECDSA_VERIFY: signature does not verify");
+                }
+                return [verifier, sig, pubkey, digest]() {
+                    volatile bool ok = verifier->check(sig, pubkey, digest.data());
+                    (void)ok;
+                };
+            }
+        );
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Signature hash construction across transaction sizes and input counts
+
+BSV_BENCH_FAMILY(sig_ops, sighash_preimage) {
+    auto tx_sizes = bench.axis("tx_sizes", {250, 1000, 10000, 100000, 1000000, 10000000});
+    auto input_counts = bench.axis("inputs", {1, 10, 100, 1000, 10000});
+    const size_t script_sig_bytes = 107;  // <sig> <compressed pubkey>
+
+    for (auto size : tx_sizes) {
+        for (auto inputs : input_counts) {
+            // Skip combinations whose inputs alone exceed the transaction size
+            if (inputs * (36 + 1 + script_sig_bytes + 4) + 64 > size) continue;
+
+            bench.add(
+                "SIGHASH_PREIMAGE",
+                std::to_string(size) + "B, " + std::to_string(inputs) + " inputs",
+                tx_sighash_bytes(size, inputs, script_sig_bytes),
+                [size, inputs, script_sig_bytes]() -> bsv_bench::BenchOperation {
+                    auto tx = std::make_shared<Tx>(make_tx(size, inputs, script_sig_bytes));
+                    auto hasher = std::make_shared<HashWriter>();
+                    auto script_code = p2pkh_script();
+                    return [tx, hasher, script_code]() {
+                        uint8_t digest[32];
+                        signature_hash(*hasher, *tx, 0, script_code, 1000, digest);
+                        volatile uint8_t b = digest[0];
+                        (void)b;
+                    };
+                }
+            );
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Whole opcodes; these feed the signature and multisig model forms
+
+BSV_BENCH_FAMILY(sig_ops, checksig) {
+    // P2PKH spend (compressed key) of a one-input transaction; input_bytes is
+    // the preimage size, so the fit separates c_ecdsa from c_preimage_per_byte
+    for (auto size : bench.axis("tx_sizes", {250, 1000, 10000, 100000, 1000000, 10000000})) {
+        bench.add(
+            "OP_CHECKSIG",
+            std::to_string(size) + "B tx",
+            tx_sighash_bytes(size, 1, 107),
+            [size]() -> bsv_bench::BenchOperation {
+                auto tx = std::make_shared<Tx>(make_tx(size, 1, 107));
+                auto hasher = std::make_shared<HashWriter>();
+                auto verifier = std::make_shared<Verifier>();
+                auto script_code = p2pkh_script();
+
+                uint8_t digest[32];
+                signature_hash(*hasher, *tx, 0, script_code, 1000, digest);
+                KeyPair key = make_key();
+                auto sig = sign(key, digest);
+                auto pubkey = key.compressed;
+                if (!verifier->check(sig, pubkey, digest)) {
+                    throw std::runtime_error("OP_CHECKSIG: signature does not verify");
+                }
+
+                return [tx, hasher, verifier, script_code, sig, pubkey]() {
+                    uint8_t digest[32];
+                    signature_hash(*hasher, *tx, 0, script_code, 1000, digest);
+                    volatile bool ok = verifier->check(sig, pubkey, digest);
+                    (void)ok;
+                };
+            }
+        );
+    }
+}
+
+BSV_BENCH_FAMILY(sig_ops, checkmultisig) {
+    // Signatures match the last m keys, the worst case for the node's
+    // in-order key scan: each of the first n-m keys costs a failed verify
+    auto key_counts = bench.axis("keys", {3, 5, 10, 15, 20});
+    auto tx_sizes = bench.axis("tx_sizes", {1000, 100000});
+
+    for (auto n : key_counts) {
+        std::vector<uint64_t> sig_counts = {1, (n + 1) / 2, n};
+        sig_counts.erase(std::unique(sig_counts.begin(), sig_counts.end()), sig_counts.end());
+
+        for (auto m : sig_counts) {
+            size_t script_sig_bytes = 1 + m * 74;  // OP_0 <sig>...
+            for (auto size : tx_sizes) {
+                bench.add(
+                    "OP_CHECKMULTISIG",
+                    std::to_string(m) + "-of-" + std::to_string(n) + ", " +
+                        std::to_string(size) + "B tx",
+                    tx_sighash_bytes(size, 1, script_sig_bytes),
+                    [m, n, size, script_sig_bytes]() -> bsv_bench::BenchOperation {
+                        auto tx = std::make_shared<Tx>(make_tx(size, 1, script_sig_bytes));
+                        auto hasher = std::make_shared<HashWriter>();
+                        auto verifier = std::make_shared<Verifier>();
+
+                        std::vector<KeyPair> keys;
+                        for (uint64_t i = 0; i < n; ++i) keys.push_back(make_key());
+                        auto script_code = multisig_script(keys, m);
+
+                        uint8_t digest[32];
+                        signature_hash(*hasher, *tx, 0, script_code, 1000, digest);
+                        std::vector<std::vector<uint8_t>> sigs;
+                        for (uint64_t i = n - m; i < n; ++i) sigs.push_back(sign(keys[i], digest));
+                        std::vector<std::vector<uint8_t>> pubkeys;
+                        for (const auto& key : keys) pubkeys.push_back(key.compressed);
+
+                        if (!check_multisig(*hasher, *verifier, *tx, script_code, sigs, pubkeys)) {
+                            throw std::runtime_error("OP_CHECKMULTISIG: signatures do not verify");
+                        }
+                        return [tx, hasher, verifier, script_code, sigs, pubkeys]() {
+                            volatile bool ok = check_multisig(*hasher, *verifier, *tx, script_code,
+                                                              sigs, pubkeys);
+                            (void)ok;
+                        };
+                    }
+                );
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Parallel verification: one batch of checks split over pinned threads
+
+namespace {
+
+struct ParallelWorker {
+    int cpu;
+    Verifier verifier;
+    HashWriter hasher;
+    std::shared_ptr<Tx> tx;  // Memory workload: each thread hashes its own copy
+};
+
+// Worker threads are started and pinned once, when the case is set up, and
+// wait at a start barrier between samples; a sample releases them all and
+// waits until each has finished its share, so it times the checks rather
+// than thread creation and migration.
+struct ParallelBatch {
+    std::vector<std::unique_ptr<ParallelWorker>> workers;
+    std::vector<uint8_t> script_code;
+    std::vector<uint8_t> sig;
+    std::vector<uint8_t> pubkey;
+    std::vector<uint8_t> digest;
+    uint64_t checks;
+    bool hash_preimage;
+
+    ~ParallelBatch() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        start.notify_all();
+        for (auto& thread : threads) thread.join();
+    }
+
+    // Start one thread per worker, once the fields above are set
+    void spawn() {
+        for (size_t w = 0; w < workers.size(); ++w) {
+            threads.emplace_back([this, w]() { work(w); });
+        }
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        remaining = workers.size();
+        ++generation;
+        start.notify_all();
+        done.wait(lock, [this]() { return remaining == 0; });
+    }
+
+private:
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable start;
+    std::condition_variable done;
+    uint64_t generation = 0;
+    size_t remaining = 0;
+    bool stop = false;
+
+    // Worker w takes checks w, w + threads, ...
+    void work(size_t w) {
+        ParallelWorker& worker = *workers[w];
+        bsv_bench::pin_to_cpu(worker.cpu);
+        size_t count = workers.size();
+        uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                start.wait(lock, [this, seen]() { return stop || generation != seen; });
+                if (stop) return;
+                seen = generation;
+            }
+            for (uint64_t i = w; i < checks; i += count) {
+                uint8_t preimage_digest[32];
+                const uint8_t* check_digest = digest.data();
+                if (hash_preimage) {
+                    signature_hash(worker.hasher, *worker.tx, 0, script_code, 1000, preimage_digest);
+                    check_digest = preimage_digest;
+                }
+                volatile bool ok = worker.verifier.check(sig, pubkey, check_digest);
+                (void)ok;
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--remaining == 0) done.notify_one();
+        }
+    }
+};
+
+} // namespace
+
+BSV_BENCH_FAMILY(sig_ops, parallel_verify) {
+    // Weak scaling: every thread gets the same number of checks, so no
+    // thread sits idle at high thread counts and the per-thread efficiency
+    // at t threads is the per-check cost ratio c(1) / (t * c(t)); the
+    // parallel_efficiency section of bsv_fit_model's output comes from here.
+    // The threads are pinned to the machine's own cores, not to --cpus, so
+    // the cases are exclusive: the parallel scheduler runs them alone.
+    //   cores   one thread per physical core
+    //   smt     two threads on each core's hyperthread pair
+    //   compute checks against a fixed digest (ECDSA-bound)
+    //   memory  each check also builds its signature hash over a per-thread
+    //           transaction larger than the private caches, so threads
+    //           compete for LLC and DRAM bandwidth
+    auto topology = bsv_bench::cpu_topology();
+    uint64_t physical_cores = topology.size();
+    bool has_smt = !topology.empty() && topology[0].size() >= 2;
+
+    std::vector<uint64_t> default_threads;
+    for (uint64_t t = 1; t < physical_cores; t *= 2) default_threads.push_back(t);
+    default_threads.push_back(physical_cores);
+    auto thread_counts = bench.axis("threads", default_threads);
+    auto batch = bench.axis("batch", {32})[0];
+    auto memory_batch = bench.axis("memory_batch", {4})[0];
+    auto memory_tx_bytes = bench.axis("memory_tx_bytes", {8000000})[0];
+
+    // The timing thread blocks until the workers finish, which the harness
+    // would otherwise count as a disturbed sample
+    bench.policy.adaptive.reject_outliers = false;
+    bench.policy.adaptive.min_samples = 10;
+    bench.policy.adaptive.warmup_iterations = 1;
+    bench.exclusive = true;
+
+    for (bool memory : {false, true}) {
+        for (bool smt : {false, true}) {
+            if (smt && !has_smt) continue;
+            for (auto cores : thread_counts) {
+                if (cores == 0 || cores > physical_cores) continue;
+
+                std::vector<int> cpus;
+                for (uint64_t c = 0; c < cores; ++c) {
+                    cpus.push_back(topology[c][0]);
+                    if (smt) cpus.push_back(topology[c][1]);
+                }
+                uint64_t checks = (memory ? memory_batch : batch) * cpus.size();
+                uint64_t tx_bytes = memory ? memory_tx_bytes : 0;
+
+                bench.add(
+                    "ECDSA_VERIFY_PARALLEL",
+                    std::string(memory ? "memory" : "compute") + ", threads=" +
+                        std::to_string(cpus.size()) + ", cores=" + std::to_string(cores) +
+                        ", batch=" + std::to_string(checks),
+                    memory ? checks * tx_sighash_bytes(tx_bytes, 1, 107) : checks * 33,
+                    [cpus, checks, memory, tx_bytes]() -> bsv_bench::BenchOperation {
+                        auto run = std::make_shared<ParallelBatch>();
+                        run->checks = checks;
+                        run->hash_preimage = memory;
+                        run->script_code = p2pkh_script();
+                        run->digest = fixed_digest();
+                        for (int cpu : cpus) {
+                            auto worker = std::make_unique<ParallelWorker>();
+                            worker->cpu = cpu;
+                            if (memory) worker->tx = std::make_shared<Tx>(make_tx(tx_bytes, 1, 107));
+                            run->workers.push_back(std::move(worker));
+                        }
+                        if (memory) {
+                            uint8_t digest[32];
+                            signature_hash(run->workers[0]->hasher, *run->workers[0]->tx, 0,
+                                           run->script_code, 1000, digest);
+                            run->digest.assign(digest, digest + 32);
+                        }
+
+                        KeyPair key = make_key();
+                        run->sig = sign(key, run->digest.data());
+                        run->pubkey = key.compressed;
+                        if (!run->workers[0]->verifier.check(run->sig, run->pubkey, run->digest.data())) {
+                            throw std::runtime_error("ECDSA_VERIFY_PARALLEL: signature does not verify");
+                        }
+                        run->spawn();
+                        return [run]() { run->run(); };
+                    }
+                );
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Signature cache lookups
+
+namespace {
+
+// Signature cache modelled on the node's: an entry is a salted SHA-256 of
+// (sighash, pubkey, signature), stored in a cuckoo set where it may occupy
+// any of 8 slots derived from its own bits. A hit still pays for the
+// signature hash, which is part of the key; it saves the ECDSA verify.
+class SigCache {
+public:
+    static constexpr int kWays = 8;
+
+    explicit SigCache(size_t bytes)
+        : slots_(std::max<size_t>(bytes / 32, kWays)),
+          table_(bsv_bench::make_buffer(slots_ * 32, 0)),
+          salted_(EVP_MD_CTX_new()), hasher_(EVP_MD_CTX_new()) {
+        uint8_t nonce[32];
+        for (int i = 0; i < 32; ++i) nonce[i] = static_cast<uint8_t>(0x3c * i + 7);
+        EVP_DigestInit_ex(salted_.get(), EVP_sha256(), nullptr);
+        EVP_DigestUpdate(salted_.get(), nonce, sizeof(nonce));
+    }
+
+    void entry(const uint8_t sighash[32], const std::vector<uint8_t>& pubkey,
+               const std::vector<uint8_t>& sig, uint8_t out[32]) {
+        EVP_MD_CTX_copy_ex(hasher_.get(), salted_.get());
+        EVP_DigestUpdate(hasher_.get(), sighash, 32);
+        EVP_DigestUpdate(hasher_.get(), pubkey.data(), pubkey.size());
+        EVP_DigestUpdate(hasher_.get(), sig.data(), sig.size());
+        EVP_DigestFinal_ex(hasher_.get(), out, nullptr);
+    }
+
+    bool contains(const uint8_t e[32]) const {
+        for (int way = 0; way < kWays; ++way) {
+            if (std::memcmp(slot(e, way), e, 32) == 0) return true;
+        }
+        return false;
+    }
+
+    // Insert, displacing entries along a bounded cuckoo path; at high
+    // occupancy the last displaced entry is dropped, as in the node
+    void insert(const uint8_t e[32], uint64_t& rng) {
+        uint8_t current[32];
+        std::memcpy(current, e, 32);
+        for (int depth = 0; depth < 32; ++depth) {
+            for (int way = 0; way < kWays; ++way) {
+                uint8_t* s = slot(current, way);
+                if (is_empty(s)) {
+                    std::memcpy(s, current, 32);
+                    ++occupied_;
+                    return;
+                }
+            }
+            rng = rng * 6364136223846793005ULL + 1442695040888963407ULL;
+            uint8_t* victim = slot(current, static_cast<int>(rng >> 61));
+            uint8_t displaced[32];
+            std::memcpy(displaced, victim, 32);
+            std::memcpy(victim, current, 32);
+            std::memcpy(current, displaced, 32);
+        }
+    }
+
+    size_t slots() const { return slots_; }
+    size_t occupied() const { return occupied_; }
+
+private:
+    // Slot for a way: 32 bits of the entry scaled onto the table
+    uint8_t* slot(const uint8_t e[32], int way) const {
+        uint32_t h;
+        std::memcpy(&h, e + 4 * way, sizeof(h));
+        return table_->data() + ((uint64_t(h) * slots_) >> 32) * 32;
+    }
+
+    static bool is_empty(const uint8_t* s) {
+        static const uint8_t zero[32] = {};
+        return std::memcmp(s, zero, 32) == 0;
+    }
+
+    size_t slots_;
+    size_t occupied_ = 0;
+    std::shared_ptr<std::vector<uint8_t>> table_;
+    MdCtx salted_;
+    MdCtx hasher_;
+};
+
+// A verified (sighash, pubkey, signature) triple as the cache sees it
+struct CachedCheck {
+    uint8_t sighash[32];
+    std::vector<uint8_t> pubkey;
+    std::vector<uint8_t> sig;
+};
+
+} // namespace
+
+BSV_BENCH_FAMILY(sig_ops, sigcache_lookup) {
+    // Lookup cost (entry hash + up to 8 slot probes) for signatures that are
+    // in the cache and ones that are not, as the cache fills. Probes rotate
+    // over enough distinct checks that a large cache's slots are not all in
+    // the CPU caches.
+    auto cache_sizes = bench.axis("sigcache_bytes", {1 << 20, 32 << 20});
+    auto occupancies = bench.axis("occupancy_percent", {10, 50, 90, 100});
+    const size_t kProbes = 4096;
+
+    for (auto bytes : cache_sizes) {
+        for (auto occupancy : occupancies) {
+            for (bool hit : {true, false}) {
+                bench.add(
+                    "SIGCACHE_LOOKUP",
+                    std::string(hit ? "hit" : "miss") + ", " + std::to_string(bytes >> 20) +
+                        "MB, " + std::to_string(occupancy) + "% full",
+                    32 + 33 + 72,
+                    [bytes, occupancy, hit, kProbes]() -> bsv_bench::BenchOperation {
+                        auto cache = std::make_shared<SigCache>(bytes);
+                        uint64_t rng = 0x9e3779b97f4a7c15ULL ^ bytes ^ occupancy;
+
+                        // Probe triples; only their cache entries matter, so
+                        // the signature bytes are arbitrary
+                        KeyPair key = make_key();
+                        auto checks = std::make_shared<std::vector<CachedCheck>>(kProbes);
+                        for (size_t i = 0; i < kProbes; ++i) {
+                            CachedCheck& c = (*checks)[i];
+                            for (int b = 0; b < 32; ++b) {
+                                c.sighash[b] = static_cast<uint8_t>((i * 131 + b * 7) ^ (i >> 8) ^ hit);
+                            }
+                            c.pubkey = key.compressed;
+                            c.sig.assign(72, static_cast<uint8_t>(i));
+                        }
+
+                        // Fill to the target occupancy with random entries,
+                        // inserting the probes for hits along the way
+                        uint64_t target = cache->slots() * occupancy / 100;
+                        if (hit) {
+                            for (auto& c : *checks) {
+                                uint8_t e[32];
+                                cache->entry(c.sighash, c.pubkey, c.sig, e);
+                                cache->insert(e, rng);
+                            }
+                        }
+                        uint64_t attempts = 0;
+                        while (cache->occupied() < target && attempts++ < 4 * cache->slots()) {
+                            uint8_t e[32];
+                            for (int b = 0; b < 32; b += 8) {
+                                rng = rng * 6364136223846793005ULL + 1442695040888963407ULL;
+                                std::memcpy(e + b, &rng, 8);
+                            }
+                            cache->insert(e, rng);
+                        }
+
+                        // Keep the hit probes that survived the fill
+                        if (hit) {
+                            std::vector<CachedCheck> present;
+                            for (auto& c : *checks) {
+                                uint8_t e[32];
+                                cache->entry(c.sighash, c.pubkey, c.sig, e);
+                                if (cache->contains(e)) present.push_back(c);
+                            }
+                            if (present.empty()) {
+                                throw std::runtime_error("SIGCACHE_LOOKUP: no probe entry survived the fill");
+                            }
+                            *checks = std::move(present);
+                        }
+
+                        size_t next = 0;
+                        return [cache, checks, next]() mutable {
+                            const CachedCheck& c = (*checks)[next];
+                            if (++next == checks->size()) next = 0;
+                            uint8_t e[32];
+                            cache->entry(c.sighash, c.pubkey, c.sig, e);
+                            volatile bool found = cache->contains(e);
+                            (void)found;
+                        };
+                    }
+                );
+            }
+        }
+    }
+}
+
+#ifndef BSV_BENCH_UNIFIED
+static std::vector<bsv_bench::FitPoint> fit_points(const std::vector<bsv_bench::BenchResult>& results,
+                                                   const std::string& opcode_name) {
+    std::vector<bsv_bench::FitPoint> points;
+    for (const auto& r : results) {
+        if (r.opcode == opcode_name) points.push_back(bsv_bench::to_fit_point(r));
+    }
+    return points;
+}
+
+static void analyze_signature_model(const std::vector<bsv_bench::BenchResult>& results,
+                                    const std::string& opcode_name,
+                                    bsv_bench::ModelForm form) {
+    std::vector<bsv_bench::FitPoint> points = fit_points(results, opcode_name);
+    if (points.size() < 2) return;
+
+    std::cout << "\n=== " << bsv_bench::model_form_name(form) << " model for " << opcode_name << " ===\n";
+
+    // Same fit as bsv_fit_model, so the numbers here match the model file
+    bsv_bench::ModelFit fit = bsv_bench::fit_model(form, points, bsv_bench::FitOptions());
+    for (const auto& [name, value] : fit.coefficients) {
+        std::cout << "  " << name << ": " << value << "\n";
+    }
+    std::cout << "  R² (weighted): " << fit.diagnostics.r_squared << "\n";
+    std::cout << "  Max relative error: " << fit.diagnostics.max_rel_error * 100 << "%\n";
+}
+
+int main(int argc, char** argv) {
+    std::cout << "=== BSV Script Benchmark: Signature Operations ===\n";
+    std::cout << "secp256k1 ECDSA (OpenSSL) with BIP143 signature hashes\n\n";
+
+    bsv_bench::BenchmarkHarness harness;
+    harness.initialize(0);  // Pin to CPU 0
+
+    auto cases = bsv_bench::BenchRegistry::instance().collect(
+        bsv_bench::ParamMatrix(), bsv_bench::CaseFilter());
+    std::vector<bsv_bench::BenchResult> results = bsv_bench::run_cases(harness, cases);
+
+    analyze_signature_model(results, "OP_CHECKSIG", bsv_bench::ModelForm::SIGNATURE);
+    analyze_signature_model(results, "OP_CHECKMULTISIG", bsv_bench::ModelForm::MULTISIG);
+
+    std::string csv_file = "output/bench_sig_ops.csv";
+    std::string json_file = "output/bench_sig_ops.json";
+
+    harness.export_csv(results, csv_file);
+    harness.export_json(results, json_file);
+
+    std::cout << "\n=== Results exported to:\n";
+    std::cout << "  " << csv_file << "\n";
+    std::cout << "  " << json_file << "\n";
 
-int main() {
-    std::cout << "OP_CHECKSIG/OP_CHECKMULTISIG benchmarks require BSV node integration\n";
-    std::cout << "TODO: Link against BSV's ECDSA verification and sighash preimage code\n";
     return 0;
 }
+#endif
@@ -1,11 +1,18 @@
 #include "bench_harness.h"
+#include "bench_registry.h"
+#include <algorithm>
 #include <vector>
 #include <cstdint>
 #include <cstring>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
 
-// Simple stack implementation for testing
-// TODO: Replace with actual BSV Script stack once integrated
+// Naive stack: every item is a std::vector, copied on pop, DUP, PICK, ROLL
+// and ROT, and ROLL erases from the middle of the item vector. This is the
+// baseline the original coefficients were measured on.
 class SimpleStack {
 public:
     void push(const std::vector<uint8_t>& data) {
@@ -24,6 +31,12 @@ public:
         return items_.back();
     }
     
+    // OP_INVERT in place on the top item
+    void invert_top() {
+        if (items_.empty()) throw std::runtime_error("Stack empty");
+        for (auto& byte : items_.back()) byte = ~byte;
+    }
+    
     void dup() {
         if (items_.empty()) throw std::runtime_error("Stack empty");
         items_.push_back(items_.back());
@@ -64,185 +77,526 @@ private:
     std::vector<std::vector<uint8_t>> items_;
 };
 
-void benchmark_op_dup(bsv_bench::BenchmarkHarness& harness,
-                      std::vector<bsv_bench::BenchResult>& results) {
-    std::cout << "Benchmarking OP_DUP...\n";
+// Production-style stacks. Every stack here has SimpleStack's interface
+// (push, pop, top, invert_top, dup, swap, pick, roll, rot, size, clear) and the
+// families below are templates over it, so all of them run the same cases.
+
+// Refcounted buffers: DUP, PICK and ROLL share the item instead of copying
+// it, and a writer clones an item only while it is shared. Buffers are
+// mutable objects so that an unshared one can be written in place; reads go
+// through const references.
+class CowStack {
+public:
+    using Buffer = std::shared_ptr<std::vector<uint8_t>>;
+    
+    void push(const std::vector<uint8_t>& data) {
+        items_.push_back(std::make_shared<std::vector<uint8_t>>(data));
+    }
+    
+    Buffer pop() {
+        if (items_.empty()) throw std::runtime_error("Stack underflow");
+        Buffer item = std::move(items_.back());
+        items_.pop_back();
+        return item;
+    }
+    
+    const std::vector<uint8_t>& top() const {
+        if (items_.empty()) throw std::runtime_error("Stack empty");
+        return *items_.back();
+    }
+    
+    // Copy-on-write access for in-place opcodes (OP_INVERT, OP_AND, ...)
+    std::vector<uint8_t>& mutable_top() {
+        if (items_.empty()) throw std::runtime_error("Stack empty");
+        if (items_.back().use_count() > 1) {
+            items_.back() = std::make_shared<std::vector<uint8_t>>(*items_.back());
+        }
+        return *items_.back();
+    }
+    
+    void invert_top() {
+        for (auto& byte : mutable_top()) byte = ~byte;
+    }
+    
+    void dup() {
+        if (items_.empty()) throw std::runtime_error("Stack empty");
+        items_.push_back(items_.back());
+    }
+    
+    void swap() {
+        if (items_.size() < 2) throw std::runtime_error("Insufficient items");
+        std::swap(items_[items_.size() - 1], items_[items_.size() - 2]);
+    }
+    
+    void pick(size_t depth) {
+        if (depth >= items_.size()) throw std::runtime_error("Pick out of range");
+        items_.push_back(items_[items_.size() - 1 - depth]);
+    }
+    
+    // Moves `depth` pointers rather than copying the rolled item
+    void roll(size_t depth) {
+        if (depth >= items_.size()) throw std::runtime_error("Roll out of range");
+        auto it = items_.end() - 1 - depth;
+        Buffer item = std::move(*it);
+        items_.erase(it);
+        items_.push_back(std::move(item));
+    }
+    
+    void rot() {
+        if (items_.size() < 3) throw std::runtime_error("Insufficient items");
+        std::rotate(items_.end() - 3, items_.end() - 2, items_.end());
+    }
+    
+    size_t size() const { return items_.size(); }
+    void clear() { items_.clear(); }
+    
+private:
+    std::vector<Buffer> items_;
+};
+
+// Byte string that keeps up to kInline bytes (hashes, public keys, script
+// numbers) inside the item, so copying a small item never allocates. Larger
+// items are deep-copied like std::vector.
+class SboItem {
+public:
+    static constexpr size_t kInline = 40;
+    
+    SboItem() = default;
+    explicit SboItem(const std::vector<uint8_t>& data) { assign(data.data(), data.size()); }
+    SboItem(const SboItem& other) { assign(other.data(), other.size_); }
+    SboItem(SboItem&& other) noexcept { take(other); }
+    ~SboItem() { release(); }
+    
+    SboItem& operator=(const SboItem& other) {
+        if (this != &other) {
+            release();
+            assign(other.data(), other.size_);
+        }
+        return *this;
+    }
+    
+    SboItem& operator=(SboItem&& other) noexcept {
+        if (this != &other) {
+            release();
+            take(other);
+        }
+        return *this;
+    }
+    
+    const uint8_t* data() const { return size_ <= kInline ? inline_ : heap_; }
+    uint8_t* data() { return size_ <= kInline ? inline_ : heap_; }
+    size_t size() const { return size_; }
+    
+private:
+    void assign(const uint8_t* data, size_t size) {
+        size_ = size;
+        uint8_t* dest = inline_;
+        if (size > kInline) dest = heap_ = new uint8_t[size];
+        if (size > 0) std::memcpy(dest, data, size);
+    }
+    
+    void take(SboItem& other) {
+        size_ = other.size_;
+        if (size_ > kInline) {
+            heap_ = other.heap_;
+        } else {
+            std::memcpy(inline_, other.inline_, size_);
+        }
+        other.size_ = 0;
+    }
+    
+    void release() {
+        if (size_ > kInline) delete[] heap_;
+        size_ = 0;
+    }
+    
+    size_t size_ = 0;
+    union {
+        uint8_t inline_[kInline];
+        uint8_t* heap_;
+    };
+};
+
+class SboStack {
+public:
+    void push(const std::vector<uint8_t>& data) {
+        items_.emplace_back(data);
+    }
+    
+    SboItem pop() {
+        if (items_.empty()) throw std::runtime_error("Stack underflow");
+        SboItem item = std::move(items_.back());
+        items_.pop_back();
+        return item;
+    }
+    
+    const SboItem& top() const {
+        if (items_.empty()) throw std::runtime_error("Stack empty");
+        return items_.back();
+    }
+    
+    void invert_top() {
+        if (items_.empty()) throw std::runtime_error("Stack empty");
+        SboItem& item = items_.back();
+        std::transform(item.data(), item.data() + item.size(), item.data(),
+                       [](uint8_t byte) { return static_cast<uint8_t>(~byte); });
+    }
+    
+    void dup() {
+        if (items_.empty()) throw std::runtime_error("Stack empty");
+        SboItem copy = items_.back();
+        items_.push_back(std::move(copy));
+    }
+    
+    void swap() {
+        if (items_.size() < 2) throw std::runtime_error("Insufficient items");
+        std::swap(items_[items_.size() - 1], items_[items_.size() - 2]);
+    }
+    
+    void pick(size_t depth) {
+        if (depth >= items_.size()) throw std::runtime_error("Pick out of range");
+        SboItem copy = items_[items_.size() - 1 - depth];
+        items_.push_back(std::move(copy));
+    }
+    
+    void roll(size_t depth) {
+        if (depth >= items_.size()) throw std::runtime_error("Roll out of range");
+        auto it = items_.end() - 1 - depth;
+        SboItem item = std::move(*it);
+        items_.erase(it);
+        items_.push_back(std::move(item));
+    }
+    
+    void rot() {
+        if (items_.size() < 3) throw std::runtime_error("Insufficient items");
+        std::rotate(items_.end() - 3, items_.end() - 2, items_.end());
+    }
+    
+    size_t size() const { return items_.size(); }
+    void clear() { items_.clear(); }
+    
+private:
+    std::vector<SboItem> items_;
+};
+
+// Refcounted items in fixed-capacity blocks. ROLL finds the item's block by
+// walking block sizes from the top and erases within that block, so it moves
+// at most kBlock pointers however deep the item is.
+class ChunkedStack {
+public:
+    using Buffer = CowStack::Buffer;
+    static constexpr size_t kBlock = 64;
+    
+    void push(const std::vector<uint8_t>& data) {
+        push_item(std::make_shared<std::vector<uint8_t>>(data));
+    }
+    
+    Buffer pop() {
+        if (size_ == 0) throw std::runtime_error("Stack underflow");
+        Buffer item = std::move(blocks_.back().back());
+        blocks_.back().pop_back();
+        if (blocks_.back().empty()) {
+            spare_ = std::move(blocks_.back());
+            blocks_.pop_back();
+        }
+        --size_;
+        return item;
+    }
+    
+    const std::vector<uint8_t>& top() const {
+        if (size_ == 0) throw std::runtime_error("Stack empty");
+        return *blocks_.back().back();
+    }
+    
+    // Copy-on-write, as CowStack
+    void invert_top() {
+        if (size_ == 0) throw std::runtime_error("Stack empty");
+        Buffer& item = blocks_.back().back();
+        if (item.use_count() > 1) item = std::make_shared<std::vector<uint8_t>>(*item);
+        for (auto& byte : *item) byte = ~byte;
+    }
+    
+    void dup() {
+        if (size_ == 0) throw std::runtime_error("Stack empty");
+        push_item(blocks_.back().back());
+    }
+    
+    void swap() {
+        if (size_ < 2) throw std::runtime_error("Insufficient items");
+        std::swap(at(0), at(1));
+    }
+    
+    void pick(size_t depth) {
+        if (depth >= size_) throw std::runtime_error("Pick out of range");
+        push_item(at(depth));
+    }
+    
+    void roll(size_t depth) {
+        if (depth >= size_) throw std::runtime_error("Roll out of range");
+        auto [block, index] = locate(depth);
+        auto& items = blocks_[block];
+        Buffer item = std::move(items[index]);
+        items.erase(items.begin() + index);
+        if (items.empty()) blocks_.erase(blocks_.begin() + block);
+        --size_;
+        push_item(std::move(item));
+    }
+    
+    void rot() {
+        if (size_ < 3) throw std::runtime_error("Insufficient items");
+        // a b c -> b c a
+        Buffer a = std::move(at(2));
+        at(2) = std::move(at(1));
+        at(1) = std::move(at(0));
+        at(0) = std::move(a);
+    }
+    
+    size_t size() const { return size_; }
+    void clear() { blocks_.clear(); size_ = 0; }
+    
+private:
+    void push_item(Buffer item) {
+        if (blocks_.empty() || blocks_.back().size() == kBlock) {
+            // Reuse the last emptied block, so DUP/pop across a block
+            // boundary doesn't allocate
+            blocks_.push_back(std::move(spare_));
+            spare_ = {};
+            blocks_.back().reserve(kBlock);
+        }
+        blocks_.back().push_back(std::move(item));
+        ++size_;
+    }
+    
+    // Block and index of the item `depth` below the top
+    std::pair<size_t, size_t> locate(size_t depth) const {
+        size_t block = blocks_.size() - 1;
+        while (depth >= blocks_[block].size()) {
+            depth -= blocks_[block].size();
+            --block;
+        }
+        return {block, blocks_[block].size() - 1 - depth};
+    }
+    
+    Buffer& at(size_t depth) {
+        auto [block, index] = locate(depth);
+        return blocks_[block][index];
+    }
+    
+    std::vector<std::vector<Buffer>> blocks_;
+    std::vector<Buffer> spare_;
+    size_t size_ = 0;
+};
+
+// Runs fn(Stack{}, name) for every stack implementation
+template <class Fn>
+void for_each_stack(Fn fn) {
+    fn(SimpleStack(), "naive");
+    fn(CowStack(), "cow");
+    fn(SboStack(), "sbo");
+    fn(ChunkedStack(), "chunked");
+}
+
+// Stack ops are cheap and stable; keep the original fixed sampling
+static const bsv_bench::IterationPolicy kStackPolicy = bsv_bench::IterationPolicy::fixed(1000, 100);
+
+BSV_BENCH_FAMILY(stack_ops, op_dup) {
+    bench.policy = kStackPolicy;
     
     // Test various stack depths and item sizes
-    std::vector<size_t> stack_depths = {1, 10, 100, 1000};
-    std::vector<size_t> item_sizes = {1, 100, 10000, 1000000};  // 1B, 100B, 10kB, 1MB
+    auto stack_depths = bench.axis("depths", {1, 10, 100, 1000});
+    auto item_sizes = bench.axis("item_sizes", {1, 100, 10000, 1000000});  // 1B, 100B, 10kB, 1MB
     
-    for (auto depth : stack_depths) {
-        for (auto item_size : item_sizes) {
-            SimpleStack stack;
-            std::vector<uint8_t> item(item_size, 0x42);
-            
-            // Pre-fill stack
-            for (size_t i = 0; i < depth; ++i) {
-                stack.push(item);
+    for_each_stack([&](auto prototype, const std::string& impl) {
+        using Stack = decltype(prototype);
+        for (auto depth : stack_depths) {
+            for (auto item_size : item_sizes) {
+                bench.add(
+                    "OP_DUP",
+                    impl + ", depth=" + std::to_string(depth) + ",item_size=" + std::to_string(item_size),
+                    item_size,
+                    [depth, item_size]() -> bsv_bench::BenchOperation {
+                        auto stack = std::make_shared<Stack>();
+                        std::vector<uint8_t> item(item_size, 0x42);
+                        
+                        // Pre-fill stack
+                        for (size_t i = 0; i < depth; ++i) {
+                            stack->push(item);
+                        }
+                        // DUP then pop to maintain size
+                        return [stack]() { stack->dup(); stack->pop(); };
+                    }
+                );
             }
-            
-            auto result = harness.benchmark(
-                "OP_DUP",
-                "depth=" + std::to_string(depth) + ",item_size=" + std::to_string(item_size),
-                item_size,
-                [&stack]() { stack.dup(); stack.pop(); },  // DUP then pop to maintain size
-                1000,
-                100
-            );
-            
-            results.push_back(result);
-            std::cout << "  depth=" << depth << ", size=" << item_size 
-                     << " -> " << result.median_cycles << " cycles\n";
         }
-    }
+    });
 }
 
-void benchmark_op_swap(bsv_bench::BenchmarkHarness& harness,
-                       std::vector<bsv_bench::BenchResult>& results) {
-    std::cout << "Benchmarking OP_SWAP...\n";
+BSV_BENCH_FAMILY(stack_ops, op_swap) {
+    bench.policy = kStackPolicy;
     
-    std::vector<size_t> stack_depths = {2, 10, 100, 1000};
-    std::vector<size_t> item_sizes = {1, 100, 10000, 1000000};
+    auto stack_depths = bench.axis("depths", {2, 10, 100, 1000});
+    auto item_sizes = bench.axis("item_sizes", {1, 100, 10000, 1000000});
     
-    for (auto depth : stack_depths) {
-        for (auto item_size : item_sizes) {
-            SimpleStack stack;
-            std::vector<uint8_t> item(item_size, 0x42);
-            
-            for (size_t i = 0; i < depth; ++i) {
-                stack.push(item);
+    for_each_stack([&](auto prototype, const std::string& impl) {
+        using Stack = decltype(prototype);
+        for (auto depth : stack_depths) {
+            for (auto item_size : item_sizes) {
+                bench.add(
+                    "OP_SWAP",
+                    impl + ", depth=" + std::to_string(depth) + ",item_size=" + std::to_string(item_size),
+                    item_size * 2,  // Swaps involve two items
+                    [depth, item_size]() -> bsv_bench::BenchOperation {
+                        auto stack = std::make_shared<Stack>();
+                        std::vector<uint8_t> item(item_size, 0x42);
+                        
+                        for (size_t i = 0; i < depth; ++i) {
+                            stack->push(item);
+                        }
+                        return [stack]() { stack->swap(); };
+                    }
+                );
             }
-            
-            auto result = harness.benchmark(
-                "OP_SWAP",
-                "depth=" + std::to_string(depth) + ",item_size=" + std::to_string(item_size),
-                item_size * 2,  // Swaps involve two items
-                [&stack]() { stack.swap(); },
-                1000,
-                100
-            );
-            
-            results.push_back(result);
-            std::cout << "  depth=" << depth << ", size=" << item_size 
-                     << " -> " << result.median_cycles << " cycles\n";
         }
-    }
+    });
 }
 
-void benchmark_op_pick(bsv_bench::BenchmarkHarness& harness,
-                       std::vector<bsv_bench::BenchResult>& results) {
-    std::cout << "Benchmarking OP_PICK...\n";
-    
-    std::vector<size_t> stack_depths = {10, 100, 1000, 10000};
-    std::vector<size_t> pick_depths = {0, 5, 50, 500};  // Relative to stack depth
-    size_t item_size = 100;
-    
-    for (auto depth : stack_depths) {
-        for (auto pick_depth : pick_depths) {
-            if (pick_depth >= depth) continue;
-            
-            SimpleStack stack;
-            std::vector<uint8_t> item(item_size, 0x42);
-            
-            for (size_t i = 0; i < depth; ++i) {
-                stack.push(item);
+BSV_BENCH_FAMILY(stack_ops, op_pick) {
+    bench.policy = kStackPolicy;
+    
+    auto stack_depths = bench.axis("stack_depths", {10, 100, 1000, 10000});
+    auto pick_depths = bench.axis("pick_depths", {0, 5, 50, 500});  // Relative to stack depth
+    size_t item_size = bench.axis("item_sizes", {100}).front();
+    
+    for_each_stack([&](auto prototype, const std::string& impl) {
+        using Stack = decltype(prototype);
+        for (auto depth : stack_depths) {
+            for (auto pick_depth : pick_depths) {
+                if (pick_depth >= depth) continue;
+                
+                bench.add(
+                    "OP_PICK",
+                    impl + ", stack_depth=" + std::to_string(depth) + ",pick_depth=" + std::to_string(pick_depth),
+                    item_size,
+                    [depth, pick_depth, item_size]() -> bsv_bench::BenchOperation {
+                        auto stack = std::make_shared<Stack>();
+                        std::vector<uint8_t> item(item_size, 0x42);
+                        
+                        for (size_t i = 0; i < depth; ++i) {
+                            stack->push(item);
+                        }
+                        return [stack, pick_depth]() { stack->pick(pick_depth); stack->pop(); };
+                    }
+                );
             }
-            
-            auto result = harness.benchmark(
-                "OP_PICK",
-                "stack_depth=" + std::to_string(depth) + ",pick_depth=" + std::to_string(pick_depth),
-                item_size,
-                [&stack, pick_depth]() { stack.pick(pick_depth); stack.pop(); },
-                1000,
-                100
-            );
-            
-            results.push_back(result);
-            std::cout << "  stack=" << depth << ", pick=" << pick_depth 
-                     << " -> " << result.median_cycles << " cycles\n";
         }
-    }
+    });
 }
 
-void benchmark_op_roll(bsv_bench::BenchmarkHarness& harness,
-                       std::vector<bsv_bench::BenchResult>& results) {
-    std::cout << "Benchmarking OP_ROLL...\n";
-    
-    std::vector<size_t> stack_depths = {10, 100, 1000};
-    std::vector<size_t> roll_depths = {1, 5, 50};
-    size_t item_size = 100;
-    
-    for (auto depth : stack_depths) {
-        for (auto roll_depth : roll_depths) {
-            if (roll_depth >= depth) continue;
-            
-            auto result = harness.benchmark(
-                "OP_ROLL",
-                "stack_depth=" + std::to_string(depth) + ",roll_depth=" + std::to_string(roll_depth),
-                item_size,
-                [depth, roll_depth, item_size]() {
-                    SimpleStack stack;
-                    std::vector<uint8_t> item(item_size, 0x42);
-                    for (size_t i = 0; i < depth; ++i) stack.push(item);
-                    stack.roll(roll_depth);
-                },
-                1000,
-                100
-            );
-            
-            results.push_back(result);
-            std::cout << "  stack=" << depth << ", roll=" << roll_depth 
-                     << " -> " << result.median_cycles << " cycles\n";
+// ROLL keeps the stack's size and, with identical items, its contents, so
+// the stack is filled once and only the ROLL is timed. input_bytes is the
+// roll depth, which is what the estimator prices OP_ROLL by.
+BSV_BENCH_FAMILY(stack_ops, op_roll) {
+    bench.policy = kStackPolicy;
+    
+    auto stack_depths = bench.axis("stack_depths", {10, 100, 1000, 10000});
+    auto roll_depths = bench.axis("roll_depths", {1, 5, 50, 500, 5000});
+    size_t item_size = bench.axis("item_sizes", {100}).front();
+    
+    for_each_stack([&](auto prototype, const std::string& impl) {
+        using Stack = decltype(prototype);
+        for (auto depth : stack_depths) {
+            for (auto roll_depth : roll_depths) {
+                if (roll_depth >= depth) continue;
+                
+                bench.add(
+                    "OP_ROLL",
+                    impl + ", stack_depth=" + std::to_string(depth) + ",roll_depth=" + std::to_string(roll_depth),
+                    roll_depth,
+                    [depth, roll_depth, item_size]() -> bsv_bench::BenchOperation {
+                        auto stack = std::make_shared<Stack>();
+                        std::vector<uint8_t> item(item_size, 0x42);
+                        
+                        for (size_t i = 0; i < depth; ++i) {
+                            stack->push(item);
+                        }
+                        return [stack, roll_depth]() { stack->roll(roll_depth); };
+                    }
+                );
+            }
         }
-    }
+    });
 }
 
-void benchmark_op_rot(bsv_bench::BenchmarkHarness& harness,
-                      std::vector<bsv_bench::BenchResult>& results) {
-    std::cout << "Benchmarking OP_ROT...\n";
+BSV_BENCH_FAMILY(stack_ops, op_rot) {
+    bench.policy = kStackPolicy;
     
-    std::vector<size_t> stack_depths = {3, 10, 100, 1000};
-    std::vector<size_t> item_sizes = {1, 100, 10000, 1000000};
+    auto stack_depths = bench.axis("depths", {3, 10, 100, 1000});
+    auto item_sizes = bench.axis("item_sizes", {1, 100, 10000, 1000000});
     
-    for (auto depth : stack_depths) {
-        for (auto item_size : item_sizes) {
-            SimpleStack stack;
-            std::vector<uint8_t> item(item_size, 0x42);
-            
-            for (size_t i = 0; i < depth; ++i) {
-                stack.push(item);
+    for_each_stack([&](auto prototype, const std::string& impl) {
+        using Stack = decltype(prototype);
+        for (auto depth : stack_depths) {
+            for (auto item_size : item_sizes) {
+                bench.add(
+                    "OP_ROT",
+                    impl + ", depth=" + std::to_string(depth) + ",item_size=" + std::to_string(item_size),
+                    item_size * 3,  // Rotates 3 items
+                    [depth, item_size]() -> bsv_bench::BenchOperation {
+                        auto stack = std::make_shared<Stack>();
+                        std::vector<uint8_t> item(item_size, 0x42);
+                        
+                        for (size_t i = 0; i < depth; ++i) {
+                            stack->push(item);
+                        }
+                        return [stack]() { stack->rot(); };
+                    }
+                );
             }
-            
-            auto result = harness.benchmark(
-                "OP_ROT",
-                "depth=" + std::to_string(depth) + ",item_size=" + std::to_string(item_size),
-                item_size * 3,  // Rotates 3 items
-                [&stack]() { stack.rot(); },
-                1000,
-                100
+        }
+    });
+}
+
+// DUP then an in-place write to the copy: the shared item a copy-on-write
+// stack has to clone before writing, and a plain copy for the others
+BSV_BENCH_FAMILY(stack_ops, dup_write) {
+    bench.policy = kStackPolicy;
+    
+    auto item_sizes = bench.axis("item_sizes", {1, 100, 10000, 1000000});
+    
+    for_each_stack([&](auto prototype, const std::string& impl) {
+        using Stack = decltype(prototype);
+        for (auto item_size : item_sizes) {
+            bench.add(
+                "DUP_WRITE",
+                impl + ", item_size=" + std::to_string(item_size),
+                item_size,
+                [item_size]() -> bsv_bench::BenchOperation {
+                    auto stack = std::make_shared<Stack>();
+                    stack->push(std::vector<uint8_t>(item_size, 0x42));
+                    stack->dup();
+                    stack->invert_top();
+                    bool written = stack->top().data()[0] == 0xbd;
+                    stack->pop();
+                    if (!written || stack->top().data()[0] != 0x42) {
+                        throw std::runtime_error("DUP_WRITE: write reached the shared item");
+                    }
+                    return [stack]() { stack->dup(); stack->invert_top(); stack->pop(); };
+                }
             );
-            
-            results.push_back(result);
-            std::cout << "  depth=" << depth << ", size=" << item_size 
-                     << " -> " << result.median_cycles << " cycles\n";
         }
-    }
+    });
 }
 
+#ifndef BSV_BENCH_UNIFIED
 int main(int argc, char** argv) {
     std::cout << "=== BSV Script Benchmark: Stack Operations ===\n\n";
     
     bsv_bench::BenchmarkHarness harness;
     harness.initialize(0);  // Pin to CPU 0
     
-    std::vector<bsv_bench::BenchResult> results;
-    
-    benchmark_op_dup(harness, results);
-    benchmark_op_swap(harness, results);
-    benchmark_op_pick(harness, results);
-    benchmark_op_roll(harness, results);
-    benchmark_op_rot(harness, results);
+    auto cases = bsv_bench::BenchRegistry::instance().collect(
+        bsv_bench::ParamMatrix(), bsv_bench::CaseFilter());
+    std::vector<bsv_bench::BenchResult> results = bsv_bench::run_cases(harness, cases);
     
     // Export results
     std::string csv_file = "output/bench_stack_ops.csv";
@@ -257,3 +611,4 @@ int main(int argc, char** argv) {
     
     return 0;
 }
+#endif
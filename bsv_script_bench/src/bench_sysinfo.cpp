@@ -0,0 +1,159 @@
+#include "bench_sysinfo.h"
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <sys/utsname.h>
+#include <unistd.h>
+
+namespace bsv_bench {
+
+// Parse sysfs cache sizes such as "48K" or "2048K"
+static uint64_t parse_cache_size(const std::string& text) {
+    uint64_t value = 0;
+    size_t i = 0;
+    while (i < text.size() && text[i] >= '0' && text[i] <= '9') {
+        value = value * 10 + (text[i] - '0');
+        ++i;
+    }
+    if (i < text.size()) {
+        if (text[i] == 'K') value <<= 10;
+        else if (text[i] == 'M') value <<= 20;
+        else if (text[i] == 'G') value <<= 30;
+    }
+    return value;
+}
+
+static std::string read_line(const std::string& path) {
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+static std::string json_escape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        if (static_cast<unsigned char>(c) >= 0x20) out += c;
+    }
+    return out;
+}
+
+std::vector<std::vector<int>> cpu_topology() {
+    int logical_cpus = static_cast<int>(sysconf(_SC_NPROCESSORS_ONLN));
+
+    // SMT siblings share a (package, core) pair
+    std::map<std::pair<std::string, std::string>, size_t> core_index;
+    std::vector<std::vector<int>> cores;
+    for (int cpu = 0; cpu < logical_cpus; ++cpu) {
+        std::string dir = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+        std::string core = read_line(dir + "core_id");
+        if (core.empty()) {
+            cores.push_back({cpu});  // No topology: treat as its own core
+            continue;
+        }
+        auto key = std::make_pair(read_line(dir + "physical_package_id"), core);
+        auto it = core_index.find(key);
+        if (it == core_index.end()) {
+            core_index[key] = cores.size();
+            cores.push_back({cpu});
+        } else {
+            cores[it->second].push_back(cpu);
+        }
+    }
+    return cores;
+}
+
+HostInfo detect_host() {
+    HostInfo info;
+
+    struct utsname uts;
+    if (uname(&uts) == 0) {
+        info.hostname = uts.nodename;
+        info.kernel = std::string(uts.sysname) + " " + uts.release;
+    }
+
+    info.logical_cpus = static_cast<int>(sysconf(_SC_NPROCESSORS_ONLN));
+
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        auto colon = line.find(':');
+        if (colon == std::string::npos) continue;
+        std::string key = line.substr(0, line.find_last_not_of(" \t", colon - 1) + 1);
+        std::string value = colon + 2 <= line.size() ? line.substr(colon + 2) : "";
+
+        if (key == "vendor_id" && info.cpu_vendor.empty()) {
+            info.cpu_vendor = value;
+        } else if (key == "model name" && info.cpu_model.empty()) {
+            info.cpu_model = value;
+        } else if (key == "cpu family" && info.cpu_family < 0) {
+            info.cpu_family = std::atoi(value.c_str());
+        } else if (key == "model" && info.cpu_model_number < 0) {
+            info.cpu_model_number = std::atoi(value.c_str());
+        } else if (key == "flags") {
+            std::istringstream flags(value);
+            std::string flag;
+            while (flags >> flag) {
+                if (flag == "sha_ni") info.sha_ni = true;
+                else if (flag == "avx2") info.avx2 = true;
+                else if (flag == "avx512f") info.avx512f = true;
+            }
+            break;  // Flags come after vendor/model; CPU 0 is enough
+        }
+    }
+
+    info.physical_cores = static_cast<int>(cpu_topology().size());
+
+    // Walk CPU 0's cache hierarchy (index0..N: L1d, L1i, L2, L3, ...)
+    for (int i = 0; i < 8; ++i) {
+        std::string dir = "/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(i) + "/";
+        std::string level = read_line(dir + "level");
+        if (level.empty()) break;
+        std::string type = read_line(dir + "type");
+        uint64_t size = parse_cache_size(read_line(dir + "size"));
+
+        if (level == "1" && type == "Data") info.l1d_bytes = size;
+        else if (level == "2") info.l2_bytes = size;
+        if (type != "Instruction" && size > 0 && level != "1") info.llc_bytes = size;
+    }
+
+#ifdef __VERSION__
+    info.compiler = __VERSION__;
+#endif
+
+    return info;
+}
+
+uint64_t llc_size_bytes() {
+    static const uint64_t llc = [] {
+        uint64_t size = detect_host().llc_bytes;
+        return size > 0 ? size : uint64_t(32) << 20;  // Assume 32MB if unknown
+    }();
+    return llc;
+}
+
+std::string HostInfo::to_json() const {
+    std::ostringstream out;
+    out << "{\n"
+        << "  \"hostname\": \"" << json_escape(hostname) << "\",\n"
+        << "  \"kernel\": \"" << json_escape(kernel) << "\",\n"
+        << "  \"cpu_vendor\": \"" << json_escape(cpu_vendor) << "\",\n"
+        << "  \"cpu_model\": \"" << json_escape(cpu_model) << "\",\n"
+        << "  \"cpu_family\": " << cpu_family << ",\n"
+        << "  \"cpu_model_number\": " << cpu_model_number << ",\n"
+        << "  \"logical_cpus\": " << logical_cpus << ",\n"
+        << "  \"physical_cores\": " << physical_cores << ",\n"
+        << "  \"l1d_bytes\": " << l1d_bytes << ",\n"
+        << "  \"l2_bytes\": " << l2_bytes << ",\n"
+        << "  \"llc_bytes\": " << llc_bytes << ",\n"
+        << "  \"sha_ni\": " << (sha_ni ? "true" : "false") << ",\n"
+        << "  \"avx2\": " << (avx2 ? "true" : "false") << ",\n"
+        << "  \"avx512f\": " << (avx512f ? "true" : "false") << ",\n"
+        << "  \"compiler\": \"" << json_escape(compiler) << "\"\n"
+        << "}\n";
+    return out.str();
+}
+
+} // namespace bsv_bench
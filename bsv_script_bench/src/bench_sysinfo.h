@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bsv_bench {
+
+// Host description stamped into every run directory
+struct HostInfo {
+    std::string hostname;
+    std::string kernel;
+    std::string cpu_vendor;
+    std::string cpu_model;
+    int cpu_family = -1;        // From /proc/cpuinfo, -1 if unknown
+    int cpu_model_number = -1;
+    int logical_cpus = 0;
+    int physical_cores = 0;     // Distinct (package, core) pairs
+
+    // Data cache sizes seen by CPU 0 (0 if unknown)
+    uint64_t l1d_bytes = 0;
+    uint64_t l2_bytes = 0;
+    uint64_t llc_bytes = 0;
+
+    bool sha_ni = false;
+    bool avx2 = false;
+    bool avx512f = false;
+
+    std::string compiler;
+
+    std::string to_json() const;
+};
+
+// Read host details from uname, /proc/cpuinfo and sysfs
+HostInfo detect_host();
+
+// Online logical CPUs grouped by physical core (SMT siblings together),
+// ordered by each core's lowest CPU number
+std::vector<std::vector<int>> cpu_topology();
+
+// Size of the last-level cache, with a conservative fallback if unknown
+uint64_t llc_size_bytes();
+
+} // namespace bsv_bench
@@ -0,0 +1,346 @@
+// Unified benchmark driver: runs any subset of the registered benchmark
+// families over a JSON/CLI-specified parameter matrix and writes results to a
+// run directory stamped with hardware metadata.
+//
+// Example: re-run only the OP_CAT 1MB-100MB slice
+//   bsv_bench --opcode OP_CAT --set op_cat.sizes=1000000,10000000,100000000
+//             --set op_cat.asym_sizes=100000000
+
+#include "bench_harness.h"
+#include "bench_registry.h"
+#include "bench_scheduler.h"
+#include "bench_sysinfo.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <regex>
+#include <sstream>
+
+using json = nlohmann::json;
+namespace fs = std::filesystem;
+
+static void usage() {
+    std::cout <<
+        "Usage: bsv_bench [options]\n"
+        "\n"
+        "Selection:\n"
+        "  --list                  List matching cases without running them\n"
+        "  --suite NAME            Only families from suite (stack_ops, byte_ops, hash_ops, ...)\n"
+        "  --family NAME[,NAME]    Only these families\n"
+        "  --opcode OP[,OP]        Only these opcodes\n"
+        "  --filter REGEX          Regex on suite/family/opcode/param_desc\n"
+        "  --min-bytes N           Only cases with input_bytes >= N\n"
+        "  --max-bytes N           Only cases with input_bytes <= N\n"
+        "\n"
+        "Parameters:\n"
+        "  --config FILE           JSON parameter matrix (see README)\n"
+        "  --set AXIS=V1,V2,...    Override an axis, e.g. op_cat.sizes=1000000,10000000\n"
+        "  --iterations N          Fixed sampling: N iterations (warmup N/10)\n"
+        "  --adaptive              Adaptive sampling for every case\n"
+        "  --ci WIDTH              Adaptive target relative CI width (default 0.02)\n"
+        "  --budget-ms MS          Adaptive time budget per case (default 2000)\n"
+        "  --cache-mode M[,M]      warm, cold, rotating or all (default warm)\n"
+        "\n"
+        "Execution:\n"
+        "  --cpu N                 Pin to CPU N (default 0)\n"
+        "  --cpus LIST             Run cases in parallel, one pinned worker per CPU\n"
+        "                          (e.g. 2-5,8 or 'isolated' for the isolcpus set)\n"
+        "  --interference-check F  Re-run fraction F of cases serially and compare\n"
+        "  --interference-threshold T  Flag relative differences above T (default 0.05)\n"
+        "  --out DIR               Parent directory for run directories (default runs)\n";
+}
+
+static std::vector<std::string> split(const std::string& s, char sep) {
+    std::vector<std::string> parts;
+    std::stringstream ss(s);
+    std::string part;
+    while (std::getline(ss, part, sep)) {
+        if (!part.empty()) parts.push_back(part);
+    }
+    return parts;
+}
+
+static std::vector<uint64_t> parse_values(const std::string& s) {
+    std::vector<uint64_t> values;
+    for (const auto& v : split(s, ',')) {
+        values.push_back(std::stoull(v));
+    }
+    return values;
+}
+
+static std::vector<bsv_bench::CacheMode> parse_cache_modes(const std::vector<std::string>& names) {
+    std::vector<bsv_bench::CacheMode> modes;
+    for (const auto& name : names) {
+        if (name == "all") {
+            return {bsv_bench::CacheMode::WARM, bsv_bench::CacheMode::COLD,
+                    bsv_bench::CacheMode::ROTATING};
+        }
+        bsv_bench::CacheMode mode;
+        if (!bsv_bench::parse_cache_mode(name, mode)) {
+            throw std::runtime_error("Unknown cache mode: " + name);
+        }
+        modes.push_back(mode);
+    }
+    if (modes.empty()) {
+        throw std::runtime_error("No cache modes given");
+    }
+    return modes;
+}
+
+static void apply_policy_json(const json& p, bsv_bench::ParamMatrix& params) {
+    params.override_policy = true;
+    std::string mode = p.value("mode", "adaptive");
+    if (mode == "fixed") {
+        params.policy = bsv_bench::IterationPolicy::fixed(
+            p.value("iterations", 1000), p.value("warmup_iterations", 100));
+    } else if (mode == "adaptive") {
+        params.policy.mode = bsv_bench::IterationPolicy::Mode::ADAPTIVE;
+        auto& a = params.policy.adaptive;
+        a.target_rel_ci_width = p.value("target_rel_ci_width", a.target_rel_ci_width);
+        a.confidence = p.value("confidence", a.confidence);
+        a.time_budget_ms = p.value("time_budget_ms", a.time_budget_ms);
+        a.min_samples = p.value("min_samples", a.min_samples);
+        a.max_samples = p.value("max_samples", a.max_samples);
+        a.warmup_iterations = p.value("warmup_iterations", a.warmup_iterations);
+        a.reject_outliers = p.value("reject_outliers", a.reject_outliers);
+    } else {
+        throw std::runtime_error("Unknown policy mode: " + mode);
+    }
+}
+
+// Config file format:
+// {
+//   "axes":    {"op_cat.sizes": [1000000, 10000000], "depths": [1, 10]},
+//   "policy":  {"mode": "adaptive", "target_rel_ci_width": 0.02, "time_budget_ms": 2000},
+//   "cache_modes": ["warm", "cold"],
+//   "suite": "byte_ops", "families": [...], "opcodes": [...], "filter": "regex",
+//   "min_bytes": 0, "max_bytes": 100000000
+// }
+static void load_config(const std::string& path,
+                        bsv_bench::ParamMatrix& params,
+                        bsv_bench::CaseFilter& filter) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open config: " + path);
+    }
+    json config;
+    file >> config;
+
+    if (config.contains("axes")) {
+        for (auto& [axis, values] : config["axes"].items()) {
+            params.set(axis, values.get<std::vector<uint64_t>>());
+        }
+    }
+    if (config.contains("policy")) {
+        apply_policy_json(config["policy"], params);
+    }
+    if (config.contains("cache_modes")) {
+        params.cache_modes = parse_cache_modes(config["cache_modes"].get<std::vector<std::string>>());
+    }
+    filter.suite = config.value("suite", filter.suite);
+    if (config.contains("families")) {
+        filter.families = config["families"].get<std::vector<std::string>>();
+    }
+    if (config.contains("opcodes")) {
+        filter.opcodes = config["opcodes"].get<std::vector<std::string>>();
+    }
+    filter.set_regex(config.value("filter", filter.regex()));
+    filter.min_bytes = config.value("min_bytes", filter.min_bytes);
+    filter.max_bytes = config.value("max_bytes", filter.max_bytes);
+}
+
+static json effective_config(const bsv_bench::ParamMatrix& params,
+                             const bsv_bench::CaseFilter& filter) {
+    json config;
+    config["axes"] = json::object();
+    for (const auto& [axis, values] : params.axes()) {
+        config["axes"][axis] = values;
+    }
+    if (params.override_policy) {
+        const auto& p = params.policy;
+        if (p.mode == bsv_bench::IterationPolicy::Mode::FIXED) {
+            config["policy"] = {{"mode", "fixed"},
+                                {"iterations", p.iterations},
+                                {"warmup_iterations", p.warmup_iterations}};
+        } else {
+            config["policy"] = {{"mode", "adaptive"},
+                                {"target_rel_ci_width", p.adaptive.target_rel_ci_width},
+                                {"confidence", p.adaptive.confidence},
+                                {"time_budget_ms", p.adaptive.time_budget_ms}};
+        }
+    }
+    config["cache_modes"] = json::array();
+    for (auto mode : params.cache_modes) {
+        config["cache_modes"].push_back(bsv_bench::cache_mode_name(mode));
+    }
+    config["suite"] = filter.suite;
+    config["families"] = filter.families;
+    config["opcodes"] = filter.opcodes;
+    config["filter"] = filter.regex();
+    config["min_bytes"] = filter.min_bytes;
+    config["max_bytes"] = filter.max_bytes;
+    return config;
+}
+
+static std::string make_run_dir(const std::string& parent, const bsv_bench::HostInfo& host) {
+    std::time_t now = std::time(nullptr);
+    char stamp[32];
+    std::strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", std::localtime(&now));
+
+    fs::path dir = fs::path(parent) / (std::string(stamp) + "_" +
+                                       (host.hostname.empty() ? "host" : host.hostname));
+    fs::create_directories(dir);
+    return dir.string();
+}
+
+int main(int argc, char** argv) {
+    bsv_bench::ParamMatrix params;
+    bsv_bench::CaseFilter filter;
+    std::string out_parent = "runs";
+    int cpu = 0;
+    bsv_bench::SchedulerOptions scheduler;
+    bool list_only = false;
+
+    // CLI flags override the config file, so load it first
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--config" && i + 1 < argc) {
+            try {
+                load_config(argv[i + 1], params, filter);
+            } catch (const std::exception& e) {
+                std::cerr << "Error: " << e.what() << "\n";
+                return 1;
+            }
+        }
+    }
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto next = [&]() -> std::string {
+                if (i + 1 >= argc) throw std::runtime_error(arg + " requires a value");
+                return argv[++i];
+            };
+
+            if (arg == "-h" || arg == "--help") {
+                usage();
+                return 0;
+            } else if (arg == "--list") {
+                list_only = true;
+            } else if (arg == "--config") {
+                next();  // Already loaded
+            } else if (arg == "--suite") {
+                filter.suite = next();
+            } else if (arg == "--family") {
+                filter.families = split(next(), ',');
+            } else if (arg == "--opcode") {
+                filter.opcodes = split(next(), ',');
+            } else if (arg == "--filter") {
+                filter.set_regex(next());
+            } else if (arg == "--min-bytes") {
+                filter.min_bytes = std::stoull(next());
+            } else if (arg == "--max-bytes") {
+                filter.max_bytes = std::stoull(next());
+            } else if (arg == "--set") {
+                std::string assignment = next();
+                auto eq = assignment.find('=');
+                if (eq == std::string::npos) {
+                    throw std::runtime_error("--set expects AXIS=V1,V2,...");
+                }
+                params.set(assignment.substr(0, eq), parse_values(assignment.substr(eq + 1)));
+            } else if (arg == "--iterations") {
+                int n = std::stoi(next());
+                params.override_policy = true;
+                params.policy = bsv_bench::IterationPolicy::fixed(n, std::max(1, n / 10));
+            } else if (arg == "--adaptive") {
+                params.override_policy = true;
+                params.policy.mode = bsv_bench::IterationPolicy::Mode::ADAPTIVE;
+            } else if (arg == "--ci") {
+                params.override_policy = true;
+                params.policy.mode = bsv_bench::IterationPolicy::Mode::ADAPTIVE;
+                params.policy.adaptive.target_rel_ci_width = std::stod(next());
+            } else if (arg == "--budget-ms") {
+                params.override_policy = true;
+                params.policy.mode = bsv_bench::IterationPolicy::Mode::ADAPTIVE;
+                params.policy.adaptive.time_budget_ms = std::stoull(next());
+            } else if (arg == "--cache-mode") {
+                params.cache_modes = parse_cache_modes(split(next(), ','));
+            } else if (arg == "--cpu") {
+                cpu = std::stoi(next());
+            } else if (arg == "--cpus") {
+                scheduler.cpus = bsv_bench::parse_cpu_list(next());
+            } else if (arg == "--interference-check") {
+                scheduler.interference_fraction = std::stod(next());
+            } else if (arg == "--interference-threshold") {
+                scheduler.interference_threshold = std::stod(next());
+            } else if (arg == "--out") {
+                out_parent = next();
+            } else {
+                throw std::runtime_error("Unknown option: " + arg);
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n\n";
+        usage();
+        return 1;
+    }
+
+    std::vector<bsv_bench::BenchCase> cases = bsv_bench::BenchRegistry::instance().collect(params, filter);
+
+    if (list_only) {
+        for (const auto& c : cases) {
+            std::cout << bsv_bench::case_id(c) << "  (" << c.input_bytes << " bytes)\n";
+        }
+        std::cout << cases.size() << " cases\n";
+        return 0;
+    }
+
+    if (cases.empty()) {
+        std::cerr << "No benchmark cases match the selection\n";
+        return 1;
+    }
+
+    bsv_bench::HostInfo host = bsv_bench::detect_host();
+    std::string run_dir = make_run_dir(out_parent, host);
+
+    std::ofstream(run_dir + "/hardware.json") << host.to_json();
+    json config = effective_config(params, filter);
+    config["cpus"] = scheduler.cpus.empty() ? std::vector<int>{cpu} : scheduler.cpus;
+    std::ofstream(run_dir + "/config.json") << config.dump(2) << "\n";
+
+    std::cout << "=== BSV Script Benchmark ===\n";
+    std::cout << cases.size() << " cases on " << host.cpu_model << "\n";
+    std::cout << "Run directory: " << run_dir << "\n\n";
+
+    bsv_bench::BenchmarkHarness harness;
+    std::vector<bsv_bench::BenchResult> results;
+
+    if (scheduler.cpus.empty()) {
+        harness.initialize(cpu);
+        results = bsv_bench::run_cases(harness, cases);
+    } else {
+        std::cout << "Running on " << scheduler.cpus.size() << " pinned workers\n";
+        std::vector<bsv_bench::InterferenceCheck> checks;
+        results = bsv_bench::run_cases_parallel(cases, scheduler, &checks);
+
+        if (!checks.empty()) {
+            std::ofstream(run_dir + "/interference.json")
+                << bsv_bench::interference_to_json(cases, checks);
+            size_t flagged = std::count_if(checks.begin(), checks.end(),
+                [](const bsv_bench::InterferenceCheck& c) { return c.flagged; });
+            if (flagged > 0) {
+                std::cout << "\nWarning: " << flagged << " of " << checks.size()
+                          << " re-run cases differ from their parallel measurement; "
+                          << "use fewer workers or serial mode for this profile\n";
+            }
+        }
+    }
+
+    harness.export_csv(results, run_dir + "/results.csv");
+    harness.export_json(results, run_dir + "/results.json");
+
+    std::cout << "\n=== Results exported to " << run_dir << "\n";
+    return 0;
+}
@@ -0,0 +1,647 @@
+#include "model_fit.h"
+#include "bench_harness.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <regex>
+#include <stdexcept>
+
+namespace bsv_bench {
+
+FitPoint to_fit_point(const BenchResult& result) {
+    FitPoint p;
+    p.opcode = result.opcode;
+    p.param_desc = result.param_desc;
+    p.input_bytes = result.input_bytes;
+    p.cycles = result.median_cycles;
+    p.ci_low = result.ci_low_cycles;
+    p.ci_high = result.ci_high_cycles;
+    return p;
+}
+
+const char* model_form_name(ModelForm form) {
+    switch (form) {
+        case ModelForm::CONSTANT: return "constant";
+        case ModelForm::LINEAR: return "linear";
+        case ModelForm::PIECEWISE: return "piecewise";
+        case ModelForm::SIGNATURE: return "signature";
+        case ModelForm::MULTISIG: return "multisig";
+        case ModelForm::QUADRATIC: return "quadratic";
+        case ModelForm::NLOGN: return "nlogn";
+    }
+    return "constant";
+}
+
+bool parse_model_form(const std::string& name, ModelForm& form) {
+    if (name == "constant") form = ModelForm::CONSTANT;
+    else if (name == "linear") form = ModelForm::LINEAR;
+    else if (name == "piecewise") form = ModelForm::PIECEWISE;
+    else if (name == "signature") form = ModelForm::SIGNATURE;
+    else if (name == "multisig") form = ModelForm::MULTISIG;
+    else if (name == "quadratic") form = ModelForm::QUADRATIC;
+    else if (name == "nlogn") form = ModelForm::NLOGN;
+    else return false;
+    return true;
+}
+
+const char* weighting_name(Weighting weighting) {
+    switch (weighting) {
+        case Weighting::NONE: return "none";
+        case Weighting::RELATIVE: return "relative";
+        case Weighting::CI: return "ci";
+    }
+    return "none";
+}
+
+bool parse_weighting(const std::string& name, Weighting& weighting) {
+    if (name == "none") weighting = Weighting::NONE;
+    else if (name == "relative") weighting = Weighting::RELATIVE;
+    else if (name == "ci") weighting = Weighting::CI;
+    else return false;
+    return true;
+}
+
+bool parse_multisig_params(const std::string& param_desc, uint64_t& m, uint64_t& n) {
+    std::smatch match;
+    static const std::regex of_form(R"((\d+)-of-(\d+))");
+    if (std::regex_search(param_desc, match, of_form)) {
+        m = std::stoull(match[1]);
+        n = std::stoull(match[2]);
+        return true;
+    }
+
+    static const std::regex m_form(R"((?:^|[^A-Za-z_])m=(\d+))");
+    static const std::regex n_form(R"((?:^|[^A-Za-z_])n=(\d+))");
+    std::smatch m_match, n_match;
+    if (std::regex_search(param_desc, m_match, m_form) &&
+        std::regex_search(param_desc, n_match, n_form)) {
+        m = std::stoull(m_match[1]);
+        n = std::stoull(n_match[1]);
+        return true;
+    }
+    return false;
+}
+
+// Solve min ||A x - b|| over the columns marked in `use` via modified
+// Gram-Schmidt QR. Columns that are numerically dependent on earlier ones
+// get a zero coefficient.
+static std::vector<double> least_squares(const std::vector<std::vector<double>>& cols,
+                                         const std::vector<double>& b,
+                                         const std::vector<bool>& use) {
+    const size_t k = cols.size();
+    const size_t m = b.size();
+
+    std::vector<std::vector<double>> q;
+    std::vector<size_t> accepted;
+    std::vector<std::vector<double>> r(k, std::vector<double>(k, 0.0));
+
+    for (size_t j = 0; j < k; ++j) {
+        if (!use[j]) continue;
+
+        std::vector<double> v = cols[j];
+        double original = 0;
+        for (double e : v) original += e * e;
+        original = std::sqrt(original);
+        if (original == 0) continue;
+
+        // Two passes of orthogonalization for stability
+        for (int pass = 0; pass < 2; ++pass) {
+            for (size_t l = 0; l < q.size(); ++l) {
+                double dot = 0;
+                for (size_t i = 0; i < m; ++i) dot += q[l][i] * v[i];
+                for (size_t i = 0; i < m; ++i) v[i] -= dot * q[l][i];
+                r[l][j] += dot;
+            }
+        }
+
+        double norm = 0;
+        for (double e : v) norm += e * e;
+        norm = std::sqrt(norm);
+        if (norm <= 1e-10 * original) {
+            for (size_t l = 0; l < q.size(); ++l) r[l][j] = 0;
+            continue;
+        }
+
+        for (double& e : v) e /= norm;
+        r[q.size()][j] = norm;
+        q.push_back(std::move(v));
+        accepted.push_back(j);
+    }
+
+    // Back substitution on R x = Q^T b
+    std::vector<double> x(k, 0.0);
+    for (size_t l = accepted.size(); l-- > 0;) {
+        double rhs = 0;
+        for (size_t i = 0; i < m; ++i) rhs += q[l][i] * b[i];
+        for (size_t t = l + 1; t < accepted.size(); ++t) {
+            rhs -= r[l][accepted[t]] * x[accepted[t]];
+        }
+        x[accepted[l]] = rhs / r[l][accepted[l]];
+    }
+    return x;
+}
+
+std::vector<double> nnls(const std::vector<std::vector<double>>& rows,
+                         const std::vector<double>& y,
+                         const std::vector<double>& weights) {
+    if (rows.empty()) return {};
+    const size_t m = rows.size();
+    const size_t k = rows[0].size();
+
+    // Weighted, column-normalized design so bytes (1e8) and constants (1)
+    // are on the same scale
+    std::vector<std::vector<double>> cols(k, std::vector<double>(m));
+    std::vector<double> b(m);
+    std::vector<double> scale(k, 0.0);
+    for (size_t i = 0; i < m; ++i) {
+        double sw = std::sqrt(weights[i]);
+        b[i] = sw * y[i];
+        for (size_t j = 0; j < k; ++j) {
+            cols[j][i] = sw * rows[i][j];
+            scale[j] += cols[j][i] * cols[j][i];
+        }
+    }
+    for (size_t j = 0; j < k; ++j) {
+        scale[j] = scale[j] > 0 ? std::sqrt(scale[j]) : 1.0;
+        for (double& e : cols[j]) e /= scale[j];
+    }
+
+    double b_norm = 0;
+    for (double e : b) b_norm += e * e;
+    const double tolerance = 1e-12 * std::sqrt(b_norm);
+
+    std::vector<double> x(k, 0.0);
+    std::vector<bool> passive(k, false);
+
+    for (size_t outer = 0; outer < 3 * k + 10; ++outer) {
+        // Gradient of the objective w.r.t. each active (zero) coefficient
+        std::vector<double> residual = b;
+        for (size_t j = 0; j < k; ++j) {
+            if (x[j] == 0) continue;
+            for (size_t i = 0; i < m; ++i) residual[i] -= cols[j][i] * x[j];
+        }
+
+        size_t best = k;
+        double best_gradient = tolerance;
+        for (size_t j = 0; j < k; ++j) {
+            if (passive[j]) continue;
+            double gradient = 0;
+            for (size_t i = 0; i < m; ++i) gradient += cols[j][i] * residual[i];
+            if (gradient > best_gradient) {
+                best_gradient = gradient;
+                best = j;
+            }
+        }
+        if (best == k) break;
+        passive[best] = true;
+
+        // Inner loop: step back towards feasibility until the passive-set
+        // solution is strictly positive
+        for (size_t inner = 0; inner <= k; ++inner) {
+            std::vector<double> z = least_squares(cols, b, passive);
+
+            bool feasible = true;
+            double alpha = 1.0;
+            for (size_t j = 0; j < k; ++j) {
+                if (passive[j] && z[j] <= 0) {
+                    feasible = false;
+                    double denom = x[j] - z[j];
+                    if (denom > 0) alpha = std::min(alpha, x[j] / denom);
+                    else alpha = 0;
+                }
+            }
+            if (feasible) {
+                x = z;
+                break;
+            }
+
+            for (size_t j = 0; j < k; ++j) {
+                x[j] += alpha * (z[j] - x[j]);
+                if (passive[j] && x[j] <= 1e-15) {
+                    passive[j] = false;
+                    x[j] = 0;
+                }
+            }
+        }
+    }
+
+    for (size_t j = 0; j < k; ++j) {
+        x[j] = std::max(0.0, x[j] / scale[j]);
+    }
+    return x;
+}
+
+static double base_weight(const FitPoint& p, Weighting weighting) {
+    double y = std::max(p.cycles, 1.0);
+    switch (weighting) {
+        case Weighting::NONE:
+            return 1.0;
+        case Weighting::RELATIVE:
+            return 1.0 / (y * y);
+        case Weighting::CI:
+            if (p.ci_high > p.ci_low) {
+                // 95% CI half-width -> standard error, floored so a lucky
+                // zero-width CI can't dominate the fit
+                double sigma = (p.ci_high - p.ci_low) / (2.0 * 1.96);
+                sigma = std::max({sigma, 0.005 * y, 0.5});
+                return 1.0 / (sigma * sigma);
+            }
+            // No CI recorded: assume a 1% standard error
+            return 1.0 / (0.0001 * y * y);
+    }
+    return 1.0;
+}
+
+static std::vector<std::string> coefficient_names(ModelForm form) {
+    switch (form) {
+        case ModelForm::CONSTANT: return {"c0"};
+        case ModelForm::LINEAR: return {"c0", "c1"};
+        case ModelForm::PIECEWISE: return {};
+        case ModelForm::SIGNATURE: return {"c_ecdsa", "c_preimage_per_byte"};
+        case ModelForm::MULTISIG: return {"c_ecdsa", "c_preimage_per_byte", "c_keyscan", "c_setup"};
+        case ModelForm::QUADRATIC:
+        case ModelForm::NLOGN: return {"c0", "c1", "c2"};
+    }
+    return {};
+}
+
+static std::vector<double> design_row(ModelForm form, const FitPoint& p) {
+    double x = static_cast<double>(p.input_bytes);
+    switch (form) {
+        case ModelForm::CONSTANT:
+            return {1.0};
+        case ModelForm::LINEAR:
+        case ModelForm::PIECEWISE:
+        case ModelForm::SIGNATURE:
+            return {1.0, x};
+        case ModelForm::MULTISIG: {
+            uint64_t m = 0, n = 0;
+            if (!parse_multisig_params(p.param_desc, m, n)) {
+                throw std::invalid_argument("multisig case without m/n: " + p.param_desc);
+            }
+            double dm = static_cast<double>(m);
+            return {dm, dm * x, static_cast<double>(n > m ? n - m : 0), 1.0};
+        }
+        case ModelForm::QUADRATIC:
+            return {1.0, x, x * x};
+        case ModelForm::NLOGN:
+            // Same log as the estimator: log2(n), 0 below 2 bytes
+            return {1.0, x, x > 1 ? x * std::log2(x) : 0.0};
+    }
+    return {1.0};
+}
+
+double ModelFit::coefficient(const std::string& name) const {
+    for (const auto& [n, value] : coefficients) {
+        if (n == name) return value;
+    }
+    return 0.0;
+}
+
+double ModelFit::predict(const FitPoint& point) const {
+    if (form == ModelForm::PIECEWISE) {
+        size_t segment = std::upper_bound(breakpoints.begin(), breakpoints.end(),
+                                          point.input_bytes) - breakpoints.begin();
+        const auto& [c0, c1] = segments[segment];
+        return c0 + c1 * static_cast<double>(point.input_bytes);
+    }
+
+    std::vector<double> row = design_row(form, point);
+    double value = 0;
+    for (size_t j = 0; j < row.size() && j < coefficients.size(); ++j) {
+        value += row[j] * coefficients[j].second;
+    }
+    return value;
+}
+
+// Weighted NNLS, then Huber IRLS if requested
+static std::vector<double> fit_design(const std::vector<std::vector<double>>& rows,
+                                      const std::vector<double>& y,
+                                      const std::vector<double>& weights,
+                                      const FitOptions& options,
+                                      FitDiagnostics& diagnostics) {
+    std::vector<double> x = nnls(rows, y, weights);
+    diagnostics.iterations = 1;
+    if (!options.robust) return x;
+
+    const size_t m = rows.size();
+    std::vector<double> robust_weights(m, 1.0);
+
+    for (int it = 1; it < options.max_iterations; ++it) {
+        std::vector<double> scaled(m);
+        std::vector<double> abs_scaled(m);
+        for (size_t i = 0; i < m; ++i) {
+            double prediction = 0;
+            for (size_t j = 0; j < x.size(); ++j) prediction += rows[i][j] * x[j];
+            scaled[i] = (y[i] - prediction) * std::sqrt(weights[i]);
+            abs_scaled[i] = std::fabs(scaled[i]);
+        }
+
+        // Robust scale estimate: normalized median absolute residual
+        std::nth_element(abs_scaled.begin(), abs_scaled.begin() + m / 2, abs_scaled.end());
+        double s = 1.4826 * abs_scaled[m / 2];
+        if (s <= 0) break;
+
+        std::vector<double> w(m);
+        for (size_t i = 0; i < m; ++i) {
+            double u = std::fabs(scaled[i]) / s;
+            robust_weights[i] = u <= options.huber_k ? 1.0 : options.huber_k / u;
+            w[i] = weights[i] * robust_weights[i];
+        }
+
+        std::vector<double> next = nnls(rows, y, w);
+        diagnostics.iterations++;
+
+        bool converged = true;
+        for (size_t j = 0; j < x.size(); ++j) {
+            if (std::fabs(next[j] - x[j]) > 1e-8 * (std::fabs(x[j]) + 1e-12)) {
+                converged = false;
+            }
+        }
+        x = std::move(next);
+        if (converged) break;
+    }
+
+    diagnostics.downweighted = 0;
+    for (double u : robust_weights) {
+        if (u < 1.0) diagnostics.downweighted++;
+    }
+    return x;
+}
+
+static void compute_diagnostics(ModelFit& fit, const std::vector<FitPoint>& points,
+                                const std::vector<double>& weights, size_t parameters) {
+    FitDiagnostics& d = fit.diagnostics;
+    d.points = points.size();
+    d.parameters = parameters;
+
+    double sum_w = 0, sum_wy = 0;
+    for (size_t i = 0; i < points.size(); ++i) {
+        sum_w += weights[i];
+        sum_wy += weights[i] * points[i].cycles;
+    }
+    double mean_y = sum_w > 0 ? sum_wy / sum_w : 0;
+
+    double ss_res = 0, ss_tot = 0, sum_rel2 = 0;
+    d.max_rel_error = 0;
+    for (size_t i = 0; i < points.size(); ++i) {
+        double y = points[i].cycles;
+        double residual = y - fit.predict(points[i]);
+        ss_res += weights[i] * residual * residual;
+        ss_tot += weights[i] * (y - mean_y) * (y - mean_y);
+
+        double rel = std::fabs(residual) / std::max(y, 1.0);
+        sum_rel2 += rel * rel;
+        d.max_rel_error = std::max(d.max_rel_error, rel);
+    }
+
+    d.r_squared = ss_tot > 0 ? 1.0 - ss_res / ss_tot : (ss_res == 0 ? 1.0 : 0.0);
+    d.rms_rel_error = points.empty() ? 0 : std::sqrt(sum_rel2 / points.size());
+
+    // Weights are normalized to mean 1 so the likelihood term is comparable
+    // across forms fitted to the same points
+    double n = static_cast<double>(points.size());
+    double k = static_cast<double>(parameters);
+    double normalized_rss = sum_w > 0 ? ss_res * n / sum_w : ss_res;
+    if (n - k - 1 > 0) {
+        d.aicc = n * std::log(std::max(normalized_rss / n, 1e-300)) + 2 * k +
+                 2 * k * (k + 1) / (n - k - 1);
+    } else {
+        d.aicc = std::numeric_limits<double>::infinity();
+    }
+
+    d.clamped.clear();
+    for (const auto& [name, value] : fit.coefficients) {
+        if (value == 0.0) d.clamped.push_back(name);
+    }
+    for (size_t s = 0; s < fit.segments.size(); ++s) {
+        if (fit.segments[s].first == 0.0) d.clamped.push_back("segments[" + std::to_string(s) + "].c0");
+        if (fit.segments[s].second == 0.0) d.clamped.push_back("segments[" + std::to_string(s) + "].c1");
+    }
+}
+
+static ModelFit fit_piecewise(const std::vector<FitPoint>& points, const FitOptions& options,
+                              const std::vector<double>& weights) {
+    ModelFit fit;
+    fit.form = ModelForm::PIECEWISE;
+
+    std::vector<uint64_t> breakpoints = options.breakpoints;
+    std::sort(breakpoints.begin(), breakpoints.end());
+    breakpoints.erase(std::unique(breakpoints.begin(), breakpoints.end()), breakpoints.end());
+
+    auto segment_of = [&breakpoints](uint64_t bytes) {
+        return static_cast<size_t>(std::upper_bound(breakpoints.begin(), breakpoints.end(), bytes) -
+                                   breakpoints.begin());
+    };
+
+    // Merge segments that can't support a line of their own
+    while (!breakpoints.empty()) {
+        std::vector<size_t> counts(breakpoints.size() + 1, 0);
+        for (const auto& p : points) counts[segment_of(p.input_bytes)]++;
+
+        auto sparse = std::find_if(counts.begin(), counts.end(), [](size_t c) { return c < 2; });
+        if (sparse == counts.end()) break;
+
+        size_t segment = sparse - counts.begin();
+        breakpoints.erase(breakpoints.begin() + (segment > 0 ? segment - 1 : 0));
+    }
+
+    fit.breakpoints = breakpoints;
+    fit.segments.assign(breakpoints.size() + 1, {0.0, 0.0});
+
+    for (size_t s = 0; s < fit.segments.size(); ++s) {
+        std::vector<std::vector<double>> rows;
+        std::vector<double> y, w;
+        for (size_t i = 0; i < points.size(); ++i) {
+            if (segment_of(points[i].input_bytes) != s) continue;
+            rows.push_back(design_row(ModelForm::LINEAR, points[i]));
+            y.push_back(points[i].cycles);
+            w.push_back(weights[i]);
+        }
+        if (rows.empty()) continue;
+
+        FitDiagnostics segment_diagnostics;
+        std::vector<double> x = fit_design(rows, y, w, options, segment_diagnostics);
+        fit.segments[s] = {x[0], x[1]};
+        fit.diagnostics.iterations = std::max(fit.diagnostics.iterations,
+                                              segment_diagnostics.iterations);
+        fit.diagnostics.downweighted += segment_diagnostics.downweighted;
+    }
+
+    // Two coefficients per segment plus each breakpoint
+    compute_diagnostics(fit, points, weights, 3 * fit.segments.size() - 1);
+    return fit;
+}
+
+ModelFit fit_model(ModelForm form, const std::vector<FitPoint>& points,
+                   const FitOptions& options) {
+    if (points.empty()) {
+        throw std::invalid_argument("fit_model: no points");
+    }
+
+    std::vector<double> weights;
+    weights.reserve(points.size());
+    for (const auto& p : points) {
+        weights.push_back(base_weight(p, options.weighting));
+    }
+
+    if (form == ModelForm::PIECEWISE) {
+        return fit_piecewise(points, options, weights);
+    }
+
+    std::vector<std::vector<double>> rows;
+    std::vector<double> y;
+    for (const auto& p : points) {
+        rows.push_back(design_row(form, p));
+        y.push_back(p.cycles);
+    }
+
+    ModelFit fit;
+    fit.form = form;
+    std::vector<double> x = fit_design(rows, y, weights, options, fit.diagnostics);
+
+    std::vector<std::string> names = coefficient_names(form);
+    for (size_t j = 0; j < names.size(); ++j) {
+        fit.coefficients.emplace_back(names[j], x[j]);
+    }
+
+    compute_diagnostics(fit, points, weights, names.size());
+    return fit;
+}
+
+std::vector<uint64_t> detect_breakpoints(const std::vector<FitPoint>& points,
+                                         const std::vector<uint64_t>& cache_sizes,
+                                         const FitOptions& options,
+                                         size_t max_breakpoints) {
+    std::vector<uint64_t> sizes;
+    for (const auto& p : points) sizes.push_back(p.input_bytes);
+    std::sort(sizes.begin(), sizes.end());
+    sizes.erase(std::unique(sizes.begin(), sizes.end()), sizes.end());
+
+    std::vector<uint64_t> candidates;
+    for (size_t i = 0; i + 1 < sizes.size(); ++i) {
+        double gap = std::sqrt(static_cast<double>(sizes[i]) * static_cast<double>(sizes[i + 1]));
+        uint64_t candidate = std::max<uint64_t>(static_cast<uint64_t>(std::ceil(gap)), sizes[i] + 1);
+
+        bool near_cache = cache_sizes.empty();
+        for (uint64_t cache : cache_sizes) {
+            if (cache > 0 && candidate >= cache / 4 && candidate <= cache * 4) near_cache = true;
+        }
+        if (near_cache) candidates.push_back(candidate);
+    }
+
+    FitOptions trial_options = options;
+    trial_options.breakpoints.clear();
+    std::vector<uint64_t> chosen;
+    double best_aicc = fit_model(ModelForm::PIECEWISE, points, trial_options).diagnostics.aicc;
+
+    while (chosen.size() < max_breakpoints) {
+        uint64_t best_candidate = 0;
+        double candidate_aicc = best_aicc;
+
+        for (uint64_t candidate : candidates) {
+            if (std::find(chosen.begin(), chosen.end(), candidate) != chosen.end()) continue;
+
+            trial_options.breakpoints = chosen;
+            trial_options.breakpoints.push_back(candidate);
+            ModelFit fit = fit_model(ModelForm::PIECEWISE, points, trial_options);
+
+            // Skip splits that left a segment too sparse to fit
+            if (fit.breakpoints.size() != trial_options.breakpoints.size()) continue;
+
+            double aicc = fit.diagnostics.aicc;
+            bool improves = std::isfinite(aicc) &&
+                            (!std::isfinite(best_aicc) || aicc < best_aicc - 2.0);
+            if (improves && (best_candidate == 0 || aicc < candidate_aicc)) {
+                best_candidate = candidate;
+                candidate_aicc = aicc;
+            }
+        }
+
+        if (best_candidate == 0) break;
+        chosen.push_back(best_candidate);
+        best_aicc = candidate_aicc;
+    }
+
+    std::sort(chosen.begin(), chosen.end());
+    return chosen;
+}
+
+ModelFit fit_best(const std::vector<ModelForm>& forms, const std::vector<FitPoint>& points,
+                  const FitOptions& options, std::vector<ModelFit>* candidates) {
+    if (forms.empty()) {
+        throw std::invalid_argument("fit_best: no candidate forms");
+    }
+
+    std::vector<ModelFit> fits;
+    for (ModelForm form : forms) {
+        fits.push_back(fit_model(form, points, options));
+    }
+
+    // Lowest AICc; with too few points for AICc, lowest worst-case error
+    auto best = std::min_element(fits.begin(), fits.end(), [](const ModelFit& a, const ModelFit& b) {
+        bool a_finite = std::isfinite(a.diagnostics.aicc);
+        bool b_finite = std::isfinite(b.diagnostics.aicc);
+        if (a_finite != b_finite) return a_finite;
+        if (a_finite) return a.diagnostics.aicc < b.diagnostics.aicc;
+        return a.diagnostics.max_rel_error < b.diagnostics.max_rel_error;
+    });
+    ModelFit chosen = *best;
+    if (candidates) *candidates = std::move(fits);
+    return chosen;
+}
+
+std::map<long, std::map<uint64_t, double>> batch_hash_costs(const std::vector<FitPoint>& points,
+                                                            const std::string& kernel) {
+    std::map<long, std::map<uint64_t, double>> by_batch;
+    std::string prefix = kernel + ", ";
+    for (const auto& p : points) {
+        if (p.param_desc.compare(0, prefix.size(), prefix) != 0) continue;
+        long batch = std::stol(p.param_desc.substr(prefix.size()));
+        if (batch > 0) by_batch[batch][p.input_bytes / batch] = p.cycles / batch;
+    }
+    return by_batch;
+}
+
+double batch_hash_slope(const std::map<uint64_t, double>& costs, const FitOptions& options) {
+    if (costs.size() < 2) return -1;
+    std::vector<FitPoint> points;
+    for (const auto& [length, cycles] : costs) {
+        FitPoint p;
+        p.input_bytes = length;
+        p.cycles = cycles;
+        points.push_back(p);
+    }
+    return fit_model(ModelForm::LINEAR, points, options).coefficient("c1");
+}
+
+// It scales a per-byte coefficient, so it must come from slopes. Whole-message
+// ratios of preimage-sized messages are dominated by OpenSSL's per-call setup
+// and would price a multi-MB preimage far too cheaply; that saving is left
+// unpriced. Batch sizes other than validation's are not candidates: a smaller
+// batch leaves multi-buffer lanes idle, and a larger one isn't what the node
+// runs.
+double batch_hash_ratio(const std::vector<FitPoint>& points, const FitOptions& options,
+                        long validation_batch, std::string& kernel, long& batch) {
+    double serial = batch_hash_slope(batch_hash_costs(points, "openssl")[1], options);
+    if (serial <= 0) return -1;
+
+    std::vector<std::string> candidates = {"scalar", "shani", "avx2"};
+    if (kernel != "best") candidates = {kernel};
+    double best = -1;
+    for (const auto& name : candidates) {
+        auto by_batch = batch_hash_costs(points, name);
+        if (by_batch.empty()) continue;
+        auto at = by_batch.lower_bound(validation_batch);
+        if (at == by_batch.end()) --at;
+        double slope = batch_hash_slope(at->second, options);
+        if (slope >= 0 && (best < 0 || slope / serial < best)) {
+            best = slope / serial;
+            kernel = name;
+            batch = at->first;
+        }
+    }
+    return best;
+}
+
+} // namespace bsv_bench
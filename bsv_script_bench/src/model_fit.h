@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bsv_bench {
+
+struct BenchResult;
+
+// One measured benchmark case as seen by the model fitter
+struct FitPoint {
+    std::string opcode;
+    std::string param_desc;
+    std::string cache_mode;
+    uint64_t input_bytes = 0;
+    double cycles = 0;      // Statistic being fitted (median by default)
+    double ci_low = 0;      // Confidence interval of the median, 0 if unknown
+    double ci_high = 0;
+    double page_faults = 0; // Faults per sample, 0 if not recorded
+};
+
+// A result measured in-process, fitted by its median as bsv_fit_model does
+FitPoint to_fit_point(const BenchResult& result);
+
+// Cost model forms understood by the estimator
+enum class ModelForm {
+    CONSTANT,   // c0
+    LINEAR,     // c0 + c1*n
+    PIECEWISE,  // c0[i] + c1[i]*n for n in segment i
+    SIGNATURE,  // c_ecdsa + c_preimage_per_byte*preimage
+    MULTISIG,   // m*(c_ecdsa + c_preimage_per_byte*preimage) + (n-m)*c_keyscan + c_setup
+    QUADRATIC,  // c0 + c1*n + c2*n^2 (schoolbook big-number multiply/divide)
+    NLOGN       // c0 + c1*n + c2*n*log2(n)
+};
+
+const char* model_form_name(ModelForm form);
+bool parse_model_form(const std::string& name, ModelForm& form);
+
+// How much each point counts in the fit
+enum class Weighting {
+    NONE,       // Plain least squares (large inputs dominate)
+    RELATIVE,   // 1/y^2: minimizes relative error across sizes
+    CI          // 1/sigma^2 from the median's CI, falling back to RELATIVE
+};
+
+const char* weighting_name(Weighting weighting);
+bool parse_weighting(const std::string& name, Weighting& weighting);
+
+struct FitOptions {
+    Weighting weighting = Weighting::CI;
+
+    // Huber M-estimation via iteratively reweighted least squares; points
+    // with standardized residuals beyond huber_k get weight k/|r|
+    bool robust = true;
+    double huber_k = 1.345;
+    int max_iterations = 50;
+
+    // Segment boundaries in bytes for PIECEWISE: breakpoints[i] is the
+    // first size in segment i+1. Segments with fewer than two points are
+    // merged into their neighbour.
+    std::vector<uint64_t> breakpoints;
+};
+
+struct FitDiagnostics {
+    size_t points = 0;
+    size_t parameters = 0;
+    double r_squared = 0;       // Weighted, using the base (non-robust) weights
+    double rms_rel_error = 0;
+    double max_rel_error = 0;
+    double aicc = 0;            // Corrected AIC, infinite if too few points
+    int iterations = 0;         // IRLS iterations
+    size_t downweighted = 0;    // Points with a Huber weight below 1
+    std::vector<std::string> clamped;   // Coefficients held at 0 by the constraint
+};
+
+// Result of fitting one form to one opcode's points. All coefficients are
+// non-negative.
+struct ModelFit {
+    ModelForm form = ModelForm::CONSTANT;
+
+    // Named coefficients in estimator JSON naming (c0, c1, c_ecdsa, ...)
+    std::vector<std::pair<std::string, double>> coefficients;
+
+    // PIECEWISE only: segments.size() == breakpoints.size() + 1, each (c0, c1)
+    std::vector<uint64_t> breakpoints;
+    std::vector<std::pair<double, double>> segments;
+
+    FitDiagnostics diagnostics;
+
+    double coefficient(const std::string& name) const;
+    double predict(const FitPoint& point) const;
+};
+
+// Fit a single form. Throws std::invalid_argument if there are no points or
+// a MULTISIG point lacks m/n in its param_desc.
+ModelFit fit_model(ModelForm form, const std::vector<FitPoint>& points,
+                   const FitOptions& options);
+
+// Fit every candidate form and return the one with the lowest AICc. All
+// candidate fits are stored in `candidates` if given.
+ModelFit fit_best(const std::vector<ModelForm>& forms, const std::vector<FitPoint>& points,
+                  const FitOptions& options, std::vector<ModelFit>* candidates = nullptr);
+
+// Choose PIECEWISE breakpoints from the data. Candidates are the gaps between
+// adjacent measured sizes (at their geometric mean); with cache_sizes given
+// (L1d, L2, LLC - the last one being the LLC/DRAM transition), only gaps
+// within a factor of 4 of a cache size are considered, since an opcode's
+// working set is a small multiple of its input. Breakpoints are added
+// greedily while each one lowers AICc by at least 2, up to max_breakpoints.
+std::vector<uint64_t> detect_breakpoints(const std::vector<FitPoint>& points,
+                                         const std::vector<uint64_t>& cache_sizes,
+                                         const FitOptions& options,
+                                         size_t max_breakpoints = 8);
+
+// Non-negative least squares (Lawson-Hanson) on weighted rows:
+// minimize sum w_i (y_i - rows_i . x)^2 subject to x >= 0
+std::vector<double> nnls(const std::vector<std::vector<double>>& rows,
+                         const std::vector<double>& y,
+                         const std::vector<double>& weights);
+
+// Extract m and n from a multisig case description ("m=2,n=3" or "2-of-3")
+bool parse_multisig_params(const std::string& param_desc, uint64_t& m, uint64_t& n);
+
+// Cycles per message of one kernel's SHA256_BATCH/RIPEMD160_BATCH points
+// ("<kernel>, <batch> x <len>B"), by batch size and message length
+std::map<long, std::map<uint64_t, double>> batch_hash_costs(const std::vector<FitPoint>& points,
+                                                            const std::string& kernel);
+
+// Per-byte slope c1 of cycles per message against message length, -1 with
+// fewer than two lengths
+double batch_hash_slope(const std::map<uint64_t, double>& costs, const FitOptions& options);
+
+// Per-byte cost of batched SHA-256 relative to OpenSSL hashing one message
+// at a time, from SHA256_BATCH points: a kernel's slope at the batch size
+// validation hashes preimages in (the smallest measured batch of at least
+// validation_batch, else the largest) over OpenSSL's slope at batch 1.
+// kernel is "best" (the cheapest of scalar, shani and avx2 at that batch)
+// or a kernel name, and is set to the kernel used, batch to its batch size.
+// -1 without the results to compare.
+double batch_hash_ratio(const std::vector<FitPoint>& points, const FitOptions& options,
+                        long validation_batch, std::string& kernel, long& batch);
+
+} // namespace bsv_bench
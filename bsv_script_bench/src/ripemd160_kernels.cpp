@@ -0,0 +1,240 @@
+#include "ripemd160_kernels.h"
+#include <algorithm>
+#include <cstring>
+#if defined(__x86_64__) || defined(__i386__)
+#define BSV_BENCH_X86 1
+#endif
+
+// Written with GCC/Clang vector extensions rather than intrinsics: the same
+// template compiles to scalar, SSE2 or (inlined into a target("avx2")
+// function) AVX2 code, and needs no per-ISA copy of the round logic.
+#define BSV_ALWAYS_INLINE inline __attribute__((always_inline))
+
+namespace bsv_bench {
+
+namespace {
+
+typedef uint32_t Words4 __attribute__((vector_size(16)));
+typedef uint32_t Words8 __attribute__((vector_size(32)));
+
+const uint32_t kInit[5] = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
+
+// Per round of 16 steps, left and right lines
+constexpr uint32_t kLeftK[5] = {0x00000000, 0x5a827999, 0x6ed9eba1, 0x8f1bbcdc, 0xa953fd4e};
+constexpr uint32_t kRightK[5] = {0x50a28be6, 0x5c4dd124, 0x6d703ef3, 0x7a6d76e9, 0x00000000};
+
+// Message word and rotation per step
+constexpr int kLeftWord[80] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    7, 4, 13, 1, 10, 6, 15, 3, 12, 0, 9, 5, 2, 14, 11, 8,
+    3, 10, 14, 4, 9, 15, 8, 1, 2, 7, 0, 6, 13, 11, 5, 12,
+    1, 9, 11, 10, 0, 8, 12, 4, 13, 3, 7, 15, 14, 5, 6, 2,
+    4, 0, 5, 9, 7, 12, 2, 10, 14, 1, 3, 8, 11, 6, 15, 13
+};
+constexpr int kRightWord[80] = {
+    5, 14, 7, 0, 9, 2, 11, 4, 13, 6, 15, 8, 1, 10, 3, 12,
+    6, 11, 3, 7, 0, 13, 5, 10, 14, 15, 8, 12, 4, 9, 1, 2,
+    15, 5, 1, 3, 7, 14, 6, 9, 11, 8, 12, 2, 10, 0, 4, 13,
+    8, 6, 4, 1, 3, 11, 15, 0, 5, 12, 2, 13, 9, 7, 10, 14,
+    12, 15, 10, 4, 1, 5, 8, 7, 6, 2, 13, 14, 0, 3, 9, 11
+};
+constexpr int kLeftRotate[80] = {
+    11, 14, 15, 12, 5, 8, 7, 9, 11, 13, 14, 15, 6, 7, 9, 8,
+    7, 6, 8, 13, 11, 9, 7, 15, 7, 12, 15, 9, 11, 7, 13, 12,
+    11, 13, 6, 7, 14, 9, 13, 15, 14, 8, 13, 6, 5, 12, 7, 5,
+    11, 12, 14, 15, 14, 15, 9, 8, 9, 14, 5, 6, 8, 6, 5, 12,
+    9, 15, 5, 11, 6, 8, 13, 12, 5, 12, 13, 14, 11, 8, 5, 6
+};
+constexpr int kRightRotate[80] = {
+    8, 9, 9, 11, 13, 15, 15, 5, 7, 7, 8, 11, 14, 14, 12, 6,
+    9, 13, 15, 7, 12, 8, 9, 11, 7, 7, 12, 7, 6, 15, 13, 11,
+    9, 7, 15, 11, 8, 6, 6, 14, 12, 13, 5, 14, 13, 13, 7, 5,
+    15, 5, 8, 11, 14, 14, 6, 14, 6, 9, 12, 9, 12, 5, 15, 8,
+    8, 5, 12, 9, 12, 5, 14, 6, 8, 13, 6, 5, 15, 13, 11, 11
+};
+
+template <int N, class V>
+BSV_ALWAYS_INLINE V rol(V x) {
+    return (x << N) | (x >> (32 - N));
+}
+
+// Boolean function of round 0-4 (the right line runs them in reverse)
+template <int Round, class V>
+BSV_ALWAYS_INLINE V f(V x, V y, V z) {
+    if constexpr (Round == 0) return x ^ y ^ z;
+    else if constexpr (Round == 1) return (x & y) | (~x & z);
+    else if constexpr (Round == 2) return (x | ~y) ^ z;
+    else if constexpr (Round == 3) return (x & z) | (y & ~z);
+    else return x ^ (y | ~z);
+}
+
+template <class V>
+struct Line {
+    V a, b, c, d, e;
+};
+
+// Step J of both lines, then the rest; recursion keeps every word index,
+// rotation and round function a compile-time constant
+template <int J, class V>
+BSV_ALWAYS_INLINE void steps(Line<V>& l, Line<V>& r, const V* x) {
+    if constexpr (J < 80) {
+        constexpr int round = J / 16;
+        V t = rol<kLeftRotate[J]>(l.a + f<round>(l.b, l.c, l.d) + x[kLeftWord[J]] + kLeftK[round]) + l.e;
+        l.a = l.e; l.e = l.d; l.d = rol<10>(l.c); l.c = l.b; l.b = t;
+        t = rol<kRightRotate[J]>(r.a + f<4 - round>(r.b, r.c, r.d) + x[kRightWord[J]] + kRightK[round]) + r.e;
+        r.a = r.e; r.e = r.d; r.d = rol<10>(r.c); r.c = r.b; r.b = t;
+        steps<J + 1>(l, r, x);
+    }
+}
+
+template <class V>
+BSV_ALWAYS_INLINE void compress(V h[5], const V x[16]) {
+    Line<V> l = {h[0], h[1], h[2], h[3], h[4]};
+    Line<V> r = l;
+    steps<0>(l, r, x);
+    V t = h[1] + l.c + r.d;
+    h[1] = h[2] + l.d + r.e;
+    h[2] = h[3] + l.e + r.a;
+    h[3] = h[4] + l.a + r.b;
+    h[4] = h[0] + l.b + r.c;
+    h[0] = t;
+}
+
+inline uint32_t load_le32(const uint8_t* p) {
+    return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+}
+
+inline void store_le32(uint8_t* p, uint32_t v) {
+    p[0] = uint8_t(v);
+    p[1] = uint8_t(v >> 8);
+    p[2] = uint8_t(v >> 16);
+    p[3] = uint8_t(v >> 24);
+}
+
+// The final one or two blocks of a len-byte message: the last len % 64
+// bytes, 0x80, zeros and the little-endian bit length. Returns the block
+// count.
+size_t pad_tail(const uint8_t* rest, size_t rest_len, uint64_t len, uint8_t tail[128]) {
+    size_t blocks = rest_len < 56 ? 1 : 2;
+    std::memset(tail, 0, blocks * 64);
+    std::memcpy(tail, rest, rest_len);
+    tail[rest_len] = 0x80;
+    uint64_t bits = len * 8;
+    for (int i = 0; i < 8; ++i) {
+        tail[blocks * 64 - 8 + i] = uint8_t(bits >> (8 * i));
+    }
+    return blocks;
+}
+
+void compress_blocks(uint32_t h[5], const uint8_t* data, size_t blocks) {
+    for (; blocks > 0; --blocks, data += 64) {
+        uint32_t x[16];
+        for (int i = 0; i < 16; ++i) x[i] = load_le32(data + 4 * i);
+        compress(h, x);
+    }
+}
+
+// Up to Lanes equal-length messages, message l in lane l; unused lanes
+// rehash message 0 and are discarded
+template <class V, size_t Lanes>
+BSV_ALWAYS_INLINE void batch_lanes(const uint8_t* const* messages, size_t len, size_t count,
+                                   uint8_t* out) {
+    size_t full = len / 64;
+    uint8_t tail[Lanes][128];
+    size_t tail_blocks = 0;
+    const uint8_t* message[Lanes];
+    for (size_t lane = 0; lane < Lanes; ++lane) {
+        message[lane] = messages[lane < count ? lane : 0];
+        tail_blocks = pad_tail(message[lane] + full * 64, len - full * 64, len, tail[lane]);
+    }
+
+    V h[5];
+    for (int i = 0; i < 5; ++i) {
+        for (size_t lane = 0; lane < Lanes; ++lane) h[i][lane] = kInit[i];
+    }
+    for (size_t block = 0; block < full + tail_blocks; ++block) {
+        V x[16];
+        for (size_t lane = 0; lane < Lanes; ++lane) {
+            const uint8_t* p = block < full ? message[lane] + block * 64
+                                            : tail[lane] + (block - full) * 64;
+            for (int i = 0; i < 16; ++i) x[i][lane] = load_le32(p + 4 * i);
+        }
+        compress(h, x);
+    }
+
+    for (size_t lane = 0; lane < count; ++lane) {
+        for (int i = 0; i < 5; ++i) store_le32(out + 20 * lane + 4 * i, h[i][lane]);
+    }
+}
+
+#ifdef BSV_BENCH_X86
+void batch_sse2(const uint8_t* const* messages, size_t len, size_t count, uint8_t* out) {
+    for (size_t i = 0; i < count; i += 4) {
+        batch_lanes<Words4, 4>(messages + i, len, std::min<size_t>(4, count - i), out + 20 * i);
+    }
+}
+
+__attribute__((target("avx2")))
+void batch_avx2(const uint8_t* const* messages, size_t len, size_t count, uint8_t* out) {
+    for (size_t i = 0; i < count; i += 8) {
+        batch_lanes<Words8, 8>(messages + i, len, std::min<size_t>(8, count - i), out + 20 * i);
+    }
+}
+#endif
+
+} // namespace
+
+const char* ripemd160_kernel_name(Ripemd160Kernel kernel) {
+    switch (kernel) {
+        case Ripemd160Kernel::UNROLLED: return "unrolled";
+        case Ripemd160Kernel::SSE2: return "sse2";
+        case Ripemd160Kernel::AVX2: return "avx2";
+    }
+    return "?";
+}
+
+bool ripemd160_kernel_supported(Ripemd160Kernel kernel) {
+    switch (kernel) {
+        case Ripemd160Kernel::UNROLLED:
+            return true;
+#ifdef BSV_BENCH_X86
+        case Ripemd160Kernel::SSE2: return __builtin_cpu_supports("sse2");
+        case Ripemd160Kernel::AVX2: return __builtin_cpu_supports("avx2");
+#else
+        default: return false;
+#endif
+    }
+    return false;
+}
+
+Ripemd160Kernel ripemd160_best_batch_kernel() {
+    for (Ripemd160Kernel k : {Ripemd160Kernel::AVX2, Ripemd160Kernel::SSE2}) {
+        if (ripemd160_kernel_supported(k)) return k;
+    }
+    return Ripemd160Kernel::UNROLLED;
+}
+
+void ripemd160(const uint8_t* data, size_t len, uint8_t* out) {
+    uint32_t h[5];
+    std::memcpy(h, kInit, sizeof(h));
+
+    size_t full = len / 64;
+    compress_blocks(h, data, full);
+    uint8_t tail[128];
+    compress_blocks(h, tail, pad_tail(data + full * 64, len - full * 64, len, tail));
+    for (int i = 0; i < 5; ++i) store_le32(out + 4 * i, h[i]);
+}
+
+void ripemd160_batch(Ripemd160Kernel kernel, const uint8_t* const* messages, size_t len,
+                     size_t count, uint8_t* out) {
+#ifdef BSV_BENCH_X86
+    if (kernel == Ripemd160Kernel::SSE2) return batch_sse2(messages, len, count, out);
+    if (kernel == Ripemd160Kernel::AVX2) return batch_avx2(messages, len, count, out);
+#endif
+    (void)kernel;
+    for (size_t i = 0; i < count; ++i) {
+        ripemd160(messages[i], len, out + kRipemd160DigestBytes * i);
+    }
+}
+
+} // namespace bsv_bench
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace bsv_bench {
+
+// In-tree RIPEMD-160 kernels, measured against OpenSSL's (portable C on
+// x86-64). One templated compression function over 32-bit words, lanes of
+// 4 or 8 words, with the 80 steps of both lines unrolled at compile time:
+//   unrolled   one message at a time, scalar
+//   sse2       multi-buffer: four independent messages, one per lane
+//   avx2       multi-buffer: eight independent messages
+// RIPEMD-160 has no data parallelism within a message, so a single large
+// OP_RIPEMD160 only gains from the unrolled kernel; the multi-buffer ones
+// need several scripts' hashes in flight at once. Single-message hashing
+// with them uses the unrolled kernel, and batches with it hash their
+// messages one after another.
+enum class Ripemd160Kernel { UNROLLED, SSE2, AVX2 };
+
+constexpr size_t kRipemd160DigestBytes = 20;
+
+const char* ripemd160_kernel_name(Ripemd160Kernel kernel);
+
+// CPUID check for the instructions the kernel needs
+bool ripemd160_kernel_supported(Ripemd160Kernel kernel);
+
+// What runtime dispatch picks for batches: avx2, else sse2, else unrolled
+Ripemd160Kernel ripemd160_best_batch_kernel();
+
+// One-shot digest of len bytes into out[20]
+void ripemd160(const uint8_t* data, size_t len, uint8_t* out);
+
+// Digests of count messages of len bytes each, written to out[20 * i]
+void ripemd160_batch(Ripemd160Kernel kernel, const uint8_t* const* messages, size_t len,
+                     size_t count, uint8_t* out);
+
+} // namespace bsv_bench
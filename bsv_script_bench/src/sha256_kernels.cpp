@@ -0,0 +1,275 @@
+#include "sha256_kernels.h"
+#include <algorithm>
+#include <cstring>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BSV_BENCH_X86 1
+#endif
+
+namespace bsv_bench {
+
+namespace {
+
+const uint32_t kInit[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+alignas(16) const uint32_t kRound[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+inline uint32_t load_be32(const uint8_t* p) {
+    return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3];
+}
+
+inline void store_be32(uint8_t* p, uint32_t v) {
+    p[0] = uint8_t(v >> 24);
+    p[1] = uint8_t(v >> 16);
+    p[2] = uint8_t(v >> 8);
+    p[3] = uint8_t(v);
+}
+
+inline uint32_t rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+// The final one or two blocks of a len-byte message: the last len % 64
+// bytes, 0x80, zeros and the bit length. Returns the block count.
+size_t pad_tail(const uint8_t* rest, size_t rest_len, uint64_t len, uint8_t tail[128]) {
+    size_t blocks = rest_len < 56 ? 1 : 2;
+    std::memset(tail, 0, blocks * 64);
+    std::memcpy(tail, rest, rest_len);
+    tail[rest_len] = 0x80;
+    uint64_t bits = len * 8;
+    for (int i = 0; i < 8; ++i) {
+        tail[blocks * 64 - 1 - i] = uint8_t(bits >> (8 * i));
+    }
+    return blocks;
+}
+
+void compress_scalar(uint32_t state[8], const uint8_t* data, size_t blocks) {
+    for (; blocks > 0; --blocks, data += 64) {
+        uint32_t w[64];
+        for (int t = 0; t < 16; ++t) w[t] = load_be32(data + 4 * t);
+        for (int t = 16; t < 64; ++t) {
+            uint32_t s0 = rotr(w[t - 15], 7) ^ rotr(w[t - 15], 18) ^ (w[t - 15] >> 3);
+            uint32_t s1 = rotr(w[t - 2], 17) ^ rotr(w[t - 2], 19) ^ (w[t - 2] >> 10);
+            w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+        }
+
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for (int t = 0; t < 64; ++t) {
+            uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) +
+                          kRound[t] + w[t];
+            uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g; g = f; f = e; e = d + t1;
+            d = c; c = b; b = a; a = t1 + t2;
+        }
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+    }
+}
+
+#ifdef BSV_BENCH_X86
+// Four rounds per group; the message schedule for group i + 1 is finished
+// (MSG2) and group i + 3's started (MSG1) alongside the rounds
+__attribute__((target("sha,sse4.1")))
+void compress_shani(uint32_t state[8], const uint8_t* data, size_t blocks) {
+    const __m128i byteswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0xB1);
+    __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4)), 0x1B);
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);     // ABEF
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);           // CDGH
+
+    for (; blocks > 0; --blocks, data += 64) {
+        __m128i abef = state0, cdgh = state1;
+        __m128i w[4];
+        for (int i = 0; i < 4; ++i) {
+            w[i] = _mm_shuffle_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * i)), byteswap);
+        }
+        for (int i = 0; i < 16; ++i) {
+            __m128i msg = _mm_add_epi32(
+                w[i & 3], _mm_load_si128(reinterpret_cast<const __m128i*>(kRound + 4 * i)));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+            if (i >= 3 && i < 15) {
+                __m128i next = _mm_add_epi32(w[(i + 1) & 3], _mm_alignr_epi8(w[i & 3], w[(i - 1) & 3], 4));
+                w[(i + 1) & 3] = _mm_sha256msg2_epu32(next, w[i & 3]);
+            }
+            state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0E));
+            if (i >= 1 && i < 13) {
+                w[(i - 1) & 3] = _mm_sha256msg1_epu32(w[(i - 1) & 3], w[i & 3]);
+            }
+        }
+        state0 = _mm_add_epi32(state0, abef);
+        state1 = _mm_add_epi32(state1, cdgh);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);                 // FEBA
+    state1 = _mm_shuffle_epi32(state1, 0xB1);              // DCHG
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);           // DCBA
+    state1 = _mm_alignr_epi8(state1, tmp, 8);              // HGFE
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), state0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), state1);
+}
+
+template <int N>
+__attribute__((target("avx2"))) inline __m256i rotr8(__m256i x) {
+    return _mm256_or_si256(_mm256_srli_epi32(x, N), _mm256_slli_epi32(x, 32 - N));
+}
+
+// One block of each of eight messages, message l in 32-bit lane l
+__attribute__((target("avx2")))
+void compress_avx2_x8(__m256i state[8], const uint8_t* const block[8]) {
+    __m256i w[16];
+    for (int t = 0; t < 16; ++t) {
+        w[t] = _mm256_setr_epi32(
+            load_be32(block[0] + 4 * t), load_be32(block[1] + 4 * t),
+            load_be32(block[2] + 4 * t), load_be32(block[3] + 4 * t),
+            load_be32(block[4] + 4 * t), load_be32(block[5] + 4 * t),
+            load_be32(block[6] + 4 * t), load_be32(block[7] + 4 * t));
+    }
+
+    __m256i a = state[0], b = state[1], c = state[2], d = state[3];
+    __m256i e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int t = 0; t < 64; ++t) {
+        if (t >= 16) {
+            __m256i w15 = w[(t - 15) & 15], w2 = w[(t - 2) & 15];
+            __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(rotr8<7>(w15), rotr8<18>(w15)),
+                                          _mm256_srli_epi32(w15, 3));
+            __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(rotr8<17>(w2), rotr8<19>(w2)),
+                                          _mm256_srli_epi32(w2, 10));
+            w[t & 15] = _mm256_add_epi32(_mm256_add_epi32(w[t & 15], s0),
+                                         _mm256_add_epi32(w[(t - 7) & 15], s1));
+        }
+        __m256i sigma1 = _mm256_xor_si256(_mm256_xor_si256(rotr8<6>(e), rotr8<11>(e)), rotr8<25>(e));
+        __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+        __m256i t1 = _mm256_add_epi32(
+            _mm256_add_epi32(_mm256_add_epi32(h, sigma1), _mm256_add_epi32(ch, w[t & 15])),
+            _mm256_set1_epi32(static_cast<int>(kRound[t])));
+        __m256i sigma0 = _mm256_xor_si256(_mm256_xor_si256(rotr8<2>(a), rotr8<13>(a)), rotr8<22>(a));
+        __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+        __m256i t2 = _mm256_add_epi32(sigma0, maj);
+        h = g; g = f; f = e; e = _mm256_add_epi32(d, t1);
+        d = c; c = b; b = a; a = _mm256_add_epi32(t1, t2);
+    }
+    state[0] = _mm256_add_epi32(state[0], a); state[1] = _mm256_add_epi32(state[1], b);
+    state[2] = _mm256_add_epi32(state[2], c); state[3] = _mm256_add_epi32(state[3], d);
+    state[4] = _mm256_add_epi32(state[4], e); state[5] = _mm256_add_epi32(state[5], f);
+    state[6] = _mm256_add_epi32(state[6], g); state[7] = _mm256_add_epi32(state[7], h);
+}
+
+// Up to eight equal-length messages; unused lanes rehash message 0 and are
+// discarded
+__attribute__((target("avx2")))
+void batch_avx2_x8(const uint8_t* const* messages, size_t len, size_t count, uint8_t* out) {
+    size_t full = len / 64;
+    uint8_t tail[8][128];
+    size_t tail_blocks = 0;
+    const uint8_t* message[8];
+    for (size_t lane = 0; lane < 8; ++lane) {
+        message[lane] = messages[lane < count ? lane : 0];
+        tail_blocks = pad_tail(message[lane] + full * 64, len - full * 64, len, tail[lane]);
+    }
+
+    __m256i state[8];
+    for (int i = 0; i < 8; ++i) state[i] = _mm256_set1_epi32(static_cast<int>(kInit[i]));
+    for (size_t block = 0; block < full + tail_blocks; ++block) {
+        const uint8_t* blocks[8];
+        for (size_t lane = 0; lane < 8; ++lane) {
+            blocks[lane] = block < full ? message[lane] + block * 64 : tail[lane] + (block - full) * 64;
+        }
+        compress_avx2_x8(state, blocks);
+    }
+
+    alignas(32) uint32_t words[8][8];
+    for (int i = 0; i < 8; ++i) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(words[i]), state[i]);
+    }
+    for (size_t lane = 0; lane < count; ++lane) {
+        for (int i = 0; i < 8; ++i) store_be32(out + 32 * lane + 4 * i, words[i][lane]);
+    }
+}
+#endif
+
+using CompressFn = void (*)(uint32_t*, const uint8_t*, size_t);
+
+CompressFn compress_fn(Sha256Kernel kernel) {
+#ifdef BSV_BENCH_X86
+    if (kernel == Sha256Kernel::SHANI) return compress_shani;
+#endif
+    (void)kernel;
+    return compress_scalar;
+}
+
+} // namespace
+
+const char* sha256_kernel_name(Sha256Kernel kernel) {
+    switch (kernel) {
+        case Sha256Kernel::SCALAR: return "scalar";
+        case Sha256Kernel::SHANI: return "shani";
+        case Sha256Kernel::AVX2: return "avx2";
+    }
+    return "?";
+}
+
+bool sha256_kernel_supported(Sha256Kernel kernel) {
+    switch (kernel) {
+        case Sha256Kernel::SCALAR:
+            return true;
+#ifdef BSV_BENCH_X86
+        case Sha256Kernel::SHANI:
+            return __builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1");
+        case Sha256Kernel::AVX2: return __builtin_cpu_supports("avx2");
+#else
+        default: return false;
+#endif
+    }
+    return false;
+}
+
+Sha256Kernel sha256_best_kernel() {
+    return sha256_kernel_supported(Sha256Kernel::SHANI) ? Sha256Kernel::SHANI : Sha256Kernel::SCALAR;
+}
+
+Sha256Kernel sha256_best_batch_kernel() {
+    if (sha256_kernel_supported(Sha256Kernel::SHANI)) return Sha256Kernel::SHANI;
+    return sha256_kernel_supported(Sha256Kernel::AVX2) ? Sha256Kernel::AVX2 : Sha256Kernel::SCALAR;
+}
+
+void sha256(Sha256Kernel kernel, const uint8_t* data, size_t len, uint8_t* out) {
+    CompressFn compress = compress_fn(kernel);
+    uint32_t state[8];
+    std::memcpy(state, kInit, sizeof(state));
+
+    size_t full = len / 64;
+    compress(state, data, full);
+    uint8_t tail[128];
+    compress(state, tail, pad_tail(data + full * 64, len - full * 64, len, tail));
+    for (int i = 0; i < 8; ++i) store_be32(out + 4 * i, state[i]);
+}
+
+void sha256_batch(Sha256Kernel kernel, const uint8_t* const* messages, size_t len,
+                  size_t count, uint8_t* out) {
+#ifdef BSV_BENCH_X86
+    if (kernel == Sha256Kernel::AVX2) {
+        for (size_t i = 0; i < count; i += 8) {
+            batch_avx2_x8(messages + i, len, std::min<size_t>(8, count - i), out + 32 * i);
+        }
+        return;
+    }
+#endif
+    for (size_t i = 0; i < count; ++i) {
+        sha256(kernel, messages[i], len, out + kSha256DigestBytes * i);
+    }
+}
+
+} // namespace bsv_bench
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace bsv_bench {
+
+// In-tree SHA-256 kernels, so hashing can be measured per implementation
+// rather than through whatever OpenSSL picks:
+//   scalar   portable FIPS 180-4 compression, one message at a time
+//   shani    x86 SHA extensions (SHA256RNDS2/MSG1/MSG2), one message at a time
+//   avx2     multi-buffer: eight independent messages, one per 32-bit lane
+// Single-message hashing with the avx2 kernel falls back to scalar; batches
+// with the others hash their messages one after another.
+enum class Sha256Kernel { SCALAR, SHANI, AVX2 };
+
+constexpr size_t kSha256DigestBytes = 32;
+
+const char* sha256_kernel_name(Sha256Kernel kernel);
+
+// CPUID check for the instructions the kernel needs
+bool sha256_kernel_supported(Sha256Kernel kernel);
+
+// What runtime dispatch picks for single messages (shani, else scalar) and
+// for batches (shani, whose rounds outrun eight AVX2 lanes, else avx2, else
+// scalar)
+Sha256Kernel sha256_best_kernel();
+Sha256Kernel sha256_best_batch_kernel();
+
+// One-shot digest of len bytes into out[32]
+void sha256(Sha256Kernel kernel, const uint8_t* data, size_t len, uint8_t* out);
+
+// Digests of count messages of len bytes each, written to out[32 * i]
+void sha256_batch(Sha256Kernel kernel, const uint8_t* const* messages, size_t len,
+                  size_t count, uint8_t* out);
+
+} // namespace bsv_bench
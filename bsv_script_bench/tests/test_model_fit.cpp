@@ -0,0 +1,241 @@
+#include "model_fit.h"
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace bsv_bench;
+
+// The bench builds with -DNDEBUG, so checks throw rather than assert
+void check(bool condition, const std::string& what) {
+    if (!condition) throw std::runtime_error(what);
+}
+
+bool near(double actual, double expected, double rel_tolerance) {
+    return std::abs(actual - expected) <= rel_tolerance * std::abs(expected);
+}
+
+// Points of cost(n) at each size, with a small deterministic +-0.4% ripple
+// so that fits have a nonzero residual
+template <class Cost>
+std::vector<FitPoint> make_points(const std::vector<uint64_t>& sizes, Cost cost) {
+    std::vector<FitPoint> points;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        FitPoint p;
+        p.opcode = "OP_TEST";
+        p.input_bytes = sizes[i];
+        p.cycles = cost(static_cast<double>(sizes[i])) * (1 + 0.002 * (static_cast<int>(i * 7 % 5) - 2));
+        points.push_back(p);
+    }
+    return points;
+}
+
+std::vector<uint64_t> sizes_up_to(uint64_t last, uint64_t step) {
+    std::vector<uint64_t> sizes;
+    for (uint64_t n = step; n <= last; n += step) sizes.push_back(n);
+    return sizes;
+}
+
+void test_nnls() {
+    std::cout << "Test: Non-negative least squares..." << std::endl;
+
+    // y = 3 + 2x is recovered exactly
+    std::vector<std::vector<double>> rows;
+    std::vector<double> y;
+    for (double x : {1.0, 2.0, 5.0, 10.0}) {
+        rows.push_back({1.0, x});
+        y.push_back(3 + 2 * x);
+    }
+    std::vector<double> weights(rows.size(), 1.0);
+    auto exact = nnls(rows, y, weights);
+    check(near(exact[0], 3, 1e-9) && near(exact[1], 2, 1e-9), "nnls: exact fit");
+
+    // A falling line would need a negative slope: it is held at 0 and the
+    // intercept becomes the mean
+    for (size_t i = 0; i < rows.size(); ++i) y[i] = 20 - rows[i][1];
+    auto clamped = nnls(rows, y, weights);
+    check(clamped[1] == 0, "nnls: negative slope clamped");
+    check(near(clamped[0], 20 - 4.5, 1e-9), "nnls: intercept of the clamped fit");
+
+    std::cout << "  ✓ exact (" << exact[0] << ", " << exact[1] << "), clamped ("
+              << clamped[0] << ", " << clamped[1] << ")" << std::endl;
+}
+
+void test_huber_outlier() {
+    std::cout << "Test: Huber IRLS against an outlier..." << std::endl;
+
+    auto points = make_points(sizes_up_to(2000, 100), [](double n) { return 100 + 2 * n; });
+    points[7].cycles *= 5;  // One disturbed sample
+
+    FitOptions options;
+    ModelFit robust = fit_model(ModelForm::LINEAR, points, options);
+    check(near(robust.coefficient("c0"), 100, 0.1), "huber: c0");
+    check(near(robust.coefficient("c1"), 2, 0.01), "huber: c1");
+    check(robust.diagnostics.downweighted >= 1, "huber: outlier downweighted");
+
+    options.robust = false;
+    ModelFit plain = fit_model(ModelForm::LINEAR, points, options);
+    check(std::abs(plain.coefficient("c1") - 2) > std::abs(robust.coefficient("c1") - 2),
+          "huber: plain least squares is pulled further by the outlier");
+
+    std::cout << "  ✓ c1 " << robust.coefficient("c1") << " robust, "
+              << plain.coefficient("c1") << " plain" << std::endl;
+}
+
+void test_aicc_selection() {
+    std::cout << "Test: AICc model selection..." << std::endl;
+
+    std::vector<ModelForm> forms = {ModelForm::LINEAR, ModelForm::QUADRATIC, ModelForm::NLOGN};
+    FitOptions options;
+
+    auto quadratic = make_points(sizes_up_to(2000, 100),
+                                 [](double n) { return 50 + n + 0.01 * n * n; });
+    std::vector<ModelFit> candidates;
+    ModelFit best = fit_best(forms, quadratic, options, &candidates);
+    check(best.form == ModelForm::QUADRATIC, "aicc: quadratic data");
+    check(candidates.size() == forms.size(), "aicc: every candidate returned");
+    check(near(best.coefficient("c2"), 0.01, 0.05), "aicc: c2");
+
+    // Extra terms that don't help cost more than they gain
+    auto linear = make_points(sizes_up_to(2000, 100), [](double n) { return 500 + 3 * n; });
+    check(fit_best(forms, linear, options).form == ModelForm::LINEAR, "aicc: linear data");
+
+    std::cout << "  ✓ " << model_form_name(best.form) << " chosen, c2 "
+              << best.coefficient("c2") << std::endl;
+}
+
+// 10 + n up to 1000 bytes, then 500 + 3n
+double two_segments(double n) {
+    return n < 1000 ? 10 + n : 500 + 3 * n;
+}
+
+void test_piecewise() {
+    std::cout << "Test: Piecewise fit..." << std::endl;
+
+    auto points = make_points({100, 200, 400, 600, 800, 1000, 2000, 4000, 8000, 16000},
+                              two_segments);
+    FitOptions options;
+    options.breakpoints = {1000};
+    ModelFit fit = fit_model(ModelForm::PIECEWISE, points, options);
+
+    check(fit.breakpoints == std::vector<uint64_t>{1000}, "piecewise: breakpoint kept");
+    check(fit.segments.size() == 2, "piecewise: two segments");
+    check(near(fit.segments[0].second, 1, 0.02), "piecewise: first slope");
+    check(near(fit.segments[1].second, 3, 0.02), "piecewise: second slope");
+
+    FitPoint below;
+    below.input_bytes = 500;
+    FitPoint above;
+    above.input_bytes = 10000;
+    check(near(fit.predict(below), two_segments(500), 0.02), "piecewise: predict below");
+    check(near(fit.predict(above), two_segments(10000), 0.02), "piecewise: predict above");
+
+    std::cout << "  ✓ slopes " << fit.segments[0].second << " and " << fit.segments[1].second
+              << std::endl;
+}
+
+void test_detect_breakpoints() {
+    std::cout << "Test: Breakpoint detection..." << std::endl;
+
+    auto points = make_points({100, 200, 400, 600, 800, 1000, 2000, 4000, 8000, 16000},
+                              two_segments);
+    FitOptions options;
+    auto found = detect_breakpoints(points, {}, options);
+    check(found.size() == 1, "detect: one breakpoint");
+    check(found[0] > 800 && found[0] <= 1000, "detect: between the segments");
+
+    // Restricted to gaps near a cache size far from the step, nothing fits
+    check(detect_breakpoints(points, {64}, options).empty(), "detect: cache size filter");
+
+    // A single line needs no breakpoint
+    auto straight = make_points({100, 200, 400, 800, 1600, 3200, 6400},
+                                [](double n) { return 10 + n; });
+    check(detect_breakpoints(straight, {}, options).empty(), "detect: straight line");
+
+    std::cout << "  ✓ breakpoint at " << found[0] << " bytes" << std::endl;
+}
+
+// SHA256_BATCH points of one kernel and batch size costing c0 + c1 * length
+// cycles per message, with the same ripple as make_points
+void add_batch_points(std::vector<FitPoint>& points, const std::string& kernel, long batch,
+                      double c0, double c1) {
+    std::vector<uint64_t> lengths = {64, 200, 1000, 16384};
+    for (size_t i = 0; i < lengths.size(); ++i) {
+        FitPoint p;
+        p.opcode = "SHA256_BATCH";
+        p.param_desc = kernel + ", " + std::to_string(batch) + " x " + std::to_string(lengths[i]) + "B";
+        p.input_bytes = batch * lengths[i];
+        p.cycles = batch * (c0 + c1 * lengths[i]) * (1 + 0.002 * (static_cast<int>(i * 7 % 5) - 2));
+        points.push_back(p);
+    }
+}
+
+void test_batch_hash_ratio() {
+    std::cout << "Test: Batched hashing ratio..." << std::endl;
+
+    // A host without SHA extensions: the 8-lane kernel is multi-x cheaper
+    // per byte once its lanes are full, and cheaper still at batch sizes
+    // validation doesn't run
+    std::vector<FitPoint> points;
+    add_batch_points(points, "openssl", 1, 1500, 11);
+    add_batch_points(points, "openssl", 32, 1300, 9);
+    add_batch_points(points, "scalar", 32, 1900, 13);
+    add_batch_points(points, "avx2", 1, 3000, 19);
+    add_batch_points(points, "avx2", 8, 400, 2.5);
+    add_batch_points(points, "avx2", 32, 380, 2.4);
+    add_batch_points(points, "avx2", 1024, 300, 2.0);
+    FitOptions options;
+
+    // Validation's batch, over serial OpenSSL at batch 1
+    std::string kernel = "best";
+    long batch = 0;
+    double ratio = batch_hash_ratio(points, options, 32, kernel, batch);
+    check(kernel == "avx2" && batch == 32, "batch ratio: avx2 at the validation batch");
+    check(near(ratio, 2.4 / 11, 0.02), "batch ratio: slope over the serial slope");
+
+    // An unmeasured batch size uses the next one measured, or the largest
+    std::string next_kernel = "avx2";
+    long next_batch = 0;
+    batch_hash_ratio(points, options, 9, next_kernel, next_batch);
+    check(next_batch == 32, "batch ratio: next measured batch");
+    std::string largest_kernel = "avx2";
+    long largest_batch = 0;
+    check(near(batch_hash_ratio(points, options, 4096, largest_kernel, largest_batch), 2.0 / 11, 0.02) &&
+          largest_batch == 1024, "batch ratio: largest measured batch");
+
+    // A named kernel is used even when it's dearer
+    std::string scalar = "scalar";
+    check(near(batch_hash_ratio(points, options, 32, scalar, batch), 13.0 / 11, 0.02),
+          "batch ratio: named kernel");
+
+    // Without serial OpenSSL there is nothing to compare
+    std::vector<FitPoint> no_serial;
+    add_batch_points(no_serial, "avx2", 32, 380, 2.4);
+    std::string any = "best";
+    check(batch_hash_ratio(no_serial, options, 32, any, batch) < 0, "batch ratio: no serial results");
+
+    std::cout << "  ✓ " << kernel << " at batch " << batch << ": " << ratio << "x serial" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Running Model Fit Tests ===" << std::endl;
+    std::cout << std::endl;
+
+    try {
+        test_nnls();
+        test_huber_outlier();
+        test_aicc_selection();
+        test_piecewise();
+        test_detect_breakpoints();
+        test_batch_hash_ratio();
+
+        std::cout << std::endl;
+        std::cout << "All tests passed! ✓" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,1273 @@
+// Fit cost model coefficients from benchmark results and write a complete
+// cost model file for libbsv_cost_estimator.
+//
+// Usage:
+//   bsv_fit_model [options] runs/<run>/ output/bench_hash_ops.json ...
+//
+// Inputs are harness JSON files or bsv_bench run directories (results.json,
+// plus hardware.json for the model's hardware section and piecewise
+// breakpoints). Every opcode found is fitted with weighted, optionally
+// Huber-robust, non-negative least squares:
+//
+//   OP_CHECKSIG*       signature   c_ecdsa + c_preimage_per_byte*input_bytes
+//   OP_CHECKMULTISIG*  multisig    m/n parsed from param_desc ("m=2,n=3")
+//   OP_MUL/DIV/MOD     best of --forms, nlogn and quadratic by AICc
+//   everything else    best of --forms by AICc (constant, linear, piecewise
+//                      with breakpoints detected around cache-level sizes)
+//
+// ECDSA_VERIFY_PARALLEL results (bench_sig_ops' parallel_verify family)
+// become the model's parallel_efficiency section instead of an opcode, and
+// the slowest SIGCACHE_LOOKUP hit (bench_sig_ops' sigcache_lookup family)
+// becomes the signature opcodes' c_sigcache_hit. bench_hash_ops'
+// SHA256_BATCH results set their c_preimage_per_byte_batched (SHA256_KERNEL
+// results only compare kernels and are dropped). bench_control_flow's
+// CONDITION_NESTING, BRANCH_PUSH and BRANCH_PATTERN results become the
+// control_flow section and the OP_IF/OP_NOTIF/OP_ELSE/OP_ENDIF costs.
+//
+// bench_bitwise_ops measures each bitwise opcode with several kernels; only
+// --bitwise-kernel's results are fitted (default scalar, the node's loops),
+// and for OP_LSHIFT/OP_RSHIFT only shift amounts that cross byte boundaries.
+// Likewise bench_stack_ops runs every stack opcode on several stack
+// implementations and only --stack-impl's are fitted (default naive), and
+// bench_byte_ops runs OP_CAT/OP_SPLIT on contiguous vectors and on a rope;
+// only --byte-repr's are fitted (default vector). Its PAGE_FIRST_TOUCH
+// results (first_touch family) become the first_touch section, the per-page
+// cost the estimator adds when a large item lands in fresh memory.
+//
+// --table emits an opcode's measured curve as-is (a "table" model) instead.
+// Cold/rotating cache-mode results become the opcode's "cold" coefficients.
+// The output depends only on the inputs and flags, so regenerating a model is
+// a pipeline step rather than a hand edit.
+
+#include "model_fit.h"
+#include <nlohmann/json.hpp>
+#include <sys/stat.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+namespace fs = std::filesystem;
+using namespace bsv_bench;
+
+static void usage() {
+    std::cerr <<
+        "Usage: bsv_fit_model [options] RESULTS...\n"
+        "\n"
+        "RESULTS are harness JSON files or bsv_bench run directories.\n"
+        "\n"
+        "Options:\n"
+        "  -o, --output FILE       Write the model here (default: stdout)\n"
+        "  --base FILE             Start from an existing model: keeps its constants,\n"
+        "                          software and parallel_efficiency sections and\n"
+        "                          opcodes that weren't measured\n"
+        "  --profile-id ID         Model profile_id (default: <host>_<date>)\n"
+        "  --hardware FILE         hardware.json (default: from the first run directory)\n"
+        "  --opcode OP[,OP]        Only fit these opcodes\n"
+        "  --table OP[,OP]         Emit these opcodes as measured lookup tables\n"
+        "                          (log-log interpolation) instead of fitting\n"
+        "  --statistic S           median, p90, p95, p99 or mean (default median)\n"
+        "  --weighting W           ci, relative or none (default ci)\n"
+        "  --no-robust             Plain weighted least squares instead of Huber IRLS\n"
+        "  --huber-k K             Huber threshold in robust standard deviations (default 1.345)\n"
+        "  --forms F[,F]           Candidate forms for non-signature opcodes: constant,\n"
+        "                          linear, piecewise, nlogn, quadratic (default\n"
+        "                          constant,linear,piecewise; OP_MUL/DIV/MOD always\n"
+        "                          also try nlogn and quadratic)\n"
+        "  --condition-stack S     Condition stack the node uses, vector (vfExec scan,\n"
+        "                          default) or counter, for the control_flow section\n"
+        "  --bitwise-kernel K      Kernel whose bench_bitwise_ops results model the\n"
+        "                          bitwise opcodes: scalar (default), autovec, avx2,\n"
+        "                          avx512\n"
+        "  --stack-impl S          Stack implementation whose bench_stack_ops results\n"
+        "                          model the stack opcodes: naive (default), cow, sbo,\n"
+        "                          chunked\n"
+        "  --byte-repr R           Byte-string representation whose bench_byte_ops\n"
+        "                          results model OP_CAT/OP_SPLIT: vector (default) or\n"
+        "                          rope\n"
+        "  --alloc-policy P        Allocator the node uses for OP_CAT/OP_SPLIT results:\n"
+        "                          system (default), arena, pool or hugepage. With\n"
+        "                          hugepage results, c0/c1 are fitted from those and\n"
+        "                          P's extra cost becomes c_alloc (page faults are\n"
+        "                          priced only by the first_touch section)\n"
+        "  --first-touch T         Pages the node's large items land in: 4k (default)\n"
+        "                          or thp (transparent huge pages), for first_touch\n"
+        "  --hash-path P           How the node's hash opcodes return digests: vector\n"
+        "                          (default, a fresh allocation per digest), into\n"
+        "                          (caller buffer) or stream (init/update/final).\n"
+        "                          Hashing is fitted from the allocation-free into\n"
+        "                          (or stream) results; for vector, the difference\n"
+        "                          becomes c_alloc\n"
+        "  --batch-hash-kernel K   SHA-256 kernel whose SHA256_BATCH results price\n"
+        "                          batched preimage hashing: best (default, the\n"
+        "                          cheapest measured), scalar, shani or avx2\n"
+        "  --hash-batch N          Preimages validation hashes per batch, whose\n"
+        "                          SHA256_BATCH results are used (default 32, the\n"
+        "                          checks per thread of ECDSA_VERIFY_PARALLEL)\n"
+        "  --ripemd160-impl I      RIPEMD-160 implementation the node runs, whose\n"
+        "                          RIPEMD160_KERNEL/RIPEMD160_BATCH results model\n"
+        "                          OP_RIPEMD160 and OP_HASH160's inner hash: openssl\n"
+        "                          (default), unrolled, sse2 or avx2; recorded in the\n"
+        "                          software section\n"
+        "  --breakpoints B[,B]     Fixed piecewise breakpoints in bytes (default: detected\n"
+        "                          per opcode near the L1d/L2/LLC sizes in hardware.json)\n";
+}
+
+static std::vector<std::string> split(const std::string& s, char sep) {
+    std::vector<std::string> parts;
+    std::stringstream ss(s);
+    std::string part;
+    while (std::getline(ss, part, sep)) {
+        if (!part.empty()) parts.push_back(part);
+    }
+    return parts;
+}
+
+static json read_json(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("failed to open " + path);
+    }
+    json value;
+    file >> value;
+    return value;
+}
+
+// ISO-8601 UTC modification time of the newest input, so identical inputs
+// give an identical model file
+static std::string newest_mtime(const std::vector<std::string>& paths) {
+    std::time_t newest = 0;
+    for (const auto& path : paths) {
+        struct stat st;
+        if (stat(path.c_str(), &st) == 0) newest = std::max(newest, st.st_mtime);
+    }
+    char stamp[32];
+    std::strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&newest));
+    return stamp;
+}
+
+// Measured curve for a table model: the median of each distinct size
+static json table_points(const std::vector<FitPoint>& points) {
+    std::map<uint64_t, std::vector<double>> by_size;
+    for (const auto& p : points) {
+        if (p.input_bytes > 0) by_size[p.input_bytes].push_back(p.cycles);
+    }
+
+    json table = json::array();
+    for (auto& [size, cycles] : by_size) {
+        std::sort(cycles.begin(), cycles.end());
+        size_t mid = cycles.size() / 2;
+        double median = cycles.size() % 2 ? cycles[mid] : (cycles[mid - 1] + cycles[mid]) / 2;
+        table.push_back({size, median});
+    }
+    return table;
+}
+
+static bool is_signature_opcode(const std::string& opcode) {
+    return opcode == "OP_CHECKSIG" || opcode == "OP_CHECKSIGVERIFY";
+}
+
+// Big-number opcodes whose cost grows faster than their operands
+static bool is_superlinear_opcode(const std::string& opcode) {
+    return opcode == "OP_MUL" || opcode == "OP_DIV" || opcode == "OP_MOD";
+}
+
+static bool is_multisig_opcode(const std::string& opcode) {
+    return opcode == "OP_CHECKMULTISIG" || opcode == "OP_CHECKMULTISIGVERIFY";
+}
+
+static const char* kParallelOpcode = "ECDSA_VERIFY_PARALLEL";
+static const char* kSigCacheOpcode = "SIGCACHE_LOOKUP";
+
+// Cost of a signature cache hit: the slowest hit lookup over the measured
+// cache sizes and occupancies, so a template budget never undercounts.
+// -1 without hit results.
+static double sigcache_hit_cycles(const std::vector<FitPoint>& points) {
+    double worst = -1;
+    for (const auto& p : points) {
+        if (p.param_desc.compare(0, 3, "hit") == 0) worst = std::max(worst, p.cycles);
+    }
+    return worst;
+}
+
+// Integer "key=value" from a param_desc, or -1
+static long param_value(const std::string& param_desc, const std::string& key) {
+    size_t pos = param_desc.find(key + "=");
+    if (pos == std::string::npos) return -1;
+    return std::strtol(param_desc.c_str() + pos + key.size() + 1, nullptr, 10);
+}
+
+// parallel_efficiency section from parallel_verify's strong-scaling runs:
+// per-thread efficiency wall(1) / (t * wall(t)) at each thread count with
+// one thread per core, and smt_speedup = wall(k threads) / wall(2k threads)
+// on k cores. Null if there is no single-thread compute baseline.
+static json parallel_efficiency_section(const std::vector<FitPoint>& points) {
+    // workload -> cores -> threads -> wall cycles per check. The batch grows
+    // with the thread count, so per-thread efficiency compares per-check
+    // costs: c(1) / (t * c(t)).
+    std::map<std::string, std::map<long, std::map<long, double>>> wall;
+    for (const auto& p : points) {
+        std::string workload = p.param_desc.substr(0, p.param_desc.find(','));
+        long threads = param_value(p.param_desc, "threads");
+        long cores = param_value(p.param_desc, "cores");
+        long batch = param_value(p.param_desc, "batch");
+        if (threads <= 0 || cores <= 0) continue;
+        wall[workload][cores][threads] = batch > 0 ? p.cycles / batch : p.cycles;
+    }
+
+    auto one_per_core = [&](const std::string& workload) {
+        std::map<long, double> curve;
+        for (const auto& [cores, by_threads] : wall[workload]) {
+            auto it = by_threads.find(cores);
+            if (it != by_threads.end()) curve[cores] = it->second;
+        }
+        return curve;
+    };
+    std::map<long, double> compute = one_per_core("compute");
+    std::map<long, double> memory = one_per_core("memory");
+    if (!compute.count(1)) return json();
+
+    json section;
+    section["threads"] = json::array();
+    section["compute"] = json::array();
+    for (const auto& [threads, cycles] : compute) {
+        section["threads"].push_back(threads);
+        section["compute"].push_back(compute[1] / (threads * cycles));
+    }
+    bool memory_complete = memory.count(1) > 0;
+    for (const auto& [threads, cycles] : compute) memory_complete = memory_complete && memory.count(threads);
+    if (memory_complete) {
+        section["memory"] = json::array();
+        for (const auto& [threads, cycles] : compute) {
+            section["memory"].push_back(memory[1] / (threads * memory[threads]));
+        }
+    }
+
+    double smt_total = 0;
+    int smt_points = 0;
+    for (const auto& [cores, by_threads] : wall["compute"]) {
+        auto single = by_threads.find(cores);
+        auto paired = by_threads.find(2 * cores);
+        if (single != by_threads.end() && paired != by_threads.end()) {
+            smt_total += single->second / paired->second;
+            ++smt_points;
+        }
+    }
+    if (smt_points > 0) section["smt_speedup"] = smt_total / smt_points;
+
+    section["description"] = "Per-thread throughput relative to one thread, one thread per "
+                             "physical core; from " + std::string(kParallelOpcode) + " runs";
+    return section;
+}
+
+static const char* kControlFlowOpcodes[] = {"CONDITION_NESTING", "BRANCH_PUSH", "BRANCH_PATTERN"};
+
+static std::vector<FitPoint> points_with_prefix(const std::vector<FitPoint>& points,
+                                                const std::string& prefix) {
+    std::vector<FitPoint> matching;
+    for (const auto& p : points) {
+        if (p.param_desc.compare(0, prefix.size(), prefix) == 0) matching.push_back(p);
+    }
+    return matching;
+}
+
+static const char* kSha256KernelOpcode = "SHA256_KERNEL";
+static const char* kSha256BatchOpcode = "SHA256_BATCH";
+
+static const char* kRipemd160KernelOpcode = "RIPEMD160_KERNEL";
+static const char* kRipemd160BatchOpcode = "RIPEMD160_BATCH";
+static const char* kRipemd160Impls[] = {"openssl", "unrolled", "sse2", "avx2"};
+
+// OP_RIPEMD160 points for one RIPEMD-160 implementation: its RIPEMD160_KERNEL
+// results for the single-message ones (openssl, unrolled), and the 1-message
+// RIPEMD160_BATCH case for the multi-buffer ones (sse2, avx2). An opcode
+// hashes one message, so it pays a full pass of every lane; the cheaper
+// per-message cost of a full batch is a throughput, not a latency. Empty
+// without the results.
+static std::vector<FitPoint> ripemd160_points(const std::vector<FitPoint>& kernel_points,
+                                              const std::vector<FitPoint>& batch_points,
+                                              const std::string& impl) {
+    if (impl == "openssl" || impl == "unrolled") {
+        auto matching = points_with_prefix(kernel_points, impl + ",");
+        for (auto& p : matching) p.opcode = "OP_RIPEMD160";
+        return matching;
+    }
+    auto matching = points_with_prefix(batch_points, impl + ", 1 x");
+    for (auto& p : matching) p.opcode = "OP_RIPEMD160";
+    return matching;
+}
+
+// Cycles per 32-byte message at the largest RIPEMD160_BATCH batch of a
+// multi-buffer kernel, with batch set to its size; -1 if not measured
+static double ripemd160_batch_throughput(const std::vector<FitPoint>& batch_points,
+                                         const std::string& impl, long& batch) {
+    auto by_batch = batch_hash_costs(batch_points, impl);
+    if (by_batch.empty()) return -1;
+    batch = by_batch.rbegin()->first;
+    auto message = by_batch.rbegin()->second.find(32);
+    return message == by_batch.rbegin()->second.end() ? -1 : message->second;
+}
+
+// Cycles of one 32-byte RIPEMD-160 (OP_HASH160's inner hash), -1 if not
+// measured
+static double ripemd160_hash160_cycles(const std::vector<FitPoint>& points) {
+    for (const auto& p : points) {
+        if (p.input_bytes == 32) return p.cycles;
+    }
+    return -1;
+}
+
+// control_flow section from bench_control_flow's results for one condition
+// stack representation ("vector" or "counter"):
+//   c_exec_per_depth  quadratic fit of CONDITION_NESTING: depth d runs
+//                     opcodes that see 1.5d^2 + 0.5d open IFs in total
+//   c_skip_per_byte   linear fit of skipped BRANCH_PUSH bytes
+//   c_mispredict      random BRANCH_PATTERN minus the cheaper predictable
+//                     pattern, per IF
+// branch_cycles is set to the cost of one flow-control opcode (a third of a
+// nesting level: OP_1 OP_IF .. OP_ENDIF), or -1 without nesting results.
+static json control_flow_section(std::map<std::string, std::vector<FitPoint>>& by_opcode,
+                                 const std::string& scheme, const FitOptions& options,
+                                 double& branch_cycles) {
+    json section;
+    branch_cycles = -1;
+
+    auto nesting = points_with_prefix(by_opcode["CONDITION_NESTING"], scheme);
+    if (nesting.size() >= 3) {
+        ModelFit fit = fit_model(ModelForm::QUADRATIC, nesting, options);
+        double per_depth = fit.coefficient("c2") / 1.5;
+        section["c_exec_per_depth"] = per_depth;
+        branch_cycles = std::max(0.0, fit.coefficient("c1") - 0.5 * per_depth) / 3;
+    }
+
+    auto skipped = points_with_prefix(by_opcode["BRANCH_PUSH"], "skipped");
+    if (skipped.size() >= 2) {
+        section["c_skip_per_byte"] = fit_model(ModelForm::LINEAR, skipped, options).coefficient("c1");
+    }
+
+    std::map<std::string, const FitPoint*> patterns;
+    for (const auto& p : by_opcode["BRANCH_PATTERN"]) {
+        if (p.param_desc.find(", " + scheme) == std::string::npos || p.input_bytes == 0) continue;
+        patterns[p.param_desc.substr(0, p.param_desc.find(','))] = &p;
+    }
+    if (patterns.count("random") && (patterns.count("constant") || patterns.count("alternating"))) {
+        double predictable = std::numeric_limits<double>::infinity();
+        for (const char* name : {"constant", "alternating"}) {
+            if (patterns.count(name)) predictable = std::min(predictable, patterns[name]->cycles);
+        }
+        const FitPoint& random = *patterns["random"];
+        section["c_mispredict"] = std::max(0.0, (random.cycles - predictable) / random.input_bytes);
+    }
+
+    if (section.empty()) return json();
+    section["condition_stack"] = scheme;
+    section["description"] = "Condition stack (" + scheme + ") and skipped-branch costs from "
+                             "bench_control_flow";
+    return section;
+}
+
+static const char* kBitwiseOpcodes[] = {
+    "OP_AND", "OP_OR", "OP_XOR", "OP_INVERT", "OP_LSHIFT", "OP_RSHIFT"
+};
+
+static bool is_bitwise_opcode(const std::string& opcode) {
+    return std::find(std::begin(kBitwiseOpcodes), std::end(kBitwiseOpcodes), opcode) !=
+           std::end(kBitwiseOpcodes);
+}
+
+// One kernel's bitwise results ("<kernel>, <size>B[, n=<bits>]"). Whole-byte
+// shifts are dropped when there are others: every other amount splits each
+// result byte across two source bytes, which is the cost to budget for.
+static std::vector<FitPoint> bitwise_points(const std::vector<FitPoint>& points,
+                                            const std::string& kernel) {
+    std::vector<FitPoint> matching = points_with_prefix(points, kernel + ",");
+    std::vector<FitPoint> crossing;
+    for (const auto& p : matching) {
+        long bits = param_value(p.param_desc, "n");
+        if (bits >= 0 && bits % 8 != 0) crossing.push_back(p);
+    }
+    return crossing.empty() ? matching : crossing;
+}
+
+static const char* kStackOpcodes[] = {"OP_DUP", "OP_SWAP", "OP_PICK", "OP_ROLL", "OP_ROT"};
+static const char* kDupWriteOpcode = "DUP_WRITE";
+static const char* kStackImpls[] = {"naive", "cow", "sbo", "chunked"};
+
+static const char* kByteReprOpcodes[] = {
+    "OP_CAT", "OP_SPLIT", "OP_CAT_CHAIN", "OP_SPLIT_CHAIN", "OP_CAT_SHA256"
+};
+static const char* kByteReprs[] = {"vector", "rope"};
+
+// One implementation's results ("<impl>, ..."), for suites that run every
+// case on several implementations. Results from before a suite did so have
+// no prefix and belong to the first (baseline) implementation.
+template <size_t N>
+static std::vector<FitPoint> impl_points(const std::vector<FitPoint>& points,
+                                         const char* const (&impls)[N],
+                                         const std::string& impl) {
+    for (const char* name : impls) {
+        if (!points_with_prefix(points, std::string(name) + ",").empty()) {
+            return points_with_prefix(points, impl + ",");
+        }
+    }
+    return impl == impls[0] ? points : std::vector<FitPoint>();
+}
+
+static const char* kAllocPolicies[] = {"system", "arena", "pool", "hugepage"};
+
+// One allocator policy's OP_CAT/OP_SPLIT results: "vector, ..." is the
+// system allocator and "vector/<policy>, ..." the others
+static std::vector<FitPoint> alloc_points(const std::vector<FitPoint>& points,
+                                          const std::string& policy) {
+    if (policy == "system") return impl_points(points, kByteReprs, "vector");
+    return points_with_prefix(points, "vector/" + policy + ",");
+}
+
+struct AllocationCost {
+    std::string source;         // What pays c_alloc, for the report
+    double c_alloc = 0;
+    double c_fault_per_page = 0;
+    // Per case of the policy: description, cycles, page faults
+    std::vector<FitPoint> cases;
+};
+
+// Extra cost of an allocator policy over the pre-faulted huge-page arena,
+// which does no allocator work and takes no faults, paired case by case:
+//   policy - hugepage = c_alloc + c_fault_per_page * faults
+// The per-page term comes from the per-script arena, whose only extra cost
+// is faulting its pages back in; c_alloc is the median of what remains on
+// cases below glibc's 128KB mmap threshold. False without hugepage results.
+static bool allocation_cost(const std::vector<FitPoint>& points, const std::string& policy,
+                            AllocationCost& cost) {
+    std::map<std::string, double> baseline;
+    const std::string huge_prefix = "vector/hugepage, ";
+    for (const auto& p : points_with_prefix(points, huge_prefix)) {
+        baseline[p.param_desc.substr(huge_prefix.size())] = p.cycles;
+    }
+    if (baseline.empty()) return false;
+    
+    auto extra = [&](const FitPoint& p, double& cycles) {
+        auto it = baseline.find(p.param_desc.substr(p.param_desc.find(", ") + 2));
+        if (it == baseline.end()) return false;
+        cycles = p.cycles - it->second;
+        return true;
+    };
+    
+    double num = 0, den = 0;
+    for (const auto& p : alloc_points(points, "arena")) {
+        double cycles;
+        if (p.page_faults > 0 && extra(p, cycles)) {
+            num += cycles * p.page_faults;
+            den += p.page_faults * p.page_faults;
+        }
+    }
+    cost.c_fault_per_page = den > 0 ? std::max(0.0, num / den) : 0.0;
+    
+    std::vector<double> small, all;
+    for (const auto& p : alloc_points(points, policy)) {
+        double cycles;
+        if (!extra(p, cycles)) continue;
+        cycles -= cost.c_fault_per_page * p.page_faults;
+        all.push_back(cycles);
+        if (p.input_bytes < 128 * 1024) small.push_back(cycles);
+        cost.cases.push_back(p);
+    }
+    if (all.empty()) return false;
+    std::vector<double>& rest = small.empty() ? all : small;
+    std::nth_element(rest.begin(), rest.begin() + rest.size() / 2, rest.end());
+    cost.c_alloc = std::max(0.0, rest[rest.size() / 2]);
+    return true;
+}
+
+static const char* kHashOpcodes[] = {
+    "OP_SHA1", "OP_SHA256", "OP_HASH160", "OP_HASH256", "OP_RIPEMD160"
+};
+static const char* kHashPaths[] = {"vector", "into", "stream"};
+
+static bool is_hash_opcode(const std::string& opcode) {
+    return std::find(std::begin(kHashOpcodes), std::end(kHashOpcodes), opcode) != std::end(kHashOpcodes);
+}
+
+// Allocation share of a hash opcode: its vector results (a fresh digest
+// vector per call, two for OP_HASH160/OP_HASH256) minus the allocation-free
+// into results, paired by size. c_alloc is the median over cases up to 512B,
+// where the allocator is a visible share of the cost and hashing noise
+// doesn't swamp it. False without both paths.
+static bool hash_allocation_cost(const std::vector<FitPoint>& points, AllocationCost& cost) {
+    std::map<uint64_t, double> into;
+    for (const auto& p : points_with_prefix(points, "into,")) into[p.input_bytes] = p.cycles;
+    
+    std::vector<double> small;
+    for (const auto& p : points_with_prefix(points, "vector,")) {
+        auto it = into.find(p.input_bytes);
+        if (it == into.end()) continue;
+        cost.cases.push_back(p);
+        if (p.input_bytes <= 512) small.push_back(p.cycles - it->second);
+    }
+    if (small.empty()) return false;
+    std::nth_element(small.begin(), small.begin() + small.size() / 2, small.end());
+    cost.c_alloc = std::max(0.0, small[small.size() / 2]);
+    cost.c_fault_per_page = 0;
+    cost.source = "vector digest";
+    return true;
+}
+
+static const char* kFirstTouchOpcode = "PAGE_FIRST_TOUCH";
+
+// first_touch section from PAGE_FIRST_TOUCH results ("<4k|thp>, <size>B"):
+// a linear fit of cycles against 4KB pages touched, c0 being the mapping
+// and c1 the per-page cost (amortised over a huge page's 512 with thp).
+// Without those results, falls back to the per-script arena's refault cost
+// (fault_per_page, 0 if none). Items from glibc's 128KB mmap threshold up
+// get fresh pages.
+static json first_touch_section(const std::vector<FitPoint>& points, const std::string& pages,
+                                const FitOptions& options, double fault_per_page) {
+    json section;
+    std::vector<FitPoint> touched;
+    for (auto p : points_with_prefix(points, pages + ",")) {
+        p.input_bytes = (p.input_bytes + 4095) / 4096;
+        touched.push_back(p);
+    }
+    if (touched.size() >= 2) {
+        ModelFit fit = fit_model(ModelForm::LINEAR, touched, options);
+        section["c_map"] = fit.coefficient("c0");
+        section["c_per_page"] = fit.coefficient("c1");
+        section["description"] = "First touch of a fresh mapping (" + pages + " pages), from " +
+                                 std::string(kFirstTouchOpcode);
+    } else if (fault_per_page > 0) {
+        section["c_map"] = 0.0;
+        section["c_per_page"] = fault_per_page;
+        section["description"] = "First touch priced at the arena's page refault cost "
+                                 "(no PAGE_FIRST_TOUCH results)";
+    } else {
+        return json();
+    }
+    section["page_bytes"] = 4096;
+    section["threshold_bytes"] = 128 * 1024;
+    return section;
+}
+
+// AICc as JSON (null when there were too few points for it)
+static json aicc_json(double aicc) {
+    return std::isfinite(aicc) ? json(aicc) : json(nullptr);
+}
+
+static json diagnostics_json(const FitDiagnostics& d) {
+    return {
+        {"points", d.points},
+        {"parameters", d.parameters},
+        {"r_squared", d.r_squared},
+        {"rms_rel_error", d.rms_rel_error},
+        {"max_rel_error", d.max_rel_error},
+        {"aicc", aicc_json(d.aicc)},
+        {"iterations", d.iterations},
+        {"downweighted", d.downweighted},
+        {"clamped", d.clamped}
+    };
+}
+
+// Model coefficients in the estimator's JSON layout
+static void write_coefficients(const ModelFit& fit, json& entry) {
+    entry["model"] = model_form_name(fit.form);
+    if (fit.form == ModelForm::PIECEWISE) {
+        entry["breakpoints"] = fit.breakpoints;
+        entry["segments"] = json::array();
+        for (const auto& [c0, c1] : fit.segments) {
+            entry["segments"].push_back({{"c0", c0}, {"c1", c1}});
+        }
+        return;
+    }
+    for (const auto& [name, value] : fit.coefficients) {
+        entry[name] = value;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string output_file;
+    std::string base_file;
+    std::string profile_id;
+    std::string hardware_file;
+    std::string statistic = "median";
+    std::vector<std::string> only_opcodes;
+    std::vector<std::string> table_opcodes;
+    std::vector<ModelForm> forms = {ModelForm::CONSTANT, ModelForm::LINEAR, ModelForm::PIECEWISE};
+    FitOptions options;
+    bool explicit_breakpoints = false;
+    std::string condition_stack = "vector";
+    std::string bitwise_kernel = "scalar";
+    std::string stack_impl = "naive";
+    std::string byte_repr = "vector";
+    std::string alloc_policy = "system";
+    std::string first_touch_pages = "4k";
+    std::string batch_hash_kernel = "best";
+    long hash_batch_size = 32;
+    std::string ripemd160_impl = "openssl";
+    std::string hash_path = "vector";
+    std::vector<std::string> inputs;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto next = [&]() -> std::string {
+                if (i + 1 >= argc) throw std::runtime_error(arg + " requires a value");
+                return argv[++i];
+            };
+
+            if (arg == "-h" || arg == "--help") {
+                usage();
+                return 0;
+            } else if (arg == "-o" || arg == "--output") {
+                output_file = next();
+            } else if (arg == "--base") {
+                base_file = next();
+            } else if (arg == "--profile-id") {
+                profile_id = next();
+            } else if (arg == "--hardware") {
+                hardware_file = next();
+            } else if (arg == "--opcode") {
+                only_opcodes = split(next(), ',');
+            } else if (arg == "--condition-stack") {
+                condition_stack = next();
+                if (condition_stack != "vector" && condition_stack != "counter") {
+                    throw std::runtime_error("--condition-stack takes vector or counter");
+                }
+            } else if (arg == "--bitwise-kernel") {
+                bitwise_kernel = next();
+                if (bitwise_kernel != "scalar" && bitwise_kernel != "autovec" &&
+                    bitwise_kernel != "avx2" && bitwise_kernel != "avx512") {
+                    throw std::runtime_error("--bitwise-kernel takes scalar, autovec, avx2 or avx512");
+                }
+            } else if (arg == "--stack-impl") {
+                stack_impl = next();
+                if (std::find(std::begin(kStackImpls), std::end(kStackImpls), stack_impl) ==
+                    std::end(kStackImpls)) {
+                    throw std::runtime_error("--stack-impl takes naive, cow, sbo or chunked");
+                }
+            } else if (arg == "--byte-repr") {
+                byte_repr = next();
+                if (std::find(std::begin(kByteReprs), std::end(kByteReprs), byte_repr) ==
+                    std::end(kByteReprs)) {
+                    throw std::runtime_error("--byte-repr takes vector or rope");
+                }
+            } else if (arg == "--alloc-policy") {
+                alloc_policy = next();
+                if (std::find(std::begin(kAllocPolicies), std::end(kAllocPolicies), alloc_policy) ==
+                    std::end(kAllocPolicies)) {
+                    throw std::runtime_error("--alloc-policy takes system, arena, pool or hugepage");
+                }
+            } else if (arg == "--hash-path") {
+                hash_path = next();
+                if (std::find(std::begin(kHashPaths), std::end(kHashPaths), hash_path) ==
+                    std::end(kHashPaths)) {
+                    throw std::runtime_error("--hash-path takes vector, into or stream");
+                }
+            } else if (arg == "--batch-hash-kernel") {
+                batch_hash_kernel = next();
+                if (batch_hash_kernel != "best" && batch_hash_kernel != "scalar" &&
+                    batch_hash_kernel != "shani" && batch_hash_kernel != "avx2") {
+                    throw std::runtime_error("--batch-hash-kernel takes best, scalar, shani or avx2");
+                }
+            } else if (arg == "--hash-batch") {
+                hash_batch_size = std::stol(next());
+                if (hash_batch_size < 1) throw std::runtime_error("--hash-batch must be at least 1");
+            } else if (arg == "--ripemd160-impl") {
+                ripemd160_impl = next();
+                if (std::find(std::begin(kRipemd160Impls), std::end(kRipemd160Impls), ripemd160_impl) ==
+                    std::end(kRipemd160Impls)) {
+                    throw std::runtime_error("--ripemd160-impl takes openssl, unrolled, sse2 or avx2");
+                }
+            } else if (arg == "--first-touch") {
+                first_touch_pages = next();
+                if (first_touch_pages != "4k" && first_touch_pages != "thp") {
+                    throw std::runtime_error("--first-touch takes 4k or thp");
+                }
+            } else if (arg == "--table") {
+                table_opcodes = split(next(), ',');
+            } else if (arg == "--statistic") {
+                statistic = next();
+                if (statistic != "median" && statistic != "p90" && statistic != "p95" &&
+                    statistic != "p99" && statistic != "mean") {
+                    throw std::runtime_error("Unknown statistic: " + statistic);
+                }
+            } else if (arg == "--weighting") {
+                std::string name = next();
+                if (!parse_weighting(name, options.weighting)) {
+                    throw std::runtime_error("Unknown weighting: " + name);
+                }
+            } else if (arg == "--no-robust") {
+                options.robust = false;
+            } else if (arg == "--huber-k") {
+                options.huber_k = std::stod(next());
+            } else if (arg == "--forms") {
+                forms.clear();
+                for (const auto& name : split(next(), ',')) {
+                    ModelForm form;
+                    if (!parse_model_form(name, form) ||
+                        form == ModelForm::SIGNATURE || form == ModelForm::MULTISIG) {
+                        throw std::runtime_error("--forms takes constant, linear, piecewise, "
+                                                 "nlogn, quadratic: " + name);
+                    }
+                    forms.push_back(form);
+                }
+            } else if (arg == "--breakpoints") {
+                options.breakpoints.clear();
+                for (const auto& v : split(next(), ',')) {
+                    options.breakpoints.push_back(std::stoull(v));
+                }
+                explicit_breakpoints = true;
+            } else if (!arg.empty() && arg[0] == '-') {
+                throw std::runtime_error("Unknown option: " + arg);
+            } else {
+                inputs.push_back(arg);
+            }
+        }
+        if (inputs.empty()) {
+            throw std::runtime_error("no input files");
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n\n";
+        usage();
+        return 1;
+    }
+
+    // Resolve run directories to their result and hardware files
+    std::vector<std::string> result_files;
+    for (const auto& input : inputs) {
+        if (fs::is_directory(input)) {
+            result_files.push_back((fs::path(input) / "results.json").string());
+            if (hardware_file.empty() && fs::exists(fs::path(input) / "hardware.json")) {
+                hardware_file = (fs::path(input) / "hardware.json").string();
+            }
+        } else {
+            result_files.push_back(input);
+        }
+    }
+
+    json model;
+    json hardware;
+    std::map<std::string, std::map<std::string, std::vector<FitPoint>>> points;  // opcode -> mode
+
+    try {
+        model = base_file.empty() ? json::object() : read_json(base_file);
+        if (!hardware_file.empty()) hardware = read_json(hardware_file);
+
+        const std::string field = statistic + "_cycles";
+        for (const auto& path : result_files) {
+            json run = read_json(path);
+            for (const auto& b : run.value("benchmarks", json::array())) {
+                FitPoint p;
+                p.opcode = b.value("opcode", "");
+                p.param_desc = b.value("param_desc", "");
+                p.cache_mode = b.value("cache_mode", "warm");
+                p.input_bytes = b.value("input_bytes", uint64_t(0));
+                p.cycles = b.value(field, 0.0);
+                p.page_faults = b.value("page_faults", 0.0);
+                if (statistic == "median") {
+                    p.ci_low = b.value("ci_low_cycles", 0.0);
+                    p.ci_high = b.value("ci_high_cycles", 0.0);
+                }
+
+                if (p.opcode.empty() || p.cycles <= 0) continue;
+                if (!only_opcodes.empty() &&
+                    std::find(only_opcodes.begin(), only_opcodes.end(), p.opcode) == only_opcodes.end()) {
+                    continue;
+                }
+                points[p.opcode][p.cache_mode].push_back(p);
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    if (points.empty()) {
+        std::cerr << "Error: no benchmark results to fit\n";
+        return 1;
+    }
+
+    // Cache sizes bound where piecewise breakpoints are searched for
+    std::vector<uint64_t> cache_sizes;
+    if (hardware.is_object()) {
+        for (const char* key : {"l1d_bytes", "l2_bytes", "llc_bytes"}) {
+            uint64_t size = hardware.value(key, uint64_t(0));
+            if (size > 0) cache_sizes.push_back(size);
+        }
+    }
+
+    std::string calibration_date = newest_mtime(result_files);
+    if (profile_id.empty()) {
+        std::string host = hardware.is_object() ? hardware.value("hostname", "host") : "host";
+        std::string day = calibration_date.substr(0, 10);
+        std::replace(day.begin(), day.end(), '-', '_');
+        profile_id = host + "_" + day;
+    }
+
+    model["profile_id"] = profile_id;
+    model["calibration_date"] = calibration_date;
+    if (hardware.is_object()) model["hardware"] = hardware;
+    if (!model.contains("constants")) {
+        model["constants"] = {{"c_dispatch", 5.0}, {"c_parse_per_byte", 0.8}};
+    }
+    if (!model.contains("opcodes")) model["opcodes"] = json::object();
+
+    model["fit"] = {
+        {"tool", "bsv_fit_model"},
+        {"inputs", inputs},
+        {"statistic", statistic},
+        {"weighting", weighting_name(options.weighting)},
+        {"robust", options.robust ? "huber" : "none"},
+        {"huber_k", options.huber_k},
+        {"nonnegative", true}
+    };
+    model["notes"] = {
+        "Generated by bsv_fit_model from the inputs listed under \"fit\"",
+        "Regenerate from new benchmark runs instead of editing coefficients by hand"
+    };
+
+    std::cerr << std::left << std::setw(22) << "opcode"
+              << std::setw(11) << "model"
+              << std::right << std::setw(7) << "points"
+              << std::setw(11) << "R2"
+              << std::setw(10) << "max err" << "  coefficients\n";
+
+    json control_flow;
+    double branch_cycles = -1;
+    {
+        std::map<std::string, std::vector<FitPoint>> control_points;
+        for (const char* opcode : kControlFlowOpcodes) {
+            if (points.count(opcode) && points[opcode].count("warm")) {
+                control_points[opcode] = points[opcode]["warm"];
+            }
+            points.erase(opcode);
+        }
+        if (!control_points.empty()) {
+            control_flow = control_flow_section(control_points, condition_stack, options, branch_cycles);
+        }
+    }
+
+    std::vector<FitPoint> first_touch_points;
+    if (points.count(kFirstTouchOpcode)) {
+        first_touch_points = points[kFirstTouchOpcode]["warm"];
+        points.erase(kFirstTouchOpcode);
+    }
+
+    for (const char* opcode : kBitwiseOpcodes) {
+        if (!points.count(opcode)) continue;
+        for (auto& [mode, mode_points] : points[opcode]) {
+            mode_points = bitwise_points(mode_points, bitwise_kernel);
+        }
+        if (points[opcode]["warm"].empty()) {
+            std::cerr << "Warning: " << opcode << " has no " << bitwise_kernel
+                      << " kernel results, skipped\n";
+            points.erase(opcode);
+        }
+    }
+
+    for (const char* opcode : kStackOpcodes) {
+        if (!points.count(opcode)) continue;
+        for (auto& [mode, mode_points] : points[opcode]) {
+            mode_points = impl_points(mode_points, kStackImpls, stack_impl);
+        }
+        if (points[opcode]["warm"].empty()) {
+            std::cerr << "Warning: " << opcode << " has no " << stack_impl
+                      << " stack results, skipped\n";
+            points.erase(opcode);
+        }
+    }
+    // Compares the stacks' copy-on-write cost; not an opcode
+    points.erase(kDupWriteOpcode);
+
+    std::map<std::string, AllocationCost> allocation_costs;
+    for (const char* opcode : kByteReprOpcodes) {
+        if (!points.count(opcode)) continue;
+        std::string policy = alloc_policy;
+        AllocationCost cost;
+        if (byte_repr == "vector" && policy != "hugepage" &&
+            allocation_cost(points[opcode]["warm"], policy, cost)) {
+            cost.source = alloc_policy + " allocator";
+            allocation_costs[opcode] = cost;
+            policy = "hugepage";
+        }
+        for (auto& [mode, mode_points] : points[opcode]) {
+            mode_points = byte_repr == "vector" ? alloc_points(mode_points, policy)
+                                                : impl_points(mode_points, kByteReprs, byte_repr);
+        }
+        if (points[opcode]["warm"].empty()) {
+            std::cerr << "Warning: " << opcode << " has no " << byte_repr
+                      << " byte-string results, skipped\n";
+            points.erase(opcode);
+        }
+    }
+
+    double sigcache_hit = -1;
+    if (points.count(kSigCacheOpcode)) {
+        auto& by_mode = points[kSigCacheOpcode];
+        if (by_mode.count("warm")) sigcache_hit = sigcache_hit_cycles(by_mode["warm"]);
+        if (sigcache_hit < 0) {
+            std::cerr << "Warning: " << kSigCacheOpcode << " has no warm hit results, skipped\n";
+        }
+        points.erase(kSigCacheOpcode);
+    }
+
+    double batch_ratio = -1;
+    long hash_batch = 0;
+    if (points.count(kSha256BatchOpcode)) {
+        batch_ratio = batch_hash_ratio(points[kSha256BatchOpcode]["warm"], options, hash_batch_size,
+                                       batch_hash_kernel, hash_batch);
+        if (batch_ratio < 0) {
+            std::cerr << "Warning: " << kSha256BatchOpcode << " needs unbatched openssl and "
+                      << batch_hash_kernel << " results at two or more lengths, skipped\n";
+        }
+        points.erase(kSha256BatchOpcode);
+    }
+    points.erase(kSha256KernelOpcode);
+
+    // Hash opcodes are fitted from a digest path without allocation; with
+    // the vector path the allocation comes back as c_alloc. Results from
+    // before the paths were measured have no prefix and are used as is.
+    for (const char* opcode : kHashOpcodes) {
+        if (!points.count(opcode)) continue;
+        std::string path = hash_path == "stream" ? "stream" : "into";
+        AllocationCost cost;
+        if (hash_path == "vector" && hash_allocation_cost(points[opcode]["warm"], cost)) {
+            allocation_costs[opcode] = cost;
+        }
+        if (points_with_prefix(points[opcode]["warm"], path + ",").empty()) path = "vector";
+        for (auto& [mode, mode_points] : points[opcode]) {
+            mode_points = impl_points(mode_points, kHashPaths, path);
+        }
+        if (points[opcode]["warm"].empty()) {
+            std::cerr << "Warning: " << opcode << " has no " << path << " hash results, skipped\n";
+            points.erase(opcode);
+        }
+    }
+
+    // OP_RIPEMD160 as the node's implementation runs it; OP_HASH160 is
+    // measured with OpenSSL's, so it is shifted by the 32-byte difference
+    double hash160_delta = 0;
+    double ripemd160_throughput = -1;
+    long ripemd160_batch = 0;
+    if (ripemd160_impl != "openssl" &&
+        (points.count(kRipemd160KernelOpcode) || points.count(kRipemd160BatchOpcode))) {
+        std::vector<FitPoint> kernel_points = points[kRipemd160KernelOpcode]["warm"];
+        std::vector<FitPoint> batch_points = points[kRipemd160BatchOpcode]["warm"];
+        auto impl = ripemd160_points(kernel_points, batch_points, ripemd160_impl);
+        if (impl.empty()) {
+            std::cerr << "Warning: OP_RIPEMD160 has no " << ripemd160_impl
+                      << " RIPEMD-160 results, skipped\n";
+            points.erase("OP_RIPEMD160");
+        } else {
+            points["OP_RIPEMD160"] = {{"warm", impl}};
+            double serial = ripemd160_hash160_cycles(
+                ripemd160_points(kernel_points, batch_points, "openssl"));
+            double node = ripemd160_hash160_cycles(impl);
+            if (serial > 0 && node > 0) hash160_delta = node - serial;
+        }
+        if (ripemd160_impl == "sse2" || ripemd160_impl == "avx2") {
+            ripemd160_throughput = ripemd160_batch_throughput(batch_points, ripemd160_impl,
+                                                              ripemd160_batch);
+        }
+    }
+    points.erase(kRipemd160KernelOpcode);
+    points.erase(kRipemd160BatchOpcode);
+
+    for (auto& [opcode, by_mode] : points) {
+        // Warm results define the model; cold ones, or failing that
+        // rotating ones, its cold coefficients
+        const std::vector<FitPoint>* warm = nullptr;
+        const std::vector<FitPoint>* cold = nullptr;
+        if (by_mode.count("warm")) warm = &by_mode["warm"];
+        if (by_mode.count("cold")) cold = &by_mode["cold"];
+        else if (by_mode.count("rotating")) cold = &by_mode["rotating"];
+        if (!warm) {
+            std::cerr << "Warning: " << opcode << " has no warm results, skipped\n";
+            continue;
+        }
+
+        if (opcode == kParallelOpcode) {
+            json section = parallel_efficiency_section(*warm);
+            if (section.is_null()) {
+                std::cerr << "Warning: " << opcode << " has no single-thread baseline, skipped\n";
+                continue;
+            }
+            model["parallel_efficiency"] = section;
+            std::cerr << std::left << std::setw(22) << opcode
+                      << std::setw(11) << "parallel"
+                      << std::right << std::setw(7) << warm->size()
+                      << std::setw(11) << "-" << std::setw(10) << "-"
+                      << "  " << section["threads"].size() << " thread counts\n";
+            continue;
+        }
+
+        if (std::find(table_opcodes.begin(), table_opcodes.end(), opcode) != table_opcodes.end()) {
+            json entry;
+            entry["model"] = "table";
+            entry["points"] = table_points(*warm);
+            if (entry["points"].empty()) {
+                std::cerr << "Warning: " << opcode << " has no sized results for a table, skipped\n";
+                continue;
+            }
+            entry["description"] = "Measured " + statistic + " cycles at " +
+                                   std::to_string(entry["points"].size()) + " sizes";
+            entry["fit"] = {{"points", warm->size()}, {"sizes", entry["points"].size()}};
+            model["opcodes"][opcode] = entry;
+
+            std::cerr << std::left << std::setw(22) << opcode
+                      << std::setw(11) << "table"
+                      << std::right << std::setw(7) << warm->size()
+                      << std::setw(11) << "-" << std::setw(10) << "-"
+                      << "  " << entry["points"].size() << " sizes\n";
+            continue;
+        }
+
+        std::vector<ModelForm> candidates_forms;
+        if (is_signature_opcode(opcode)) {
+            candidates_forms = {ModelForm::SIGNATURE};
+        } else if (is_multisig_opcode(opcode)) {
+            candidates_forms = {ModelForm::MULTISIG};
+        } else {
+            std::vector<uint64_t> sizes;
+            for (const auto& p : *warm) sizes.push_back(p.input_bytes);
+            std::sort(sizes.begin(), sizes.end());
+            bool single_size = sizes.front() == sizes.back();
+            std::vector<ModelForm> opcode_forms = forms;
+            if (is_superlinear_opcode(opcode)) {
+                for (ModelForm form : {ModelForm::NLOGN, ModelForm::QUADRATIC}) {
+                    if (std::find(forms.begin(), forms.end(), form) == forms.end()) {
+                        opcode_forms.push_back(form);
+                    }
+                }
+            }
+            for (ModelForm form : opcode_forms) {
+                if (single_size && form != ModelForm::CONSTANT) continue;
+                candidates_forms.push_back(form);
+            }
+            if (candidates_forms.empty()) candidates_forms = {ModelForm::CONSTANT};
+        }
+
+        ModelFit fit;
+        std::vector<ModelFit> candidates;
+        try {
+            FitOptions opcode_options = options;
+            if (!explicit_breakpoints &&
+                std::find(candidates_forms.begin(), candidates_forms.end(),
+                          ModelForm::PIECEWISE) != candidates_forms.end()) {
+                opcode_options.breakpoints = detect_breakpoints(*warm, cache_sizes, options);
+            }
+            fit = fit_best(candidates_forms, *warm, opcode_options, &candidates);
+        } catch (const std::exception& e) {
+            std::cerr << "Warning: " << opcode << ": " << e.what() << ", skipped\n";
+            continue;
+        }
+
+        json entry;
+        write_coefficients(fit, entry);
+
+        std::ostringstream description;
+        description << "Fitted " << model_form_name(fit.form) << " model over "
+                    << fit.diagnostics.points << " points (R²=" << std::setprecision(5)
+                    << fit.diagnostics.r_squared << ", max error "
+                    << std::setprecision(3) << fit.diagnostics.max_rel_error * 100 << "%)";
+        if (is_bitwise_opcode(opcode)) description << ", " << bitwise_kernel << " kernel";
+        if (opcode == "OP_RIPEMD160") description << ", " << ripemd160_impl << " RIPEMD-160";
+        if (std::find(std::begin(kStackOpcodes), std::end(kStackOpcodes), opcode) !=
+            std::end(kStackOpcodes)) {
+            description << ", " << stack_impl << " stack";
+        }
+        if (std::find(std::begin(kByteReprOpcodes), std::end(kByteReprOpcodes), opcode) !=
+            std::end(kByteReprOpcodes)) {
+            description << ", " << byte_repr << " byte strings";
+        }
+        auto allocation = allocation_costs.find(opcode);
+        if (allocation != allocation_costs.end()) {
+            entry["c_alloc"] = allocation->second.c_alloc;
+            if (is_hash_opcode(opcode)) {
+                description << ", hashing from the allocation-free path plus the "
+                            << allocation->second.source << " as c_alloc";
+            } else {
+                description << ", copy cost from the huge-page arena plus " << alloc_policy
+                            << " allocator c_alloc";
+            }
+        } else if (is_hash_opcode(opcode) && hash_path != "vector") {
+            description << ", " << hash_path << " digest path";
+        }
+        entry["description"] = description.str();
+
+        json fit_info = diagnostics_json(fit.diagnostics);
+        fit_info["candidates"] = json::object();
+        for (const auto& c : candidates) {
+            fit_info["candidates"][model_form_name(c.form)] = aicc_json(c.diagnostics.aicc);
+        }
+
+        if (cold && (fit.form == ModelForm::CONSTANT || fit.form == ModelForm::LINEAR)) {
+            ModelFit cold_fit = fit_model(fit.form, *cold, options);
+            entry["cold"] = json::object();
+            for (const auto& [name, value] : cold_fit.coefficients) {
+                entry["cold"][name] = value;
+            }
+            fit_info["cold"] = diagnostics_json(cold_fit.diagnostics);
+            fit_info["cold"]["cache_mode"] = cold->front().cache_mode;
+        }
+        entry["fit"] = fit_info;
+        model["opcodes"][opcode] = entry;
+
+        std::ostringstream coefficients;
+        if (fit.form == ModelForm::PIECEWISE) {
+            coefficients << fit.segments.size() << " segments";
+        }
+        for (const auto& [name, value] : fit.coefficients) {
+            coefficients << name << "=" << value << " ";
+        }
+        std::cerr << std::left << std::setw(22) << opcode
+                  << std::setw(11) << model_form_name(fit.form)
+                  << std::right << std::setw(7) << fit.diagnostics.points
+                  << std::setw(11) << std::fixed << std::setprecision(6) << fit.diagnostics.r_squared
+                  << std::setw(9) << std::setprecision(2) << fit.diagnostics.max_rel_error * 100 << "%"
+                  << std::defaultfloat << "  " << coefficients.str() << "\n";
+        
+        if (allocation != allocation_costs.end()) {
+            const AllocationCost& cost = allocation->second;
+            std::cerr << "  " << cost.source << ": " << std::setprecision(6)
+                      << "c_alloc=" << cost.c_alloc
+                      << " c_fault_per_page=" << cost.c_fault_per_page << "\n";
+            for (const auto& p : cost.cases) {
+                double faults = cost.c_fault_per_page * p.page_faults;
+                std::cerr << "    " << std::left << std::setw(40) << p.param_desc << std::right
+                          << std::setw(12) << std::setprecision(0) << std::fixed << p.cycles
+                          << " cycles, " << std::setw(3) << 100 * std::min(1.0, cost.c_alloc / p.cycles)
+                          << "% allocation, " << std::setw(3)
+                          << 100 * std::min(1.0, faults / p.cycles) << "% page faults\n"
+                          << std::defaultfloat;
+            }
+        }
+    }
+
+    if (!control_flow.is_null()) {
+        model["control_flow"] = control_flow;
+        int priced = 0;
+        for (const char* opcode : {"OP_IF", "OP_NOTIF", "OP_ELSE", "OP_ENDIF"}) {
+            if (branch_cycles < 0 || model["opcodes"].contains(opcode)) continue;
+            model["opcodes"][opcode] = {
+                {"model", "constant"},
+                {"c0", branch_cycles},
+                {"description", "Flow-control opcode, from CONDITION_NESTING (" + condition_stack + ")"}
+            };
+            ++priced;
+        }
+        std::cerr << std::left << std::setw(22) << "control_flow"
+                  << std::setw(11) << condition_stack
+                  << std::right << std::setw(7) << "-"
+                  << std::setw(11) << "-" << std::setw(10) << "-"
+                  << "  c_exec_per_depth=" << std::setprecision(6)
+                  << control_flow.value("c_exec_per_depth", 0.0)
+                  << " c_skip_per_byte=" << control_flow.value("c_skip_per_byte", 0.0)
+                  << " c_mispredict=" << control_flow.value("c_mispredict", 0.0)
+                  << ", " << priced << " branch opcodes\n";
+    }
+
+    double fault_per_page = 0;
+    for (const auto& [opcode, cost] : allocation_costs) {
+        fault_per_page = std::max(fault_per_page, cost.c_fault_per_page);
+    }
+    json first_touch = first_touch_section(first_touch_points, first_touch_pages, options,
+                                           fault_per_page);
+    if (!first_touch.is_null()) {
+        model["first_touch"] = first_touch;
+        std::cerr << std::left << std::setw(22) << "first_touch"
+                  << std::setw(11) << first_touch_pages
+                  << std::right << std::setw(7) << "-"
+                  << std::setw(11) << "-" << std::setw(10) << "-"
+                  << "  c_map=" << std::setprecision(6) << first_touch.value("c_map", 0.0)
+                  << " c_per_page=" << first_touch.value("c_per_page", 0.0) << "\n";
+    }
+
+    if (batch_ratio >= 0) {
+        int priced = 0;
+        for (auto& entry : model["opcodes"]) {
+            std::string form = entry.value("model", "");
+            if (form == "signature" || form == "multisig") {
+                entry["c_preimage_per_byte_batched"] =
+                    entry.value("c_preimage_per_byte", 0.0) * batch_ratio;
+                ++priced;
+            }
+        }
+        std::cerr << std::left << std::setw(22) << kSha256BatchOpcode
+                  << std::setw(11) << batch_hash_kernel
+                  << std::right << std::setw(7) << "-"
+                  << std::setw(11) << "-" << std::setw(10) << "-"
+                  << "  " << std::setprecision(3) << batch_ratio << "x serial cost per byte in batches of "
+                  << hash_batch << ", on " << priced << " opcodes\n";
+    }
+
+    if (points.count("OP_RIPEMD160") && model["opcodes"].contains("OP_RIPEMD160")) {
+        model["software"]["ripemd160"] = ripemd160_impl;
+        if (ripemd160_throughput > 0) {
+            model["software"]["ripemd160_batch"] = {{"batch", ripemd160_batch},
+                                                    {"cycles_per_32B_message", ripemd160_throughput}};
+            std::cerr << std::left << std::setw(22) << kRipemd160BatchOpcode
+                      << std::setw(11) << ripemd160_impl
+                      << std::right << std::setw(7) << "-"
+                      << std::setw(11) << "-" << std::setw(10) << "-"
+                      << "  " << std::setprecision(6) << ripemd160_throughput
+                      << " cycles per 32B message in batches of " << ripemd160_batch
+                      << ", not priced\n";
+        }
+    }
+    if (hash160_delta != 0 && points.count("OP_HASH160") && model["opcodes"].contains("OP_HASH160")) {
+        json& hash160 = model["opcodes"]["OP_HASH160"];
+        if (hash160.contains("c0")) {
+            hash160["c0"] = std::max(0.0, hash160.value("c0", 0.0) + hash160_delta);
+            hash160["description"] = hash160.value("description", std::string()) +
+                                     ", inner RIPEMD-160 by " + ripemd160_impl;
+            std::cerr << std::left << std::setw(22) << "OP_HASH160"
+                      << std::setw(11) << ripemd160_impl
+                      << std::right << std::setw(7) << "-"
+                      << std::setw(11) << "-" << std::setw(10) << "-"
+                      << "  c0 " << std::showpos << std::setprecision(6) << hash160_delta
+                      << std::noshowpos << " for the inner RIPEMD-160\n";
+        } else {
+            std::cerr << "Warning: OP_HASH160 has no c0 to move to " << ripemd160_impl
+                      << " RIPEMD-160, left as measured\n";
+        }
+    }
+
+    if (sigcache_hit >= 0) {
+        int priced = 0;
+        for (auto& entry : model["opcodes"]) {
+            std::string form = entry.value("model", "");
+            if (form == "signature" || form == "multisig") {
+                entry["c_sigcache_hit"] = sigcache_hit;
+                ++priced;
+            }
+        }
+        std::cerr << std::left << std::setw(22) << kSigCacheOpcode
+                  << std::setw(11) << "sigcache"
+                  << std::right << std::setw(7) << "-"
+                  << std::setw(11) << "-" << std::setw(10) << "-"
+                  << "  c_sigcache_hit=" << std::setprecision(6) << sigcache_hit << " on " << priced << " opcodes\n";
+    }
+
+    if (output_file.empty()) {
+        std::cout << model.dump(2) << "\n";
+    } else {
+        std::ofstream file(output_file);
+        if (!file.is_open()) {
+            std::cerr << "Error: failed to write " << output_file << "\n";
+            return 1;
+        }
+        file << model.dump(2) << "\n";
+        std::cerr << "\nCost model written to " << output_file << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,181 @@
+// Merge latency histograms from several benchmark runs (possibly on different
+// machines) into one distribution per (opcode, param_desc, cache_mode).
+//
+// Usage:
+//   bsv_merge_hist [-o merged.json] [-p 99] run1.json run2.json ...
+//
+// Prints, for each case, the merged percentile and the worst single-run
+// percentile (with the file it came from), and optionally writes the merged
+// results in the harness JSON format.
+
+#include "bench_histogram.h"
+#include <nlohmann/json.hpp>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+using bsv_bench::LatencyHistogram;
+
+struct MergedCase {
+    std::string opcode;
+    std::string param_desc;
+    std::string cache_mode;
+    uint64_t input_bytes = 0;
+    LatencyHistogram histogram;
+    uint64_t worst_percentile = 0;
+    std::string worst_source;
+    int sources = 0;
+};
+
+static LatencyHistogram histogram_from_json(const json& h) {
+    std::vector<std::pair<uint32_t, uint64_t>> buckets;
+    const auto& flat = h.at("buckets");
+    uint32_t index = 0;
+    for (size_t i = 0; i + 1 < flat.size(); i += 2) {
+        index += flat[i].get<uint32_t>();
+        buckets.emplace_back(index, flat[i + 1].get<uint64_t>());
+    }
+    return LatencyHistogram::from_buckets(
+        h.value("sub_bucket_bits", 7),
+        buckets,
+        h.value("min", uint64_t(0)),
+        h.value("max", uint64_t(0))
+    );
+}
+
+static void usage() {
+    std::cerr << "Usage: bsv_merge_hist [-o merged.json] [-p percentile] run.json...\n";
+}
+
+int main(int argc, char** argv) {
+    std::string output_file;
+    double percentile = 99.0;
+    std::vector<std::string> inputs;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if ((arg == "-o" || arg == "--output") && i + 1 < argc) {
+            output_file = argv[++i];
+        } else if ((arg == "-p" || arg == "--percentile") && i + 1 < argc) {
+            percentile = std::stod(argv[++i]);
+        } else if (arg == "-h" || arg == "--help") {
+            usage();
+            return 0;
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+
+    if (inputs.empty()) {
+        usage();
+        return 1;
+    }
+
+    // Keyed by opcode + param_desc + cache_mode, in first-seen order; results
+    // from before cache modes were recorded are warm
+    std::map<std::string, MergedCase> merged;
+    std::vector<std::string> order;
+
+    for (const auto& path : inputs) {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            std::cerr << "Error: failed to open " << path << "\n";
+            return 1;
+        }
+
+        json run;
+        try {
+            file >> run;
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << path << ": " << e.what() << "\n";
+            return 1;
+        }
+
+        for (const auto& b : run.value("benchmarks", json::array())) {
+            if (!b.contains("histogram")) {
+                std::cerr << "Warning: " << path << ": no histogram for "
+                          << b.value("opcode", "?") << " " << b.value("param_desc", "") << "\n";
+                continue;
+            }
+
+            std::string cache_mode = b.value("cache_mode", "warm");
+            std::string key = b.value("opcode", "") + "|" + b.value("param_desc", "") + "|" + cache_mode;
+            auto it = merged.find(key);
+            if (it == merged.end()) {
+                MergedCase c;
+                c.opcode = b.value("opcode", "");
+                c.param_desc = b.value("param_desc", "");
+                c.cache_mode = cache_mode;
+                c.input_bytes = b.value("input_bytes", uint64_t(0));
+                it = merged.emplace(key, std::move(c)).first;
+                order.push_back(key);
+            }
+
+            LatencyHistogram h = histogram_from_json(b["histogram"]);
+            uint64_t run_percentile = h.value_at_percentile(percentile);
+            if (run_percentile >= it->second.worst_percentile) {
+                it->second.worst_percentile = run_percentile;
+                it->second.worst_source = path;
+            }
+            it->second.histogram.merge(h);
+            it->second.sources++;
+        }
+    }
+
+    std::cout << std::left << std::setw(18) << "opcode"
+              << std::setw(28) << "param_desc"
+              << std::setw(10) << "cache"
+              << std::right << std::setw(10) << "samples"
+              << std::setw(16) << ("merged p" + std::to_string(int(percentile)))
+              << std::setw(16) << ("worst p" + std::to_string(int(percentile)))
+              << "  worst source\n";
+
+    json out;
+    out["benchmarks"] = json::array();
+
+    for (const auto& key : order) {
+        const MergedCase& c = merged[key];
+        const LatencyHistogram& h = c.histogram;
+
+        std::cout << std::left << std::setw(18) << c.opcode
+                  << std::setw(28) << c.param_desc
+                  << std::setw(10) << c.cache_mode
+                  << std::right << std::setw(10) << h.total_count()
+                  << std::setw(16) << h.value_at_percentile(percentile)
+                  << std::setw(16) << c.worst_percentile
+                  << "  " << c.worst_source << "\n";
+
+        json entry;
+        entry["opcode"] = c.opcode;
+        entry["param_desc"] = c.param_desc;
+        entry["cache_mode"] = c.cache_mode;
+        entry["input_bytes"] = c.input_bytes;
+        entry["median_cycles"] = h.value_at_percentile(50);
+        entry["p90_cycles"] = h.value_at_percentile(90);
+        entry["p95_cycles"] = h.value_at_percentile(95);
+        entry["p99_cycles"] = h.value_at_percentile(99);
+        entry["mean_cycles"] = h.mean();
+        entry["stddev_cycles"] = h.stddev();
+        entry["sample_count"] = h.total_count();
+        entry["merged_sources"] = c.sources;
+        entry["worst_source_percentile"] = {
+            {"percentile", percentile},
+            {"cycles", c.worst_percentile},
+            {"source", c.worst_source}
+        };
+        entry["histogram"] = json::parse(h.to_json());
+        out["benchmarks"].push_back(entry);
+    }
+
+    if (!output_file.empty()) {
+        std::ofstream file(output_file);
+        file << out.dump(2) << "\n";
+        std::cout << "\nMerged results written to " << output_file << "\n";
+    }
+
+    return 0;
+}
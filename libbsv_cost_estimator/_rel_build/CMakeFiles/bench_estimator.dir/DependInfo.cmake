@@ -0,0 +1,20 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/libbsv_cost_estimator/benchmarks/bench_estimator.cpp" "CMakeFiles/bench_estimator.dir/benchmarks/bench_estimator.cpp.o" "gcc" "CMakeFiles/bench_estimator.dir/benchmarks/bench_estimator.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/libbsv_cost_estimator/_rel_build/CMakeFiles/bsv_cost_estimator.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_estimator.dir/benchmarks/bench_estimator.cpp.o"
+  "CMakeFiles/bench_estimator.dir/benchmarks/bench_estimator.cpp.o.d"
+  "bench_estimator"
+  "bench_estimator.pdb"
+  "generated/bsv/models/static_cost_model.h"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_estimator.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
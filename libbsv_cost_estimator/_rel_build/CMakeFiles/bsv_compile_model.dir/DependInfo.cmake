@@ -0,0 +1,20 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/libbsv_cost_estimator/tools/bsv_compile_model.cpp" "CMakeFiles/bsv_compile_model.dir/tools/bsv_compile_model.cpp.o" "gcc" "CMakeFiles/bsv_compile_model.dir/tools/bsv_compile_model.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/libbsv_cost_estimator/_rel_build/CMakeFiles/bsv_cost_estimator.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bsv_compile_model.dir/tools/bsv_compile_model.cpp.o"
+  "CMakeFiles/bsv_compile_model.dir/tools/bsv_compile_model.cpp.o.d"
+  "bsv_compile_model"
+  "bsv_compile_model.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bsv_compile_model.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,23 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/libbsv_cost_estimator/src/cost_estimator.cpp" "CMakeFiles/bsv_cost_estimator.dir/src/cost_estimator.cpp.o" "gcc" "CMakeFiles/bsv_cost_estimator.dir/src/cost_estimator.cpp.o.d"
+  "/root/repo/libbsv_cost_estimator/src/cost_model.cpp" "CMakeFiles/bsv_cost_estimator.dir/src/cost_model.cpp.o" "gcc" "CMakeFiles/bsv_cost_estimator.dir/src/cost_model.cpp.o.d"
+  "/root/repo/libbsv_cost_estimator/src/hardware.cpp" "CMakeFiles/bsv_cost_estimator.dir/src/hardware.cpp.o" "gcc" "CMakeFiles/bsv_cost_estimator.dir/src/hardware.cpp.o.d"
+  "/root/repo/libbsv_cost_estimator/src/model_handle.cpp" "CMakeFiles/bsv_cost_estimator.dir/src/model_handle.cpp.o" "gcc" "CMakeFiles/bsv_cost_estimator.dir/src/model_handle.cpp.o.d"
+  "/root/repo/libbsv_cost_estimator/src/profile_registry.cpp" "CMakeFiles/bsv_cost_estimator.dir/src/profile_registry.cpp.o" "gcc" "CMakeFiles/bsv_cost_estimator.dir/src/profile_registry.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
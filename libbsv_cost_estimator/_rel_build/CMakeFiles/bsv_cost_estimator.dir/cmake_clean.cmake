@@ -0,0 +1,19 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bsv_cost_estimator.dir/src/cost_estimator.cpp.o"
+  "CMakeFiles/bsv_cost_estimator.dir/src/cost_estimator.cpp.o.d"
+  "CMakeFiles/bsv_cost_estimator.dir/src/cost_model.cpp.o"
+  "CMakeFiles/bsv_cost_estimator.dir/src/cost_model.cpp.o.d"
+  "CMakeFiles/bsv_cost_estimator.dir/src/hardware.cpp.o"
+  "CMakeFiles/bsv_cost_estimator.dir/src/hardware.cpp.o.d"
+  "CMakeFiles/bsv_cost_estimator.dir/src/model_handle.cpp.o"
+  "CMakeFiles/bsv_cost_estimator.dir/src/model_handle.cpp.o.d"
+  "CMakeFiles/bsv_cost_estimator.dir/src/profile_registry.cpp.o"
+  "CMakeFiles/bsv_cost_estimator.dir/src/profile_registry.cpp.o.d"
+  "libbsv_cost_estimator.a"
+  "libbsv_cost_estimator.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bsv_cost_estimator.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "libbsv_cost_estimator.a"
+)
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/estimate_tx.dir/examples/estimate_tx.cpp.o"
+  "CMakeFiles/estimate_tx.dir/examples/estimate_tx.cpp.o.d"
+  "estimate_tx"
+  "estimate_tx.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/estimate_tx.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
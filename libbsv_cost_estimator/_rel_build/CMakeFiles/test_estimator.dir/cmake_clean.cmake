@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_estimator.dir/tests/test_estimator.cpp.o"
+  "CMakeFiles/test_estimator.dir/tests/test_estimator.cpp.o.d"
+  "generated/bsv/models/static_cost_model.h"
+  "test_estimator"
+  "test_estimator.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_estimator.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
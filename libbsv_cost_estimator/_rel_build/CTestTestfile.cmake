@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/libbsv_cost_estimator
+# Build directory: /root/repo/libbsv_cost_estimator/_rel_build
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(test_estimator "/root/repo/libbsv_cost_estimator/_rel_build/test_estimator")
+set_tests_properties(test_estimator PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/libbsv_cost_estimator/CMakeLists.txt;101;add_test;/root/repo/libbsv_cost_estimator/CMakeLists.txt;0;")
@@ -0,0 +1,79 @@
+// Generated by bsv_compile_model from /root/repo/cost_models/example_model.json. Do not edit.
+#pragma once
+
+#include "bsv/static_cost_estimator.h"
+#include <array>
+#include <limits>
+
+namespace bsv {
+namespace cost {
+namespace models {
+
+struct static_cost_model {
+    static constexpr double kInf = std::numeric_limits<double>::infinity();
+
+    static constexpr const char* profile_id = "benchmark_2025_11_10";
+    static constexpr double c_dispatch = 5.0;
+    static constexpr double c_parse_per_byte = 0.80000000000000004;
+
+    // {type, has_cold, c0, c1, c2, c_ecdsa, c_preimage_per_byte, c_keyscan, c_setup,
+    //  c_sigcache_hit, c_preimage_per_byte_batched, c_alloc, c0_cold, c1_cold,
+    //  aux_offset, aux_count}
+    static constexpr std::array<OpcodeCostModel, 256> opcodes = [] {
+        std::array<OpcodeCostModel, 256> t{};
+        t[0x63] = {CostModelType::CONSTANT, 0, 33.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0};  // OP_IF
+        t[0x64] = {CostModelType::CONSTANT, 0, 33.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0};  // OP_NOTIF
+        t[0x67] = {CostModelType::CONSTANT, 0, 33.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0};  // OP_ELSE
+        t[0x68] = {CostModelType::CONSTANT, 0, 33.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0};  // OP_ENDIF
+        t[0x76] = {CostModelType::CONSTANT, 0, 130.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0};  // OP_DUP
+        t[0x79] = {CostModelType::CONSTANT, 0, 136.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0};  // OP_PICK
+        t[0x7a] = {CostModelType::LINEAR, 0, 570.0, 3.5, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0};  // OP_ROLL
+        t[0x7c] = {CostModelType::CONSTANT, 0, 86.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0};  // OP_SWAP
+        t[0x7e] = {CostModelType::LINEAR, 0, 150.0, 0.14999999999999999, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 50.0, 0.0, 0.0, 0, 0};  // OP_CAT
+        t[0x7f] = {CostModelType::LINEAR, 0, 200.0, 0.34999999999999998, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0};  // OP_SPLIT
+        t[0x80] = {CostModelType::LINEAR, 0, 120.0, 0.040000000000000001, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0};  // OP_NUM2BIN
+        t[0x81] = {CostModelType::CONSTANT, 0, 90.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0};  // OP_BIN2NUM
+        t[0x83] = {CostModelType::LINEAR, 0, 230.0, 1.6499999999999999, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0};  // OP_INVERT
+        t[0x84] = {CostModelType::LINEAR, 0, 255.0, 1.52, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0};  // OP_AND
+        t[0x85] = {CostModelType::LINEAR, 0, 255.0, 1.5900000000000001, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0};  // OP_OR
+        t[0x86] = {CostModelType::LINEAR, 0, 257.0, 1.5700000000000001, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0};  // OP_XOR
+        t[0x93] = {CostModelType::LINEAR, 0, 1180.0, 12.300000000000001, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0};  // OP_ADD
+        t[0x95] = {CostModelType::QUADRATIC, 0, 1020.0, 30.100000000000001, 0.0035999999999999999, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0};  // OP_MUL
+        t[0x96] = {CostModelType::QUADRATIC, 0, 1100.0, 6.0499999999999998, 0.024500000000000001, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0};  // OP_DIV
+        t[0x97] = {CostModelType::QUADRATIC, 0, 1070.0, 6.29, 0.021100000000000001, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0};  // OP_MOD
+        t[0x98] = {CostModelType::LINEAR, 0, 298.0, 4.6500000000000004, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0};  // OP_LSHIFT
+        t[0x99] = {CostModelType::LINEAR, 0, 288.0, 4.6500000000000004, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0};  // OP_RSHIFT
+        t[0xa6] = {CostModelType::LINEAR, 0, 1000.0, 7.5999999999999996, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0};  // OP_RIPEMD160
+        t[0xa7] = {CostModelType::LINEAR, 0, 1000.0, 1.24, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0};  // OP_SHA1
+        t[0xa8] = {CostModelType::LINEAR, 0, 1000.0, 1.3500000000000001, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0};  // OP_SHA256
+        t[0xa9] = {CostModelType::LINEAR, 0, 1500.0, 1.3700000000000001, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0};  // OP_HASH160
+        t[0xaa] = {CostModelType::LINEAR, 0, 1800.0, 1.3799999999999999, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0};  // OP_HASH256
+        t[0xac] = {CostModelType::SIGNATURE, 0, 0.0, 0.0, 0.0, 85000.0, 1.3500000000000001, 0.0, 0.0, 2500.0, 1.3, 0.0, 0.0, 0.0, 0, 0};  // OP_CHECKSIG
+        t[0xae] = {CostModelType::MULTISIG, 0, 0.0, 0.0, 0.0, 85000.0, 1.3500000000000001, 150.0, 300.0, 2500.0, 1.3, 0.0, 0.0, 0.0, 0, 0};  // OP_CHECKMULTISIG
+        return t;
+    }();
+
+    static constexpr std::array<PiecewiseCost, 0> piecewise = {{
+    }};
+
+    // {size, cycles, log(size), log(cycles)}
+    static constexpr std::array<TablePoint, 0> table = {{
+    }};
+
+    // {count, reserved, smt_speedup, threads, compute, memory}
+    static constexpr ParallelEfficiency parallel = {
+        0, 0, 0.0,
+        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}};
+
+    // {c_exec_per_depth, c_skip_per_byte, c_mispredict}
+    static constexpr ControlFlowCost control_flow = {2.96, 0.058000000000000003, 14.300000000000001};
+
+    // {c_map, c_per_page, page_bytes, threshold_bytes}
+    static constexpr FirstTouchCost first_touch = {0.0, 4172.0, 4096.0, 131072.0};
+};
+
+} // namespace models
+} // namespace cost
+} // namespace bsv
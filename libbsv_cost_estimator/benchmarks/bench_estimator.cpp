@@ -0,0 +1,147 @@
+// Estimator microbenchmark: time per estimate for the runtime-loaded
+// CostEstimator (JSON model, then the same model compiled and mmapped) and
+// StaticCostEstimator with the model compiled in (BSV_STATIC_COST_MODEL).
+//
+// Usage: bench_estimator [model.json]   (default: the static model's source)
+
+#include "bsv/cost_estimator.h"
+#include "bsv/compiled_model.h"
+#include "bsv/static_cost_estimator.h"
+#include "bsv/models/static_cost_model.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace bsv::cost;
+using Clock = std::chrono::steady_clock;
+
+struct Scenario {
+    std::string name;
+    Script unlocking;
+    Script locking;
+};
+
+static Script push(size_t size) {
+    Script s;
+    if (size < 0x4c) {
+        s.push_back(static_cast<uint8_t>(size));
+    } else {
+        s.push_back(static_cast<uint8_t>(OpCode::OP_PUSHDATA1));
+        s.push_back(static_cast<uint8_t>(size));
+    }
+    s.resize(s.size() + size, 0xab);
+    return s;
+}
+
+static void append(Script& script, const Script& more) {
+    script.insert(script.end(), more.begin(), more.end());
+}
+
+static std::vector<Scenario> scenarios() {
+    std::vector<Scenario> list;
+
+    // Standard P2PKH: <sig> <pubkey> | DUP HASH160 <20> EQUALVERIFY CHECKSIG
+    Scenario p2pkh{"p2pkh", {}, {}};
+    append(p2pkh.unlocking, push(71));
+    append(p2pkh.unlocking, push(33));
+    p2pkh.locking = {static_cast<uint8_t>(OpCode::OP_DUP), static_cast<uint8_t>(OpCode::OP_HASH160)};
+    append(p2pkh.locking, push(20));
+    p2pkh.locking.push_back(0x88);  // OP_EQUALVERIFY
+    p2pkh.locking.push_back(static_cast<uint8_t>(OpCode::OP_CHECKSIG));
+    list.push_back(p2pkh);
+
+    // Data assembly: ten 200-byte pushes concatenated, then hashed
+    Scenario cat_hash{"cat_hash", {}, {}};
+    for (int i = 0; i < 10; ++i) append(cat_hash.unlocking, push(200));
+    for (int i = 0; i < 9; ++i) cat_hash.locking.push_back(static_cast<uint8_t>(OpCode::OP_CAT));
+    cat_hash.locking.push_back(static_cast<uint8_t>(OpCode::OP_SHA256));
+    cat_hash.locking.push_back(static_cast<uint8_t>(OpCode::OP_HASH256));
+    list.push_back(cat_hash);
+
+    // Long script: 500 x (push, DUP, CAT, SHA256)
+    Scenario long_script{"long_2000_ops", {}, {}};
+    for (int i = 0; i < 500; ++i) {
+        append(long_script.locking, push(1));
+        long_script.locking.push_back(static_cast<uint8_t>(OpCode::OP_DUP));
+        long_script.locking.push_back(static_cast<uint8_t>(OpCode::OP_CAT));
+        long_script.locking.push_back(static_cast<uint8_t>(OpCode::OP_SHA256));
+    }
+    list.push_back(long_script);
+
+    return list;
+}
+
+// Median nanoseconds per call over several timed batches
+template <class Fn>
+static double time_ns(Fn&& fn) {
+    // Size batches to roughly 20ms
+    uint64_t iterations = 1;
+    for (;;) {
+        auto start = Clock::now();
+        for (uint64_t i = 0; i < iterations; ++i) fn();
+        double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        if (elapsed > 0.02 || iterations >= (uint64_t(1) << 30)) break;
+        iterations *= 2;
+    }
+
+    std::vector<double> samples;
+    for (int batch = 0; batch < 9; ++batch) {
+        auto start = Clock::now();
+        for (uint64_t i = 0; i < iterations; ++i) fn();
+        double elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        samples.push_back(elapsed / iterations);
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+int main(int argc, char** argv) {
+    std::string model_path = argc > 1 ? argv[1] : BSV_STATIC_COST_MODEL_SOURCE;
+    std::string compiled_path = "bench_estimator_model.bsvcm";
+    compile_cost_model(model_path, compiled_path);
+
+    CostEstimator from_json(model_path);
+    CostEstimator from_binary(compiled_path);
+    StaticCostEstimator<models::static_cost_model> compiled_in;
+
+    Transaction tx;
+    tx.version = 1;
+    tx.locktime = 0;
+    tx.inputs.push_back({std::vector<uint8_t>(32, 0), 0, {}, 0xffffffff});
+    tx.outputs.push_back({100000, Script(25, 0)});
+
+    std::cout << "Model: " << model_path << " (static: " << compiled_in.get_profile_id() << ")\n\n"
+              << std::left << std::setw(16) << "scenario"
+              << std::right << std::setw(14) << "json ns"
+              << std::setw(14) << "mmap ns"
+              << std::setw(14) << "static ns"
+              << std::setw(10) << "speedup"
+              << "  result\n";
+
+    volatile uint64_t sink = 0;
+    for (const auto& s : scenarios()) {
+        auto runtime = from_binary.estimate(s.unlocking, s.locking, tx, 0);
+        auto fixed = compiled_in.estimate(s.unlocking, s.locking, tx, 0);
+        bool same = runtime.total_cycles == fixed.total_cycles;
+
+        double json_ns = time_ns([&] { sink = sink + from_json.estimate(s.unlocking, s.locking, tx, 0).total_cycles; });
+        double mmap_ns = time_ns([&] { sink = sink + from_binary.estimate(s.unlocking, s.locking, tx, 0).total_cycles; });
+        double static_ns = time_ns([&] { sink = sink + compiled_in.estimate(s.unlocking, s.locking, tx, 0).total_cycles; });
+
+        std::cout << std::left << std::setw(16) << s.name << std::right << std::fixed
+                  << std::setprecision(1)
+                  << std::setw(14) << json_ns
+                  << std::setw(14) << mmap_ns
+                  << std::setw(14) << static_ns
+                  << std::setprecision(2) << std::setw(9) << mmap_ns / static_ns << "x"
+                  << "  " << fixed.total_cycles << " cycles"
+                  << (same ? "" : " (MISMATCH vs runtime model)") << "\n";
+    }
+
+    std::remove(compiled_path.c_str());
+    return 0;
+}
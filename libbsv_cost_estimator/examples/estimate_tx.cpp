@@ -56,8 +56,11 @@ void print_estimate(const CostEstimate& est) {
     std::cout << "  Dispatch:     " << est.breakdown.dispatch << " cycles" << std::endl;
     std::cout << "  Stack Ops:    " << est.breakdown.stack_ops << " cycles" << std::endl;
     std::cout << "  Byte Ops:     " << est.breakdown.byte_ops << " cycles" << std::endl;
+    std::cout << "  Arithmetic:   " << est.breakdown.arithmetic << " cycles" << std::endl;
     std::cout << "  Hashing:      " << est.breakdown.hashing << " cycles" << std::endl;
     std::cout << "  Signatures:   " << est.breakdown.signatures << " cycles" << std::endl;
+    std::cout << "  Control Flow: " << est.breakdown.control_flow << " cycles" << std::endl;
+    std::cout << "  Memory:       " << est.breakdown.memory << " cycles" << std::endl;
     
     std::cout << "\nResource Usage:" << std::endl;
     std::cout << "  Peak Stack:   " << est.peak_stack_bytes << " bytes ("
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace bsv {
+namespace cost {
+
+// Compiled cost models
+//
+// A compiled model is a versioned, checksummed binary image of a JSON cost
+// model: a fixed header followed by a dense 256-entry opcode table and the
+// piecewise/table/hardware/software sections. CostEstimator mmaps it
+// read-only and evaluates costs directly from the mapping, so loading does no
+// parsing or allocation and the pages are shared between processes using the
+// same model.
+//
+// The format is tied to the library version that wrote it; files with a
+// different kCompiledModelVersion are rejected rather than migrated, so
+// recompile them from the JSON source.
+
+static constexpr uint32_t kCompiledModelVersion = 8;
+
+// Compile a JSON cost model to a binary model file.
+// Throws std::runtime_error if the JSON is invalid or the output can't be written.
+void compile_cost_model(const std::string& json_path, const std::string& output_path);
+
+// True if the file starts with the compiled model magic (no other validation)
+bool is_compiled_cost_model(const std::string& path);
+
+} // namespace cost
+} // namespace bsv
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "bsv/model_handle.h"
+#include "bsv/profile_registry.h"
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -24,6 +26,28 @@ enum class OpCode : uint8_t {
     OP_NUM2BIN = 0x80,
     OP_BIN2NUM = 0x81,
     
+    // Bitwise logic (arbitrary-length operands)
+    OP_INVERT = 0x83,
+    OP_AND = 0x84,
+    OP_OR = 0x85,
+    OP_XOR = 0x86,
+    OP_LSHIFT = 0x98,
+    OP_RSHIFT = 0x99,
+    
+    // Arithmetic (big-number script numbers)
+    OP_ADD = 0x93,
+    OP_SUB = 0x94,
+    OP_MUL = 0x95,
+    OP_DIV = 0x96,
+    OP_MOD = 0x97,
+    OP_NUMEQUAL = 0x9c,
+    OP_NUMEQUALVERIFY = 0x9d,
+    OP_NUMNOTEQUAL = 0x9e,
+    OP_LESSTHAN = 0x9f,
+    OP_GREATERTHAN = 0xa0,
+    OP_LESSTHANOREQUAL = 0xa1,
+    OP_GREATERTHANOREQUAL = 0xa2,
+    
     // Hashing
     OP_SHA1 = 0xa7,
     OP_SHA256 = 0xa8,
@@ -38,12 +62,15 @@ enum class OpCode : uint8_t {
     
     // Control
     OP_IF = 0x63,
+    OP_NOTIF = 0x64,
     OP_ELSE = 0x67,
     OP_ENDIF = 0x68,
     
     // Constants
     OP_0 = 0x00,
+    OP_1NEGATE = 0x4f,
     OP_1 = 0x51,
+    OP_16 = 0x60,
     OP_PUSHDATA1 = 0x4c,
     OP_PUSHDATA2 = 0x4d,
     OP_PUSHDATA4 = 0x4e,
@@ -92,9 +119,11 @@ struct CostEstimate {
         uint64_t dispatch;
         uint64_t stack_ops;
         uint64_t byte_ops;
+        uint64_t arithmetic;
         uint64_t hashing;
         uint64_t signatures;
         uint64_t control_flow;
+        uint64_t memory;        // First touch of newly mapped large items
     } breakdown;
     
     // Resource usage
@@ -106,12 +135,25 @@ struct CostEstimate {
     // Warnings
     std::vector<std::string> warnings;
     
+    // Model the estimate was computed with (see ModelHandle)
+    std::string profile_id;
+    uint64_t model_generation;
+    
     // Convert to fee (cycles / cycles_per_unit)
     double to_fee(uint64_t cycles_per_unit = 100000) const {
         return static_cast<double>(total_cycles) / cycles_per_unit;
     }
 };
 
+// Cost of validating a set of inputs (e.g. a block's) on parallel worker
+// threads, using the model's parallel_efficiency section
+struct ParallelEstimate {
+    uint64_t cpu_cycles;    // Sum of the inputs' total_cycles
+    double wall_cycles;     // Expected elapsed cycles
+    double speedup;         // cpu_cycles / wall_cycles
+    uint32_t threads;       // Threads that get work (at most one per input)
+};
+
 // Safety limits for script execution
 struct EstimatorLimits {
     uint64_t max_script_size = 100'000'000;      // 100MB
@@ -121,13 +163,56 @@ struct EstimatorLimits {
     uint64_t max_total_cycles = 10'000'000'000;  // 10B cycles (safety)
 };
 
+// Cache state the script's data is assumed to be in when it executes
+enum class CacheState {
+    WARM,   // Inputs resident in cache (repeated validation, small scripts)
+    COLD    // Inputs come from DRAM (first sight of a tx, large pushes)
+};
+
+// Whether signature checks find their result in the node's signature cache
+enum class SigCacheState {
+    MISS,   // Full ECDSA verify (mempool admission, unseen transactions)
+    HIT     // Verified at admission; only the cache lookup (block templates)
+};
+
+// How signature preimages are hashed
+enum class PreimageHashing {
+    SERIAL,     // One at a time as each signature is checked (mempool admission)
+    BATCHED     // Many at once with a multi-buffer/SHA-NI kernel (block validation)
+};
+
+// Estimation options beyond safety limits
+struct EstimatorOptions {
+    // Opcodes with "cold" coefficients in the model use them when COLD;
+    // the rest fall back to their warm coefficients
+    CacheState cache_state = CacheState::WARM;
+
+    // HIT prices each verified signature at the model's c_sigcache_hit
+    // instead of c_ecdsa. The sighash is still charged, since it is part of
+    // the cache key, and multisig key-scan attempts are never cached.
+    SigCacheState sigcache = SigCacheState::MISS;
+    
+    // BATCHED prices preimage bytes at the model's c_preimage_per_byte_batched
+    PreimageHashing preimage_hashing = PreimageHashing::SERIAL;
+};
+
 // Main cost estimator class
 class CostEstimator {
 public:
-    // Load cost model from JSON file
+    // Load cost model from JSON or compiled model file
     explicit CostEstimator(const std::string& model_path);
+    
+    // Use a shared model handle; reloading it affects every estimator on it
+    explicit CostEstimator(std::shared_ptr<ModelHandle> model);
     ~CostEstimator();
     
+    // Load the profile in models_dir that best matches this host (see
+    // ProfileRegistry). If none matches closely the nearest is used and
+    // selection->warning says why; every estimate also carries the warning
+    // until the model is reloaded.
+    static std::unique_ptr<CostEstimator> for_host(const std::string& models_dir,
+                                                   ProfileSelection* selection = nullptr);
+    
     // Non-copyable
     CostEstimator(const CostEstimator&) = delete;
     CostEstimator& operator=(const CostEstimator&) = delete;
@@ -149,9 +234,38 @@ public:
         const EstimatorLimits& limits
     ) const;
     
-    // Get model metadata
+    // Estimate with custom limits and options
+    CostEstimate estimate_with_options(
+        const Script& unlocking_script,
+        const Script& locking_script,
+        const Transaction& tx,
+        uint32_t input_index,
+        const EstimatorLimits& limits,
+        const EstimatorOptions& options
+    ) const;
+    
+    // CPU cycles and expected wall time of validating these inputs on
+    // `threads` worker threads. physical_cores below threads means the
+    // extra threads share cores as hyperthreads; 0 means one core each.
+    ParallelEstimate estimate_parallel(
+        const std::vector<CostEstimate>& inputs,
+        uint32_t threads,
+        uint32_t physical_cores = 0
+    ) const;
+    
+    // Swap in a new model without stopping concurrent estimates; returns
+    // the new generation (see ModelHandle::reload)
+    uint64_t reload_model(const std::string& model_path);
+    
+    // Get model metadata. Hardware info is the model's "hardware" section
+    // as JSON, or the detected host if the model has none. Software info is
+    // the "software" section (build, OpenSSL and in-tree hash kernels the
+    // profile was measured with), empty if the model has none.
     std::string get_profile_id() const;
     std::string get_hardware_info() const;
+    std::string get_software_info() const;
+    uint64_t get_model_generation() const;
+    std::shared_ptr<ModelHandle> get_model_handle() const;
     
 private:
     class Impl;
@@ -0,0 +1,165 @@
+#pragma once
+
+// Evaluation of a single opcode's cost model. Header-only so that
+// StaticCostEstimator can inline it with constexpr model records and have
+// the compiler fold the coefficients.
+
+#include "bsv/detail/cost_model_types.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace bsv {
+namespace cost {
+namespace detail {
+
+// Size parameters of one opcode execution (item size, or m/n/preimage for
+// multisig). Fixed capacity so the executor never allocates per opcode.
+struct CostParams {
+    uint64_t value[3] = {0, 0, 0};
+    uint32_t count = 0;
+
+    constexpr CostParams() = default;
+    constexpr CostParams(uint64_t a) : value{a, 0, 0}, count(1) {}
+    constexpr CostParams(uint64_t a, uint64_t b, uint64_t c) : value{a, b, c}, count(3) {}
+
+    constexpr bool empty() const { return count == 0; }
+    constexpr size_t size() const { return count; }
+    constexpr uint64_t operator[](size_t i) const { return value[i]; }
+};
+
+// Index of the segment containing n: the number of breakpoints <= n
+inline unsigned piecewise_segment(const PiecewiseCost& p, double n) {
+#if defined(__AVX__)
+    __m256d x = _mm256_set1_pd(n);
+    unsigned lo = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_load_pd(p.breakpoints), x, _CMP_LE_OQ));
+    unsigned hi = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_load_pd(p.breakpoints + 4), x, _CMP_LE_OQ));
+    return __builtin_popcount(lo | (hi << 4));
+#elif defined(__SSE2__)
+    __m128d x = _mm_set1_pd(n);
+    unsigned mask = 0;
+    for (int i = 0; i < kMaxPiecewiseBreakpoints; i += 2) {
+        mask |= _mm_movemask_pd(_mm_cmple_pd(_mm_load_pd(p.breakpoints + i), x)) << i;
+    }
+    return __builtin_popcount(mask);
+#else
+    unsigned segment = 0;
+    for (int i = 0; i < kMaxPiecewiseBreakpoints; ++i) {
+        segment += p.breakpoints[i] <= n;
+    }
+    return segment;
+#endif
+}
+
+// Interpolate a table in log-log space (a power law between neighbouring
+// points). Below the first point the first cost applies; beyond the last one
+// the last segment's cycles/byte continues linearly.
+inline double table_lookup(const TablePoint* points, uint32_t count, double n) {
+    if (n <= points[0].size) {
+        return points[0].cycles;
+    }
+
+    const TablePoint* last = points + count - 1;
+    if (n >= last->size) {
+        if (count == 1) return last->cycles;
+        const TablePoint* prev = last - 1;
+        double slope = std::max(0.0, (last->cycles - prev->cycles) / (last->size - prev->size));
+        return last->cycles + slope * (n - last->size);
+    }
+
+    const TablePoint* hi = std::upper_bound(points, last, n,
+        [](double value, const TablePoint& p) { return value < p.size; });
+    const TablePoint* lo = hi - 1;
+    double t = (std::log(n) - lo->log_size) / (hi->log_size - lo->log_size);
+    return std::exp(lo->log_cycles + t * (hi->log_cycles - lo->log_cycles));
+}
+
+// Cost of one execution of an opcode with the given model. piecewise and
+// table are the model's shared pools that aux_offset indexes into.
+inline uint64_t evaluate_opcode_cost(
+    const OpcodeCostModel& model,
+    const PiecewiseCost* piecewise,
+    const TablePoint* table,
+    const CostParams& params,
+    bool cold_cache,
+    bool sigcache_hit = false,
+    bool batched_hashing = false
+) {
+    bool cold = model.has_cold && cold_cache;
+    double c0 = cold ? model.c0_cold : model.c0;
+    double c1 = cold ? model.c1_cold : model.c1;
+    double c_verify = sigcache_hit ? model.c_sigcache_hit : model.c_ecdsa;
+    double c_preimage = batched_hashing ? model.c_preimage_per_byte_batched
+                                        : model.c_preimage_per_byte;
+
+    switch (model.type) {
+        case CostModelType::NONE:
+            // Unknown opcode - use default
+            return 100;
+
+        case CostModelType::CONSTANT:
+            return static_cast<uint64_t>(c0);
+
+        case CostModelType::LINEAR: {
+            uint64_t n = params.empty() ? 0 : params[0];
+            return static_cast<uint64_t>(c0 + c1 * n + model.c_alloc);
+        }
+
+        case CostModelType::QUADRATIC: {
+            double n = params.empty() ? 0.0 : static_cast<double>(params[0]);
+            return static_cast<uint64_t>(c0 + c1 * n + model.c2 * n * n + model.c_alloc);
+        }
+
+        case CostModelType::NLOGN: {
+            double n = params.empty() ? 0.0 : static_cast<double>(params[0]);
+            double n_log_n = n > 1 ? n * std::log2(n) : 0.0;
+            return static_cast<uint64_t>(c0 + c1 * n + model.c2 * n_log_n + model.c_alloc);
+        }
+
+        case CostModelType::PIECEWISE: {
+            double n = params.empty() ? 0.0 : static_cast<double>(params[0]);
+            const PiecewiseCost& segments = piecewise[model.aux_offset];
+            unsigned segment = piecewise_segment(segments, n);
+            return static_cast<uint64_t>(
+                segments.c0[segment] + segments.c1[segment] * n + model.c_alloc
+            );
+        }
+
+        case CostModelType::TABLE: {
+            double n = params.empty() ? 0.0 : static_cast<double>(params[0]);
+            return static_cast<uint64_t>(
+                table_lookup(table + model.aux_offset, model.aux_count, n) + model.c_alloc
+            );
+        }
+
+        case CostModelType::SIGNATURE: {
+            uint64_t preimage_size = params.empty() ? 1000 : params[0];
+            return static_cast<uint64_t>(
+                c_verify + c_preimage * preimage_size
+            );
+        }
+
+        case CostModelType::MULTISIG: {
+            uint64_t m = params.size() > 0 ? params[0] : 1;  // signatures to verify
+            uint64_t n = params.size() > 1 ? params[1] : 3;  // total pubkeys
+            uint64_t preimage_size = params.size() > 2 ? params[2] : 1000;
+
+            return static_cast<uint64_t>(
+                m * (c_verify + c_preimage * preimage_size) +
+                (n - m) * model.c_keyscan +
+                model.c_setup
+            );
+        }
+    }
+
+    return 100; // Fallback
+}
+
+} // namespace detail
+} // namespace cost
+} // namespace bsv
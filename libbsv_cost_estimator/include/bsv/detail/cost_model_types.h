@@ -0,0 +1,109 @@
+#pragma once
+
+// Per-opcode cost model records, shared by the runtime estimator (compiled
+// model files and JSON models compiled on load) and StaticCostEstimator
+// (constexpr tables generated from a model at build time).
+
+#include <cstdint>
+
+namespace bsv {
+namespace cost {
+
+// Maximum breakpoints in a piecewise model (enough for L1/L2/LLC/DRAM plus
+// a few data-driven splits)
+static constexpr int kMaxPiecewiseBreakpoints = 8;
+
+// Size-tiered cost: segment i covers [breakpoints[i-1], breakpoints[i]) and
+// costs c0[i] + c1[i]*n. Unused breakpoint slots hold +inf so the segment
+// lookup is a fixed-width compare with no data-dependent branches.
+struct alignas(32) PiecewiseCost {
+    double breakpoints[kMaxPiecewiseBreakpoints];
+    double c0[kMaxPiecewiseBreakpoints + 1];
+    double c1[kMaxPiecewiseBreakpoints + 1];
+};
+
+// One measured (size, cycles) point of a table model, with logs precomputed
+struct TablePoint {
+    double size;
+    double cycles;
+    double log_size;
+    double log_cycles;
+};
+
+// Maximum thread counts in a parallel efficiency table
+static constexpr int kMaxParallelPoints = 16;
+
+// Scaling of validation across worker threads (the model's
+// "parallel_efficiency" section). Efficiencies are per-thread throughput
+// relative to one thread, at threads[i] threads on as many physical cores;
+// count == 0 means the model has none and scaling is taken as ideal.
+struct ParallelEfficiency {
+    uint32_t count;
+    uint32_t reserved;
+    double smt_speedup;                     // Core throughput with two hyperthreads vs one (0 = unknown)
+    double threads[kMaxParallelPoints];
+    double compute[kMaxParallelPoints];     // ECDSA-bound work
+    double memory[kMaxParallelPoints];      // Hashing/copy-bound work
+};
+
+// Conditional execution costs (the model's "control_flow" section); all
+// zero when the model has none
+struct ControlFlowCost {
+    double c_exec_per_depth;    // Per opcode per open IF (vfExec scan; 0 with a counter)
+    double c_skip_per_byte;     // Reading a push inside an IF block that may be skipped
+    double c_mispredict;        // Per OP_IF/OP_NOTIF whose condition is unpredictable
+};
+
+// First-touch cost of a newly materialised large stack item (the model's
+// "first_touch" section): an item of threshold_bytes or more lands in memory
+// the process hasn't touched yet and pays c_map + c_per_page per page on top
+// of the opcode's own cost. page_bytes == 0 means the model has none.
+struct FirstTouchCost {
+    double c_map;               // Per item: mapping the region
+    double c_per_page;          // Per page: the fault and zeroing
+    double page_bytes;          // Unit of c_per_page (4096)
+    double threshold_bytes;     // Smallest item that gets a fresh mapping
+};
+
+enum class CostModelType : uint32_t {
+    NONE = 0,       // Opcode not in the model: default cost
+    CONSTANT,
+    LINEAR,
+    PIECEWISE,
+    TABLE,
+    SIGNATURE,
+    MULTISIG,
+    QUADRATIC,      // c0 + c1*n + c2*n^2
+    NLOGN           // c0 + c1*n + c2*n*log2(n)
+};
+
+// Cost model for a single opcode. One entry per opcode byte, so lookup is a
+// direct index.
+struct OpcodeCostModel {
+    CostModelType type;
+    uint32_t has_cold;          // Cold-cache coefficients present
+
+    double c0;                  // Base cost
+    double c1;                  // Per-byte cost (linear model)
+    double c2;                  // Super-linear term (quadratic/nlogn models)
+    double c_ecdsa;             // ECDSA verification cost
+    double c_preimage_per_byte; // Preimage hashing cost
+    double c_keyscan;           // Per-key scan (multisig)
+    double c_setup;             // Setup overhead
+    double c_sigcache_hit;      // Signature cache lookup that hits (replaces c_ecdsa)
+    double c_preimage_per_byte_batched; // Preimage hashing in a multi-buffer batch
+    double c_alloc;             // Allocation overhead
+
+    // Cold-cache coefficients (constant/linear), used when the caller
+    // asks for CacheState::COLD
+    double c0_cold;
+    double c1_cold;
+
+    // PIECEWISE: index into the piecewise section.
+    // TABLE: first point and point count in the table section.
+    uint32_t aux_offset;
+    uint32_t aux_count;
+};
+
+} // namespace cost
+} // namespace bsv
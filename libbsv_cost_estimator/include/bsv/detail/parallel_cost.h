@@ -0,0 +1,75 @@
+#pragma once
+
+// Wall-time estimate for inputs validated on parallel worker threads, shared
+// by CostEstimator and StaticCostEstimator.
+
+#include "bsv/cost_estimator.h"
+#include "bsv/detail/cost_model_types.h"
+#include <algorithm>
+#include <vector>
+
+namespace bsv {
+namespace cost {
+namespace detail {
+
+// Per-thread efficiency from one of the model's tables at n threads on as
+// many cores: linear between measured thread counts, flat past either end
+inline double parallel_table_efficiency(const ParallelEfficiency& p, const double* table, double n) {
+    if (p.count == 0) return 1.0;
+    if (n <= p.threads[0]) return table[0];
+    for (uint32_t i = 1; i < p.count; ++i) {
+        if (n <= p.threads[i]) {
+            double t = (n - p.threads[i - 1]) / (p.threads[i] - p.threads[i - 1]);
+            return table[i - 1] + t * (table[i] - table[i - 1]);
+        }
+    }
+    return table[p.count - 1];
+}
+
+// Per-thread efficiency of `threads` threads on `cores` physical cores.
+// Threads beyond the core count run as hyperthreads and add smt_speedup - 1
+// of a core each (nothing if the model has no SMT measurement).
+inline double parallel_efficiency(const ParallelEfficiency& p, const double* table,
+                                  uint32_t threads, uint32_t cores) {
+    if (threads == 0) return 1.0;
+    cores = std::min(cores == 0 ? threads : cores, threads);
+    double throughput = cores * parallel_table_efficiency(p, table, cores);
+    if (threads > cores) {
+        double smt_gain = std::max(0.0, p.smt_speedup - 1.0);
+        double shared = std::min<uint32_t>(threads - cores, cores);
+        throughput *= 1.0 + smt_gain * shared / cores;
+    }
+    return throughput / threads;
+}
+
+// Signature and script work scale with the compute table, hashing and byte
+// operations with the memory table. An input runs on one thread, so the
+// wall time is never below the most expensive input.
+inline ParallelEstimate estimate_parallel(const ParallelEfficiency& p,
+                                          const std::vector<CostEstimate>& inputs,
+                                          uint32_t threads, uint32_t physical_cores) {
+    ParallelEstimate result = {};
+    uint64_t memory_cycles = 0;
+    uint64_t longest = 0;
+    for (const auto& input : inputs) {
+        result.cpu_cycles += input.total_cycles;
+        memory_cycles += std::min(input.total_cycles, input.breakdown.hashing + input.breakdown.byte_ops);
+        longest = std::max(longest, input.total_cycles);
+    }
+    if (inputs.empty()) return result;
+
+    uint32_t used = static_cast<uint32_t>(std::min<size_t>(std::max<uint32_t>(threads, 1), inputs.size()));
+    uint32_t cores = physical_cores == 0 ? used : std::min(physical_cores, used);
+    double compute_rate = used * parallel_efficiency(p, p.compute, used, cores);
+    double memory_rate = used * parallel_efficiency(p, p.memory, used, cores);
+
+    result.threads = used;
+    result.wall_cycles = std::max<double>(
+        longest, (result.cpu_cycles - memory_cycles) / compute_rate + memory_cycles / memory_rate);
+    result.speedup = result.wall_cycles > 0 ? result.cpu_cycles / result.wall_cycles : 1.0;
+    return result;
+}
+
+} // namespace detail
+} // namespace cost
+} // namespace bsv
@@ -0,0 +1,525 @@
+#pragma once
+
+// Symbolic execution of a script against a cost model. Shared by
+// CostEstimator (model loaded at runtime) and StaticCostEstimator (model
+// compiled in); the model is reached only through the OpcodeCost callable,
+// so with a constexpr model every handler's cost folds to its coefficients.
+
+#include "bsv/cost_estimator.h"
+#include "bsv/detail/cost_eval.h"
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+namespace bsv {
+namespace cost {
+namespace detail {
+
+// Value of a pushed script number: little-endian magnitude with the sign in
+// the top bit of the last byte
+inline int64_t script_number(const uint8_t* data, size_t size) {
+    if (size == 0) return 0;
+    int64_t value = 0;
+    for (size_t i = 0; i < size; ++i) value |= static_cast<int64_t>(data[i]) << (8 * i);
+    int64_t sign_bit = int64_t{0x80} << (8 * (size - 1));
+    return (value & sign_bit) ? -(value & ~sign_bit) : value;
+}
+
+// opcode_cost(OpCode, const CostParams&) -> uint64_t cycles
+template <class OpcodeCost>
+CostEstimate symbolic_execute(
+    const OpcodeCost& opcode_cost,
+    double c_dispatch,
+    double c_parse_per_byte,
+    const ControlFlowCost& control_flow,
+    const FirstTouchCost& first_touch,
+    const Script& unlocking_script,
+    const Script& locking_script,
+    const Transaction& tx,
+    uint32_t input_index,
+    const EstimatorLimits& limits
+) {
+    CostEstimate result;
+    result.total_cycles = 0;
+    result.breakdown = {};
+    result.peak_stack_bytes = 0;
+    result.peak_stack_items = 0;
+    result.signature_count = 0;
+    result.opcode_count = 0;
+    result.model_generation = 0;
+
+    // Combine scripts (unlocking || locking)
+    Script combined;
+    combined.reserve(unlocking_script.size() + locking_script.size());
+    combined.insert(combined.end(), unlocking_script.begin(), unlocking_script.end());
+    combined.insert(combined.end(), locking_script.begin(), locking_script.end());
+
+    // Check size limits
+    if (combined.size() > limits.max_script_size) {
+        result.warnings.push_back("Script exceeds size limit");
+        return result;
+    }
+
+    // Parsing cost
+    result.breakdown.parsing = static_cast<uint64_t>(c_parse_per_byte * combined.size());
+    result.total_cycles += result.breakdown.parsing;
+
+    // Symbolic execution
+    std::vector<uint64_t> stack_sizes;  // Track size of each stack item
+    uint64_t current_stack_bytes = 0;
+
+    // Value of each stack item that is a number the script pushed itself
+    // (up to 4 bytes), for opcodes whose result size depends on one
+    std::vector<std::optional<int64_t>> stack_values;
+
+    // Open IF blocks. Both branches of every IF are walked and charged, so
+    // the estimate is an upper bound on whichever branch executes.
+    uint64_t cond_depth = 0;
+
+    // A new item large enough to get its own mapping faults in every page
+    auto charge_first_touch = [&](uint64_t item_size) {
+        if (first_touch.page_bytes <= 0 || item_size < first_touch.threshold_bytes) return;
+        uint64_t pages = (item_size + static_cast<uint64_t>(first_touch.page_bytes) - 1) /
+                         static_cast<uint64_t>(first_touch.page_bytes);
+        uint64_t cost = static_cast<uint64_t>(first_touch.c_map + first_touch.c_per_page * pages);
+        result.breakdown.memory += cost;
+        result.total_cycles += cost;
+    };
+
+    size_t pc = 0;  // Program counter
+    while (pc < combined.size()) {
+        if (result.opcode_count >= limits.max_opcode_count) {
+            result.warnings.push_back("Opcode count limit exceeded");
+            break;
+        }
+
+        uint8_t op_byte = combined[pc++];
+        result.opcode_count++;
+
+        // Dispatch overhead
+        result.breakdown.dispatch += static_cast<uint64_t>(c_dispatch);
+        result.total_cycles += static_cast<uint64_t>(c_dispatch);
+
+        // Every opcode checks the condition stack before executing
+        if (cond_depth > 0) {
+            uint64_t scan = static_cast<uint64_t>(control_flow.c_exec_per_depth * cond_depth);
+            result.breakdown.control_flow += scan;
+            result.total_cycles += scan;
+        }
+
+        // Handle push operations
+        bool is_push = false;
+        uint64_t push_size = 0;
+        std::optional<int64_t> push_value;
+        if (op_byte == static_cast<uint8_t>(OpCode::OP_0)) {
+            is_push = true;
+            push_value = 0;
+        } else if (op_byte == static_cast<uint8_t>(OpCode::OP_1NEGATE) ||
+                   (op_byte >= static_cast<uint8_t>(OpCode::OP_1) &&
+                    op_byte <= static_cast<uint8_t>(OpCode::OP_16))) {
+            // OP_1NEGATE and OP_1..OP_16 push their number without data
+            is_push = true;
+            push_size = 1;
+            push_value = static_cast<int64_t>(op_byte) - 0x50;
+        } else if (op_byte > 0 && op_byte < 0x4c) {
+            // Direct push of N bytes
+            is_push = true;
+            push_size = op_byte;
+        } else if (op_byte == static_cast<uint8_t>(OpCode::OP_PUSHDATA1) && pc < combined.size()) {
+            is_push = true;
+            push_size = combined[pc++];
+        } else if (op_byte == static_cast<uint8_t>(OpCode::OP_PUSHDATA2) && pc + 2 <= combined.size()) {
+            is_push = true;
+            push_size = combined[pc] | (combined[pc + 1] << 8);
+            pc += 2;
+        } else if (op_byte == static_cast<uint8_t>(OpCode::OP_PUSHDATA4) && pc + 4 <= combined.size()) {
+            is_push = true;
+            push_size = static_cast<uint64_t>(combined[pc]) | (static_cast<uint64_t>(combined[pc + 1]) << 8) |
+                        (static_cast<uint64_t>(combined[pc + 2]) << 16) |
+                        (static_cast<uint64_t>(combined[pc + 3]) << 24);
+            pc += 4;
+        }
+
+        if (is_push) {
+            uint64_t data_size = push_value ? 0 : push_size;
+            if (!push_value && data_size <= 4 && pc + data_size <= combined.size()) {
+                push_value = script_number(combined.data() + pc, data_size);
+            }
+            pc += data_size;
+            stack_sizes.push_back(push_size);
+            stack_values.push_back(push_value);
+            current_stack_bytes += push_size;
+            charge_first_touch(push_size);
+            // A push in a skipped branch is still read past
+            if (cond_depth > 0) {
+                uint64_t skip = static_cast<uint64_t>(control_flow.c_skip_per_byte * data_size);
+                result.breakdown.control_flow += skip;
+                result.total_cycles += skip;
+            }
+        } else {
+            // Execute opcode symbolically. Each handler names its opcode as
+            // a constant so a compile-time model folds into it.
+            uint64_t cost = 0;
+            // Set by handlers that keep stack_values in step themselves
+            bool values_kept = false;
+
+            switch (static_cast<OpCode>(op_byte)) {
+                case OpCode::OP_DUP: {
+                    CostParams params;
+                    if (!stack_sizes.empty()) {
+                        uint64_t top_size = stack_sizes.back();
+                        stack_sizes.push_back(top_size);
+                        stack_values.push_back(stack_values.back());
+                        current_stack_bytes += top_size;
+                        params = {top_size};
+                        charge_first_touch(top_size);
+                    }
+                    cost = opcode_cost(OpCode::OP_DUP, params);
+                    result.breakdown.stack_ops += cost;
+                    values_kept = true;
+                    break;
+                }
+
+                case OpCode::OP_SWAP:
+                    // Just swap, no size change
+                    if (stack_sizes.size() >= 2) {
+                        std::swap(stack_sizes[stack_sizes.size()-1], stack_sizes[stack_sizes.size()-2]);
+                        std::swap(stack_values[stack_values.size()-1], stack_values[stack_values.size()-2]);
+                    }
+                    cost = opcode_cost(OpCode::OP_SWAP, {});
+                    result.breakdown.stack_ops += cost;
+                    values_kept = true;
+                    break;
+
+                case OpCode::OP_ROLL: {
+                    // The roll depth is a stack value the executor doesn't
+                    // track, so price the deepest roll possible: every
+                    // other item moves up one place
+                    CostParams params;
+                    if (!stack_sizes.empty()) {
+                        current_stack_bytes -= stack_sizes.back();
+                        stack_sizes.pop_back();
+                        stack_values.pop_back();
+                    }
+                    if (!stack_sizes.empty()) {
+                        params = {stack_sizes.size() - 1};
+                        std::rotate(stack_sizes.begin(), stack_sizes.begin() + 1, stack_sizes.end());
+                        std::rotate(stack_values.begin(), stack_values.begin() + 1, stack_values.end());
+                    }
+                    cost = opcode_cost(OpCode::OP_ROLL, params);
+                    result.breakdown.stack_ops += cost;
+                    values_kept = true;
+                    break;
+                }
+
+                case OpCode::OP_CAT: {
+                    CostParams params;
+                    if (stack_sizes.size() >= 2) {
+                        uint64_t size_b = stack_sizes.back(); stack_sizes.pop_back();
+                        uint64_t size_a = stack_sizes.back(); stack_sizes.pop_back();
+                        uint64_t result_size = size_a + size_b;
+                        stack_sizes.push_back(result_size);
+                        current_stack_bytes = current_stack_bytes - size_a - size_b + result_size;
+                        params = {result_size};
+                        charge_first_touch(result_size);
+                    }
+                    cost = opcode_cost(OpCode::OP_CAT, params);
+                    result.breakdown.byte_ops += cost;
+                    break;
+                }
+
+                case OpCode::OP_SPLIT: {
+                    // <x> <position>: splits x into x[0, position) and
+                    // x[position, end). A position the script computed is
+                    // priced as if one half took the whole item
+                    CostParams params;
+                    if (stack_sizes.size() >= 2) {
+                        std::optional<int64_t> position = stack_values.back();
+                        current_stack_bytes -= stack_sizes.back();
+                        stack_sizes.pop_back();
+                        stack_values.pop_back();
+                        uint64_t size = stack_sizes.back();
+                        uint64_t left = size;
+                        if (position && *position >= 0) {
+                            left = std::min(size, static_cast<uint64_t>(*position));
+                        }
+                        stack_sizes.back() = left;
+                        stack_sizes.push_back(size - left);
+                        stack_values.back().reset();
+                        stack_values.emplace_back();
+                        params = {size};
+                        charge_first_touch(left);
+                        charge_first_touch(size - left);
+                    }
+                    cost = opcode_cost(OpCode::OP_SPLIT, params);
+                    result.breakdown.byte_ops += cost;
+                    values_kept = true;
+                    break;
+                }
+
+                case OpCode::OP_NUM2BIN: {
+                    // <number> <size>: pads the number to size bytes. A
+                    // size the script computed is priced as if the number
+                    // kept its own size
+                    CostParams params;
+                    if (stack_sizes.size() >= 2) {
+                        std::optional<int64_t> requested = stack_values.back();
+                        current_stack_bytes -= stack_sizes.back();
+                        stack_sizes.pop_back();
+                        stack_values.pop_back();
+                        uint64_t number_size = stack_sizes.back();
+                        uint64_t result_size = number_size;
+                        if (requested && *requested >= 0) {
+                            result_size = std::max(number_size, static_cast<uint64_t>(*requested));
+                        }
+                        stack_sizes.back() = result_size;
+                        current_stack_bytes = current_stack_bytes - number_size + result_size;
+                        params = {result_size};
+                        charge_first_touch(result_size);
+                    }
+                    cost = opcode_cost(OpCode::OP_NUM2BIN, params);
+                    result.breakdown.byte_ops += cost;
+                    break;
+                }
+
+                case OpCode::OP_AND:
+                case OpCode::OP_OR:
+                case OpCode::OP_XOR: {
+                    // Operands must be the same size; the result replaces
+                    // the first in place
+                    OpCode op = static_cast<OpCode>(op_byte);
+                    CostParams params;
+                    if (stack_sizes.size() >= 2) {
+                        uint64_t size_b = stack_sizes.back(); stack_sizes.pop_back();
+                        current_stack_bytes -= size_b;
+                        params = {std::max(stack_sizes.back(), size_b)};
+                    }
+                    cost = op == OpCode::OP_AND ? opcode_cost(OpCode::OP_AND, params)
+                         : op == OpCode::OP_OR  ? opcode_cost(OpCode::OP_OR, params)
+                                                : opcode_cost(OpCode::OP_XOR, params);
+                    result.breakdown.byte_ops += cost;
+                    break;
+                }
+
+                case OpCode::OP_INVERT: {
+                    CostParams params;
+                    if (!stack_sizes.empty()) params = {stack_sizes.back()};
+                    cost = opcode_cost(OpCode::OP_INVERT, params);
+                    result.breakdown.byte_ops += cost;
+                    break;
+                }
+
+                case OpCode::OP_LSHIFT:
+                case OpCode::OP_RSHIFT: {
+                    // Pops the shift amount; the shifted item keeps its size
+                    OpCode op = static_cast<OpCode>(op_byte);
+                    CostParams params;
+                    if (stack_sizes.size() >= 2) {
+                        current_stack_bytes -= stack_sizes.back();
+                        stack_sizes.pop_back();
+                        params = {stack_sizes.back()};
+                    }
+                    cost = op == OpCode::OP_LSHIFT ? opcode_cost(OpCode::OP_LSHIFT, params)
+                                                   : opcode_cost(OpCode::OP_RSHIFT, params);
+                    result.breakdown.byte_ops += cost;
+                    break;
+                }
+
+                case OpCode::OP_SHA256:
+                case OpCode::OP_HASH256: {
+                    OpCode op = static_cast<OpCode>(op_byte);
+                    CostParams params;
+                    if (!stack_sizes.empty()) {
+                        uint64_t input_size = stack_sizes.back();
+                        stack_sizes.pop_back();
+                        current_stack_bytes -= input_size;
+                        stack_sizes.push_back(32);  // SHA256 output
+                        current_stack_bytes += 32;
+                        params = {input_size};
+                    }
+                    cost = op == OpCode::OP_SHA256 ? opcode_cost(OpCode::OP_SHA256, params)
+                                                   : opcode_cost(OpCode::OP_HASH256, params);
+                    result.breakdown.hashing += cost;
+                    break;
+                }
+
+                case OpCode::OP_RIPEMD160:
+                case OpCode::OP_SHA1:
+                case OpCode::OP_HASH160: {
+                    OpCode op = static_cast<OpCode>(op_byte);
+                    CostParams params;
+                    if (!stack_sizes.empty()) {
+                        uint64_t input_size = stack_sizes.back();
+                        stack_sizes.pop_back();
+                        current_stack_bytes -= input_size;
+                        stack_sizes.push_back(20);  // RIPEMD160/SHA1 output
+                        current_stack_bytes += 20;
+                        params = {input_size};
+                    }
+                    cost = op == OpCode::OP_RIPEMD160 ? opcode_cost(OpCode::OP_RIPEMD160, params)
+                         : op == OpCode::OP_SHA1      ? opcode_cost(OpCode::OP_SHA1, params)
+                                                      : opcode_cost(OpCode::OP_HASH160, params);
+                    result.breakdown.hashing += cost;
+                    break;
+                }
+
+                case OpCode::OP_ADD:
+                case OpCode::OP_SUB:
+                case OpCode::OP_MUL:
+                case OpCode::OP_DIV:
+                case OpCode::OP_MOD:
+                case OpCode::OP_NUMEQUAL:
+                case OpCode::OP_NUMEQUALVERIFY:
+                case OpCode::OP_NUMNOTEQUAL:
+                case OpCode::OP_LESSTHAN:
+                case OpCode::OP_GREATERTHAN:
+                case OpCode::OP_LESSTHANOREQUAL:
+                case OpCode::OP_GREATERTHANOREQUAL: {
+                    // Big-number operands are unbounded, so cost is by the
+                    // larger operand's size (quadratic for MUL/DIV/MOD)
+                    OpCode op = static_cast<OpCode>(op_byte);
+                    CostParams params;
+                    if (stack_sizes.size() >= 2) {
+                        uint64_t size_b = stack_sizes.back(); stack_sizes.pop_back();
+                        uint64_t size_a = stack_sizes.back(); stack_sizes.pop_back();
+                        current_stack_bytes -= size_a + size_b;
+                        params = {std::max(size_a, size_b)};
+
+                        // Result sizes are upper bounds
+                        uint64_t result_size = 1;
+                        switch (op) {
+                            case OpCode::OP_ADD:
+                            case OpCode::OP_SUB: result_size = std::max(size_a, size_b) + 1; break;
+                            case OpCode::OP_MUL: result_size = size_a + size_b; break;
+                            case OpCode::OP_DIV: result_size = size_a; break;
+                            case OpCode::OP_MOD: result_size = size_b; break;
+                            default: break;
+                        }
+                        if (op != OpCode::OP_NUMEQUALVERIFY) {
+                            stack_sizes.push_back(result_size);
+                            current_stack_bytes += result_size;
+                            charge_first_touch(result_size);
+                        }
+                    }
+                    cost = opcode_cost(op, params);
+                    result.breakdown.arithmetic += cost;
+                    break;
+                }
+
+                case OpCode::OP_IF:
+                case OpCode::OP_NOTIF:
+                    // Pops the condition; a data-dependent condition is
+                    // assumed to mispredict
+                    if (!stack_sizes.empty()) {
+                        current_stack_bytes -= stack_sizes.back();
+                        stack_sizes.pop_back();
+                        stack_values.pop_back();
+                    }
+                    values_kept = true;
+                    cost = (op_byte == static_cast<uint8_t>(OpCode::OP_IF)
+                                ? opcode_cost(OpCode::OP_IF, {})
+                                : opcode_cost(OpCode::OP_NOTIF, {}))
+                         + static_cast<uint64_t>(control_flow.c_mispredict);
+                    result.breakdown.control_flow += cost;
+                    cond_depth++;
+                    break;
+
+                case OpCode::OP_ELSE:
+                    cost = opcode_cost(OpCode::OP_ELSE, {});
+                    result.breakdown.control_flow += cost;
+                    values_kept = true;
+                    break;
+
+                case OpCode::OP_ENDIF:
+                    cost = opcode_cost(OpCode::OP_ENDIF, {});
+                    result.breakdown.control_flow += cost;
+                    if (cond_depth > 0) cond_depth--;
+                    values_kept = true;
+                    break;
+
+                case OpCode::OP_CHECKSIG: {
+                    // Calculate preimage size
+                    uint64_t preimage_size = calculate_sighash_size(tx, input_index, SIGHASH_ALL);
+                    cost = opcode_cost(OpCode::OP_CHECKSIG, {preimage_size});
+                    result.breakdown.signatures += cost;
+                    result.signature_count++;
+                    // Pop sig and pubkey from stack
+                    if (stack_sizes.size() >= 2) {
+                        stack_sizes.pop_back();
+                        stack_sizes.pop_back();
+                        stack_sizes.push_back(1);  // Push result (true/false)
+                    }
+                    break;
+                }
+
+                case OpCode::OP_CHECKMULTISIG: {
+                    // <dummy> <sig>*m <m> <pubkey>*n <n>. m and n are read
+                    // from the pushed numbers; a count the script computed
+                    // is priced at the 20-key limit with every signature
+                    // verified, the worst case
+                    constexpr uint64_t kMaxKeys = 20;
+                    auto count_at = [&](size_t depth) -> std::optional<uint64_t> {
+                        if (depth >= stack_values.size()) return std::nullopt;
+                        const auto& value = stack_values[stack_values.size() - 1 - depth];
+                        if (!value || *value < 0 || *value > static_cast<int64_t>(kMaxKeys)) {
+                            return std::nullopt;
+                        }
+                        return static_cast<uint64_t>(*value);
+                    };
+                    std::optional<uint64_t> keys = count_at(0);
+                    uint64_t n = keys.value_or(kMaxKeys);
+                    uint64_t m = keys ? std::min(count_at(n + 1).value_or(n), n) : kMaxKeys;
+                    uint64_t preimage_size = calculate_sighash_size(tx, input_index, SIGHASH_ALL);
+                    cost = opcode_cost(OpCode::OP_CHECKMULTISIG, {m, n, preimage_size});
+                    result.breakdown.signatures += cost;
+                    result.signature_count += static_cast<uint32_t>(m);
+                    // Pop both counts, the keys, the signatures and the
+                    // dummy, or only n when the items can't be counted;
+                    // push the result
+                    size_t popped = std::min(stack_sizes.size(), static_cast<size_t>(keys ? n + m + 3 : 1));
+                    for (size_t i = 0; i < popped; ++i) {
+                        current_stack_bytes -= stack_sizes.back();
+                        stack_sizes.pop_back();
+                    }
+                    stack_sizes.push_back(1);
+                    current_stack_bytes += 1;
+                    break;
+                }
+
+                default:
+                    // Unknown opcode - estimate conservatively
+                    cost = 100 + opcode_cost(static_cast<OpCode>(op_byte), {});
+                    break;
+            }
+
+            // Any other opcode replaces the items it read with results
+            // whose values aren't tracked
+            if (!values_kept) {
+                stack_values.resize(stack_sizes.size());
+                if (!stack_values.empty()) stack_values.back().reset();
+            }
+
+            result.total_cycles += cost;
+        }
+
+        // Track peak stack usage
+        result.peak_stack_bytes = std::max(result.peak_stack_bytes, current_stack_bytes);
+        result.peak_stack_items = std::max(result.peak_stack_items, static_cast<uint32_t>(stack_sizes.size()));
+
+        // Check limits
+        if (current_stack_bytes > limits.max_stack_item_size) {
+            result.warnings.push_back("Stack byte limit exceeded");
+            break;
+        }
+        if (stack_sizes.size() > limits.max_stack_items) {
+            result.warnings.push_back("Stack item count limit exceeded");
+            break;
+        }
+    }
+
+    return result;
+}
+
+} // namespace detail
+} // namespace cost
+} // namespace bsv
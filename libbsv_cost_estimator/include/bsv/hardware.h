@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace bsv {
+namespace cost {
+
+// Description of a host, either detected or read from a cost model's
+// "hardware" section. JSON keys match the benchmark suite's hardware.json,
+// so calibrated models carry it unchanged. Unknown values are empty, -1 or 0.
+struct HardwareInfo {
+    std::string cpu_vendor;         // "GenuineIntel", "AuthenticAMD", ...
+    std::string cpu_model;          // Brand string
+    int cpu_family = -1;            // CPUID display family
+    int cpu_model_number = -1;      // CPUID display model
+
+    int logical_cpus = 0;
+    int physical_cores = 0;
+
+    uint64_t l1d_bytes = 0;
+    uint64_t l2_bytes = 0;
+    uint64_t llc_bytes = 0;
+
+    bool sha_ni = false;
+    bool avx2 = false;
+    bool avx512f = false;
+
+    std::string to_json() const;
+
+    // Parse a hardware object; missing keys stay unknown. Throws
+    // std::runtime_error if the text isn't a JSON object.
+    static HardwareInfo from_json(const std::string& text);
+};
+
+// Detect the current host: CPUID for vendor, family/model and ISA features
+// (usable only if the OS saves the AVX state), sysfs for caches and core
+// topology. Cached after the first call.
+const HardwareInfo& detect_hardware();
+
+} // namespace cost
+} // namespace bsv
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace bsv {
+namespace cost {
+
+// Shared, hot-reloadable reference to the current cost model
+//
+// Estimators built on a handle read the model through an epoch scheme:
+// starting an estimate pins the model that is current at that moment, with
+// no lock and no shared-pointer refcount traffic. reload() publishes a new
+// model atomically; estimates already running finish on the model they
+// started with, new ones see the new model, and the old model is released
+// once the last estimate using it has finished.
+//
+// Every successful load bumps the generation (the first model is
+// generation 1), which CostEstimate reports alongside the profile_id.
+class ModelHandle {
+public:
+    // Load the initial model (JSON or compiled, see bsv/compiled_model.h).
+    // Throws std::runtime_error if it can't be loaded.
+    explicit ModelHandle(const std::string& model_path);
+    ~ModelHandle();
+
+    // Non-copyable
+    ModelHandle(const ModelHandle&) = delete;
+    ModelHandle& operator=(const ModelHandle&) = delete;
+
+    // Load a model and make it current, returning its generation. Blocks
+    // until estimates that started on the previous model have finished.
+    // Reloads are serialized. If loading throws, the current model stays.
+    uint64_t reload(const std::string& model_path);
+
+    // Generation and profile_id of the current model
+    uint64_t generation() const;
+    std::string profile_id() const;
+
+private:
+    friend class CostEstimator;
+    class Impl;
+    std::unique_ptr<Impl> pimpl_;
+};
+
+} // namespace cost
+} // namespace bsv
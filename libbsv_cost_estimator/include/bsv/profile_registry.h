@@ -0,0 +1,72 @@
+#pragma once
+
+#include "bsv/hardware.h"
+#include <string>
+#include <vector>
+
+namespace bsv {
+namespace cost {
+
+// One calibrated profile found in a models directory
+struct ProfileEntry {
+    std::string path;           // .bsvcm preferred over .json for the same profile_id
+    std::string profile_id;
+    HardwareInfo hardware;      // From the model's "hardware" section
+    bool has_hardware = false;  // False if the model doesn't describe its host
+    std::vector<std::string> ignored;   // Other models with this profile_id
+};
+
+// How well a profile fits a host
+struct ProfileMatch {
+    const ProfileEntry* profile = nullptr;
+    double distance = 0;                // 0 = identical; lower is better
+    bool close = false;                 // No major mismatch (see ProfileRegistry)
+    std::vector<std::string> mismatches;
+};
+
+// Outcome of picking a profile for a host
+struct ProfileSelection {
+    std::string path;
+    std::string profile_id;
+    double distance = 0;
+    bool close = false;
+    std::string warning;        // Set when no profile matched closely, or
+                                // other models share the chosen profile_id
+};
+
+// Calibrated profiles in a cost_models/ directory, matched against a host
+//
+// A profile matches closely when the vendor and SHA-NI/AVX2/AVX-512 support
+// agree, the CPU is the same (brand string, or family and model), and each
+// cache level is within 2x. Those decide the costs that vary most between
+// machines: hashing throughput, SIMD kernels and the size at which byte ops
+// fall out of cache. Other differences (core count, cache sizes within the
+// 2x band) only order the candidates.
+class ProfileRegistry {
+public:
+    // Scan a directory for .json and .bsvcm models. Files that fail to load
+    // are skipped and listed in errors(), as are models whose profile_id an
+    // earlier file (in name order) already has, other than a model's
+    // compiled and JSON forms.
+    explicit ProfileRegistry(const std::string& directory);
+
+    const std::vector<ProfileEntry>& profiles() const { return profiles_; }
+    const std::vector<std::string>& errors() const { return errors_; }
+
+    // Score every profile against the host, best first
+    std::vector<ProfileMatch> rank(const HardwareInfo& host) const;
+
+    // Pick the best profile. If none matches closely, the nearest one is
+    // still used and the selection carries a warning saying why; it also
+    // warns if models were ignored for sharing the chosen profile_id. Throws
+    // std::runtime_error if the directory has no loadable profiles.
+    ProfileSelection select(const HardwareInfo& host) const;
+
+private:
+    std::string directory_;
+    std::vector<ProfileEntry> profiles_;
+    std::vector<std::string> errors_;
+};
+
+} // namespace cost
+} // namespace bsv
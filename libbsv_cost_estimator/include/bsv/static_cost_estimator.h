@@ -0,0 +1,98 @@
+#pragma once
+
+// Cost estimator with the model compiled in
+//
+// For fixed-hardware deployments the model can be baked into the binary:
+// bsv_add_static_cost_model() in CMake generates a header with the model's
+// coefficients as constexpr tables (bsv_compile_model --cxx-header), and
+// StaticCostEstimator<Model> runs the same symbolic executor as
+// CostEstimator against them. There is no model to load, lock or look up,
+// and each opcode handler's cost reduces to its coefficients at compile time.
+//
+//   #include "bsv/models/appliance_model.h"
+//   StaticCostEstimator<bsv::cost::models::appliance_model> estimator;
+//   auto estimate = estimator.estimate(unlocking, locking, tx, 0);
+//
+// A Model type provides:
+//   static constexpr const char* profile_id;
+//   static constexpr double c_dispatch, c_parse_per_byte;
+//   static constexpr std::array<OpcodeCostModel, 256> opcodes;
+//   static constexpr std::array<PiecewiseCost, N> piecewise;
+//   static constexpr std::array<TablePoint, M> table;
+//   static constexpr ParallelEfficiency parallel;
+//   static constexpr ControlFlowCost control_flow;
+//   static constexpr FirstTouchCost first_touch;
+
+#include "bsv/cost_estimator.h"
+#include "bsv/detail/parallel_cost.h"
+#include "bsv/detail/symbolic_executor.h"
+#include <array>
+
+namespace bsv {
+namespace cost {
+
+template <class Model>
+class StaticCostEstimator {
+public:
+    static_assert(Model::opcodes.size() == 256, "Model::opcodes must cover every opcode byte");
+
+    CostEstimate estimate(
+        const Script& unlocking_script,
+        const Script& locking_script,
+        const Transaction& tx,
+        uint32_t input_index
+    ) const {
+        return estimate_with_options(unlocking_script, locking_script, tx, input_index,
+                                     EstimatorLimits{}, EstimatorOptions{});
+    }
+
+    CostEstimate estimate_with_limits(
+        const Script& unlocking_script,
+        const Script& locking_script,
+        const Transaction& tx,
+        uint32_t input_index,
+        const EstimatorLimits& limits
+    ) const {
+        return estimate_with_options(unlocking_script, locking_script, tx, input_index,
+                                     limits, EstimatorOptions{});
+    }
+
+    // The estimate's profile_id is Model::profile_id and its
+    // model_generation is 0, since a compiled-in model never changes
+    CostEstimate estimate_with_options(
+        const Script& unlocking_script,
+        const Script& locking_script,
+        const Transaction& tx,
+        uint32_t input_index,
+        const EstimatorLimits& limits,
+        const EstimatorOptions& options
+    ) const {
+        bool cold = options.cache_state == CacheState::COLD;
+        bool sigcache_hit = options.sigcache == SigCacheState::HIT;
+        bool batched = options.preimage_hashing == PreimageHashing::BATCHED;
+        auto opcode_cost = [cold, sigcache_hit, batched](OpCode op, const detail::CostParams& params) {
+            return detail::evaluate_opcode_cost(Model::opcodes[static_cast<uint8_t>(op)],
+                                                Model::piecewise.data(), Model::table.data(),
+                                                params, cold, sigcache_hit, batched);
+        };
+
+        CostEstimate result = detail::symbolic_execute(
+            opcode_cost, Model::c_dispatch, Model::c_parse_per_byte, Model::control_flow,
+            Model::first_touch, unlocking_script, locking_script, tx, input_index, limits);
+        result.profile_id = Model::profile_id;
+        return result;
+    }
+
+    ParallelEstimate estimate_parallel(
+        const std::vector<CostEstimate>& inputs,
+        uint32_t threads,
+        uint32_t physical_cores = 0
+    ) const {
+        return detail::estimate_parallel(Model::parallel, inputs, threads, physical_cores);
+    }
+
+    std::string get_profile_id() const { return Model::profile_id; }
+};
+
+} // namespace cost
+} // namespace bsv
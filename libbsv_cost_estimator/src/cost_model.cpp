@@ -0,0 +1,552 @@
+#include "cost_model.h"
+#include "bsv/cost_estimator.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <nlohmann/json.hpp>
+using json = nlohmann::json;
+
+namespace bsv {
+namespace cost {
+
+struct OpcodeName {
+    const char* name;
+    OpCode op;
+};
+
+// Every opcode the estimator knows by name; model entries for other names
+// are ignored
+static const OpcodeName kOpcodeNames[] = {
+    {"OP_0", OpCode::OP_0},
+    {"OP_PUSHDATA1", OpCode::OP_PUSHDATA1},
+    {"OP_PUSHDATA2", OpCode::OP_PUSHDATA2},
+    {"OP_PUSHDATA4", OpCode::OP_PUSHDATA4},
+    {"OP_1", OpCode::OP_1},
+    {"OP_IF", OpCode::OP_IF},
+    {"OP_NOTIF", OpCode::OP_NOTIF},
+    {"OP_ELSE", OpCode::OP_ELSE},
+    {"OP_ENDIF", OpCode::OP_ENDIF},
+    {"OP_DUP", OpCode::OP_DUP},
+    {"OP_PICK", OpCode::OP_PICK},
+    {"OP_ROLL", OpCode::OP_ROLL},
+    {"OP_ROT", OpCode::OP_ROT},
+    {"OP_SWAP", OpCode::OP_SWAP},
+    {"OP_CAT", OpCode::OP_CAT},
+    {"OP_SPLIT", OpCode::OP_SPLIT},
+    {"OP_NUM2BIN", OpCode::OP_NUM2BIN},
+    {"OP_BIN2NUM", OpCode::OP_BIN2NUM},
+    {"OP_INVERT", OpCode::OP_INVERT},
+    {"OP_AND", OpCode::OP_AND},
+    {"OP_OR", OpCode::OP_OR},
+    {"OP_XOR", OpCode::OP_XOR},
+    {"OP_LSHIFT", OpCode::OP_LSHIFT},
+    {"OP_RSHIFT", OpCode::OP_RSHIFT},
+    {"OP_ADD", OpCode::OP_ADD},
+    {"OP_SUB", OpCode::OP_SUB},
+    {"OP_MUL", OpCode::OP_MUL},
+    {"OP_DIV", OpCode::OP_DIV},
+    {"OP_MOD", OpCode::OP_MOD},
+    {"OP_NUMEQUAL", OpCode::OP_NUMEQUAL},
+    {"OP_NUMEQUALVERIFY", OpCode::OP_NUMEQUALVERIFY},
+    {"OP_NUMNOTEQUAL", OpCode::OP_NUMNOTEQUAL},
+    {"OP_LESSTHAN", OpCode::OP_LESSTHAN},
+    {"OP_GREATERTHAN", OpCode::OP_GREATERTHAN},
+    {"OP_LESSTHANOREQUAL", OpCode::OP_LESSTHANOREQUAL},
+    {"OP_GREATERTHANOREQUAL", OpCode::OP_GREATERTHANOREQUAL},
+    {"OP_RIPEMD160", OpCode::OP_RIPEMD160},
+    {"OP_SHA1", OpCode::OP_SHA1},
+    {"OP_SHA256", OpCode::OP_SHA256},
+    {"OP_HASH160", OpCode::OP_HASH160},
+    {"OP_HASH256", OpCode::OP_HASH256},
+    {"OP_CHECKSIG", OpCode::OP_CHECKSIG},
+    {"OP_CHECKSIGVERIFY", OpCode::OP_CHECKSIGVERIFY},
+    {"OP_CHECKMULTISIG", OpCode::OP_CHECKMULTISIG},
+};
+
+bool opcode_from_name(const std::string& name, uint8_t& op) {
+    for (const auto& entry : kOpcodeNames) {
+        if (name == entry.name) {
+            op = static_cast<uint8_t>(entry.op);
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* opcode_name(uint8_t op) {
+    for (const auto& entry : kOpcodeNames) {
+        if (static_cast<uint8_t>(entry.op) == op) return entry.name;
+    }
+    return nullptr;
+}
+
+uint64_t compiled_model_checksum(const uint8_t* data, size_t size) {
+    const size_t skip_begin = offsetof(CompiledModelHeader, checksum);
+    const size_t skip_end = skip_begin + sizeof(uint64_t);
+
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < size; ++i) {
+        uint8_t byte = (i >= skip_begin && i < skip_end) ? 0 : data[i];
+        hash = (hash ^ byte) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static uint64_t align_section(uint64_t offset) {
+    return (offset + kCompiledSectionAlignment - 1) & ~uint64_t(kCompiledSectionAlignment - 1);
+}
+
+// Parse "breakpoints": [...], "segments": [{"c0": .., "c1": ..}, ...]
+static void load_piecewise(const std::string& opcode_name, const json& data, PiecewiseCost& p) {
+    std::vector<double> breakpoints = data.value("breakpoints", std::vector<double>{});
+    const json& segments = data.contains("segments") ? data["segments"] : json::array();
+
+    if (breakpoints.size() > kMaxPiecewiseBreakpoints) {
+        throw std::runtime_error(opcode_name + ": piecewise model has more than " +
+                                 std::to_string(kMaxPiecewiseBreakpoints) + " breakpoints");
+    }
+    if (segments.size() != breakpoints.size() + 1) {
+        throw std::runtime_error(opcode_name + ": piecewise model needs one more segment than breakpoints");
+    }
+    if (!std::is_sorted(breakpoints.begin(), breakpoints.end())) {
+        throw std::runtime_error(opcode_name + ": piecewise breakpoints must be ascending");
+    }
+
+    for (int i = 0; i < kMaxPiecewiseBreakpoints; ++i) {
+        p.breakpoints[i] = i < (int)breakpoints.size()
+            ? breakpoints[i] : std::numeric_limits<double>::infinity();
+    }
+    for (int i = 0; i <= kMaxPiecewiseBreakpoints; ++i) {
+        // Padding segments are unreachable; keep them equal to the last one
+        const json& segment = segments[std::min<size_t>(i, segments.size() - 1)];
+        p.c0[i] = segment.value("c0", 0.0);
+        p.c1[i] = segment.value("c1", 0.0);
+    }
+}
+
+// Parse "points": [[size, cycles], ...] into the shared pool
+static void load_table(const std::string& opcode_name, const json& data,
+                       std::vector<TablePoint>& table_points, OpcodeCostModel& model) {
+    const json& points = data.contains("points") ? data["points"] : json::array();
+    if (points.empty()) {
+        throw std::runtime_error(opcode_name + ": table model has no points");
+    }
+
+    model.aux_offset = static_cast<uint32_t>(table_points.size());
+    model.aux_count = static_cast<uint32_t>(points.size());
+
+    double previous_size = 0;
+    for (const auto& point : points) {
+        double size = point.at(0).get<double>();
+        double cycles = point.at(1).get<double>();
+        if (size <= previous_size || cycles <= 0) {
+            throw std::runtime_error(opcode_name + ": table sizes must be positive and ascending, "
+                                     "cycles positive");
+        }
+        table_points.push_back({size, cycles, std::log(size), std::log(cycles)});
+        previous_size = size;
+    }
+}
+
+// Parse "parallel_efficiency": {"threads": [...], "compute": [...],
+// "memory": [...], "smt_speedup": x}. "memory" defaults to "compute".
+static void load_parallel(const json& data, ParallelEfficiency& p) {
+    const json& threads = data.contains("threads") ? data["threads"] : json::array();
+    const json& compute = data.contains("compute") ? data["compute"] : json::array();
+    const json& memory = data.contains("memory") ? data["memory"] : compute;
+    if (threads.empty() || threads.size() > kMaxParallelPoints) {
+        throw std::runtime_error("parallel_efficiency: needs 1 to " +
+                                 std::to_string(kMaxParallelPoints) + " thread counts");
+    }
+    if (compute.size() != threads.size() || memory.size() != threads.size()) {
+        throw std::runtime_error("parallel_efficiency: one efficiency per thread count");
+    }
+
+    p.count = static_cast<uint32_t>(threads.size());
+    p.smt_speedup = data.value("smt_speedup", 0.0);
+    if (p.smt_speedup < 0 || p.smt_speedup > 2) {
+        throw std::runtime_error("parallel_efficiency: smt_speedup must be within [0, 2]");
+    }
+
+    double previous = 0;
+    for (uint32_t i = 0; i < p.count; ++i) {
+        p.threads[i] = threads[i].get<double>();
+        p.compute[i] = compute[i].get<double>();
+        p.memory[i] = memory[i].get<double>();
+        if (p.threads[i] <= previous) {
+            throw std::runtime_error("parallel_efficiency: thread counts must be positive and ascending");
+        }
+        if (p.compute[i] <= 0 || p.memory[i] <= 0) {
+            throw std::runtime_error("parallel_efficiency: efficiencies must be positive");
+        }
+        previous = p.threads[i];
+    }
+}
+
+// Parse "control_flow": {"c_exec_per_depth": .., "c_skip_per_byte": ..,
+// "c_mispredict": .., "condition_stack": "vector" | "counter"}
+static void load_control_flow(const json& data, ControlFlowCost& c) {
+    std::string scheme = data.value("condition_stack", "vector");
+    if (scheme != "vector" && scheme != "counter") {
+        throw std::runtime_error("control_flow: condition_stack must be vector or counter");
+    }
+    c.c_exec_per_depth = data.value("c_exec_per_depth", 0.0);
+    c.c_skip_per_byte = data.value("c_skip_per_byte", 0.0);
+    c.c_mispredict = data.value("c_mispredict", 0.0);
+    if (c.c_exec_per_depth < 0 || c.c_skip_per_byte < 0 || c.c_mispredict < 0) {
+        throw std::runtime_error("control_flow: coefficients must be non-negative");
+    }
+}
+
+// Parse "first_touch": {"c_map": .., "c_per_page": .., "page_bytes": 4096,
+// "threshold_bytes": 131072}
+static void load_first_touch(const json& data, FirstTouchCost& f) {
+    f.c_map = data.value("c_map", 0.0);
+    f.c_per_page = data.value("c_per_page", 0.0);
+    f.page_bytes = data.value("page_bytes", 4096.0);
+    f.threshold_bytes = data.value("threshold_bytes", 131072.0);
+    if (f.c_map < 0 || f.c_per_page < 0) {
+        throw std::runtime_error("first_touch: coefficients must be non-negative");
+    }
+    if (f.page_bytes < 1 || f.threshold_bytes < 0) {
+        throw std::runtime_error("first_touch: page_bytes must be positive and threshold_bytes non-negative");
+    }
+}
+
+std::vector<uint8_t> CompiledModel::compile_json(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open cost model: " + path);
+    }
+
+    json model;
+    file >> model;
+
+    OpcodeCostModel opcodes[256] = {};
+    std::vector<PiecewiseCost> piecewise;
+    std::vector<TablePoint> table_points;
+
+    CompiledModelHeader header = {};
+    std::memcpy(header.magic, kCompiledModelMagic, sizeof(header.magic));
+    header.version = kCompiledModelVersion;
+    header.endian_tag = kCompiledModelEndianTag;
+    header.header_size = sizeof(CompiledModelHeader);
+    header.opcode_entry_size = sizeof(OpcodeCostModel);
+
+    std::string profile_id = model.value("profile_id", "unknown");
+    std::strncpy(header.profile_id, profile_id.c_str(), sizeof(header.profile_id) - 1);
+
+    // Load constants
+    header.c_dispatch = 5.0;
+    header.c_parse_per_byte = 0.8;
+    if (model.contains("constants")) {
+        header.c_dispatch = model["constants"].value("c_dispatch", 5.0);
+        header.c_parse_per_byte = model["constants"].value("c_parse_per_byte", 0.8);
+    }
+
+    // Load opcode models
+    if (model.contains("opcodes")) {
+        for (auto& [opcode_name, opcode_data] : model["opcodes"].items()) {
+            OpcodeCostModel cost_model = {};
+
+            std::string model_type = opcode_data.value("model", "constant");
+            if (model_type == "constant") {
+                cost_model.type = CostModelType::CONSTANT;
+                cost_model.c0 = opcode_data.value("c0", 0.0);
+            } else if (model_type == "linear") {
+                cost_model.type = CostModelType::LINEAR;
+                cost_model.c0 = opcode_data.value("c0", 0.0);
+                cost_model.c1 = opcode_data.value("c1", 0.0);
+                cost_model.c_alloc = opcode_data.value("c_alloc", 0.0);
+            } else if (model_type == "quadratic" || model_type == "nlogn") {
+                // Big-number multiply/divide: c2 scales n^2 or n*log2(n)
+                cost_model.type = model_type == "quadratic" ? CostModelType::QUADRATIC
+                                                            : CostModelType::NLOGN;
+                cost_model.c0 = opcode_data.value("c0", 0.0);
+                cost_model.c1 = opcode_data.value("c1", 0.0);
+                cost_model.c2 = opcode_data.value("c2", 0.0);
+                cost_model.c_alloc = opcode_data.value("c_alloc", 0.0);
+            } else if (model_type == "piecewise") {
+                cost_model.type = CostModelType::PIECEWISE;
+                PiecewiseCost segments;
+                load_piecewise(opcode_name, opcode_data, segments);
+                cost_model.aux_offset = static_cast<uint32_t>(piecewise.size());
+                cost_model.aux_count = 1;
+                piecewise.push_back(segments);
+                cost_model.c_alloc = opcode_data.value("c_alloc", 0.0);
+            } else if (model_type == "table") {
+                cost_model.type = CostModelType::TABLE;
+                load_table(opcode_name, opcode_data, table_points, cost_model);
+                cost_model.c_alloc = opcode_data.value("c_alloc", 0.0);
+            } else if (model_type == "signature") {
+                cost_model.type = CostModelType::SIGNATURE;
+                cost_model.c_ecdsa = opcode_data.value("c_ecdsa", 85000.0);
+                cost_model.c_preimage_per_byte = opcode_data.value("c_preimage_per_byte", 2.5);
+                cost_model.c_sigcache_hit = opcode_data.value("c_sigcache_hit", cost_model.c_ecdsa);
+                cost_model.c_preimage_per_byte_batched =
+                    opcode_data.value("c_preimage_per_byte_batched", cost_model.c_preimage_per_byte);
+            } else if (model_type == "multisig") {
+                cost_model.type = CostModelType::MULTISIG;
+                cost_model.c_ecdsa = opcode_data.value("c_ecdsa", 85000.0);
+                cost_model.c_preimage_per_byte = opcode_data.value("c_preimage_per_byte", 2.5);
+                cost_model.c_keyscan = opcode_data.value("c_keyscan", 150.0);
+                cost_model.c_setup = opcode_data.value("c_setup", 300.0);
+                cost_model.c_sigcache_hit = opcode_data.value("c_sigcache_hit", cost_model.c_ecdsa);
+                cost_model.c_preimage_per_byte_batched =
+                    opcode_data.value("c_preimage_per_byte_batched", cost_model.c_preimage_per_byte);
+            } else {
+                throw std::runtime_error(opcode_name + ": unknown cost model type '" + model_type + "'");
+            }
+
+            // Optional cold-cache coefficients, e.g. "cold": {"c0": 400, "c1": 0.9}
+            if (opcode_data.contains("cold")) {
+                const auto& cold = opcode_data["cold"];
+                cost_model.has_cold = 1;
+                cost_model.c0_cold = cold.value("c0", cost_model.c0);
+                cost_model.c1_cold = cold.value("c1", cost_model.c1);
+            }
+
+            uint8_t op;
+            if (opcode_from_name(opcode_name, op)) {
+                opcodes[op] = cost_model;
+            }
+        }
+    }
+
+    if (model.contains("parallel_efficiency")) {
+        load_parallel(model["parallel_efficiency"], header.parallel);
+    }
+    if (model.contains("control_flow")) {
+        load_control_flow(model["control_flow"], header.control_flow);
+    }
+    if (model.contains("first_touch")) {
+        load_first_touch(model["first_touch"], header.first_touch);
+    }
+
+    std::string hardware = model.contains("hardware") ? model["hardware"].dump() : "";
+    std::string software = model.contains("software") ? model["software"].dump() : "";
+
+    // Lay out the sections
+    header.opcodes_offset = align_section(sizeof(CompiledModelHeader));
+    header.piecewise_offset = align_section(header.opcodes_offset + sizeof(opcodes));
+    header.piecewise_count = static_cast<uint32_t>(piecewise.size());
+    header.table_offset = align_section(header.piecewise_offset +
+                                        piecewise.size() * sizeof(PiecewiseCost));
+    header.table_point_count = static_cast<uint32_t>(table_points.size());
+    header.hardware_offset = align_section(header.table_offset +
+                                           table_points.size() * sizeof(TablePoint));
+    header.hardware_size = hardware.size();
+    header.software_offset = align_section(header.hardware_offset + header.hardware_size);
+    header.software_size = software.size();
+    header.file_size = header.software_offset + header.software_size;
+
+    std::vector<uint8_t> blob(header.file_size, 0);
+    std::memcpy(blob.data() + header.opcodes_offset, opcodes, sizeof(opcodes));
+    if (!piecewise.empty()) {
+        std::memcpy(blob.data() + header.piecewise_offset, piecewise.data(),
+                    piecewise.size() * sizeof(PiecewiseCost));
+    }
+    if (!table_points.empty()) {
+        std::memcpy(blob.data() + header.table_offset, table_points.data(),
+                    table_points.size() * sizeof(TablePoint));
+    }
+    std::memcpy(blob.data() + header.hardware_offset, hardware.data(), hardware.size());
+    std::memcpy(blob.data() + header.software_offset, software.data(), software.size());
+
+    std::memcpy(blob.data(), &header, sizeof(header));
+    header.checksum = compiled_model_checksum(blob.data(), blob.size());
+    std::memcpy(blob.data(), &header, sizeof(header));
+
+    return blob;
+}
+
+void CompiledModel::attach(const uint8_t* data, size_t size, const std::string& source) {
+    auto fail = [&](const std::string& reason) {
+        throw std::runtime_error("Invalid compiled cost model " + source + ": " + reason);
+    };
+
+    if (size < sizeof(CompiledModelHeader)) fail("truncated header");
+    const auto* header = reinterpret_cast<const CompiledModelHeader*>(data);
+
+    if (std::memcmp(header->magic, kCompiledModelMagic, sizeof(header->magic)) != 0) {
+        fail("bad magic");
+    }
+    if (header->endian_tag != kCompiledModelEndianTag) {
+        fail("written on a machine with a different byte order");
+    }
+    if (header->version != kCompiledModelVersion) {
+        fail("format version " + std::to_string(header->version) + ", expected " +
+             std::to_string(kCompiledModelVersion) + " (recompile the model)");
+    }
+    if (header->header_size != sizeof(CompiledModelHeader) ||
+        header->opcode_entry_size != sizeof(OpcodeCostModel)) {
+        fail("unexpected record sizes");
+    }
+    if (header->file_size != size) fail("file size mismatch");
+    if (compiled_model_checksum(data, size) != header->checksum) fail("checksum mismatch");
+    if (std::memchr(header->profile_id, '\0', sizeof(header->profile_id)) == nullptr) {
+        fail("unterminated profile_id");
+    }
+    if (header->parallel.count > kMaxParallelPoints) fail("bad parallel efficiency table");
+
+    // Sections must be aligned and in bounds. Counts are 32-bit, so the
+    // products can't overflow.
+    auto check_section = [&](uint64_t offset, uint64_t bytes, const char* name) {
+        if (offset % kCompiledSectionAlignment != 0 || offset > size || bytes > size - offset) {
+            fail(std::string("bad ") + name + " section");
+        }
+    };
+    check_section(header->opcodes_offset, 256 * sizeof(OpcodeCostModel), "opcode");
+    check_section(header->piecewise_offset,
+                  uint64_t(header->piecewise_count) * sizeof(PiecewiseCost), "piecewise");
+    check_section(header->table_offset,
+                  uint64_t(header->table_point_count) * sizeof(TablePoint), "table");
+    check_section(header->hardware_offset, header->hardware_size, "hardware");
+    check_section(header->software_offset, header->software_size, "software");
+
+    const auto* opcodes = reinterpret_cast<const OpcodeCostModel*>(data + header->opcodes_offset);
+    for (int op = 0; op < 256; ++op) {
+        const OpcodeCostModel& model = opcodes[op];
+        bool valid = true;
+        switch (model.type) {
+            case CostModelType::PIECEWISE:
+                valid = model.aux_offset < header->piecewise_count;
+                break;
+            case CostModelType::TABLE:
+                valid = model.aux_count > 0 &&
+                        uint64_t(model.aux_offset) + model.aux_count <= header->table_point_count;
+                break;
+            case CostModelType::NONE:
+            case CostModelType::CONSTANT:
+            case CostModelType::LINEAR:
+            case CostModelType::SIGNATURE:
+            case CostModelType::MULTISIG:
+            case CostModelType::QUADRATIC:
+            case CostModelType::NLOGN:
+                break;
+            default:
+                valid = false;
+                break;
+        }
+        if (!valid) fail("bad entry for opcode " + std::to_string(op));
+    }
+
+    data_ = data;
+    size_ = size;
+    header_ = header;
+    opcodes_ = opcodes;
+    piecewise_ = reinterpret_cast<const PiecewiseCost*>(data + header->piecewise_offset);
+    table_ = reinterpret_cast<const TablePoint*>(data + header->table_offset);
+}
+
+std::shared_ptr<const CompiledModel> CompiledModel::load(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open cost model: " + path);
+    }
+
+    struct stat st;
+    char magic[sizeof(kCompiledModelMagic)] = {};
+    bool compiled = ::fstat(fd, &st) == 0 &&
+                    ::pread(fd, magic, sizeof(magic), 0) == (ssize_t)sizeof(magic) &&
+                    std::memcmp(magic, kCompiledModelMagic, sizeof(magic)) == 0;
+
+    std::shared_ptr<CompiledModel> model(new CompiledModel());
+
+    if (compiled) {
+        // Map the file as is; every process using this model shares the pages
+        size_t size = static_cast<size_t>(st.st_size);
+        void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED) {
+            throw std::runtime_error("Failed to map cost model: " + path);
+        }
+        ::madvise(mapping, size, MADV_WILLNEED);
+        model->mapping_ = mapping;
+        model->mapping_size_ = size;
+        model->file_backed_ = true;
+    } else {
+        ::close(fd);
+
+        // Compile in memory into a page-aligned private mapping, so sections
+        // have the same alignment as in a mapped file
+        std::vector<uint8_t> blob = compile_json(path);
+        void* mapping = ::mmap(nullptr, blob.size(), PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapping == MAP_FAILED) {
+            throw std::runtime_error("Failed to allocate cost model: " + path);
+        }
+        std::memcpy(mapping, blob.data(), blob.size());
+        ::mprotect(mapping, blob.size(), PROT_READ);
+        model->mapping_ = mapping;
+        model->mapping_size_ = blob.size();
+    }
+
+    model->attach(static_cast<const uint8_t*>(model->mapping_), model->mapping_size_, path);
+    return model;
+}
+
+CompiledModel::~CompiledModel() {
+    if (mapping_ != nullptr) {
+        ::munmap(mapping_, mapping_size_);
+    }
+}
+
+std::string CompiledModel::profile_id() const {
+    return std::string(header_->profile_id);
+}
+
+std::string CompiledModel::hardware_info() const {
+    return std::string(reinterpret_cast<const char*>(data_ + header_->hardware_offset),
+                       header_->hardware_size);
+}
+
+std::string CompiledModel::software_info() const {
+    return std::string(reinterpret_cast<const char*>(data_ + header_->software_offset),
+                       header_->software_size);
+}
+
+// Public API
+
+void compile_cost_model(const std::string& json_path, const std::string& output_path) {
+    std::vector<uint8_t> blob = CompiledModel::compile_json(json_path);
+
+    // Write to a temporary file and rename it into place: running estimators
+    // may have the old file mapped, and rewriting it in place would change
+    // the model under them
+    std::string temp_path = output_path + ".tmp";
+    {
+        std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            throw std::runtime_error("Failed to create compiled model: " + temp_path);
+        }
+        out.write(reinterpret_cast<const char*>(blob.data()), blob.size());
+        if (!out) {
+            throw std::runtime_error("Failed to write compiled model: " + temp_path);
+        }
+    }
+    if (std::rename(temp_path.c_str(), output_path.c_str()) != 0) {
+        std::remove(temp_path.c_str());
+        throw std::runtime_error("Failed to replace compiled model: " + output_path);
+    }
+}
+
+bool is_compiled_cost_model(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    char magic[sizeof(kCompiledModelMagic)] = {};
+    return file.read(magic, sizeof(magic)) &&
+           std::memcmp(magic, kCompiledModelMagic, sizeof(magic)) == 0;
+}
+
+} // namespace cost
+} // namespace bsv
@@ -0,0 +1,128 @@
+#pragma once
+
+// Internal representation of a loaded cost model.
+//
+// A model is one contiguous blob laid out exactly as a compiled model file
+// (see CompiledModelHeader), so the same structures are used whether the
+// model was parsed from JSON at startup or mmapped from bsv_compile_model
+// output. Everything here is plain data: no pointers, fixed-width fields.
+
+#include "bsv/compiled_model.h"
+#include "bsv/detail/cost_model_types.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace bsv {
+namespace cost {
+
+static_assert(std::is_trivially_copyable<OpcodeCostModel>::value &&
+              std::is_standard_layout<OpcodeCostModel>::value,
+              "OpcodeCostModel is stored in compiled model files");
+
+static constexpr char kCompiledModelMagic[8] = {'B', 'S', 'V', 'C', 'M', 'D', 'L', '\0'};
+static constexpr uint32_t kCompiledModelEndianTag = 0x01020304;
+static constexpr size_t kCompiledSectionAlignment = 64;
+
+// File layout: this header, then each section at its recorded offset
+// (64-byte aligned):
+//
+//   opcodes[256] | piecewise[piecewise_count] | table[table_point_count] |
+//   hardware JSON text | software JSON text
+//
+// checksum is FNV-1a 64 over the whole file with the checksum field zeroed.
+struct CompiledModelHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t endian_tag;
+    uint64_t file_size;
+    uint64_t checksum;
+
+    uint32_t header_size;
+    uint32_t opcode_entry_size;
+    uint64_t opcodes_offset;
+    uint64_t piecewise_offset;
+    uint32_t piecewise_count;
+    uint32_t table_point_count;
+    uint64_t table_offset;
+    uint64_t hardware_offset;
+    uint64_t hardware_size;
+    uint64_t software_offset;
+    uint64_t software_size;
+
+    double c_dispatch;          // Per-opcode dispatch overhead
+    double c_parse_per_byte;    // Script parsing cost
+
+    char profile_id[64];        // NUL-terminated, truncated if longer
+
+    ParallelEfficiency parallel;
+    ControlFlowCost control_flow;
+    FirstTouchCost first_touch;
+};
+
+static_assert(std::is_trivially_copyable<CompiledModelHeader>::value &&
+              std::is_standard_layout<CompiledModelHeader>::value,
+              "CompiledModelHeader is stored in compiled model files");
+
+// A validated, read-only model blob: either a shared mapping of a compiled
+// file or a private mapping holding a JSON model compiled at load time.
+// Accessors point into it.
+class CompiledModel {
+public:
+    // Load a JSON or compiled model, detected by the file's magic bytes.
+    // Throws std::runtime_error on I/O, parse or validation errors.
+    static std::shared_ptr<const CompiledModel> load(const std::string& path);
+
+    // Compile a JSON model file into blob form
+    static std::vector<uint8_t> compile_json(const std::string& path);
+
+    ~CompiledModel();
+    CompiledModel(const CompiledModel&) = delete;
+    CompiledModel& operator=(const CompiledModel&) = delete;
+
+    const CompiledModelHeader& header() const { return *header_; }
+    const OpcodeCostModel& opcode(uint8_t op) const { return opcodes_[op]; }
+    const PiecewiseCost* piecewise() const { return piecewise_; }
+    const TablePoint* table_points() const { return table_; }
+    const ParallelEfficiency& parallel() const { return header_->parallel; }
+    const ControlFlowCost& control_flow() const { return header_->control_flow; }
+    const FirstTouchCost& first_touch() const { return header_->first_touch; }
+
+    std::string profile_id() const;
+    std::string hardware_info() const;
+    std::string software_info() const;
+
+    // True if backed by a mapped compiled file
+    bool file_backed() const { return file_backed_; }
+    size_t size() const { return size_; }
+
+private:
+    CompiledModel() = default;
+
+    // Validate the blob and set up the section pointers
+    void attach(const uint8_t* data, size_t size, const std::string& source);
+
+    void* mapping_ = nullptr;
+    size_t mapping_size_ = 0;
+    bool file_backed_ = false;
+    size_t size_ = 0;
+
+    const uint8_t* data_ = nullptr;
+    const CompiledModelHeader* header_ = nullptr;
+    const OpcodeCostModel* opcodes_ = nullptr;
+    const PiecewiseCost* piecewise_ = nullptr;
+    const TablePoint* table_ = nullptr;
+};
+
+// FNV-1a 64 of a compiled blob, with the header's checksum field zeroed
+uint64_t compiled_model_checksum(const uint8_t* data, size_t size);
+
+// Script opcode names known to model files ("OP_DUP" -> 0x76)
+bool opcode_from_name(const std::string& name, uint8_t& op);
+const char* opcode_name(uint8_t op);
+
+} // namespace cost
+} // namespace bsv
@@ -0,0 +1,200 @@
+#include "bsv/hardware.h"
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+#include <nlohmann/json.hpp>
+using json = nlohmann::json;
+
+namespace bsv {
+namespace cost {
+
+static std::string read_line(const std::string& path) {
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+// Parse sysfs cache sizes such as "48K" or "2048K"
+static uint64_t parse_cache_size(const std::string& text) {
+    uint64_t value = 0;
+    size_t i = 0;
+    while (i < text.size() && text[i] >= '0' && text[i] <= '9') {
+        value = value * 10 + (text[i] - '0');
+        ++i;
+    }
+    if (i < text.size()) {
+        if (text[i] == 'K') value <<= 10;
+        else if (text[i] == 'M') value <<= 20;
+        else if (text[i] == 'G') value <<= 30;
+    }
+    return value;
+}
+
+static std::string trim(const std::string& s) {
+    size_t begin = s.find_first_not_of(' ');
+    size_t end = s.find_last_not_of(' ');
+    return begin == std::string::npos ? "" : s.substr(begin, end - begin + 1);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+static void detect_cpuid(HardwareInfo& info) {
+    unsigned eax, ebx, ecx, edx;
+    if (!__get_cpuid(0, &eax, &ebx, &ecx, &edx)) return;
+    unsigned max_leaf = eax;
+
+    char vendor[13] = {};
+    std::memcpy(vendor, &ebx, 4);
+    std::memcpy(vendor + 4, &edx, 4);
+    std::memcpy(vendor + 8, &ecx, 4);
+    info.cpu_vendor = vendor;
+
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return;
+    unsigned family = (eax >> 8) & 0xf;
+    unsigned model = (eax >> 4) & 0xf;
+    if (family == 0xf) family += (eax >> 20) & 0xff;
+    if (family == 0x6 || family >= 0xf) model += ((eax >> 16) & 0xf) << 4;
+    info.cpu_family = static_cast<int>(family);
+    info.cpu_model_number = static_cast<int>(model);
+
+    // AVX state must be enabled by the OS (XCR0) for the features to be usable
+    bool osxsave = (ecx >> 27) & 1;
+    uint64_t xcr0 = 0;
+    if (osxsave) {
+        unsigned lo, hi;
+        __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+        xcr0 = (uint64_t(hi) << 32) | lo;
+    }
+    bool avx_state = (xcr0 & 0x6) == 0x6;
+    bool avx512_state = (xcr0 & 0xe6) == 0xe6;
+
+    if (max_leaf >= 7 && __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+        info.avx2 = avx_state && ((ebx >> 5) & 1);
+        info.avx512f = avx512_state && ((ebx >> 16) & 1);
+        info.sha_ni = (ebx >> 29) & 1;
+    }
+
+    if (__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) && eax >= 0x80000004) {
+        unsigned brand[12];
+        for (unsigned i = 0; i < 3; ++i) {
+            __get_cpuid(0x80000002 + i, &brand[4 * i], &brand[4 * i + 1],
+                        &brand[4 * i + 2], &brand[4 * i + 3]);
+        }
+        char text[49] = {};
+        std::memcpy(text, brand, 48);
+        info.cpu_model = trim(text);
+    }
+}
+#endif
+
+// Vendor/model from /proc/cpuinfo where CPUID isn't available
+static void detect_cpuinfo(HardwareInfo& info) {
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        auto colon = line.find(':');
+        if (colon == std::string::npos) continue;
+        std::string key = trim(line.substr(0, colon));
+        while (!key.empty() && key.back() == '\t') key.pop_back();
+        std::string value = trim(line.substr(colon + 1));
+
+        if ((key == "vendor_id" || key == "CPU implementer") && info.cpu_vendor.empty()) {
+            info.cpu_vendor = value;
+        } else if ((key == "model name" || key == "Hardware") && info.cpu_model.empty()) {
+            info.cpu_model = value;
+        }
+    }
+}
+
+static HardwareInfo detect() {
+    HardwareInfo info;
+
+#if defined(__x86_64__) || defined(__i386__)
+    detect_cpuid(info);
+#endif
+    if (info.cpu_vendor.empty()) {
+        detect_cpuinfo(info);
+    }
+
+    info.logical_cpus = static_cast<int>(sysconf(_SC_NPROCESSORS_ONLN));
+
+    // Physical cores: SMT siblings share a (package, core) pair
+    std::set<std::pair<std::string, std::string>> cores;
+    for (int cpu = 0; cpu < info.logical_cpus; ++cpu) {
+        std::string dir = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+        std::string core = read_line(dir + "core_id");
+        if (core.empty()) continue;
+        cores.insert({read_line(dir + "physical_package_id"), core});
+    }
+    info.physical_cores = cores.empty() ? info.logical_cpus : static_cast<int>(cores.size());
+
+    // Walk CPU 0's cache hierarchy (index0..N: L1d, L1i, L2, L3, ...)
+    for (int i = 0; i < 8; ++i) {
+        std::string dir = "/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(i) + "/";
+        std::string level = read_line(dir + "level");
+        if (level.empty()) break;
+        std::string type = read_line(dir + "type");
+        uint64_t size = parse_cache_size(read_line(dir + "size"));
+
+        if (level == "1" && type == "Data") info.l1d_bytes = size;
+        else if (level == "2") info.l2_bytes = size;
+        if (type != "Instruction" && size > 0 && level != "1") info.llc_bytes = size;
+    }
+
+    return info;
+}
+
+const HardwareInfo& detect_hardware() {
+    static const HardwareInfo info = detect();
+    return info;
+}
+
+std::string HardwareInfo::to_json() const {
+    json out = {
+        {"cpu_vendor", cpu_vendor},
+        {"cpu_model", cpu_model},
+        {"cpu_family", cpu_family},
+        {"cpu_model_number", cpu_model_number},
+        {"logical_cpus", logical_cpus},
+        {"physical_cores", physical_cores},
+        {"l1d_bytes", l1d_bytes},
+        {"l2_bytes", l2_bytes},
+        {"llc_bytes", llc_bytes},
+        {"sha_ni", sha_ni},
+        {"avx2", avx2},
+        {"avx512f", avx512f},
+    };
+    return out.dump();
+}
+
+HardwareInfo HardwareInfo::from_json(const std::string& text) {
+    json data = json::parse(text, nullptr, false);
+    if (!data.is_object()) {
+        throw std::runtime_error("hardware description is not a JSON object");
+    }
+
+    HardwareInfo info;
+    info.cpu_vendor = data.value("cpu_vendor", "");
+    info.cpu_model = data.value("cpu_model", "");
+    info.cpu_family = data.value("cpu_family", -1);
+    info.cpu_model_number = data.value("cpu_model_number", -1);
+    info.logical_cpus = data.value("logical_cpus", 0);
+    info.physical_cores = data.value("physical_cores", 0);
+    info.l1d_bytes = data.value("l1d_bytes", uint64_t(0));
+    info.l2_bytes = data.value("l2_bytes", uint64_t(0));
+    info.llc_bytes = data.value("llc_bytes", uint64_t(0));
+    info.sha_ni = data.value("sha_ni", false);
+    info.avx2 = data.value("avx2", false);
+    info.avx512f = data.value("avx512f", false);
+    return info;
+}
+
+} // namespace cost
+} // namespace bsv
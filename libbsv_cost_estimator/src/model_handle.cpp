@@ -0,0 +1,82 @@
+#include "model_handle.h"
+#include <functional>
+#include <thread>
+
+namespace bsv {
+namespace cost {
+
+ModelHandle::Impl::Impl(std::shared_ptr<const CompiledModel> model) {
+    publish(std::move(model));
+}
+
+ModelHandle::Impl::~Impl() {
+    // The handle is only destroyed once nothing can be estimating with it
+    delete current_.load();
+}
+
+size_t ModelHandle::Impl::this_thread_shard() {
+    static thread_local size_t shard =
+        std::hash<std::thread::id>()(std::this_thread::get_id()) % kReaderShards;
+    return shard;
+}
+
+ModelHandle::Impl::ReadGuard::ReadGuard(const Impl& impl) {
+    ReaderShard& shard = impl.shards_[this_thread_shard()];
+    for (;;) {
+        uint64_t epoch = impl.epoch_.load();
+        counter_ = &shard.readers[epoch & 1];
+        counter_->fetch_add(1);
+        if (impl.epoch_.load() == epoch) break;
+        // A reload flipped the epoch under us; register in the new bucket
+        counter_->fetch_sub(1);
+    }
+    version_ = impl.current_.load();
+}
+
+ModelHandle::Impl::ReadGuard::~ReadGuard() {
+    counter_->fetch_sub(1, std::memory_order_release);
+}
+
+uint64_t ModelHandle::Impl::publish(std::shared_ptr<const CompiledModel> model) {
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+
+    uint64_t generation = generation_.load() + 1;
+    auto* next = new ModelVersion{model, model->profile_id(), generation};
+    const ModelVersion* previous = current_.exchange(next);
+    generation_.store(generation, std::memory_order_release);
+
+    uint64_t old_bucket = epoch_.fetch_add(1) & 1;
+    for (size_t i = 0; i < kReaderShards; ++i) {
+        while (shards_[i].readers[old_bucket].load(std::memory_order_acquire) != 0) {
+            std::this_thread::yield();
+        }
+    }
+
+    delete previous;
+    return generation;
+}
+
+// Public API
+
+ModelHandle::ModelHandle(const std::string& model_path)
+    : pimpl_(std::make_unique<Impl>(CompiledModel::load(model_path))) {
+}
+
+ModelHandle::~ModelHandle() = default;
+
+uint64_t ModelHandle::reload(const std::string& model_path) {
+    // Load before publishing so a bad file leaves the current model in place
+    return pimpl_->publish(CompiledModel::load(model_path));
+}
+
+uint64_t ModelHandle::generation() const {
+    return pimpl_->generation();
+}
+
+std::string ModelHandle::profile_id() const {
+    Impl::ReadGuard guard(*pimpl_);
+    return guard.version().profile_id;
+}
+
+} // namespace cost
+} // namespace bsv
@@ -0,0 +1,78 @@
+#pragma once
+
+// Epoch-based publication of the current cost model (see bsv/model_handle.h).
+//
+// Readers register in one of two buckets selected by the low bit of the
+// epoch, on a per-thread shard to avoid contending on one cache line:
+//
+//   reader:  e = epoch; shard.readers[e & 1]++; retry if epoch != e;
+//            v = current; ... use v ...; shard.readers[e & 1]--
+//   writer:  old = current.exchange(next); epoch++;
+//            wait until every shard's readers[old_epoch & 1] == 0; delete old
+//
+// A reader whose recheck sees the old epoch incremented its bucket before the
+// writer bumped the epoch, so the writer waits for it; a reader that sees
+// the new epoch loads current after the exchange and so never sees the old
+// version. All operations are sequentially consistent, which provides the
+// store-load ordering both sides rely on.
+
+#include "bsv/model_handle.h"
+#include "cost_model.h"
+#include <atomic>
+#include <mutex>
+
+namespace bsv {
+namespace cost {
+
+// One published model
+struct ModelVersion {
+    std::shared_ptr<const CompiledModel> model;
+    std::string profile_id;
+    uint64_t generation;
+};
+
+class ModelHandle::Impl {
+public:
+    explicit Impl(std::shared_ptr<const CompiledModel> model);
+    ~Impl();
+
+    // Pins the current version for the guard's lifetime
+    class ReadGuard {
+    public:
+        explicit ReadGuard(const Impl& impl);
+        ~ReadGuard();
+
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+        const ModelVersion& version() const { return *version_; }
+        const CompiledModel& model() const { return *version_->model; }
+
+    private:
+        std::atomic<uint64_t>* counter_;
+        const ModelVersion* version_;
+    };
+
+    // Make `model` current and wait for readers of the previous version
+    uint64_t publish(std::shared_ptr<const CompiledModel> model);
+
+    uint64_t generation() const { return generation_.load(std::memory_order_acquire); }
+
+private:
+    static constexpr size_t kReaderShards = 64;
+
+    struct alignas(64) ReaderShard {
+        std::atomic<uint64_t> readers[2] = {};
+    };
+
+    static size_t this_thread_shard();
+
+    mutable ReaderShard shards_[kReaderShards];
+    std::atomic<uint64_t> epoch_{0};
+    std::atomic<const ModelVersion*> current_{nullptr};
+    std::atomic<uint64_t> generation_{0};
+    std::mutex writer_mutex_;   // Serializes publish(); readers never take it
+};
+
+} // namespace cost
+} // namespace bsv
@@ -0,0 +1,195 @@
+#include "bsv/profile_registry.h"
+#include "cost_model.h"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace bsv {
+namespace cost {
+
+ProfileRegistry::ProfileRegistry(const std::string& directory)
+    : directory_(directory) {
+    std::error_code ec;
+    fs::directory_iterator it(directory, ec);
+    if (ec) {
+        throw std::runtime_error("Failed to read cost model directory: " + directory);
+    }
+
+    std::vector<fs::path> files;
+    for (const auto& entry : it) {
+        std::string extension = entry.path().extension().string();
+        if (entry.is_regular_file() && (extension == ".json" || extension == ".bsvcm")) {
+            files.push_back(entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+
+    std::map<std::string, size_t> by_profile_id;
+    for (const auto& file : files) {
+        ProfileEntry entry;
+        entry.path = file.string();
+        try {
+            auto model = CompiledModel::load(entry.path);
+            entry.profile_id = model->profile_id();
+            std::string hardware = model->hardware_info();
+            if (!hardware.empty()) {
+                entry.hardware = HardwareInfo::from_json(hardware);
+                entry.has_hardware = !entry.hardware.cpu_vendor.empty() ||
+                                     !entry.hardware.cpu_model.empty();
+            }
+        } catch (const std::exception& e) {
+            errors_.push_back(entry.path + ": " + e.what());
+            continue;
+        }
+
+        // A compiled model and its JSON source describe the same profile;
+        // keep the compiled one since it maps instead of parsing. Any other
+        // model with the same profile_id is a different calibration that
+        // can't be told apart by id, so only the first is kept.
+        auto existing = by_profile_id.find(entry.profile_id);
+        if (existing == by_profile_id.end()) {
+            by_profile_id[entry.profile_id] = profiles_.size();
+            profiles_.push_back(entry);
+            continue;
+        }
+        ProfileEntry& kept = profiles_[existing->second];
+        fs::path kept_path(kept.path);
+        if (kept_path.stem() == file.stem() && kept_path.extension() != file.extension()) {
+            if (file.extension() == ".bsvcm") {
+                entry.ignored = kept.ignored;
+                kept = entry;
+            }
+        } else {
+            errors_.push_back(entry.path + ": profile_id " + entry.profile_id + " is already used by " +
+                              kept.path + ", ignored");
+            kept.ignored.push_back(entry.path);
+        }
+    }
+}
+
+static double size_ratio(uint64_t a, uint64_t b) {
+    if (a == 0 || b == 0) return 1.0;
+    return a > b ? double(a) / b : double(b) / a;
+}
+
+static ProfileMatch match_profile(const ProfileEntry& profile, const HardwareInfo& host) {
+    ProfileMatch match;
+    match.profile = &profile;
+
+    if (!profile.has_hardware) {
+        match.distance = 100;
+        match.mismatches.push_back("profile has no hardware description");
+        return match;
+    }
+
+    const HardwareInfo& hw = profile.hardware;
+    bool major = false;
+    auto mismatch = [&](double penalty, const std::string& reason) {
+        match.distance += penalty;
+        major = true;
+        match.mismatches.push_back(reason);
+    };
+
+    if (!hw.cpu_vendor.empty() && !host.cpu_vendor.empty() && hw.cpu_vendor != host.cpu_vendor) {
+        mismatch(20, "vendor " + hw.cpu_vendor + " vs " + host.cpu_vendor);
+    }
+
+    bool same_brand = !hw.cpu_model.empty() && hw.cpu_model == host.cpu_model;
+    bool same_model = hw.cpu_family >= 0 && hw.cpu_family == host.cpu_family &&
+                      hw.cpu_model_number == host.cpu_model_number;
+    if (!same_brand && !same_model) {
+        bool same_family = hw.cpu_family >= 0 && hw.cpu_family == host.cpu_family;
+        mismatch(same_family ? 4 : 8, "CPU '" + hw.cpu_model + "' vs '" + host.cpu_model + "'");
+    } else if (!same_brand) {
+        // Same microarchitecture, different SKU (clock, core count)
+        match.distance += 1;
+    }
+
+    // SHA-NI changes hashing cost several-fold; wider vectors change the
+    // SIMD kernels
+    auto feature = [&](const char* name, bool in_profile, bool on_host, double penalty) {
+        if (in_profile != on_host) {
+            mismatch(penalty, std::string(name) + (on_host ? " missing from" : " only in") + " profile");
+        }
+    };
+    feature("SHA-NI", hw.sha_ni, host.sha_ni, 10);
+    feature("AVX2", hw.avx2, host.avx2, 5);
+    feature("AVX-512", hw.avx512f, host.avx512f, 3);
+
+    const struct { const char* name; uint64_t profile, host; } caches[] = {
+        {"L1d", hw.l1d_bytes, host.l1d_bytes},
+        {"L2", hw.l2_bytes, host.l2_bytes},
+        {"LLC", hw.llc_bytes, host.llc_bytes},
+    };
+    for (const auto& cache : caches) {
+        double ratio = size_ratio(cache.profile, cache.host);
+        if (ratio > 2.0) {
+            std::ostringstream reason;
+            reason << cache.name << " " << cache.profile << " vs " << cache.host << " bytes";
+            mismatch(std::log2(ratio), reason.str());
+        } else {
+            match.distance += std::log2(ratio);
+        }
+    }
+
+    if (hw.physical_cores > 0 && host.physical_cores > 0) {
+        match.distance += 0.25 * std::log2(size_ratio(hw.physical_cores, host.physical_cores));
+    }
+
+    match.close = !major;
+    return match;
+}
+
+std::vector<ProfileMatch> ProfileRegistry::rank(const HardwareInfo& host) const {
+    std::vector<ProfileMatch> matches;
+    for (const auto& profile : profiles_) {
+        matches.push_back(match_profile(profile, host));
+    }
+    std::stable_sort(matches.begin(), matches.end(), [](const ProfileMatch& a, const ProfileMatch& b) {
+        if (a.close != b.close) return a.close;
+        return a.distance < b.distance;
+    });
+    return matches;
+}
+
+ProfileSelection ProfileRegistry::select(const HardwareInfo& host) const {
+    std::vector<ProfileMatch> matches = rank(host);
+    if (matches.empty()) {
+        throw std::runtime_error("No loadable cost models in " + directory_);
+    }
+
+    const ProfileMatch& best = matches.front();
+    ProfileSelection selection;
+    selection.path = best.profile->path;
+    selection.profile_id = best.profile->profile_id;
+    selection.distance = best.distance;
+    selection.close = best.close;
+
+    if (!best.close) {
+        std::string reasons;
+        for (const auto& reason : best.mismatches) {
+            reasons += (reasons.empty() ? "" : "; ") + reason;
+        }
+        selection.warning = "No calibrated profile in " + directory_ + " matches this host (" +
+                            host.cpu_model + "); using nearest profile " + selection.profile_id +
+                            " (" + reasons + ")";
+    }
+    if (!best.profile->ignored.empty()) {
+        std::string ignored;
+        for (const auto& path : best.profile->ignored) {
+            ignored += (ignored.empty() ? "" : ", ") + path;
+        }
+        selection.warning += (selection.warning.empty() ? "" : "; ") + std::string("Profile ") +
+                             selection.profile_id + " is also the profile_id of " + ignored +
+                             ", which were ignored; using " + selection.path;
+    }
+    return selection;
+}
+
+} // namespace cost
+} // namespace bsv
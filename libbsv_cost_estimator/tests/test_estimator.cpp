@@ -1,9 +1,120 @@
 #include "bsv/cost_estimator.h"
+#include "bsv/compiled_model.h"
+#include "bsv/static_cost_estimator.h"
+#include "bsv/models/static_cost_model.h"
 #include <iostream>
-#include <cassert>
+#include <fstream>
+#include <cmath>
+#include <atomic>
+#include <filesystem>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <thread>
 
 using namespace bsv::cost;
 
+// The library builds Release with -DNDEBUG by default, so checks throw
+// rather than assert
+void check(bool condition, const char* what, int line) {
+    if (!condition) {
+        throw std::runtime_error("line " + std::to_string(line) + ": " + what);
+    }
+}
+
+#define CHECK(condition) check((condition), #condition, __LINE__)
+
+// Files a test writes, removed when it returns
+class TestFiles {
+public:
+    TestFiles(std::initializer_list<std::string> paths) : paths_(paths) {}
+    ~TestFiles() {
+        std::error_code ec;
+        for (const auto& path : paths_) std::filesystem::remove_all(path, ec);
+    }
+
+private:
+    std::vector<std::string> paths_;
+};
+
+void write_model(const std::string& path, const std::string& json) {
+    std::ofstream(path) << json;
+}
+
+// One input spending a zero outpoint and one 100000-satoshi output
+Transaction make_test_tx(const Script& script_pubkey = {}) {
+    Transaction tx;
+    tx.version = 1;
+    tx.locktime = 0;
+    tx.inputs.push_back({std::vector<uint8_t>(32, 0), 0, {}, 0xffffffff});
+    tx.outputs.push_back({100000, script_pubkey});
+    return tx;
+}
+
+// Loading the model at path throws
+void expect_load_failure(const std::string& path) {
+    bool rejected = false;
+    try {
+        CostEstimator bad(path);
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    CHECK(rejected);
+}
+
+// A model with this JSON is rejected at load time
+void expect_rejected(const std::string& json) {
+    const char* path = "test_rejected_model.json";
+    TestFiles files({path});
+    write_model(path, json);
+    expect_load_failure(path);
+}
+
+void expect_same_estimate(const CostEstimate& a, const CostEstimate& b) {
+    CHECK(a.total_cycles == b.total_cycles);
+    CHECK(a.breakdown.parsing == b.breakdown.parsing);
+    CHECK(a.breakdown.dispatch == b.breakdown.dispatch);
+    CHECK(a.breakdown.stack_ops == b.breakdown.stack_ops);
+    CHECK(a.breakdown.byte_ops == b.breakdown.byte_ops);
+    CHECK(a.breakdown.arithmetic == b.breakdown.arithmetic);
+    CHECK(a.breakdown.hashing == b.breakdown.hashing);
+    CHECK(a.breakdown.signatures == b.breakdown.signatures);
+    CHECK(a.breakdown.control_flow == b.breakdown.control_flow);
+    CHECK(a.breakdown.memory == b.breakdown.memory);
+    CHECK(a.peak_stack_bytes == b.peak_stack_bytes);
+}
+
+// Compiles the JSON model at json_path and checks that the binary model
+// estimates exactly as the JSON one does; returns the compiled estimate
+CostEstimate check_compiled_agreement(const std::string& json_path, const Script& unlocking,
+                                      const Script& locking, const Transaction& tx,
+                                      const EstimatorOptions& options = {}) {
+    std::string compiled_path = std::filesystem::path(json_path).replace_extension(".bsvcm").string();
+    TestFiles files({compiled_path});
+    compile_cost_model(json_path, compiled_path);
+    EstimatorLimits limits;
+    auto from_json = CostEstimator(json_path).estimate_with_options(unlocking, locking, tx, 0,
+                                                                     limits, options);
+    auto compiled = CostEstimator(compiled_path).estimate_with_options(unlocking, locking, tx, 0,
+                                                                        limits, options);
+    expect_same_estimate(from_json, compiled);
+    return compiled;
+}
+
+// Checks that the compiled-in example model (generated from
+// example_model.json by the build) estimates exactly as the runtime one;
+// returns the runtime estimate
+CostEstimate check_static_agreement(const Script& unlocking, const Script& locking,
+                                    const Transaction& tx, const EstimatorOptions& options = {}) {
+    EstimatorLimits limits;
+    auto runtime = CostEstimator("../../cost_models/example_model.json")
+                       .estimate_with_options(unlocking, locking, tx, 0, limits, options);
+    auto compiled_in = StaticCostEstimator<models::static_cost_model>()
+                           .estimate_with_options(unlocking, locking, tx, 0, limits, options);
+    expect_same_estimate(runtime, compiled_in);
+    return runtime;
+}
+
 void test_basic_estimation() {
     std::cout << "Test: Basic cost estimation..." << std::endl;
     
@@ -32,8 +143,8 @@ void test_basic_estimation() {
     
     auto result = estimator.estimate(unlocking, locking, tx, 0);
     
-    assert(result.total_cycles > 0);
-    assert(result.opcode_count > 0);
+    CHECK(result.total_cycles > 0);
+    CHECK(result.opcode_count > 0);
     std::cout << "  ✓ Estimated " << result.total_cycles << " cycles" << std::endl;
 }
 
@@ -70,8 +181,8 @@ void test_cat_operation() {
     
     auto result = estimator.estimate(unlocking, locking, tx, 0);
     
-    assert(result.total_cycles > 0);
-    assert(result.breakdown.byte_ops > 0);
+    CHECK(result.total_cycles > 0);
+    CHECK(result.breakdown.byte_ops > 0);
     std::cout << "  ✓ OP_CAT (20 bytes): " << result.breakdown.byte_ops 
               << " cycles" << std::endl;
 }
@@ -105,8 +216,8 @@ void test_hash_operations() {
     
     auto result = estimator.estimate(unlocking, locking, tx, 0);
     
-    assert(result.total_cycles > 0);
-    assert(result.breakdown.hashing > 0);
+    CHECK(result.total_cycles > 0);
+    CHECK(result.breakdown.hashing > 0);
     std::cout << "  ✓ OP_SHA256 (32 bytes): " << result.breakdown.hashing 
               << " cycles" << std::endl;
 }
@@ -141,10 +252,883 @@ void test_limits() {
     
     auto result = estimator.estimate_with_limits(unlocking, locking, tx, 0, limits);
     
-    assert(!result.warnings.empty());
+    CHECK(!result.warnings.empty());
     std::cout << "  ✓ Detected limit violation: " << result.warnings[0] << std::endl;
 }
 
+void test_cold_cache_coefficients() {
+    std::cout << "Test: Cold-cache coefficients..." << std::endl;
+    
+    const char* model_path = "test_cold_model.json";
+    TestFiles files({model_path});
+    write_model(model_path, R"({
+        "profile_id": "cold_test",
+        "opcodes": {
+            "OP_SHA256": {"model": "linear", "c0": 1000, "c1": 1.0,
+                          "cold": {"c0": 3000, "c1": 2.0}},
+            "OP_DUP": {"model": "constant", "c0": 100}
+        }
+    })");
+    
+    CostEstimator estimator(model_path);
+    
+    Transaction tx = make_test_tx();
+    
+    // Push 32 bytes, duplicate, hash
+    Script unlocking = {0x20};
+    unlocking.resize(33);
+    Script locking = {static_cast<uint8_t>(OpCode::OP_DUP),
+                      static_cast<uint8_t>(OpCode::OP_SHA256)};
+    
+    EstimatorLimits limits;
+    EstimatorOptions options;
+    auto warm = estimator.estimate_with_options(unlocking, locking, tx, 0, limits, options);
+    options.cache_state = CacheState::COLD;
+    auto cold = estimator.estimate_with_options(unlocking, locking, tx, 0, limits, options);
+    
+    CHECK(warm.breakdown.hashing == 1000 + 32);
+    CHECK(cold.breakdown.hashing == 3000 + 2 * 32);
+    // OP_DUP has no cold coefficients, so it keeps its warm cost
+    CHECK(cold.breakdown.stack_ops == warm.breakdown.stack_ops);
+    std::cout << "  ✓ OP_SHA256 (32 bytes): warm " << warm.breakdown.hashing
+              << ", cold " << cold.breakdown.hashing << " cycles" << std::endl;
+}
+
+void test_piecewise_model() {
+    std::cout << "Test: Piecewise cost model..." << std::endl;
+    
+    const char* model_path = "test_piecewise_model.json";
+    TestFiles files({model_path});
+    write_model(model_path, R"({
+        "profile_id": "piecewise_test",
+        "opcodes": {
+            "OP_SHA256": {"model": "piecewise",
+                          "breakpoints": [64, 128],
+                          "segments": [{"c0": 100, "c1": 4.0},
+                                       {"c0": 1000, "c1": 2.0},
+                                       {"c0": 5000, "c1": 1.0}]}
+        }
+    })");
+    
+    CostEstimator estimator(model_path);
+    
+    Transaction tx = make_test_tx();
+    
+    auto hash_cost = [&](uint8_t push_size) {
+        Script unlocking = {static_cast<uint8_t>(OpCode::OP_PUSHDATA1), push_size};
+        unlocking.resize(2 + push_size);
+        Script locking = {static_cast<uint8_t>(OpCode::OP_SHA256)};
+        return estimator.estimate(unlocking, locking, tx, 0).breakdown.hashing;
+    };
+    
+    CHECK(hash_cost(32) == 100 + 4 * 32);
+    CHECK(hash_cost(63) == 100 + 4 * 63);
+    CHECK(hash_cost(64) == 1000 + 2 * 64);    // Breakpoint starts the next segment
+    CHECK(hash_cost(200) == 5000 + 200);
+    
+    // Malformed models are rejected at load time
+    expect_rejected(R"({"opcodes": {"OP_SHA256": {"model": "piecewise",
+                       "breakpoints": [128, 64],
+                       "segments": [{"c0": 1}, {"c0": 2}, {"c0": 3}]}}})");
+    
+    std::cout << "  ✓ OP_SHA256 32/64/200 bytes: " << hash_cost(32) << "/"
+              << hash_cost(64) << "/" << hash_cost(200) << " cycles" << std::endl;
+}
+
+void test_table_model() {
+    std::cout << "Test: Table cost model..." << std::endl;
+    
+    const char* model_path = "test_table_model.json";
+    TestFiles files({model_path});
+    write_model(model_path, R"({
+        "profile_id": "table_test",
+        "opcodes": {
+            "OP_SHA256": {"model": "table",
+                          "points": [[10, 100], [1000, 10000], [2000, 12000]]}
+        }
+    })");
+    
+    CostEstimator estimator(model_path);
+    
+    Transaction tx = make_test_tx();
+    
+    auto hash_cost = [&](const std::vector<uint8_t>& unlocking) {
+        Script locking = {static_cast<uint8_t>(OpCode::OP_SHA256)};
+        return estimator.estimate(unlocking, locking, tx, 0).breakdown.hashing;
+    };
+    
+    // OP_PUSHDATA1 of n bytes
+    auto push = [](uint8_t n) {
+        Script s = {static_cast<uint8_t>(OpCode::OP_PUSHDATA1), n};
+        s.resize(2 + n);
+        return s;
+    };
+    
+    // Below the first point: first point's cost
+    CHECK(hash_cost(push(5)) == 100);
+    // Exactly on a point
+    CHECK(hash_cost(push(10)) == 100);
+    // Log-log interpolation: halfway between 10 and 1000 is 100 -> 1000 cycles
+    uint64_t mid = hash_cost(push(100));
+    CHECK(mid >= 999 && mid <= 1000);
+    
+    // Beyond the last point: linear with the last segment's slope (2 cycles/byte).
+    // Build a 2500-byte item from ten 250-byte pushes.
+    Script large;
+    for (int i = 0; i < 10; ++i) {
+        Script p = push(250);
+        large.insert(large.end(), p.begin(), p.end());
+    }
+    for (int i = 0; i < 9; ++i) {
+        large.push_back(static_cast<uint8_t>(OpCode::OP_CAT));
+    }
+    CHECK(hash_cost(large) == 12000 + 2 * 500);
+    
+    std::cout << "  ✓ OP_SHA256 5/10/100 bytes: " << hash_cost(push(5)) << "/"
+              << hash_cost(push(10)) << "/" << hash_cost(push(100)) << " cycles" << std::endl;
+}
+
+void test_compiled_model() {
+    std::cout << "Test: Compiled binary model..." << std::endl;
+    
+    const char* json_path = "test_compiled_model.json";
+    const char* compiled_path = "test_compiled_model.bsvcm";
+    TestFiles files({json_path, compiled_path});
+    write_model(json_path, R"({
+        "profile_id": "compiled_test",
+        "hardware": {"cpu": "test"},
+        "software": {"openssl_version": "3.0.2", "ripemd160": "avx2"},
+        "constants": {"c_dispatch": 7, "c_parse_per_byte": 1.5},
+        "opcodes": {
+            "OP_DUP": {"model": "constant", "c0": 120},
+            "OP_CAT": {"model": "piecewise", "breakpoints": [64],
+                       "segments": [{"c0": 100, "c1": 1}, {"c0": 500, "c1": 2}]},
+            "OP_SHA256": {"model": "table", "points": [[10, 100], [1000, 10000]],
+                          "cold": {"c0": 3000, "c1": 2.0}},
+            "OP_HASH256": {"model": "linear", "c0": 1000, "c1": 1.5,
+                           "cold": {"c0": 3000, "c1": 2.0}},
+            "OP_CHECKSIG": {"model": "signature", "c_ecdsa": 50000, "c_preimage_per_byte": 2}
+        }
+    })");
+    
+    compile_cost_model(json_path, compiled_path);
+    CHECK(is_compiled_cost_model(compiled_path));
+    CHECK(!is_compiled_cost_model(json_path));
+    
+    CostEstimator from_json(json_path);
+    CostEstimator from_binary(compiled_path);
+    CHECK(from_binary.get_profile_id() == "compiled_test");
+    CHECK(from_binary.get_hardware_info() == from_json.get_hardware_info());
+    CHECK(from_binary.get_software_info() == from_json.get_software_info());
+    CHECK(from_binary.get_software_info().find("\"ripemd160\":\"avx2\"") != std::string::npos);
+    
+    Transaction tx = make_test_tx();
+    
+    // Push 40 bytes, DUP, CAT (80 bytes), DUP, SHA256, HASH256, CHECKSIG
+    Script unlocking = {40};
+    unlocking.resize(41);
+    Script locking = {static_cast<uint8_t>(OpCode::OP_DUP),
+                      static_cast<uint8_t>(OpCode::OP_CAT),
+                      static_cast<uint8_t>(OpCode::OP_DUP),
+                      static_cast<uint8_t>(OpCode::OP_SHA256),
+                      static_cast<uint8_t>(OpCode::OP_HASH256),
+                      static_cast<uint8_t>(OpCode::OP_CHECKSIG)};
+    
+    EstimatorLimits limits;
+    EstimatorOptions options;
+    for (CacheState state : {CacheState::WARM, CacheState::COLD}) {
+        options.cache_state = state;
+        expect_same_estimate(from_json.estimate_with_options(unlocking, locking, tx, 0, limits, options),
+                             from_binary.estimate_with_options(unlocking, locking, tx, 0, limits, options));
+    }
+    auto result = from_binary.estimate(unlocking, locking, tx, 0);
+    CHECK(result.breakdown.byte_ops == 500 + 2 * 80);
+    CHECK(result.breakdown.dispatch == 7 * 7);
+    
+    // A flipped byte fails the checksum
+    {
+        std::fstream file(compiled_path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(300);
+        file.put('\x5a');
+    }
+    expect_load_failure(compiled_path);
+    
+    std::cout << "  ✓ JSON and compiled models agree: " << result.total_cycles << " cycles" << std::endl;
+}
+
+void test_model_hot_reload() {
+    std::cout << "Test: Hot model reload..." << std::endl;
+    
+    const char* model_a = "test_reload_a.json";
+    const char* model_b = "test_reload_b.json";
+    TestFiles files({model_a, model_b});
+    write_model(model_a, R"({"profile_id": "reload_a", "opcodes": {"OP_DUP": {"model": "constant", "c0": 100}}})");
+    write_model(model_b, R"({"profile_id": "reload_b", "opcodes": {"OP_DUP": {"model": "constant", "c0": 200}}})");
+    
+    auto handle = std::make_shared<ModelHandle>(model_a);
+    CostEstimator estimator(handle);
+    CHECK(estimator.get_model_generation() == 1);
+    
+    Transaction tx = make_test_tx();
+    Script unlocking = {0x01, 0x00};
+    Script locking = {static_cast<uint8_t>(OpCode::OP_DUP)};
+    
+    auto first = estimator.estimate(unlocking, locking, tx, 0);
+    CHECK(first.profile_id == "reload_a" && first.model_generation == 1);
+    
+    // Readers estimate while the model flips between A (odd generations)
+    // and B (even); every estimate must be consistent with one model
+    std::atomic<bool> stop{false};
+    std::atomic<bool> consistent{true};
+    std::atomic<uint64_t> estimates{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; ++t) {
+        readers.emplace_back([&]() {
+            uint64_t last_generation = 0;
+            while (!stop.load()) {
+                auto r = estimator.estimate(unlocking, locking, tx, 0);
+                bool is_a = r.profile_id == "reload_a";
+                uint64_t expected = is_a ? 100 : 200;
+                if (r.breakdown.stack_ops != expected ||
+                    (r.model_generation % 2 == 1) != is_a ||
+                    r.model_generation < last_generation) {
+                    consistent = false;
+                }
+                last_generation = r.model_generation;
+                estimates++;
+            }
+        });
+    }
+    
+    const int reloads = 200;
+    for (int i = 0; i < reloads; ++i) {
+        handle->reload(i % 2 == 0 ? model_b : model_a);
+    }
+    stop = true;
+    for (auto& reader : readers) reader.join();
+    
+    CHECK(consistent);
+    CHECK(handle->generation() == 1 + reloads);
+    
+    // A failed reload keeps the current model
+    bool rejected = false;
+    try {
+        estimator.reload_model("does_not_exist.json");
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    CHECK(rejected);
+    CHECK(estimator.get_model_generation() == 1 + reloads);
+    CHECK(estimator.get_profile_id() == "reload_a");
+    
+    std::cout << "  ✓ " << reloads << " reloads under " << estimates.load()
+              << " concurrent estimates" << std::endl;
+}
+
+void test_profile_selection() {
+    std::cout << "Test: Host detection and profile selection..." << std::endl;
+    
+    const HardwareInfo& host = detect_hardware();
+    CHECK(host.logical_cpus > 0);
+    HardwareInfo round_trip = HardwareInfo::from_json(host.to_json());
+    CHECK(round_trip.cpu_model == host.cpu_model && round_trip.llc_bytes == host.llc_bytes);
+    
+    HardwareInfo other = host;
+    other.cpu_vendor = "OtherVendor";
+    other.cpu_model = "Other CPU";
+    other.cpu_family = 99;
+    other.sha_ni = !host.sha_ni;
+    other.llc_bytes = host.llc_bytes * 8 + 1;
+    
+    auto write_profile = [](const std::string& path, const std::string& profile_id,
+                            const std::string& hardware) {
+        write_model(path, R"({"profile_id": ")" + profile_id + "\"" +
+                              (hardware.empty() ? "" : ", \"hardware\": " + hardware) +
+                              R"(, "opcodes": {"OP_DUP": {"model": "constant", "c0": 100}}})");
+    };
+    
+    TestFiles files({"test_profiles"});
+    std::filesystem::create_directories("test_profiles/all");
+    std::filesystem::create_directories("test_profiles/mismatched");
+    write_profile("test_profiles/all/this_host.json", "this_host", host.to_json());
+    write_profile("test_profiles/all/other_host.json", "other_host", other.to_json());
+    write_profile("test_profiles/all/generic.json", "generic", "");
+    write_profile("test_profiles/mismatched/other_host.json", "other_host", other.to_json());
+    write_profile("test_profiles/mismatched/generic.json", "generic", "");
+    
+    ProfileRegistry registry("test_profiles/all");
+    CHECK(registry.profiles().size() == 3);
+    ProfileSelection selection = registry.select(host);
+    CHECK(selection.profile_id == "this_host");
+    CHECK(selection.close && selection.warning.empty());
+    
+    auto estimator = CostEstimator::for_host("test_profiles/all", &selection);
+    CHECK(estimator->get_profile_id() == "this_host");
+    CHECK(!estimator->get_hardware_info().empty());
+    
+    Transaction tx = make_test_tx();
+    Script unlocking = {0x01, 0x00};
+    Script locking = {static_cast<uint8_t>(OpCode::OP_DUP)};
+    CHECK(estimator->estimate(unlocking, locking, tx, 0).warnings.empty());
+    
+    // No close match: the nearest profile is used, with a warning
+    ProfileSelection fallback = ProfileRegistry("test_profiles/mismatched").select(host);
+    CHECK(fallback.profile_id == "other_host");
+    CHECK(!fallback.close && !fallback.warning.empty());
+    
+    // Estimates carry the warning even when no selection is asked for,
+    // until another model is loaded
+    auto nearest = CostEstimator::for_host("test_profiles/mismatched");
+    auto warned = nearest->estimate(unlocking, locking, tx, 0);
+    CHECK(warned.warnings.size() == 1 && warned.warnings[0] == fallback.warning);
+    nearest->reload_model("test_profiles/all/this_host.json");
+    CHECK(nearest->estimate(unlocking, locking, tx, 0).warnings.empty());
+    
+    // Two calibrations with one profile_id: the first by name is kept (its
+    // compiled form, as usual) and the other is reported
+    std::filesystem::create_directories("test_profiles/duplicate");
+    write_profile("test_profiles/duplicate/a_host.json", "this_host", host.to_json());
+    write_profile("test_profiles/duplicate/b_host.json", "this_host", host.to_json());
+    compile_cost_model("test_profiles/duplicate/a_host.json", "test_profiles/duplicate/a_host.bsvcm");
+    ProfileRegistry duplicates("test_profiles/duplicate");
+    CHECK(duplicates.profiles().size() == 1 && duplicates.errors().size() == 1);
+    ProfileSelection duplicate = duplicates.select(host);
+    CHECK(duplicate.path == "test_profiles/duplicate/a_host.bsvcm" && duplicate.close);
+    CHECK(duplicate.warning.find("b_host.json") != std::string::npos);
+    auto reported = CostEstimator::for_host("test_profiles/duplicate")->estimate(unlocking, locking, tx, 0);
+    CHECK(reported.warnings.size() == 1 && reported.warnings[0] == duplicate.warning);
+    
+    std::cout << "  ✓ " << (host.cpu_model.empty() ? "host" : host.cpu_model) << " -> "
+              << selection.profile_id << "; fallback warning: " << fallback.warning << std::endl;
+}
+
+void test_static_estimator() {
+    std::cout << "Test: Compile-time static model..." << std::endl;
+    
+    // static_cost_model is generated from example_model.json by the build
+    CostEstimator runtime("../../cost_models/example_model.json");
+    StaticCostEstimator<models::static_cost_model> compiled_in;
+    CHECK(compiled_in.get_profile_id() == runtime.get_profile_id());
+    
+    Transaction tx = make_test_tx(Script(25, 0));
+    
+    // Pushes, stack, byte, hash, signature and unmodelled opcodes
+    Script unlocking = {0x20};
+    unlocking.resize(33);
+    Script locking = {static_cast<uint8_t>(OpCode::OP_DUP),
+                      static_cast<uint8_t>(OpCode::OP_CAT),
+                      static_cast<uint8_t>(OpCode::OP_DUP),
+                      static_cast<uint8_t>(OpCode::OP_SWAP),
+                      static_cast<uint8_t>(OpCode::OP_SHA256),
+                      static_cast<uint8_t>(OpCode::OP_HASH160),
+                      static_cast<uint8_t>(OpCode::OP_HASH256),
+                      0x88,
+                      static_cast<uint8_t>(OpCode::OP_CHECKSIG)};
+    
+    auto a = runtime.estimate(unlocking, locking, tx, 0);
+    auto b = compiled_in.estimate(unlocking, locking, tx, 0);
+    expect_same_estimate(a, b);
+    CHECK(b.profile_id == a.profile_id && b.model_generation == 0);
+    
+    std::cout << "  ✓ Runtime and compiled-in models agree: " << b.total_cycles << " cycles" << std::endl;
+}
+
+void test_parallel_estimate() {
+    std::cout << "Test: Parallel validation wall time..." << std::endl;
+    
+    const char* model_path = "test_parallel_model.json";
+    const char* compiled_path = "test_parallel_model.bsvcm";
+    TestFiles files({model_path, compiled_path});
+    write_model(model_path, R"({"profile_id": "parallel",
+                                "opcodes": {"OP_DUP": {"model": "constant", "c0": 100}},
+                                "parallel_efficiency": {"threads": [1, 2, 4],
+                                                        "compute": [1.0, 0.9, 0.8],
+                                                        "memory": [1.0, 0.7, 0.5],
+                                                        "smt_speedup": 1.2}})");
+    
+    // Eight signature-bound inputs of 1000 cycles each
+    std::vector<CostEstimate> inputs(8, CostEstimate{});
+    for (auto& input : inputs) {
+        input.total_cycles = 1000;
+        input.breakdown.signatures = 1000;
+    }
+    
+    CostEstimator estimator(model_path);
+    auto near = [](double a, double b) { return std::abs(a - b) < 1e-6 * b; };
+    
+    auto one = estimator.estimate_parallel(inputs, 1);
+    CHECK(one.cpu_cycles == 8000 && near(one.wall_cycles, 8000) && one.threads == 1);
+    CHECK(near(estimator.estimate_parallel(inputs, 4).wall_cycles, 8000 / (4 * 0.8)));
+    
+    // Between measured counts the efficiency is interpolated
+    CHECK(near(estimator.estimate_parallel(inputs, 3).wall_cycles, 8000 / (3 * 0.85)));
+    
+    // Eight threads on four cores: the hyperthreads add 20% per core
+    auto smt = estimator.estimate_parallel(inputs, 8, 4);
+    CHECK(near(smt.wall_cycles, 8000 / (4 * 0.8 * 1.2)));
+    
+    // No more threads than inputs, and never faster than the longest input
+    auto wide = estimator.estimate_parallel(inputs, 64);
+    CHECK(wide.threads == 8 && near(wide.wall_cycles, 8000 / (8 * 0.8)));
+    inputs[0].total_cycles = inputs[0].breakdown.signatures = 5000;
+    CHECK(near(estimator.estimate_parallel(inputs, 64).wall_cycles, 5000));
+    
+    // Hashing scales with the memory table
+    std::vector<CostEstimate> hashing(4, CostEstimate{});
+    for (auto& input : hashing) {
+        input.total_cycles = 1000;
+        input.breakdown.hashing = 1000;
+    }
+    CHECK(near(estimator.estimate_parallel(hashing, 4).wall_cycles, 4000 / (4 * 0.5)));
+    
+    // The section survives compilation; without one, scaling is ideal
+    compile_cost_model(model_path, compiled_path);
+    CostEstimator compiled(compiled_path);
+    CHECK(near(compiled.estimate_parallel(hashing, 4).wall_cycles, 4000 / (4 * 0.5)));
+    CostEstimator uncalibrated("../../cost_models/example_model.json");
+    CHECK(near(uncalibrated.estimate_parallel(hashing, 4).wall_cycles, 1000));
+    
+    std::cout << "  ✓ 8 inputs on 4 threads: " << estimator.estimate_parallel(inputs, 4).speedup
+              << "x speedup" << std::endl;
+}
+
+void test_sigcache_pricing() {
+    std::cout << "Test: Signature cache hit pricing..." << std::endl;
+    
+    const char* model_path = "test_sigcache_model.json";
+    TestFiles files({model_path});
+    write_model(model_path, R"({"profile_id": "sigcache",
+                                "opcodes": {"OP_CHECKSIG": {"model": "signature", "c_ecdsa": 100000,
+                                                            "c_preimage_per_byte": 2.0,
+                                                            "c_sigcache_hit": 1000}}})");
+    
+    Transaction tx = make_test_tx(Script(25, 0));
+    
+    Script unlocking = {0x01, 0x00, 0x01, 0x00};
+    Script locking = {static_cast<uint8_t>(OpCode::OP_CHECKSIG)};
+    
+    CostEstimator estimator(model_path);
+    EstimatorLimits limits;
+    EstimatorOptions options;
+    auto miss = estimator.estimate_with_options(unlocking, locking, tx, 0, limits, options);
+    options.sigcache = SigCacheState::HIT;
+    auto hit = estimator.estimate_with_options(unlocking, locking, tx, 0, limits, options);
+    
+    // A hit saves the ECDSA verify but still hashes the preimage
+    CHECK(miss.breakdown.signatures - hit.breakdown.signatures == 99000);
+    CHECK(hit.breakdown.signatures > 1000);
+    
+    // The coefficient survives compilation
+    CHECK(check_compiled_agreement(model_path, unlocking, locking, tx, options).total_cycles ==
+           hit.total_cycles);
+    
+    // The compiled-in model agrees, and the default is the cold price
+    auto example_hit = check_static_agreement(unlocking, locking, tx, options);
+    CHECK(check_static_agreement(unlocking, locking, tx).total_cycles > example_hit.total_cycles);
+    
+    std::cout << "  ✓ OP_CHECKSIG: miss " << miss.breakdown.signatures
+              << ", hit " << hit.breakdown.signatures << " cycles" << std::endl;
+}
+
+void test_arithmetic_models() {
+    std::cout << "Test: Big-number arithmetic models..." << std::endl;
+    
+    const char* model_path = "test_arithmetic_model.json";
+    TestFiles files({model_path});
+    write_model(model_path, R"({"profile_id": "arithmetic",
+                                "opcodes": {"OP_ADD": {"model": "linear", "c0": 100, "c1": 1.0},
+                                            "OP_MUL": {"model": "quadratic", "c0": 100, "c1": 1.0, "c2": 0.5},
+                                            "OP_DIV": {"model": "nlogn", "c0": 100, "c1": 1.0, "c2": 2.0}}})");
+    
+    Transaction tx = make_test_tx();
+    
+    // <64 bytes> <32 bytes> OP_MUL: priced by the larger operand
+    Script unlocking = {0x40};
+    unlocking.resize(65, 0x11);
+    unlocking.push_back(0x20);
+    unlocking.resize(unlocking.size() + 32, 0x22);
+    
+    CostEstimator estimator(model_path);
+    auto mul = estimator.estimate(unlocking, {static_cast<uint8_t>(OpCode::OP_MUL)}, tx, 0);
+    CHECK(mul.breakdown.arithmetic == 100 + 64 + 0.5 * 64 * 64);
+    CHECK(mul.peak_stack_bytes == 96);
+    
+    auto div = estimator.estimate(unlocking, {static_cast<uint8_t>(OpCode::OP_DIV)}, tx, 0);
+    CHECK(div.breakdown.arithmetic == 100 + 64 + 2.0 * 64 * 6);
+    
+    // The product is as long as both operands, so a following OP_ADD sees 96 bytes
+    Script locking = {static_cast<uint8_t>(OpCode::OP_MUL), 0x01, 0x05,
+                      static_cast<uint8_t>(OpCode::OP_ADD)};
+    auto chain = estimator.estimate(unlocking, locking, tx, 0);
+    CHECK(chain.breakdown.arithmetic == mul.breakdown.arithmetic + 100 + 96);
+    
+    // Both types survive compilation
+    CHECK(check_compiled_agreement(model_path, unlocking, {static_cast<uint8_t>(OpCode::OP_DIV)}, tx)
+               .total_cycles == div.total_cycles);
+    
+    // The compiled-in example model prices OP_MUL like the runtime one
+    check_static_agreement(unlocking, locking, tx);
+    
+    std::cout << "  ✓ 64B x 32B: OP_MUL " << mul.breakdown.arithmetic
+              << ", OP_DIV " << div.breakdown.arithmetic << " cycles" << std::endl;
+}
+
+void test_control_flow_costs() {
+    std::cout << "Test: Control flow costs..." << std::endl;
+    
+    const char* model_path = "test_control_flow_model.json";
+    TestFiles files({model_path});
+    write_model(model_path, R"({"profile_id": "control_flow",
+                                "constants": {"c_dispatch": 0},
+                                "opcodes": {"OP_IF": {"model": "constant", "c0": 30},
+                                            "OP_ELSE": {"model": "constant", "c0": 20},
+                                            "OP_ENDIF": {"model": "constant", "c0": 10},
+                                            "OP_DUP": {"model": "constant", "c0": 5}},
+                                "control_flow": {"c_exec_per_depth": 3, "c_skip_per_byte": 0.5,
+                                                 "c_mispredict": 15, "condition_stack": "vector"}})");
+    
+    Transaction tx = make_test_tx();
+    
+    // <1> IF IF <40 bytes> ENDIF ELSE DUP ENDIF
+    Script unlocking = {0x01, 0x01};
+    Script locking = {static_cast<uint8_t>(OpCode::OP_IF), 0x51,
+                      static_cast<uint8_t>(OpCode::OP_IF), 0x28};
+    locking.resize(locking.size() + 40, 0x33);
+    locking.push_back(static_cast<uint8_t>(OpCode::OP_ENDIF));
+    locking.push_back(static_cast<uint8_t>(OpCode::OP_ELSE));
+    locking.push_back(static_cast<uint8_t>(OpCode::OP_DUP));
+    locking.push_back(static_cast<uint8_t>(OpCode::OP_ENDIF));
+    
+    CostEstimator estimator(model_path);
+    auto estimate = estimator.estimate(unlocking, locking, tx, 0);
+    // Two IFs with mispredicts, ELSE and two ENDIFs; per-opcode depth scans
+    // of 3 (OP_1) + 3 (inner IF) + 6 (push) + 6 (ENDIF) + 3 + 3 + 3 at
+    // depth 1; 40 bytes pushed inside the IF
+    uint64_t expected = 2 * (30 + 15) + 20 + 2 * 10 + 27 + 20;
+    CHECK(estimate.breakdown.control_flow == expected);
+    CHECK(estimate.breakdown.stack_ops == 5);
+    
+    // Survives compilation, and the compiled-in example model agrees with
+    // the runtime one
+    CHECK(check_compiled_agreement(model_path, unlocking, locking, tx).breakdown.control_flow ==
+           expected);
+    CHECK(check_static_agreement(unlocking, locking, tx).breakdown.control_flow > 0);
+    
+    // Malformed sections are rejected
+    expect_rejected(R"({"profile_id": "bad", "opcodes": {},
+                       "control_flow": {"c_exec_per_depth": 3, "condition_stack": "list"}})");
+    
+    std::cout << "  ✓ Nested IF/ELSE: " << estimate.breakdown.control_flow
+              << " control flow cycles" << std::endl;
+}
+
+void test_bitwise_models() {
+    std::cout << "Test: Bitwise opcodes..." << std::endl;
+    
+    const char* model_path = "test_bitwise_model.json";
+    TestFiles files({model_path});
+    write_model(model_path, R"({"profile_id": "bitwise",
+                                "opcodes": {"OP_XOR": {"model": "linear", "c0": 200, "c1": 1.5},
+                                            "OP_INVERT": {"model": "linear", "c0": 100, "c1": 2.0},
+                                            "OP_LSHIFT": {"model": "linear", "c0": 300, "c1": 4.5}}})");
+    
+    Transaction tx = make_test_tx();
+    
+    // <64 bytes> <64 bytes>
+    Script unlocking = {0x40};
+    unlocking.resize(65, 0x11);
+    unlocking.push_back(0x40);
+    unlocking.resize(unlocking.size() + 64, 0x22);
+    
+    CostEstimator estimator(model_path);
+    auto xor_estimate = estimator.estimate(unlocking, {static_cast<uint8_t>(OpCode::OP_XOR)}, tx, 0);
+    CHECK(xor_estimate.breakdown.byte_ops == 200 + 1.5 * 64);
+    CHECK(xor_estimate.peak_stack_bytes == 128);
+    
+    // XOR leaves one 64-byte item; INVERT keeps it, and <13> LSHIFT shifts it
+    Script locking = {static_cast<uint8_t>(OpCode::OP_XOR),
+                      static_cast<uint8_t>(OpCode::OP_INVERT),
+                      0x01, 0x0d,
+                      static_cast<uint8_t>(OpCode::OP_LSHIFT)};
+    auto chain = estimator.estimate(unlocking, locking, tx, 0);
+    CHECK(chain.breakdown.byte_ops == (200 + 1.5 * 64) + (100 + 2.0 * 64) + (300 + 4.5 * 64));
+    
+    // The compiled-in example model prices bitwise opcodes like the runtime one
+    CHECK(check_static_agreement(unlocking, locking, tx).breakdown.byte_ops > 0);
+    
+    std::cout << "  ✓ 64B XOR, INVERT, LSHIFT: " << chain.breakdown.byte_ops << " cycles" << std::endl;
+}
+
+void test_roll_depth() {
+    std::cout << "Test: OP_ROLL priced by depth..." << std::endl;
+    
+    const char* model_path = "test_roll_model.json";
+    TestFiles files({model_path});
+    write_model(model_path, R"({"profile_id": "roll",
+                                "opcodes": {"OP_ROLL": {"model": "linear", "c0": 100, "c1": 10}}})");
+    
+    Transaction tx = make_test_tx();
+    
+    // Five 1-byte items, then a 32-byte item at the bottom and the count
+    Script unlocking = {0x20};
+    unlocking.resize(33, 0x11);
+    for (int i = 0; i < 5; ++i) {
+        unlocking.push_back(0x01);
+        unlocking.push_back(0x22);
+    }
+    unlocking.push_back(0x01);
+    unlocking.push_back(0x05);
+    
+    CostEstimator estimator(model_path);
+    auto estimate = estimator.estimate(unlocking, {static_cast<uint8_t>(OpCode::OP_ROLL)}, tx, 0);
+    // The count is popped, then the deepest of the 6 remaining items rolls up
+    CHECK(estimate.breakdown.stack_ops == 100 + 10 * 5);
+    
+    // ROLL keeps the item count, so a second count and ROLL cost the same
+    Script locking = {static_cast<uint8_t>(OpCode::OP_ROLL), 0x01, 0x01,
+                      static_cast<uint8_t>(OpCode::OP_ROLL)};
+    auto twice = estimator.estimate(unlocking, locking, tx, 0);
+    CHECK(twice.breakdown.stack_ops == 2 * (100 + 10 * 5));
+    CHECK(twice.peak_stack_bytes == 32 + 5 + 1);
+    
+    std::cout << "  ✓ ROLL over 6 items: " << estimate.breakdown.stack_ops << " cycles" << std::endl;
+}
+
+void test_first_touch() {
+    std::cout << "Test: First-touch cost of large items..." << std::endl;
+    
+    const char* model_path = "test_first_touch_model.json";
+    TestFiles files({model_path});
+    write_model(model_path, R"({"profile_id": "first_touch",
+                                "constants": {"c_dispatch": 0, "c_parse_per_byte": 0},
+                                "opcodes": {"OP_DUP": {"model": "constant", "c0": 5},
+                                            "OP_CAT": {"model": "constant", "c0": 7}},
+                                "first_touch": {"c_map": 1000, "c_per_page": 10,
+                                                "page_bytes": 4096, "threshold_bytes": 131072}})");
+    
+    Transaction tx = make_test_tx();
+    
+    // PUSHDATA4 <200000 bytes> DUP CAT <16 bytes> DUP: the small push and
+    // its copy are below the threshold
+    Script unlocking = {static_cast<uint8_t>(OpCode::OP_PUSHDATA4), 0x40, 0x0d, 0x03, 0x00};
+    unlocking.resize(unlocking.size() + 200000, 0x11);
+    Script locking = {static_cast<uint8_t>(OpCode::OP_DUP), static_cast<uint8_t>(OpCode::OP_CAT),
+                      0x10};
+    locking.resize(locking.size() + 16, 0x22);
+    locking.push_back(static_cast<uint8_t>(OpCode::OP_DUP));
+    
+    CostEstimator estimator(model_path);
+    auto estimate = estimator.estimate(unlocking, locking, tx, 0);
+    // 49 pages for the push and its copy, 98 for the concatenation
+    uint64_t expected = 2 * (1000 + 10 * 49) + (1000 + 10 * 98);
+    CHECK(estimate.breakdown.memory == expected);
+    CHECK(estimate.total_cycles == expected + 2 * 5 + 7);
+    
+    // Survives compilation, and the compiled-in example model agrees with
+    // the runtime one
+    CHECK(check_compiled_agreement(model_path, unlocking, locking, tx).breakdown.memory == expected);
+    CHECK(check_static_agreement(unlocking, locking, tx).breakdown.memory > 0);
+    
+    // Models without the section charge nothing
+    write_model(model_path, R"({"profile_id": "no_first_touch", "opcodes": {}})");
+    CHECK(CostEstimator(model_path).estimate(unlocking, locking, tx, 0).breakdown.memory == 0);
+    
+    // Malformed sections are rejected
+    expect_rejected(R"({"profile_id": "bad", "opcodes": {},
+                       "first_touch": {"c_per_page": 10, "page_bytes": 0}})");
+    
+    std::cout << "  ✓ 200KB push, DUP and CAT: " << estimate.breakdown.memory
+              << " first-touch cycles" << std::endl;
+}
+
+void test_batched_preimage_hashing() {
+    std::cout << "Test: Batched preimage hashing..." << std::endl;
+    
+    const char* model_path = "test_batched_hash_model.json";
+    TestFiles files({model_path});
+    write_model(model_path, R"({"profile_id": "batched_hash",
+                                "opcodes": {"OP_CHECKSIG": {"model": "signature", "c_ecdsa": 100000,
+                                                            "c_preimage_per_byte": 2.0,
+                                                            "c_preimage_per_byte_batched": 0.5}}})");
+    
+    Transaction tx = make_test_tx(Script(25, 0));
+    
+    Script unlocking = {0x01, 0x00, 0x01, 0x00};
+    Script locking = {static_cast<uint8_t>(OpCode::OP_CHECKSIG)};
+    uint64_t preimage = calculate_sighash_size(tx, 0, SIGHASH_ALL);
+    
+    CostEstimator estimator(model_path);
+    EstimatorLimits limits;
+    EstimatorOptions options;
+    auto serial = estimator.estimate_with_options(unlocking, locking, tx, 0, limits, options);
+    options.preimage_hashing = PreimageHashing::BATCHED;
+    auto batched = estimator.estimate_with_options(unlocking, locking, tx, 0, limits, options);
+    
+    // Only the preimage bytes get cheaper
+    CHECK(serial.breakdown.signatures == static_cast<uint64_t>(100000 + 2.0 * preimage));
+    CHECK(batched.breakdown.signatures == static_cast<uint64_t>(100000 + 0.5 * preimage));
+    
+    // The coefficient survives compilation, and the compiled-in model agrees
+    CHECK(check_compiled_agreement(model_path, unlocking, locking, tx, options).total_cycles ==
+           batched.total_cycles);
+    check_static_agreement(unlocking, locking, tx, options);
+    
+    // Without the coefficient, batching changes nothing
+    write_model(model_path, R"({"profile_id": "serial_hash",
+                                "opcodes": {"OP_CHECKSIG": {"model": "signature", "c_ecdsa": 100000,
+                                                            "c_preimage_per_byte": 2.0}}})");
+    CHECK(CostEstimator(model_path).estimate_with_options(unlocking, locking, tx, 0, limits, options)
+               .total_cycles == serial.total_cycles);
+    
+    std::cout << "  ✓ OP_CHECKSIG: serial " << serial.breakdown.signatures
+              << ", batched " << batched.breakdown.signatures << " cycles" << std::endl;
+}
+
+void test_160_bit_hashes() {
+    std::cout << "Test: 160-bit hashes priced by input size..." << std::endl;
+    
+    const char* model_path = "test_hash160_model.json";
+    TestFiles files({model_path});
+    write_model(model_path, R"({"profile_id": "hash160",
+                                "constants": {"c_dispatch": 0, "c_parse_per_byte": 0},
+                                "opcodes": {"OP_HASH160": {"model": "linear", "c0": 500, "c1": 3},
+                                            "OP_RIPEMD160": {"model": "linear", "c0": 200, "c1": 2},
+                                            "OP_SHA1": {"model": "linear", "c0": 100, "c1": 1}}})");
+    
+    Transaction tx = make_test_tx();
+    
+    // <64 bytes> HASH160 RIPEMD160 SHA1: the later hashes read the 20-byte
+    // digest of the one before
+    Script unlocking = {0x40};
+    unlocking.resize(65, 0x11);
+    Script locking = {static_cast<uint8_t>(OpCode::OP_HASH160),
+                      static_cast<uint8_t>(OpCode::OP_RIPEMD160),
+                      static_cast<uint8_t>(OpCode::OP_SHA1)};
+    
+    CostEstimator estimator(model_path);
+    auto estimate = estimator.estimate(unlocking, locking, tx, 0);
+    uint64_t expected = (500 + 3 * 64) + (200 + 2 * 20) + (100 + 20);
+    CHECK(estimate.breakdown.hashing == expected);
+    CHECK(estimate.total_cycles == expected);
+    CHECK(estimate.peak_stack_bytes == 64);
+    
+    // Survives compilation, and the compiled-in example model agrees with
+    // the runtime one
+    CHECK(check_compiled_agreement(model_path, unlocking, locking, tx).breakdown.hashing == expected);
+    CHECK(check_static_agreement(unlocking, locking, tx).breakdown.hashing > 0);
+    
+    std::cout << "  ✓ HASH160, RIPEMD160 and SHA1: " << estimate.breakdown.hashing
+              << " cycles" << std::endl;
+}
+
+void test_split_num2bin_sizes() {
+    std::cout << "Test: OP_SPLIT and OP_NUM2BIN result sizes..." << std::endl;
+    
+    const char* model_path = "test_split_model.json";
+    TestFiles files({model_path});
+    write_model(model_path, R"({"profile_id": "split",
+                                "constants": {"c_dispatch": 0, "c_parse_per_byte": 0},
+                                "opcodes": {"OP_SPLIT": {"model": "linear", "c0": 200, "c1": 1},
+                                            "OP_NUM2BIN": {"model": "linear", "c0": 100, "c1": 2}},
+                                "first_touch": {"c_map": 1000, "c_per_page": 10,
+                                                "page_bytes": 4096, "threshold_bytes": 131072}})");
+    
+    Transaction tx = make_test_tx();
+    CostEstimator estimator(model_path);
+    
+    // PUSHDATA4 <200000 bytes> <150000> SPLIT: 49 pages for the push, 37 for
+    // the left half and none for the 50000-byte right half
+    Script item = {static_cast<uint8_t>(OpCode::OP_PUSHDATA4), 0x40, 0x0d, 0x03, 0x00};
+    item.resize(item.size() + 200000, 0x11);
+    Script split = {0x03, 0xf0, 0x49, 0x02, static_cast<uint8_t>(OpCode::OP_SPLIT)};
+    auto known = estimator.estimate(item, split, tx, 0);
+    CHECK(known.breakdown.byte_ops == 200 + 200000);
+    CHECK(known.breakdown.memory == (1000 + 10 * 49) + (1000 + 10 * 37));
+    CHECK(known.peak_stack_bytes == 200000 + 3);
+    CHECK(check_compiled_agreement(model_path, item, split, tx).breakdown.memory ==
+          known.breakdown.memory);
+    
+    // A position too wide to track is priced as one half taking the item
+    Script wide_split = {0x05, 0xf0, 0x49, 0x02, 0x00, 0x00, static_cast<uint8_t>(OpCode::OP_SPLIT)};
+    CHECK(estimator.estimate(item, wide_split, tx, 0).breakdown.memory == 2 * (1000 + 10 * 49));
+    
+    // <7> <200000> NUM2BIN makes a 200000-byte item, <7> OP_16 NUM2BIN a
+    // 16-byte one
+    Script number = {0x01, 0x07};
+    Script padded = {0x03, 0x40, 0x0d, 0x03, static_cast<uint8_t>(OpCode::OP_NUM2BIN)};
+    auto large = estimator.estimate(number, padded, tx, 0);
+    CHECK(large.breakdown.byte_ops == 100 + 2 * 200000);
+    CHECK(large.breakdown.memory == 1000 + 10 * 49);
+    CHECK(large.peak_stack_bytes == 200000);
+    Script small = {static_cast<uint8_t>(OpCode::OP_16), static_cast<uint8_t>(OpCode::OP_NUM2BIN)};
+    CHECK(estimator.estimate(number, small, tx, 0).breakdown.byte_ops == 100 + 2 * 16);
+    
+    // A size too wide to track leaves the number its own size
+    Script wide_size = {0x05, 0x40, 0x0d, 0x03, 0x00, 0x00, static_cast<uint8_t>(OpCode::OP_NUM2BIN)};
+    CHECK(estimator.estimate(number, wide_size, tx, 0).breakdown.byte_ops == 100 + 2 * 1);
+    
+    // The compiled-in example model agrees with the runtime one
+    CHECK(check_static_agreement(item, split, tx).breakdown.byte_ops > 0);
+    CHECK(check_static_agreement(number, padded, tx).breakdown.byte_ops > 0);
+    
+    std::cout << "  ✓ SPLIT of 200KB: " << known.breakdown.memory
+              << " first-touch cycles; NUM2BIN to 200KB: " << large.breakdown.byte_ops
+              << " cycles" << std::endl;
+}
+
+void test_multisig_counts() {
+    std::cout << "Test: OP_CHECKMULTISIG priced by m and n..." << std::endl;
+    
+    const char* model_path = "test_multisig_model.json";
+    TestFiles files({model_path});
+    write_model(model_path, R"({"profile_id": "multisig",
+                                "constants": {"c_dispatch": 0, "c_parse_per_byte": 0},
+                                "opcodes": {"OP_CHECKMULTISIG": {"model": "multisig", "c_ecdsa": 10000,
+                                                                 "c_preimage_per_byte": 1.0,
+                                                                 "c_keyscan": 100, "c_setup": 50}}})");
+    
+    Transaction tx = make_test_tx(Script(25, 0));
+    uint64_t verify = 10000 + calculate_sighash_size(tx, 0, SIGHASH_ALL);
+    
+    // OP_0 <sig> <sig> | <m> <pubkey>*3 OP_3 CHECKMULTISIG
+    Script unlocking = {static_cast<uint8_t>(OpCode::OP_0), 0x01, 0x00, 0x01, 0x00};
+    auto locking_with = [](const Script& m_push, const Script& n_push) {
+        Script locking = m_push;
+        for (int i = 0; i < 3; ++i) {
+            locking.push_back(0x21);
+            locking.resize(locking.size() + 33, 0x02);
+        }
+        locking.insert(locking.end(), n_push.begin(), n_push.end());
+        locking.push_back(static_cast<uint8_t>(OpCode::OP_CHECKMULTISIG));
+        return locking;
+    };
+    Script two = {static_cast<uint8_t>(OpCode::OP_1) + 1};
+    Script three = {static_cast<uint8_t>(OpCode::OP_1) + 2};
+    Script untracked = {0x05, 0x03, 0x00, 0x00, 0x00, 0x00};  // 3, too wide to track
+    
+    CostEstimator estimator(model_path);
+    auto known = estimator.estimate(unlocking, locking_with(two, three), tx, 0);
+    CHECK(known.breakdown.signatures == 2 * verify + 1 * 100 + 50);
+    CHECK(known.signature_count == 2);
+    CHECK(known.peak_stack_items == 8);
+    
+    // An unknown m is taken to be n; an unknown n prices the 20-key limit
+    auto unknown_m = estimator.estimate(unlocking, locking_with(untracked, three), tx, 0);
+    CHECK(unknown_m.breakdown.signatures == 3 * verify + 50);
+    auto unknown_n = estimator.estimate(unlocking, locking_with(two, untracked), tx, 0);
+    CHECK(unknown_n.breakdown.signatures == 20 * verify + 50);
+    CHECK(unknown_n.signature_count == 20);
+    
+    // Survives compilation, and the compiled-in example model agrees with
+    // the runtime one
+    CHECK(check_compiled_agreement(model_path, unlocking, locking_with(two, three), tx)
+              .breakdown.signatures == known.breakdown.signatures);
+    CHECK(check_static_agreement(unlocking, locking_with(two, three), tx).signature_count == 2);
+    
+    std::cout << "  ✓ 2-of-3: " << known.breakdown.signatures << " cycles, unknown n: "
+              << unknown_n.breakdown.signatures << " cycles" << std::endl;
+}
+
 int main() {
     std::cout << "=== Running Cost Estimator Tests ===" << std::endl;
     std::cout << std::endl;
@@ -154,6 +1138,24 @@ int main() {
         test_cat_operation();
         test_hash_operations();
         test_limits();
+        test_cold_cache_coefficients();
+        test_piecewise_model();
+        test_table_model();
+        test_compiled_model();
+        test_model_hot_reload();
+        test_profile_selection();
+        test_static_estimator();
+        test_parallel_estimate();
+        test_sigcache_pricing();
+        test_arithmetic_models();
+        test_control_flow_costs();
+        test_bitwise_models();
+        test_roll_depth();
+        test_first_touch();
+        test_batched_preimage_hashing();
+        test_160_bit_hashes();
+        test_split_num2bin_sizes();
+        test_multisig_counts();
         
         std::cout << std::endl;
         std::cout << "All tests passed! ✓" << std::endl;
@@ -0,0 +1,352 @@
+// Compile a JSON cost model into the binary format CostEstimator mmaps.
+//
+// Usage:
+//   bsv_compile_model cost_models/host_2025_11_10.json -o host_2025_11_10.bsvcm
+//   bsv_compile_model --info host_2025_11_10.bsvcm
+//   bsv_compile_model --cxx-header appliance_model cost_models/host.json -o appliance_model.h
+//
+// The output is deterministic for a given input, and is written to a
+// temporary file and renamed into place so estimators that have the old
+// model mapped are unaffected.
+//
+// --cxx-header emits the model as constexpr tables for StaticCostEstimator
+// instead (see bsv/static_cost_estimator.h).
+
+#include "bsv/compiled_model.h"
+#include "cost_model.h"
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+using namespace bsv::cost;
+
+static const char* type_name(CostModelType type) {
+    switch (type) {
+        case CostModelType::NONE: return "none";
+        case CostModelType::CONSTANT: return "constant";
+        case CostModelType::LINEAR: return "linear";
+        case CostModelType::PIECEWISE: return "piecewise";
+        case CostModelType::TABLE: return "table";
+        case CostModelType::SIGNATURE: return "signature";
+        case CostModelType::MULTISIG: return "multisig";
+        case CostModelType::QUADRATIC: return "quadratic";
+        case CostModelType::NLOGN: return "nlogn";
+    }
+    return "?";
+}
+
+static void usage() {
+    std::cerr <<
+        "Usage: bsv_compile_model MODEL.json -o OUTPUT\n"
+        "       bsv_compile_model --info MODEL\n"
+        "\n"
+        "Options:\n"
+        "  -o, --output FILE       Write the compiled model here (default: MODEL with\n"
+        "                          its extension replaced by .bsvcm)\n"
+        "  --info                  Validate a compiled (or JSON) model and print its contents\n"
+        "  --cxx-header NAME       Write a C++ header defining bsv::cost::models::NAME with\n"
+        "                          the model as constexpr tables (for StaticCostEstimator)\n"
+        "  -h, --help              Show this help\n";
+}
+
+static int print_info(const std::string& path) {
+    auto model = CompiledModel::load(path);
+    const CompiledModelHeader& header = model->header();
+
+    std::cout << "file:             " << path
+              << (model->file_backed() ? " (compiled)" : " (JSON, compiled in memory)") << "\n"
+              << "format version:   " << header.version << "\n"
+              << "size:             " << model->size() << " bytes\n"
+              << "checksum:         " << std::hex << std::setw(16) << std::setfill('0')
+              << header.checksum << std::dec << std::setfill(' ') << "\n"
+              << "profile_id:       " << model->profile_id() << "\n"
+              << "c_dispatch:       " << header.c_dispatch << "\n"
+              << "c_parse_per_byte: " << header.c_parse_per_byte << "\n"
+              << "piecewise:        " << header.piecewise_count << "\n"
+              << "table points:     " << header.table_point_count << "\n"
+              << "parallel:         ";
+    if (header.parallel.count == 0) {
+        std::cout << "none (ideal scaling)\n";
+    } else {
+        for (uint32_t i = 0; i < header.parallel.count; ++i) {
+            std::cout << (i ? ", " : "") << header.parallel.threads[i] << "t="
+                      << header.parallel.compute[i] << "/" << header.parallel.memory[i];
+        }
+        std::cout << " (compute/memory), smt " << header.parallel.smt_speedup << "\n";
+    }
+    const ControlFlowCost& control = header.control_flow;
+    std::cout << "control flow:     " << control.c_exec_per_depth << "/depth, "
+              << control.c_skip_per_byte << "/skipped byte, "
+              << control.c_mispredict << "/mispredict\n";
+    const FirstTouchCost& touch = header.first_touch;
+    if (touch.page_bytes == 0) {
+        std::cout << "first touch:      none\n";
+    } else {
+        std::cout << "first touch:      " << touch.c_map << " + " << touch.c_per_page << "/"
+                  << touch.page_bytes << "B page, from " << touch.threshold_bytes << "B\n";
+    }
+    std::string software = model->software_info();
+    std::cout << "software:         " << (software.empty() ? "none" : software) << "\n";
+    std::cout << "\n";
+
+    for (int op = 0; op < 256; ++op) {
+        const OpcodeCostModel& entry = model->opcode(static_cast<uint8_t>(op));
+        if (entry.type == CostModelType::NONE) continue;
+
+        const char* name = opcode_name(static_cast<uint8_t>(op));
+        std::cout << "  0x" << std::hex << std::setw(2) << std::setfill('0') << op
+                  << std::dec << std::setfill(' ') << "  "
+                  << std::left << std::setw(20) << (name ? name : "?")
+                  << std::right << type_name(entry.type)
+                  << (entry.has_cold ? " (cold)" : "") << "\n";
+    }
+    return 0;
+}
+
+static const char* type_enumerator(CostModelType type) {
+    switch (type) {
+        case CostModelType::NONE: return "NONE";
+        case CostModelType::CONSTANT: return "CONSTANT";
+        case CostModelType::LINEAR: return "LINEAR";
+        case CostModelType::PIECEWISE: return "PIECEWISE";
+        case CostModelType::TABLE: return "TABLE";
+        case CostModelType::SIGNATURE: return "SIGNATURE";
+        case CostModelType::MULTISIG: return "MULTISIG";
+        case CostModelType::QUADRATIC: return "QUADRATIC";
+        case CostModelType::NLOGN: return "NLOGN";
+    }
+    return "NONE";
+}
+
+// Round-trippable double literal
+static std::string cxx_double(double value) {
+    if (std::isinf(value)) {
+        return value > 0 ? "kInf" : "-kInf";
+    }
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.17g", value);
+    std::string literal = text;
+    if (literal.find_first_of(".eE") == std::string::npos) literal += ".0";
+    return literal;
+}
+
+static std::string cxx_string(const std::string& value) {
+    std::string out = "\"";
+    for (char c : value) {
+        if (c == '"' || c == '\\') out += '\\';
+        if (static_cast<unsigned char>(c) >= 0x20) out += c;
+    }
+    return out + "\"";
+}
+
+static bool is_identifier(const std::string& name) {
+    if (name.empty() || std::isdigit(static_cast<unsigned char>(name[0]))) return false;
+    for (char c : name) {
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_') return false;
+    }
+    return true;
+}
+
+static std::string cxx_header(const CompiledModel& model, const std::string& name,
+                              const std::string& source) {
+    const CompiledModelHeader& header = model.header();
+    std::ostringstream out;
+
+    out << "// Generated by bsv_compile_model from " << source << ". Do not edit.\n"
+        << "#pragma once\n"
+        << "\n"
+        << "#include \"bsv/static_cost_estimator.h\"\n"
+        << "#include <array>\n"
+        << "#include <limits>\n"
+        << "\n"
+        << "namespace bsv {\n"
+        << "namespace cost {\n"
+        << "namespace models {\n"
+        << "\n"
+        << "struct " << name << " {\n"
+        << "    static constexpr double kInf = std::numeric_limits<double>::infinity();\n"
+        << "\n"
+        << "    static constexpr const char* profile_id = " << cxx_string(model.profile_id()) << ";\n"
+        << "    static constexpr double c_dispatch = " << cxx_double(header.c_dispatch) << ";\n"
+        << "    static constexpr double c_parse_per_byte = " << cxx_double(header.c_parse_per_byte) << ";\n"
+        << "\n"
+        << "    // {type, has_cold, c0, c1, c2, c_ecdsa, c_preimage_per_byte, c_keyscan, c_setup,\n"
+        << "    //  c_sigcache_hit, c_preimage_per_byte_batched, c_alloc, c0_cold, c1_cold,\n"
+        << "    //  aux_offset, aux_count}\n"
+        << "    static constexpr std::array<OpcodeCostModel, 256> opcodes = [] {\n"
+        << "        std::array<OpcodeCostModel, 256> t{};\n";
+    for (int op = 0; op < 256; ++op) {
+        const OpcodeCostModel& e = model.opcode(static_cast<uint8_t>(op));
+        if (e.type == CostModelType::NONE) continue;
+        const char* op_name = opcode_name(static_cast<uint8_t>(op));
+        out << "        t[0x" << std::hex << std::setw(2) << std::setfill('0') << op
+            << std::dec << std::setfill(' ') << "] = {CostModelType::" << type_enumerator(e.type)
+            << ", " << e.has_cold << ", " << cxx_double(e.c0) << ", " << cxx_double(e.c1)
+            << ", " << cxx_double(e.c2)
+            << ", " << cxx_double(e.c_ecdsa) << ", " << cxx_double(e.c_preimage_per_byte)
+            << ", " << cxx_double(e.c_keyscan) << ", " << cxx_double(e.c_setup)
+            << ", " << cxx_double(e.c_sigcache_hit) << ", " << cxx_double(e.c_preimage_per_byte_batched)
+            << ", " << cxx_double(e.c_alloc) << ", " << cxx_double(e.c0_cold)
+            << ", " << cxx_double(e.c1_cold) << ", " << e.aux_offset << ", " << e.aux_count
+            << "};  // " << (op_name ? op_name : "?") << "\n";
+    }
+    out << "        return t;\n"
+        << "    }();\n"
+        << "\n"
+        << "    static constexpr std::array<PiecewiseCost, " << header.piecewise_count
+        << "> piecewise = {{\n";
+    for (uint32_t i = 0; i < header.piecewise_count; ++i) {
+        const PiecewiseCost& p = model.piecewise()[i];
+        auto list = [&](const double* values, int count) {
+            out << "{";
+            for (int j = 0; j < count; ++j) out << (j ? ", " : "") << cxx_double(values[j]);
+            out << "}";
+        };
+        out << "        {";
+        list(p.breakpoints, kMaxPiecewiseBreakpoints);
+        out << ",\n         ";
+        list(p.c0, kMaxPiecewiseBreakpoints + 1);
+        out << ",\n         ";
+        list(p.c1, kMaxPiecewiseBreakpoints + 1);
+        out << "},\n";
+    }
+    out << "    }};\n"
+        << "\n"
+        << "    // {size, cycles, log(size), log(cycles)}\n"
+        << "    static constexpr std::array<TablePoint, " << header.table_point_count
+        << "> table = {{\n";
+    for (uint32_t i = 0; i < header.table_point_count; ++i) {
+        const TablePoint& t = model.table_points()[i];
+        out << "        {" << cxx_double(t.size) << ", " << cxx_double(t.cycles) << ", "
+            << cxx_double(t.log_size) << ", " << cxx_double(t.log_cycles) << "},\n";
+    }
+    const ParallelEfficiency& p = header.parallel;
+    auto parallel_list = [&](const double* values) {
+        out << "{";
+        for (int j = 0; j < kMaxParallelPoints; ++j) out << (j ? ", " : "") << cxx_double(values[j]);
+        out << "}";
+    };
+    out << "    }};\n"
+        << "\n"
+        << "    // {count, reserved, smt_speedup, threads, compute, memory}\n"
+        << "    static constexpr ParallelEfficiency parallel = {\n"
+        << "        " << p.count << ", 0, " << cxx_double(p.smt_speedup) << ",\n        ";
+    parallel_list(p.threads);
+    out << ",\n        ";
+    parallel_list(p.compute);
+    out << ",\n        ";
+    parallel_list(p.memory);
+    const ControlFlowCost& c = header.control_flow;
+    const FirstTouchCost& f = header.first_touch;
+    out << "};\n"
+        << "\n"
+        << "    // {c_exec_per_depth, c_skip_per_byte, c_mispredict}\n"
+        << "    static constexpr ControlFlowCost control_flow = {"
+        << cxx_double(c.c_exec_per_depth) << ", " << cxx_double(c.c_skip_per_byte) << ", "
+        << cxx_double(c.c_mispredict) << "};\n"
+        << "\n"
+        << "    // {c_map, c_per_page, page_bytes, threshold_bytes}\n"
+        << "    static constexpr FirstTouchCost first_touch = {"
+        << cxx_double(f.c_map) << ", " << cxx_double(f.c_per_page) << ", "
+        << cxx_double(f.page_bytes) << ", " << cxx_double(f.threshold_bytes) << "};\n"
+        << "};\n"
+        << "\n"
+        << "} // namespace models\n"
+        << "} // namespace cost\n"
+        << "} // namespace bsv\n";
+    return out.str();
+}
+
+int main(int argc, char** argv) {
+    std::string input_file;
+    std::string output_file;
+    std::string header_name;
+    bool info = false;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto next = [&]() -> std::string {
+                if (i + 1 >= argc) throw std::runtime_error(arg + " requires a value");
+                return argv[++i];
+            };
+
+            if (arg == "-h" || arg == "--help") {
+                usage();
+                return 0;
+            } else if (arg == "-o" || arg == "--output") {
+                output_file = next();
+            } else if (arg == "--info") {
+                info = true;
+            } else if (arg == "--cxx-header") {
+                header_name = next();
+                if (!is_identifier(header_name)) {
+                    throw std::runtime_error("--cxx-header needs a C++ identifier: " + header_name);
+                }
+            } else if (!arg.empty() && arg[0] == '-') {
+                throw std::runtime_error("Unknown option: " + arg);
+            } else if (input_file.empty()) {
+                input_file = arg;
+            } else {
+                throw std::runtime_error("more than one input file");
+            }
+        }
+        if (input_file.empty()) {
+            throw std::runtime_error("no input file");
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n\n";
+        usage();
+        return 1;
+    }
+
+    try {
+        if (info) {
+            return print_info(input_file);
+        }
+
+        if (!header_name.empty()) {
+            if (output_file.empty()) output_file = header_name + ".h";
+            std::string text = cxx_header(*CompiledModel::load(input_file), header_name, input_file);
+
+            // Leave an unchanged header untouched so dependents don't rebuild
+            std::ifstream existing(output_file, std::ios::binary);
+            std::ostringstream current;
+            current << existing.rdbuf();
+            if (!existing.is_open() || current.str() != text) {
+                std::ofstream out(output_file, std::ios::binary | std::ios::trunc);
+                out << text;
+                if (!out) throw std::runtime_error("Failed to write " + output_file);
+            }
+            return 0;
+        }
+
+        if (output_file.empty()) {
+            size_t dot = input_file.find_last_of('.');
+            size_t slash = input_file.find_last_of('/');
+            bool has_extension = dot != std::string::npos &&
+                                 (slash == std::string::npos || dot > slash);
+            output_file = (has_extension ? input_file.substr(0, dot) : input_file) + ".bsvcm";
+        }
+        if (is_compiled_cost_model(input_file)) {
+            throw std::runtime_error(input_file + " is already compiled");
+        }
+
+        compile_cost_model(input_file, output_file);
+
+        // Load the result back so a bad file never ships
+        auto model = CompiledModel::load(output_file);
+        std::cerr << "Compiled " << input_file << " -> " << output_file
+                  << " (" << model->size() << " bytes, profile " << model->profile_id() << ")\n";
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}